@@ -392,6 +392,26 @@ CHECK_SPECIFIC_ATTRIBUTE([optimize], [NOOPTIMIZE],
                          [int foo (int arg) __attribute__ ((optimize("O0")));])
 
 
+#
+# Check for per-function target attributes, used to compile CRC kernels which
+# are selected at runtime according to CPU capabilities.
+#
+CHECK_SPECIFIC_ATTRIBUTE([target_pclmul], [TARGET_PCLMUL],
+                         [#include <wmmintrin.h>
+                          #include <smmintrin.h>
+                          __attribute__((target("sse4.1,pclmul")))
+                          int foo(long long arg) {
+                              __m128i x = _mm_cvtsi64_si128(arg);
+                              return _mm_extract_epi32(_mm_clmulepi64_si128(x, x, 0), 1);
+                          }])
+CHECK_SPECIFIC_ATTRIBUTE([target_crc], [TARGET_CRC],
+                         [__attribute__((target("+crc")))
+                          unsigned foo(unsigned crc, unsigned long arg) {
+                              asm volatile ("crc32x %w0, %w0, %x1" : "+r"(crc) : "r"(arg));
+                              return crc;
+                          }])
+
+
 #
 # Compile code with frame pointer. Optimizations usually omit the frame pointer,
 # but if we are profiling the code with callgraph we need it.
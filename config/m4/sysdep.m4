@@ -243,6 +243,20 @@ AC_CHECK_HEADERS([sys/eventfd.h])
 AC_CHECK_HEADERS([sys/event.h])
 
 
+#
+# io_uring
+#
+AC_CHECK_DECLS([__NR_io_uring_setup, __NR_io_uring_enter,
+                IORING_OP_POLL_REMOVE, IORING_FEAT_NODROP,
+                IORING_FEAT_SINGLE_MMAP],
+               [],
+               [io_uring_happy=no],
+               [[#include <sys/syscall.h>]
+                [#include <linux/io_uring.h>]])
+AS_IF([test "x$io_uring_happy" != "xno"],
+      [AC_DEFINE([HAVE_IO_URING], 1, [Enable io_uring event set])])
+
+
 #
 # FreeBSD-specific threading functions
 #
@@ -61,6 +61,42 @@ out:
     return result;
 }
 
+static void print_nt_calibrate_bw(size_t size, const double *bw, void *arg)
+{
+    printf("#     %10zu bytes: %10.3f %10.3f %10.3f %10.3f MB/s\n", size,
+           bw[UCS_CPU_NT_COPY_NONE] / UCS_MBYTE,
+           bw[UCS_CPU_NT_COPY_SOURCE] / UCS_MBYTE,
+           bw[UCS_CPU_NT_COPY_DEST] / UCS_MBYTE,
+           bw[UCS_CPU_NT_COPY_ALL] / UCS_MBYTE);
+}
+
+static void print_nt_calibrate()
+{
+    char min_thresh_str[32];
+    char dest_thresh_str[32];
+    size_t nt_min, nt_dest;
+    ucs_status_t status;
+
+    printf("# Copy bandwidth under cache pressure (regular, nt-source, "
+           "nt-destination, nt-all):\n");
+    status = ucs_cpu_nt_calibrate(print_nt_calibrate_bw, NULL, &nt_min,
+                                  &nt_dest);
+    if (status != UCS_OK) {
+        printf("#     not supported: %s\n", ucs_status_string(status));
+        return;
+    }
+
+    ucs_config_sprintf_memunits(min_thresh_str, sizeof(min_thresh_str),
+                                &nt_min, NULL);
+    ucs_config_sprintf_memunits(dest_thresh_str, sizeof(dest_thresh_str),
+                                &nt_dest, NULL);
+    printf("# Calibrated thresholds, can be set in the configuration file:\n");
+    printf("#     %sNT_BUFFER_TRANSFER_MIN=%s\n", UCS_DEFAULT_ENV_PREFIX,
+           min_thresh_str);
+    printf("#     %sNT_DEST_THRESHOLD=%s\n", UCS_DEFAULT_ENV_PREFIX,
+           dest_thresh_str);
+}
+
 static void print_repeat_char(int ch, int count)
 {
     int i;
@@ -230,5 +266,6 @@ void print_sys_info(int print_opts)
             printf("#     %10zu bytes: %.3f MB/s\n", size,
                    measure_memcpy_bandwidth(size) / UCS_MBYTE);
         }
+        print_nt_calibrate();
     }
 }
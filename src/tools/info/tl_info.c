@@ -474,6 +474,9 @@ static void print_md_info(uct_component_h component,
         if (md_attr.flags & UCT_MD_FLAG_INVALIDATE) {
             printf("#           memory invalidation is supported\n");
         }
+        if (md_attr.flags & UCT_MD_FLAG_REG_FILE) {
+            printf("#           file-backed memory registration is supported\n");
+        }
 
         if (md_attr.reg_alignment != 1) {
             printf("#            alignment: %zx\n", md_attr.reg_alignment);
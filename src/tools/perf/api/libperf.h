@@ -293,6 +293,10 @@ typedef struct ucx_perf_params {
         ucp_perf_datatype_t     recv_datatype;
         size_t                  am_hdr_size; /* UCP Active Message header size
                                                 (not included in message size) */
+        char                    reg_mpool_pages[16]; /* Page backing of the
+                                                        registered memory pools
+                                                        (UCX_REG_MPOOL_PAGES),
+                                                        empty for default */
         int                     is_daemon_mode;  /* Whether DPU offloading daemon
                                                     is configured */
         struct sockaddr_storage dmn_local_addr;  /* IP and port of local daemon,
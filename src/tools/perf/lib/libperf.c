@@ -2050,6 +2050,15 @@ static ucs_status_t ucp_perf_setup(ucx_perf_context_t *perf)
         goto err;
     }
 
+    if (perf->params.ucp.reg_mpool_pages[0] != '\0') {
+        status = ucp_config_modify(config, "REG_MPOOL_PAGES",
+                                   perf->params.ucp.reg_mpool_pages);
+        if (status != UCS_OK) {
+            ucp_config_release(config);
+            goto err;
+        }
+    }
+
     status = ucp_init(&ucp_params, config, &perf->ucp.context);
     ucp_config_release(config);
     if (status != UCS_OK) {
@@ -151,6 +151,10 @@ static void usage(const struct perftest_context *ctx, const char *program)
                                 ctx->params.super.ucp.am_hdr_size);
     printf("     -y             do additional memcopy to the user memory in active message receive handler\n");
     printf("     -z             pass pre-registered memory handle\n");
+    printf("     -L <pages>     page backing of the registered bounce buffer pools\n");
+    printf("                        regular    - allocation methods from UCX_ALLOC_PRIO\n");
+    printf("                        thp        - transparent huge pages\n");
+    printf("                        hugetlb    - huge pages from hugetlbfs\n");
     printf("     -g <IP>[:<port>], --daemon-local <IP>[:<port>]\n");
     printf("                    IP address and port of the local daemon to offload UCP operations to\n");
     printf("                    Port is optional, by default daemon port is (%d)\n",
@@ -510,6 +514,15 @@ ucs_status_t parse_test_params(perftest_params_t *params, char opt,
     case 'z':
         params->super.flags |= UCX_PERF_TEST_FLAG_PREREG;
         return UCS_OK;
+    case 'L':
+        if (strcmp(opt_arg, "regular") && strcmp(opt_arg, "thp") &&
+            strcmp(opt_arg, "hugetlb")) {
+            ucs_error("Invalid option argument for -L");
+            return UCS_ERR_INVALID_PARAM;
+        }
+        ucs_strncpy_zero(params->super.ucp.reg_mpool_pages, opt_arg,
+                         sizeof(params->super.ucp.reg_mpool_pages));
+        return UCS_OK;
     default:
        return UCS_ERR_INVALID_PARAM;
     }
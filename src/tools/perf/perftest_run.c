@@ -156,6 +156,12 @@ static void print_header(struct perftest_context *ctx)
             printf("| AM header size: %-60zu                             |\n",
                    ctx->params.super.ucp.am_hdr_size);
         }
+
+        if ((test->api == UCX_PERF_API_UCP) &&
+            (ctx->params.super.ucp.reg_mpool_pages[0] != '\0')) {
+            printf("| Reg. pages:   %-60s                               |\n",
+                   ctx->params.super.ucp.reg_mpool_pages);
+        }
     }
 
     if (ctx->flags & TEST_FLAG_PRINT_CSV) {
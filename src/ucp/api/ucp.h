@@ -392,7 +392,13 @@ enum ucp_mem_map_params_field {
     UCP_MEM_MAP_PARAM_FIELD_MEMORY_TYPE          = UCS_BIT(4),
 
     /** Exported memory handle buffer. */
-    UCP_MEM_MAP_PARAM_FIELD_EXPORTED_MEMH_BUFFER = UCS_BIT(5)
+    UCP_MEM_MAP_PARAM_FIELD_EXPORTED_MEMH_BUFFER = UCS_BIT(5),
+
+    /** File descriptor of the file which holds the data. */
+    UCP_MEM_MAP_PARAM_FIELD_FILE_FD              = UCS_BIT(6),
+
+    /** File offset of the data. */
+    UCP_MEM_MAP_PARAM_FIELD_FILE_OFFSET          = UCS_BIT(7)
 };
 
 /**
@@ -1684,6 +1690,29 @@ typedef struct ucp_mem_map_params {
       * set to NULL by default.
       */
     const void              *exported_memh_buffer;
+
+     /**
+      * File descriptor of a regular file which holds the data of the memory
+      * segment to map, e.g. the segment is a mapping of this file.
+      * If it's set (along with its corresponding bit in the field_mask -
+      * @ref UCP_MEM_MAP_PARAM_FIELD_FILE_FD), the memory is also registered
+      * with the file on the transports which support it, so zero-copy sends
+      * from the segment may transmit the data from the file without copying
+      * it to user space.
+      * Can be used only to map an existing memory segment, which is not cached
+      * by the registration cache. The file descriptor must remain open until
+      * the memory is unmapped.
+      */
+     int                    file_fd;
+
+     /**
+      * File offset of the data at @ref ucp_mem_map_params.address, when
+      * @ref ucp_mem_map_params.file_fd is set.
+      * If it's not set (along with its corresponding bit in the field_mask -
+      * @ref UCP_MEM_MAP_PARAM_FIELD_FILE_OFFSET), the @ref ucp_mem_map routine
+      * will consider the offset as set to 0.
+      */
+     size_t                 file_offset;
 } ucp_mem_map_params_t;
 
 
@@ -101,6 +101,13 @@ static const char *ucp_fence_modes[] = {
     [UCP_FENCE_MODE_LAST]     = NULL
 };
 
+static const char *ucp_mpool_pages[] = {
+    [UCP_MPOOL_PAGES_REGULAR] = "regular",
+    [UCP_MPOOL_PAGES_THP]     = "thp",
+    [UCP_MPOOL_PAGES_HUGETLB] = "hugetlb",
+    [UCP_MPOOL_PAGES_LAST]    = NULL
+};
+
 static const char *ucp_rndv_modes[] = {
     [UCP_RNDV_MODE_AUTO]         = "auto",
     [UCP_RNDV_MODE_GET_ZCOPY]    = "get_zcopy",
@@ -263,6 +270,14 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "Segment size that is used to perform data transfer when doing RKEY PTR progress",
    ucs_offsetof(ucp_context_config_t, rkey_ptr_seg_size), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"RNDV_SHM_RKEY_PTR", "n",
+   "Use single-copy rkey_ptr rendezvous between local processes for buffers\n"
+   "allocated by ucp_mem_map() on a shared memory domain (e.g. posix, sysv),\n"
+   "when no transport can map arbitrary remote memory (e.g. xpmem). The send\n"
+   "buffer memory handle must be passed to the send operation, and it must be\n"
+   "allocated on the memory domain of the selected transport.",
+   ucs_offsetof(ucp_context_config_t, rndv_shm_rkey_ptr), UCS_CONFIG_TYPE_BOOL},
+
   {"ZCOPY_THRESH", "auto",
    "Threshold for switching from buffer copy to zero copy protocol",
    ucs_offsetof(ucp_context_config_t, zcopy_thresh), UCS_CONFIG_TYPE_MEMUNITS},
@@ -315,6 +330,17 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "Size of a segment in the worker preregistered memory pool.",
    ucs_offsetof(ucp_context_config_t, seg_size), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"REG_MPOOL_PAGES", "regular",
+   "Page backing of the worker preregistered host memory pools, which hold the\n"
+   "bounce buffers and the host rendezvous pipeline fragments:\n"
+   " regular - allocate with the methods from UCX_ALLOC_PRIO.\n"
+   " thp     - transparent huge pages, requested by madvise(MADV_HUGEPAGE).\n"
+   " hugetlb - huge pages from hugetlbfs.\n"
+   "With thp or hugetlb, chunk sizes are rounded up to the huge page size, and\n"
+   "if huge pages cannot be allocated, the methods from UCX_ALLOC_PRIO are used.",
+   ucs_offsetof(ucp_context_config_t, reg_mpool_pages),
+   UCS_CONFIG_TYPE_ENUM(ucp_mpool_pages)},
+
   {"TM_THRESH", "1024", /* TODO: calculate automatically */
    "Threshold for using tag matching offload capabilities.\n"
    "Smaller buffers will not be posted to the transport.",
@@ -1719,6 +1745,10 @@ ucp_add_component_resources(ucp_context_h context, ucp_rsc_index_t cmpt_index,
             context->dmabuf_reg_md_map |= UCS_BIT(md_index);
         }
 
+        if (md_attr->flags & UCT_MD_FLAG_REG_FILE) {
+            context->file_reg_md_map |= UCS_BIT(md_index);
+        }
+
         ucs_for_each_bit(mem_type, md_attr->dmabuf_mem_types) {
             /* In case of multiple providers, take the first one */
             if (context->dmabuf_mds[mem_type] == UCP_NULL_RESOURCE) {
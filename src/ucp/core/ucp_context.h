@@ -80,10 +80,14 @@ typedef struct ucp_context_config {
     ucp_rndv_mode_t                        rndv_mode;
     /** RKEY PTR segment size */
     size_t                                 rkey_ptr_seg_size;
+    /** Use rkey_ptr rendezvous with memory allocated on shared memory MDs */
+    int                                    rndv_shm_rkey_ptr;
     /** Estimation of bcopy bandwidth */
     double                                 bcopy_bw;
     /** Segment size in the worker pre-registered memory pool */
     size_t                                 seg_size;
+    /** Page backing of the pre-registered host memory pools */
+    ucp_mpool_pages_t                      reg_mpool_pages;
     /** RNDV pipeline fragment size */
     size_t                                 rndv_frag_size[UCS_MEMORY_TYPE_LAST];
     /** Number of RNDV pipeline fragments per allocation */
@@ -374,6 +378,9 @@ typedef struct ucp_context {
     /* Map of MDs that support dmabuf registration */
     ucp_md_map_t                  dmabuf_reg_md_map;
 
+    /* Map of MDs that support registration of memory backed by a file */
+    ucp_md_map_t                  file_reg_md_map;
+
     /* List of MDs that detect non host memory type */
     ucp_md_index_t                mem_type_detect_mds[UCS_MEMORY_TYPE_LAST];
     ucp_md_index_t                num_mem_type_detect_mds;  /* Number of mem type MDs */
@@ -243,7 +243,9 @@ static int ucp_is_md_selected_by_config(ucp_context_h context,
 static ucs_status_t ucp_mem_do_alloc(ucp_context_h context, void *address,
                                      size_t length, unsigned uct_flags,
                                      ucs_memory_type_t mem_type,
-                                     ucs_sys_device_t sys_dev, const char *name,
+                                     ucs_sys_device_t sys_dev,
+                                     uct_alloc_method_t pref_method,
+                                     const char *name,
                                      uct_allocated_memory_t *mem)
 {
     uct_alloc_method_t method;
@@ -252,6 +254,32 @@ static ucs_status_t ucp_mem_do_alloc(ucp_context_h context, void *address,
     ucs_status_t status;
     uct_md_h mds[UCP_MAX_MDS];
 
+    /* Try the preferred method first, and fall back to the configured ones */
+    if (pref_method != UCT_ALLOC_METHOD_DEFAULT) {
+        ucs_assert(pref_method != UCT_ALLOC_METHOD_MD);
+
+        memset(&params, 0, sizeof(params));
+        params.field_mask = UCT_MEM_ALLOC_PARAM_FIELD_FLAGS    |
+                            UCT_MEM_ALLOC_PARAM_FIELD_ADDRESS  |
+                            UCT_MEM_ALLOC_PARAM_FIELD_MEM_TYPE |
+                            UCT_MEM_ALLOC_PARAM_FIELD_NAME     |
+                            UCT_MEM_ALLOC_PARAM_FIELD_SYS_DEVICE;
+        params.flags      = uct_flags;
+        params.name       = name;
+        params.mem_type   = mem_type;
+        params.address    = address;
+        params.sys_device = sys_dev;
+
+        status = uct_mem_alloc(length, &pref_method, 1, &params, mem);
+        if (status == UCS_OK) {
+            goto out;
+        }
+
+        ucs_debug("failed to allocate %zu bytes of %s with method %s, "
+                  "falling back to the configured methods", length, name,
+                  uct_alloc_method_names[pref_method]);
+    }
+
     for (method_index = 0; method_index < context->config.num_alloc_methods;
                     ++method_index)
     {
@@ -355,7 +383,8 @@ static void ucp_memh_dereg(ucp_context_h context, ucp_mem_h memh,
         }
 
         ucs_trace("de-registering memh[%d]=%p", md_index, memh->uct[md_index]);
-        ucs_assert(context->tl_mds[md_index].attr.flags & UCT_MD_FLAG_REG);
+        ucs_assert((context->tl_mds[md_index].attr.flags & UCT_MD_FLAG_REG) ||
+                   (context->file_reg_md_map & UCS_BIT(md_index)));
 
         params.memh = memh->uct[md_index];
         if (memh->inv_md_map & UCS_BIT(md_index)) {
@@ -521,6 +550,7 @@ static ucs_status_t ucp_memh_register_gva(ucp_context_h context, ucp_mem_h memh,
 static ucs_status_t
 ucp_memh_register_internal(ucp_context_h context, ucp_mem_h memh,
                            ucp_md_map_t md_map, unsigned uct_flags,
+                           int file_fd, size_t file_offset,
                            const char *alloc_name, ucs_log_level_t err_level,
                            int allow_partial_reg, int gva_enable)
 {
@@ -585,7 +615,9 @@ ucp_memh_register_internal(ucp_context_h context, ucp_mem_h memh,
 
     ucs_for_each_bit(md_index, reg_md_map) {
         ucs_assertv((context->reg_md_map[mem_type] |
-                     context->reg_block_md_map[mem_type]) & UCS_BIT(md_index),
+                     context->reg_block_md_map[mem_type] |
+                     ((file_fd >= 0) ? context->file_reg_md_map : 0)) &
+                            UCS_BIT(md_index),
                     "mem_type=%s md[%d]=%s reg_md_map=0x%" PRIx64
                     " reg_block_md_map=0x%" PRIx64,
                     ucs_memory_type_names[mem_type], md_index,
@@ -608,6 +640,17 @@ ucp_memh_register_internal(ucp_context_h context, ucp_mem_h memh,
             ucs_align_ptr_range(&reg_address, &reg_length, reg_align);
         }
 
+        if ((file_fd >= 0) &&
+            (context->file_reg_md_map & UCS_BIT(md_index)) &&
+            (UCS_PTR_BYTE_DIFF(reg_address, address) <= file_offset)) {
+            /* If this MD can send the data from the file - provide it */
+            reg_params.field_mask |= UCT_MD_MEM_REG_FIELD_FILE_FD |
+                                     UCT_MD_MEM_REG_FIELD_FILE_OFFSET;
+            reg_params.file_fd     = file_fd;
+            reg_params.file_offset = file_offset -
+                                     UCS_PTR_BYTE_DIFF(reg_address, address);
+        }
+
         status = uct_md_mem_reg_v2(context->tl_mds[md_index].md, reg_address,
                                    reg_length, &reg_params, &memh->uct[md_index]);
         if (ucs_unlikely(status != UCS_OK)) {
@@ -646,16 +689,26 @@ out_close_dmabuf_fd:
     return status;
 }
 
-ucs_status_t ucp_memh_register(ucp_context_h context, ucp_mem_h memh,
-                               ucp_md_map_t md_map, unsigned uct_flags,
-                               const char *alloc_name)
+static ucs_status_t
+ucp_memh_register_file(ucp_context_h context, ucp_mem_h memh,
+                       ucp_md_map_t md_map, unsigned uct_flags, int file_fd,
+                       size_t file_offset, const char *alloc_name)
 {
     ucs_log_level_t err_level = (uct_flags & UCT_MD_MEM_FLAG_HIDE_ERRORS) ?
                                         UCS_LOG_LEVEL_DIAG :
                                         UCS_LOG_LEVEL_ERROR;
 
     return ucp_memh_register_internal(context, memh, md_map, uct_flags,
-                                      alloc_name, err_level, 1, 1);
+                                      file_fd, file_offset, alloc_name,
+                                      err_level, 1, 1);
+}
+
+ucs_status_t ucp_memh_register(ucp_context_h context, ucp_mem_h memh,
+                               ucp_md_map_t md_map, unsigned uct_flags,
+                               const char *alloc_name)
+{
+    return ucp_memh_register_file(context, memh, md_map, uct_flags, -1, 0,
+                                  alloc_name);
 }
 
 void ucp_memh_disable_gva(ucp_mem_h memh, ucp_md_map_t md_map)
@@ -665,8 +718,9 @@ void ucp_memh_disable_gva(ucp_mem_h memh, ucp_md_map_t md_map)
 
     memh->md_map &= ~context->gva_md_map[memh->mem_type];
     memh->flags  &= ~UCP_MEMH_FLAG_HAS_AUTO_GVA;
-    status = ucp_memh_register_internal(context, memh, md_map, 0, "disable gva",
-                                        UCS_LOG_LEVEL_DIAG, 1, 0);
+    status = ucp_memh_register_internal(context, memh, md_map, 0, -1, 0,
+                                        "disable gva", UCS_LOG_LEVEL_DIAG, 1,
+                                        0);
     /* When allow_partial_reg == 1 registration should not fail */
     ucs_assert_always(status == UCS_OK);
 }
@@ -802,7 +856,8 @@ ucp_memh_init_from_parent(ucp_mem_h memh, ucp_md_map_t parent_md_map)
 }
 
 static ucs_status_t ucp_memh_init_uct_reg(ucp_context_h context, ucp_mem_h memh,
-                                          unsigned uct_flags,
+                                          unsigned uct_flags, int file_fd,
+                                          size_t file_offset,
                                           const char *alloc_name)
 {
     ucs_memory_type_t mem_type = memh->mem_type;
@@ -816,12 +871,17 @@ static ucs_status_t ucp_memh_init_uct_reg(ucp_context_h context, ucp_mem_h memh,
         reg_md_map |= context->reg_block_md_map[mem_type];
     }
 
+    if ((file_fd >= 0) && (mem_type == UCS_MEMORY_TYPE_HOST)) {
+        /* Also register on MDs which send the data from the file */
+        reg_md_map |= context->file_reg_md_map;
+    }
+
     reg_md_map  &= ~memh->md_map;
     cache_md_map = context->cache_md_map[mem_type] & reg_md_map;
 
     if ((context->rcache == NULL) || (memh->flags & UCP_MEMH_FLAG_NO_RCACHE)) {
-        status = ucp_memh_register(context, memh, reg_md_map, uct_flags,
-                                   alloc_name);
+        status = ucp_memh_register_file(context, memh, reg_md_map, uct_flags,
+                                        file_fd, file_offset, alloc_name);
         if (status != UCS_OK) {
             goto err;
         }
@@ -829,6 +889,8 @@ static ucs_status_t ucp_memh_init_uct_reg(ucp_context_h context, ucp_mem_h memh,
         memh->reg_id = context->next_memh_reg_id++;
         memh->parent = memh;
     } else {
+        /* Cached registrations are shared, so they can't refer to a file */
+        ucs_assert(file_fd < 0);
         status = ucp_memh_get(context, address, length, mem_type, cache_md_map,
                               uct_flags, alloc_name, &memh->parent);
         if (status != UCS_OK) {
@@ -978,15 +1040,16 @@ err_free_memh:
 static ucs_status_t ucp_memh_alloc(ucp_context_h context, void *address,
                                    size_t length, ucs_memory_type_t mem_type,
                                    ucs_sys_device_t sys_dev, uint8_t memh_flags,
-                                   unsigned uct_flags, const char *alloc_name,
-                                   ucp_mem_h *memh_p)
+                                   unsigned uct_flags,
+                                   uct_alloc_method_t pref_method,
+                                   const char *alloc_name, ucp_mem_h *memh_p)
 {
     uct_allocated_memory_t mem;
     ucs_status_t status;
     ucp_mem_h memh;
 
     status = ucp_mem_do_alloc(context, address, length, uct_flags, mem_type,
-                              sys_dev, alloc_name, &mem);
+                              sys_dev, pref_method, alloc_name, &mem);
     if (status != UCS_OK) {
         goto out;
     }
@@ -997,7 +1060,8 @@ static ucs_status_t ucp_memh_alloc(ucp_context_h context, void *address,
         goto err_dealloc;
     }
 
-    status = ucp_memh_init_uct_reg(context, memh, uct_flags, alloc_name);
+    status = ucp_memh_init_uct_reg(context, memh, uct_flags, -1, 0,
+                                   alloc_name);
     if (status != UCS_OK) {
         goto err_free_memh;
     }
@@ -1042,7 +1106,8 @@ ucs_status_t ucp_mem_map(ucp_context_h context, const ucp_mem_map_params_t *para
     unsigned flags;
     void *address;
     const void *exported_memh_buffer;
-    size_t length;
+    size_t length, file_offset;
+    int file_fd;
 
     if (!(params->field_mask &
           (UCP_MEM_MAP_PARAM_FIELD_LENGTH |
@@ -1061,6 +1126,10 @@ ucs_status_t ucp_mem_map(ucp_context_h context, const ucp_mem_map_params_t *para
                                            EXPORTED_MEMH_BUFFER, NULL);
     mem_type             = UCP_PARAM_VALUE(MEM_MAP, params, memory_type,
                                            MEMORY_TYPE, UCS_MEMORY_TYPE_LAST);
+    file_fd              = UCP_PARAM_VALUE(MEM_MAP, params, file_fd, FILE_FD,
+                                           -1);
+    file_offset          = UCP_PARAM_VALUE(MEM_MAP, params, file_offset,
+                                           FILE_OFFSET, 0);
 
     if ((flags & UCP_MEM_MAP_FIXED) &&
         ((uintptr_t)address % ucs_get_page_size())) {
@@ -1117,6 +1186,20 @@ ucs_status_t ucp_mem_map(ucp_context_h context, const ucp_mem_map_params_t *para
         goto out;
     }
 
+    if (file_fd >= 0) {
+        if ((flags & UCP_MEM_MAP_ALLOCATE) ||
+            (memh_flags & UCP_MEMH_FLAG_IMPORTED)) {
+            ucs_error("file descriptor can be used only to map an existing "
+                      "memory segment");
+            status = UCS_ERR_INVALID_PARAM;
+            goto out;
+        }
+
+        /* Registrations in the cache may be shared with other mappings of
+         * the same segment, which don't refer to the file */
+        memh_flags |= UCP_MEMH_FLAG_NO_RCACHE;
+    }
+
     uct_flags = ucp_mem_map_params2uct_flags(context, params);
 
     if (memh_flags & UCP_MEMH_FLAG_IMPORTED) {
@@ -1124,15 +1207,17 @@ ucs_status_t ucp_mem_map(ucp_context_h context, const ucp_mem_map_params_t *para
     } else if (flags & UCP_MEM_MAP_ALLOCATE) {
         status = ucp_memh_alloc(context, address, length, mem_type,
                                 UCS_SYS_DEVICE_ID_UNKNOWN, 0, uct_flags,
-                                alloc_name, &memh);
+                                UCT_ALLOC_METHOD_DEFAULT, alloc_name, &memh);
     } else {
         status = ucp_memh_create(context, address, length, mem_type,
-                                 UCT_ALLOC_METHOD_LAST, 0, uct_flags, &memh);
+                                 UCT_ALLOC_METHOD_LAST, memh_flags, uct_flags,
+                                 &memh);
         if (status != UCS_OK) {
             goto out;
         }
 
-        status = ucp_memh_init_uct_reg(context, memh, uct_flags, alloc_name);
+        status = ucp_memh_init_uct_reg(context, memh, uct_flags, file_fd,
+                                       file_offset, alloc_name);
         if (status != UCS_OK) {
             ucs_free(memh);
         }
@@ -1348,17 +1433,57 @@ ucp_mem_advise(ucp_context_h context, ucp_mem_h memh,
     return status;
 }
 
+/**
+ * @return Allocation method to try first for a chunk of a pre-registered memory
+ *         pool, according to the configured page backing. When huge pages are
+ *         requested, the chunk length is rounded up to whole huge pages.
+ */
+static uct_alloc_method_t
+ucp_mpool_alloc_method(ucp_context_h context, ucs_memory_type_t mem_type,
+                       ucs_sys_device_t sys_dev, size_t *length_p)
+{
+    uct_alloc_method_t method;
+    ssize_t huge_page_size;
+
+    if ((mem_type != UCS_MEMORY_TYPE_HOST) ||
+        (sys_dev != UCS_SYS_DEVICE_ID_UNKNOWN)) {
+        return UCT_ALLOC_METHOD_DEFAULT;
+    }
+
+    switch (context->config.ext.reg_mpool_pages) {
+    case UCP_MPOOL_PAGES_THP:
+        method = UCT_ALLOC_METHOD_THP;
+        break;
+    case UCP_MPOOL_PAGES_HUGETLB:
+        method = UCT_ALLOC_METHOD_HUGE;
+        break;
+    default:
+        return UCT_ALLOC_METHOD_DEFAULT;
+    }
+
+    huge_page_size = ucs_get_huge_page_size();
+    if (huge_page_size > 0) {
+        *length_p = ucs_align_up(*length_p, huge_page_size);
+    }
+
+    return method;
+}
+
 static ucs_status_t
 ucp_mpool_malloc(ucp_worker_h worker, ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
 {
+    size_t length = *size_p + sizeof(ucp_mem_desc_t);
     ucp_mem_desc_t *chunk_hdr;
+    uct_alloc_method_t method;
     ucp_mem_h memh;
     ucs_status_t status;
 
-    status = ucp_memh_alloc(worker->context, NULL, *size_p + sizeof(*chunk_hdr),
+    method = ucp_mpool_alloc_method(worker->context, UCS_MEMORY_TYPE_HOST,
+                                    UCS_SYS_DEVICE_ID_UNKNOWN, &length);
+    status = ucp_memh_alloc(worker->context, NULL, length,
                             UCS_MEMORY_TYPE_HOST, UCS_SYS_DEVICE_ID_UNKNOWN,
                             UCP_MEMH_FLAG_NO_RCACHE, UCT_MD_MEM_ACCESS_RMA,
-                            ucs_mpool_name(mp), &memh);
+                            method, ucs_mpool_name(mp), &memh);
     if (status != UCS_OK) {
         goto out;
     }
@@ -1396,8 +1521,10 @@ ucp_rndv_frag_malloc_mpools(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
     ucs_sys_device_t sys_dev     = mpriv->sys_dev;
     size_t frag_size             = context->config.ext.rndv_frag_size[mem_type];
     ucp_rndv_frag_mp_chunk_hdr_t *chunk_hdr;
+    uct_alloc_method_t method;
     ucs_status_t status;
     unsigned num_elems;
+    size_t length;
 
     /* metadata */
     chunk_hdr = ucs_malloc(sizeof(*chunk_hdr) + *size_p, "chunk_hdr");
@@ -1409,10 +1536,12 @@ ucp_rndv_frag_malloc_mpools(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
             mp, (ucs_mpool_chunk_t*)(chunk_hdr + 1), *size_p);
 
     /* payload; need to get default flags from ucp_mem_map_params2uct_flags() */
-    status = ucp_memh_alloc(context, NULL, frag_size * num_elems, mem_type,
-                            sys_dev, UCP_MEMH_FLAG_NO_RCACHE,
+    length = frag_size * num_elems;
+    method = ucp_mpool_alloc_method(context, mem_type, sys_dev, &length);
+    status = ucp_memh_alloc(context, NULL, length, mem_type, sys_dev,
+                            UCP_MEMH_FLAG_NO_RCACHE,
                             UCT_MD_MEM_ACCESS_RMA | UCT_MD_MEM_FLAG_LOCK,
-                            ucs_mpool_name(mp), &chunk_hdr->memh);
+                            method, ucs_mpool_name(mp), &chunk_hdr->memh);
     if (status != UCS_OK) {
         return status;
     }
@@ -1605,7 +1734,7 @@ ucp_mem_rcache_mem_reg_cb(void *ctx, ucs_rcache_t *rcache, void *arg,
         return ucp_memh_register_internal(context, memh, reg_ctx->reg_md_map,
                                           reg_ctx->uct_flags |
                                                   UCT_MD_MEM_FLAG_HIDE_ERRORS,
-                                          reg_ctx->alloc_name,
+                                          -1, 0, reg_ctx->alloc_name,
                                           UCS_LOG_LEVEL_DEBUG, 0, 1);
     }
 
@@ -1751,7 +1880,8 @@ ucs_status_t ucp_mm_get_alloc_md_index(ucp_context_h context,
                                   UCT_MD_MEM_ACCESS_RMA |
                                           UCT_MD_MEM_FLAG_HIDE_ERRORS,
                                   alloc_mem_type, UCS_SYS_DEVICE_ID_UNKNOWN,
-                                  "get_alloc_md_id", &mem);
+                                  UCT_ALLOC_METHOD_DEFAULT, "get_alloc_md_id",
+                                  &mem);
         if (status != UCS_OK) {
             return status;
         }
@@ -206,6 +206,12 @@ static UCS_F_ALWAYS_INLINE ucp_md_map_t ucp_memh_export_md_map(ucp_mem_h memh)
     return memh->context->export_md_map & memh->md_map;
 }
 
+static UCS_F_ALWAYS_INLINE ucp_md_map_t ucp_memh_rkey_md_map(ucp_mem_h memh)
+{
+    /* Registrations with a file are used only to send from the file locally */
+    return memh->md_map & ~memh->context->file_reg_md_map;
+}
+
 static size_t ucp_memh_extended_info_size(size_t size)
 {
     if ((size - sizeof(uint8_t)) > UINT8_MAX) {
@@ -578,7 +584,7 @@ ucp_memh_packed_size(ucp_mem_h memh, uint64_t flags, int rkey_compat)
     }
 
     if (rkey_compat) {
-        return ucp_rkey_packed_size(context, memh->md_map,
+        return ucp_rkey_packed_size(context, ucp_memh_rkey_md_map(memh),
                                     UCS_SYS_DEVICE_ID_UNKNOWN, 0);
     }
 
@@ -597,9 +603,10 @@ static ssize_t ucp_memh_do_pack(ucp_mem_h memh, uint64_t flags,
     if (rkey_compat) {
         mem_info.type    = memh->mem_type;
         mem_info.sys_dev = UCS_SYS_DEVICE_ID_UNKNOWN;
-        return ucp_rkey_pack_memh(memh->context, memh->md_map, memh,
-                                  ucp_memh_address(memh), ucp_memh_length(memh),
-                                  &mem_info, 0, NULL, 0, memh_buffer);
+        return ucp_rkey_pack_memh(memh->context, ucp_memh_rkey_md_map(memh),
+                                  memh, ucp_memh_address(memh),
+                                  ucp_memh_length(memh), &mem_info, 0, NULL, 0,
+                                  memh_buffer);
     }
 
     ucs_fatal("packing rkey using ucp_memh_pack() is unsupported");
@@ -773,11 +780,11 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rkey_proto_resolve,
         rkey_config_key.sys_dev = UCS_SYS_DEVICE_ID_UNKNOWN;
     }
 
-    khiter = kh_get(ucp_worker_rkey_config, &worker->rkey_config_hash,
-                    rkey_config_key);
-    if (ucs_likely(khiter != kh_end(&worker->rkey_config_hash))) {
+    khiter = ucs_swiss_get(ucp_worker_rkey_config, &worker->rkey_config_hash,
+                           rkey_config_key);
+    if (ucs_likely(khiter != ucs_swiss_end(&worker->rkey_config_hash))) {
         /* Found existing configuration in hash */
-        rkey->cfg_index = kh_val(&worker->rkey_config_hash, khiter);
+        rkey->cfg_index = ucs_swiss_val(&worker->rkey_config_hash, khiter);
         return UCS_OK;
     }
 
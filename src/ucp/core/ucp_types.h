@@ -229,6 +229,17 @@ typedef enum {
 } ucp_fence_mode_t;
 
 
+/**
+ * Page backing of the worker pre-registered memory pools.
+ */
+typedef enum {
+    UCP_MPOOL_PAGES_REGULAR, /* Use the configured allocation methods */
+    UCP_MPOOL_PAGES_THP,     /* Transparent huge pages, madvise(MADV_HUGEPAGE) */
+    UCP_MPOOL_PAGES_HUGETLB, /* Huge pages from hugetlbfs */
+    UCP_MPOOL_PAGES_LAST
+} ucp_mpool_pages_t;
+
+
 /**
  * Communication scheme in RNDV protocol.
  */
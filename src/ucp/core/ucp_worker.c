@@ -1911,6 +1911,7 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     ucp_rsc_index_t  iface_id;
     ucs_status_t     status;
     ucs_mpool_params_t mp_params;
+    ucs_numa_node_t  numa_node;
 
     for (iface_id = 0; iface_id < worker->num_ifaces; ++iface_id) {
         if_attr           = &worker->ifaces[iface_id]->attr;
@@ -1925,12 +1926,20 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     /* Create a hashtable of memory pools for mem_type devices */
     kh_init_inplace(ucp_worker_mpool_hash, &worker->mpool_hash);
 
+    /* Place requests and receive buffers on the node of the worker's CPUs */
+    numa_node = ucs_numa_node_of_cpu_set(&worker->cpu_mask);
+
     ucs_mpool_params_reset(&mp_params);
     mp_params.elem_size       = sizeof(ucp_request_t) +
                                 context->config.request.size;
     mp_params.elems_per_chunk = 128;
+    mp_params.numa_node       = numa_node;
     mp_params.ops             = &ucp_request_mpool_ops;
     mp_params.name            = "ucp_requests";
+    if (worker->flags & UCP_WORKER_FLAG_THREAD_MULTI) {
+        /* Let sender threads allocate requests without contention */
+        mp_params.flags |= UCS_MPOOL_FLAG_THREAD_CACHE;
+    }
     /* Create memory pool for requests */
     status = ucs_mpool_init(&mp_params, &worker->req_mp);
     if (status != UCS_OK) {
@@ -1999,7 +2008,8 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
                                     max_mp_entry_size, 0,
                                     UCP_WORKER_HEADROOM_SIZE + worker->am.alignment,
                                     0, UCS_SYS_CACHE_LINE_SIZE, 128, UINT_MAX,
-                                    &ucp_am_mpool_ops, "ucp_am_bufs");
+                                    numa_node, &ucp_am_mpool_ops,
+                                    "ucp_am_bufs");
         if (status != UCS_OK) {
             goto err_reg_mp_cleanup;
         }
@@ -2209,8 +2219,8 @@ ucp_worker_add_rkey_config(ucp_worker_h worker,
     }
 
     /* Save key-to-index lookup */
-    khiter = kh_put(ucp_worker_rkey_config, &worker->rkey_config_hash, *key,
-                    &khret);
+    khiter = ucs_swiss_put(ucp_worker_rkey_config, &worker->rkey_config_hash,
+                           *key, &khret);
     if (khret == UCS_KH_PUT_FAILED) {
         status = UCS_ERR_NO_MEMORY;
         goto err;
@@ -2218,7 +2228,7 @@ ucp_worker_add_rkey_config(ucp_worker_h worker,
 
     /* We should not get into this function if key already exists */
     ucs_assert_always(khret != UCS_KH_PUT_KEY_PRESENT);
-    kh_value(&worker->rkey_config_hash, khiter) = rkey_cfg_index;
+    ucs_swiss_value(&worker->rkey_config_hash, khiter) = rkey_cfg_index;
 
     /* Initialize protocol selection */
     status = ucp_proto_select_init(&rkey_config->proto_select);
@@ -2242,7 +2252,7 @@ ucp_worker_add_rkey_config(ucp_worker_h worker,
     return UCS_OK;
 
 err_kh_del:
-    kh_del(ucp_worker_rkey_config, &worker->rkey_config_hash, khiter);
+    ucs_swiss_del(ucp_worker_rkey_config, &worker->rkey_config_hash, khiter);
 err:
     return status;
 }
@@ -2502,7 +2512,7 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     ucs_list_head_init(&worker->stream_ready_eps);
     ucs_list_head_init(&worker->all_eps);
     ucs_list_head_init(&worker->internal_eps);
-    kh_init_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucs_swiss_init_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
     kh_init_inplace(ucp_worker_discard_uct_ep_hash, &worker->discard_uct_ep_hash);
     worker->counters.ep_creations         = 0;
     worker->counters.ep_creation_failures = 0;
@@ -2713,7 +2723,8 @@ err_free:
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
-    kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucs_swiss_destroy_inplace(ucp_worker_rkey_config,
+                              &worker->rkey_config_hash);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
     return status;
@@ -2963,7 +2974,8 @@ void ucp_worker_destroy(ucp_worker_h worker)
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
-    kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucs_swiss_destroy_inplace(ucp_worker_rkey_config,
+                              &worker->rkey_config_hash);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
 }
@@ -19,6 +19,7 @@
 #include <ucs/datastruct/mpool_set.h>
 #include <ucs/datastruct/queue_types.h>
 #include <ucs/datastruct/strided_alloc.h>
+#include <ucs/datastruct/swiss_hash.h>
 #include <ucs/datastruct/conn_match.h>
 #include <ucs/datastruct/ptr_map.h>
 #include <ucs/datastruct/usage_tracker.h>
@@ -209,8 +210,9 @@ enum {
 
 
 /* Hash map to find rkey config index by rkey config key, for fast rkey unpack */
-KHASH_TYPE(ucp_worker_rkey_config, ucp_rkey_config_key_t, ucp_worker_cfg_index_t);
-typedef khash_t(ucp_worker_rkey_config) ucp_worker_rkey_config_hash_t;
+UCS_SWISS_HASH_TYPE(ucp_worker_rkey_config, ucp_rkey_config_key_t,
+                    ucp_worker_cfg_index_t);
+typedef ucs_swiss_hash_t(ucp_worker_rkey_config) ucp_worker_rkey_config_hash_t;
 
 
 /* Hash map of UCT EPs that are being discarded on UCP Worker */
@@ -17,9 +17,9 @@
 
 UCS_PTR_MAP_IMPL(ep, 1);
 
-KHASH_IMPL(ucp_worker_rkey_config, ucp_rkey_config_key_t,
-           ucp_worker_cfg_index_t, 1, ucp_rkey_config_hash_func,
-           ucp_rkey_config_is_equal);
+UCS_SWISS_HASH_IMPL(ucp_worker_rkey_config, ucp_rkey_config_key_t,
+                    ucp_worker_cfg_index_t, 1, ucp_rkey_config_hash_func,
+                    ucp_rkey_config_is_equal);
 
 #define UCP_WORKER_PROGRESS_TIMER_SKIP_COUNT 32
 
@@ -35,10 +35,10 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_worker_rkey_config_get(
         const ucs_sys_dev_distance_t *lanes_distance,
         ucp_worker_cfg_index_t *cfg_index_p)
 {
-    khiter_t khiter = kh_get(ucp_worker_rkey_config, &worker->rkey_config_hash,
-                             *key);
-    if (ucs_likely(khiter != kh_end(&worker->rkey_config_hash))) {
-        *cfg_index_p = kh_val(&worker->rkey_config_hash, khiter);
+    khiter_t khiter = ucs_swiss_get(ucp_worker_rkey_config,
+                                    &worker->rkey_config_hash, *key);
+    if (ucs_likely(khiter != ucs_swiss_end(&worker->rkey_config_hash))) {
+        *cfg_index_p = ucs_swiss_val(&worker->rkey_config_hash, khiter);
         return UCS_OK;
     }
 
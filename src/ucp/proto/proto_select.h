@@ -10,7 +10,7 @@
 #include "proto.h"
 #include "proto_perf.h"
 
-#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/swiss_hash.h>
 #include <ucs/datastruct/array.h>
 
 
@@ -146,7 +146,7 @@ typedef struct {
 
 
 /* Hash type of mapping a buffer-type (key) to a protocol selection */
-KHASH_TYPE(ucp_proto_select_hash, khint64_t, ucp_proto_select_elem_t)
+UCS_SWISS_HASH_TYPE(ucp_proto_select_hash, khint64_t, ucp_proto_select_elem_t)
 
 
 /**
@@ -154,7 +154,7 @@ KHASH_TYPE(ucp_proto_select_hash, khint64_t, ucp_proto_select_elem_t)
  */
 typedef struct {
     /* Lookup from protocol selection key to thresholds array */
-    khash_t(ucp_proto_select_hash)    *hash;
+    ucs_swiss_hash_t(ucp_proto_select_hash) *hash;
 
     /* cache the last used protocol, for fast lookup */
     struct {
@@ -24,8 +24,8 @@ typedef union {
 } ucp_proto_select_key_t;
 
 
-KHASH_IMPL(ucp_proto_select_hash, khint64_t, ucp_proto_select_elem_t, 1,
-           kh_int64_hash_func, kh_int64_hash_equal)
+UCS_SWISS_HASH_IMPL(ucp_proto_select_hash, khint64_t, ucp_proto_select_elem_t,
+                    1, kh_int64_hash_func, kh_int64_hash_equal)
 
 
 static UCS_F_ALWAYS_INLINE const ucp_proto_threshold_elem_t *
@@ -90,10 +90,11 @@ ucp_proto_select_lookup(ucp_worker_h worker, ucp_proto_select_t *proto_select,
     if (ucs_likely(proto_select->cache.key == key.u64)) {
         select_elem = proto_select->cache.value;
     } else {
-        khiter = kh_get(ucp_proto_select_hash, proto_select->hash, key.u64);
-        if (ucs_likely(khiter != kh_end(proto_select->hash))) {
+        khiter = ucs_swiss_get(ucp_proto_select_hash, proto_select->hash,
+                               key.u64);
+        if (ucs_likely(khiter != ucs_swiss_end(proto_select->hash))) {
             /* key was found in hash - select by message size */
-            select_elem = &kh_value(proto_select->hash, khiter);
+            select_elem = &ucs_swiss_value(proto_select->hash, khiter);
         } else {
             select_elem = ucp_proto_select_lookup_slow(worker, proto_select, 0,
                                                        ep_cfg_index,
@@ -216,6 +216,33 @@ ucp_proto_t ucp_put_offload_bcopy_proto = {
     .reset    = ucp_proto_request_bcopy_reset
 };
 
+static UCS_F_ALWAYS_INLINE ucp_md_index_t
+ucp_proto_put_offload_zcopy_memh_index(ucp_request_t *req,
+                                       const ucp_proto_multi_lane_priv_t *lpriv)
+{
+    const ucp_datatype_iter_t *dt_iter = &req->send.state.dt_iter;
+    ucp_context_h context              = req->send.ep->worker->context;
+    ucp_md_index_t md_index;
+    ucp_mem_h memh;
+
+    if (ucs_likely(lpriv->super.md_index != UCP_NULL_RESOURCE) ||
+        !ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_CONTIG,
+                                    UCP_DT_MASK_CONTIG_IOV)) {
+        return lpriv->super.md_index;
+    }
+
+    /* The lane does not need a memory handle, but if the user mapped the
+     * buffer with a file, the lane can send the data from the file */
+    memh     = dt_iter->type.contig.memh;
+    md_index = ucp_ep_md_index(req->send.ep, lpriv->super.lane);
+    if ((memh != NULL) &&
+        (memh->md_map & context->file_reg_md_map & UCS_BIT(md_index))) {
+        return md_index;
+    }
+
+    return UCP_NULL_RESOURCE;
+}
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_proto_put_offload_zcopy_send_func(ucp_request_t *req,
                                       const ucp_proto_multi_lane_priv_t *lpriv,
@@ -228,8 +255,9 @@ ucp_proto_put_offload_zcopy_send_func(ucp_request_t *req,
 
     ucp_datatype_iter_next_iov(&req->send.state.dt_iter,
                                ucp_proto_multi_max_payload(req, lpriv, 0),
-                               lpriv->super.md_index, UCP_DT_MASK_CONTIG_IOV,
-                               next_iter, &iov, 1);
+                               ucp_proto_put_offload_zcopy_memh_index(req,
+                                                                      lpriv),
+                               UCP_DT_MASK_CONTIG_IOV, next_iter, &iov, 1);
     return uct_ep_put_zcopy(ucp_ep_get_lane(req->send.ep, lpriv->super.lane),
                             &iov, 1,
                             req->send.rma.remote_addr +
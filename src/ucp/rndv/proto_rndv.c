@@ -15,9 +15,30 @@
 #include <ucp/proto/proto_common.inl>
 
 
+/*
+ * Check if the lane is an rkey_ptr lane on a shared memory domain which cannot
+ * register memory, but can map the memory allocated on it (e.g. posix, sysv).
+ * The remote peer can copy from such memory directly if the send buffer was
+ * allocated by ucp_mem_map() on that memory domain.
+ */
+static int
+ucp_proto_rndv_ctrl_is_alloc_md(const ucp_proto_rndv_ctrl_init_params_t *params,
+                                ucp_lane_index_t lane,
+                                const uct_md_attr_v2_t *md_attr)
+{
+    ucs_memory_type_t mem_type = params->super.reg_mem_info.type;
+
+    return (params->remote_op_id == UCP_OP_ID_RNDV_RECV) &&
+           (lane == params->super.super.ep_config_key->rkey_ptr_lane) &&
+           (md_attr->flags & UCT_MD_FLAG_ALLOC) &&
+           (mem_type != UCS_MEMORY_TYPE_UNKNOWN) &&
+           (md_attr->alloc_mem_types & UCS_BIT(mem_type));
+}
+
 static void
 ucp_proto_rndv_ctrl_get_md_map(const ucp_proto_rndv_ctrl_init_params_t *params,
                                ucp_md_map_t *md_map,
+                               ucp_md_map_t *alloc_md_map,
                                ucp_sys_dev_map_t *sys_dev_map,
                                ucs_sys_dev_distance_t *sys_distance)
 {
@@ -34,8 +55,9 @@ ucp_proto_rndv_ctrl_get_md_map(const ucp_proto_rndv_ctrl_init_params_t *params,
     /* md_map is all lanes which support get_zcopy on the given mem_type and
      * require remote key
      */
-    *md_map      = 0;
-    *sys_dev_map = 0;
+    *md_map       = 0;
+    *alloc_md_map = 0;
+    *sys_dev_map  = 0;
 
     if (params->super.super.select_param->dt_class != UCP_DATATYPE_CONTIG) {
         return;
@@ -73,7 +95,11 @@ ucp_proto_rndv_ctrl_get_md_map(const ucp_proto_rndv_ctrl_init_params_t *params,
         if (!(params->md_map & UCS_BIT(md_index)) &&
             !(context->reg_md_map[params->super.reg_mem_info.type] &
              UCS_BIT(md_index))) {
-            continue;
+            if (!ucp_proto_rndv_ctrl_is_alloc_md(params, lane, md_attr)) {
+                continue;
+            }
+
+            *alloc_md_map |= UCS_BIT(md_index);
         }
 
         ucs_trace_req("lane[%d]: selected md %s index %u", lane,
@@ -295,7 +321,8 @@ ucp_proto_rndv_ctrl_init_priv(const ucp_proto_rndv_ctrl_init_params_t *params,
     const ucp_proto_init_params_t *init_params = &params->super.super;
 
     /* Initialize estimated memory registration map */
-    ucp_proto_rndv_ctrl_get_md_map(params, &rpriv->md_map, &rpriv->sys_dev_map,
+    ucp_proto_rndv_ctrl_get_md_map(params, &rpriv->md_map,
+                                   &rpriv->alloc_md_map, &rpriv->sys_dev_map,
                                    rpriv->sys_dev_distance);
 
     /* Use only memory domains for which the unpacking of the remote key was
@@ -358,7 +385,9 @@ static void ucp_proto_rndv_ctrl_variant_probe(
         return;
     }
 
-    status = ucp_proto_init_add_memreg_time(&params->super, rpriv->md_map,
+    status = ucp_proto_init_add_memreg_time(&params->super,
+                                            rpriv->md_map &
+                                            ~rpriv->alloc_md_map,
                                             UCP_PROTO_PERF_FACTOR_LOCAL_CPU,
                                             "memory registration",
                                             params->super.min_length,
@@ -441,10 +470,13 @@ void ucp_proto_rndv_ctrl_probe(const ucp_proto_rndv_ctrl_init_params_t *params,
     /* Initialize 'rpriv' structure */
     ucp_proto_rndv_ctrl_init_priv(params, rpriv, params->lane);
 
-    /* Init remote proto */
+    /* Init remote proto. Memory domains which are used only for buffers
+     * allocated on them are not taken into account, so the estimation holds
+     * for any buffer. */
     remote_select_param = ucp_proto_rndv_remote_select_param_init(params);
     status              = ucp_proto_rndv_ctrl_select_remote_proto(
-            params, &remote_select_param, rpriv->md_map, &remote_proto_select);
+            params, &remote_select_param,
+            rpriv->md_map & ~rpriv->alloc_md_map, &remote_proto_select);
     if (status != UCS_OK) {
         return;
     }
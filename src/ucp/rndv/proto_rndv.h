@@ -35,6 +35,10 @@ typedef struct {
     /* Memory domains to send remote keys */
     ucp_md_map_t            md_map;
 
+    /* Subset of md_map which can only map memory allocated on it, so the
+     * remote key is sent only for buffers allocated by ucp_mem_map() */
+    ucp_md_map_t            alloc_md_map;
+
     /* System devices used for communication, used to pack distance in rkey */
     ucp_sys_dev_map_t       sys_dev_map;
 
@@ -46,9 +46,11 @@ ucp_proto_rndv_rts_request_init(ucp_request_t *req)
         return status;
     }
 
+    /* Memory domains in alloc_md_map cannot register the buffer; their remote
+     * key is packed only if the buffer memory handle was allocated on them */
     status = ucp_datatype_iter_mem_reg(ep->worker->context,
                                        &req->send.state.dt_iter,
-                                       rpriv->md_map,
+                                       rpriv->md_map & ~rpriv->alloc_md_map,
                                        UCT_MD_MEM_ACCESS_RMA |
                                        UCT_MD_MEM_FLAG_HIDE_ERRORS,
                                        UCP_DT_MASK_ALL);
@@ -2108,9 +2108,22 @@ ucp_wireup_add_rma_bw_lanes(const ucp_wireup_select_params_t *select_params,
 
         ucp_context_memaccess_tl_bitmap(context, UCS_MEMORY_TYPE_HOST, 0,
                                         &tl_bitmap);
-        ucp_wireup_add_bw_lanes_pairwise(select_params, &rkey_ptr_info,
-                                         tl_bitmap, UCP_NULL_LANE, select_ctx,
-                                         0);
+        found_lane = ucp_wireup_add_bw_lanes_pairwise(select_params,
+                                                      &rkey_ptr_info,
+                                                      tl_bitmap, UCP_NULL_LANE,
+                                                      select_ctx, 0);
+
+        /* If no transport can map arbitrary remote memory, fall back to a
+         * shared memory domain which can map only the memory it allocated
+         * (e.g. posix, sysv). It is used for buffers allocated by
+         * ucp_mem_map() on that memory domain.
+         */
+        if (!found_lane && context->config.ext.rndv_shm_rkey_ptr) {
+            rkey_ptr_info.criteria.local_md_flags = UCT_MD_FLAG_ALLOC;
+            ucp_wireup_add_bw_lanes_pairwise(select_params, &rkey_ptr_info,
+                                             tl_bitmap, UCP_NULL_LANE,
+                                             select_ctx, 0);
+        }
     }
 
     bw_info.criteria.title            = "high-bw remote memory access";
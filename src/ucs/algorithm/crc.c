@@ -8,10 +8,27 @@
 #  include "config.h"
 #endif
 
-#include <ucs/algorithm/crc.h>
+#include <ucs/algorithm/crc_int.h>
+#include <ucs/arch/cpu.h>
+#include <ucs/debug/assert.h>
+#include <ucs/sys/compiler_def.h>
+#include <ucs/sys/math.h>
+#include <ucs/type/init_once.h>
 
 #include <string.h>
 
+#if defined(__x86_64__) && HAVE_ATTRIBUTE_TARGET_PCLMUL
+#  include <wmmintrin.h>
+#  include <smmintrin.h>
+#  define UCS_CRC32_HW_PCLMUL 1
+#elif defined(__aarch64__) && HAVE_ATTRIBUTE_TARGET_CRC
+#  include <sys/auxv.h>
+#  define UCS_CRC32_HW_ARMV8  1
+#  ifndef HWCAP_CRC32
+#    define HWCAP_CRC32       UCS_BIT(7)
+#  endif
+#endif
+
 
 /* CRC-16-CCITT */
 #define UCS_CRC16_POLY    0x8408u
@@ -19,32 +36,363 @@
 /* CRC-32 (ISO 3309) */
 #define UCS_CRC32_POLY    0xedb88320l
 
+/* Number of lookup tables for slicing-by-8 */
+#define UCS_CRC_NUM_TABLES 8
+
+#define UCS_CRC_CALC_BYTE(_width, _crc) \
+    do { \
+        uint8_t bit; \
+        for (bit = 0; bit < 8; ++bit) { \
+            (_crc) = ((_crc) >> 1) ^ (-(int)((_crc) & 1) & \
+                                      UCS_CRC ## _width ## _POLY); \
+        } \
+    } while (0)
+
 #define UCS_CRC_CALC(_width, _buffer, _size, _crc) \
     do { \
         const uint8_t *end = (const uint8_t*)(UCS_PTR_BYTE_OFFSET(_buffer, _size)); \
         const uint8_t *p; \
-        uint8_t bit; \
         \
         if ((_size) != 0) { \
             for (p = (_buffer); p < end; ++p) { \
                 (_crc) ^= *p; \
-                for (bit = 0; bit < 8; ++bit) { \
-                    (_crc) = ((_crc) >> 1) ^ (-(int)((_crc) & 1) & \
-                                              UCS_CRC ## _width ## _POLY); \
-                } \
+                UCS_CRC_CALC_BYTE(_width, _crc); \
+            } \
+        } \
+    } while (0)
+
+/*
+ * Table k holds the CRC of a byte followed by k zero bytes, which allows
+ * processing 8 bytes at once with independent table lookups.
+ */
+#define UCS_CRC_TABLE_INIT(_table) \
+    do { \
+        unsigned idx, k; \
+        \
+        for (idx = 0; idx < 256; ++idx) { \
+            for (k = 1; k < UCS_CRC_NUM_TABLES; ++k) { \
+                (_table)[k][idx] = ((_table)[k - 1][idx] >> 8) ^ \
+                                   (_table)[0][(_table)[k - 1][idx] & 0xff]; \
             } \
         } \
-        (_crc) = ~(_crc); \
     } while (0)
 
+#define UCS_CRC_TABLE_CALC(_table, _buffer, _size, _crc) \
+    do { \
+        const uint8_t *data = (const uint8_t*)(_buffer); \
+        size_t length       = (_size); \
+        uint32_t lo, hi; \
+        \
+        for (; length >= 8; length -= 8, data += 8) { \
+            lo = ucs_crc_load_le32(data) ^ (_crc); \
+            hi = ucs_crc_load_le32(data + 4); \
+            (_crc) = (_table)[7][lo & 0xff] ^ (_table)[6][(lo >> 8) & 0xff] ^ \
+                     (_table)[5][(lo >> 16) & 0xff] ^ (_table)[4][lo >> 24] ^ \
+                     (_table)[3][hi & 0xff] ^ (_table)[2][(hi >> 8) & 0xff] ^ \
+                     (_table)[1][(hi >> 16) & 0xff] ^ (_table)[0][hi >> 24]; \
+        } \
+        \
+        for (; length > 0; --length, ++data) { \
+            (_crc) = ((_crc) >> 8) ^ (_table)[0][((_crc) ^ *data) & 0xff]; \
+        } \
+    } while (0)
 
-uint16_t ucs_crc16(const void *buffer, size_t size)
+
+typedef uint32_t (*ucs_crc32_func_t)(uint32_t crc, const void *buffer,
+                                     size_t size);
+
+
+const char *ucs_crc_method_names[] = {
+    [UCS_CRC_METHOD_BITWISE] = "bitwise",
+    [UCS_CRC_METHOD_TABLE]   = "table",
+    [UCS_CRC_METHOD_HW]      = "hw",
+    [UCS_CRC_METHOD_LAST]    = NULL
+};
+
+static ucs_init_once_t ucs_crc_init_once = UCS_INIT_ONCE_INITIALIZER;
+static uint32_t ucs_crc32_table[UCS_CRC_NUM_TABLES][256];
+static uint16_t ucs_crc16_table[UCS_CRC_NUM_TABLES][256];
+static ucs_crc32_func_t ucs_crc32_func;
+
+
+static UCS_F_ALWAYS_INLINE uint32_t ucs_crc_load_le32(const uint8_t *p)
 {
-    uint16_t crc = UINT16_MAX;
-    UCS_CRC_CALC(16, buffer, size, crc);
+    uint32_t value;
+
+    memcpy(&value, p, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+static uint32_t ucs_crc32_bitwise(uint32_t crc, const void *buffer, size_t size)
+{
+    UCS_CRC_CALC(32, buffer, size, crc);
     return crc;
 }
 
+static uint32_t ucs_crc32_table_calc(uint32_t crc, const void *buffer,
+                                     size_t size)
+{
+    UCS_CRC_TABLE_CALC(ucs_crc32_table, buffer, size, crc);
+    return crc;
+}
+
+#if UCS_CRC32_HW_PCLMUL
+
+static int ucs_crc32_hw_is_supported()
+{
+    int cpu_flag = ucs_arch_get_cpu_flag();
+
+    return (cpu_flag != UCS_CPU_FLAG_UNKNOWN) &&
+           ucs_test_all_flags(cpu_flag,
+                              UCS_CPU_FLAG_PCLMUL | UCS_CPU_FLAG_SSE41);
+}
+
+/*
+ * Fold 64-byte blocks with carry-less multiplication, as described in Intel's
+ * "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+ * white paper, using the constants for the bit-reflected CRC-32 polynomial.
+ * The tail, which is shorter than 16 bytes, is processed using the tables.
+ */
+static __attribute__((target("sse4.1,pclmul"))) uint32_t
+ucs_crc32_hw(uint32_t crc, const void *buffer, size_t size)
+{
+    static const uint64_t k1k2[] UCS_V_ALIGNED(16) = {0x0154442bd4,
+                                                      0x01c6e41596};
+    static const uint64_t k3k4[] UCS_V_ALIGNED(16) = {0x01751997d0,
+                                                      0x00ccaa009e};
+    static const uint64_t k5k0[] UCS_V_ALIGNED(16) = {0x0163cd6124,
+                                                      0x0000000000};
+    static const uint64_t poly[] UCS_V_ALIGNED(16) = {0x01db710641,
+                                                      0x01f7011641};
+    const uint8_t *p = (const uint8_t*)buffer;
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    if (size < 64) {
+        return ucs_crc32_table_calc(crc, buffer, size);
+    }
+
+    x1 = _mm_loadu_si128((const __m128i*)(p + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*)(p + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*)(p + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*)(p + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(crc));
+    x0 = _mm_load_si128((const __m128i*)k1k2);
+    p    += 64;
+    size -= 64;
+
+    /* Fold 4 x 128 bits in parallel */
+    while (size >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        y5 = _mm_loadu_si128((const __m128i*)(p + 0x00));
+        y6 = _mm_loadu_si128((const __m128i*)(p + 0x10));
+        y7 = _mm_loadu_si128((const __m128i*)(p + 0x20));
+        y8 = _mm_loadu_si128((const __m128i*)(p + 0x30));
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+        p    += 64;
+        size -= 64;
+    }
+
+    /* Fold into a single 128-bit value */
+    x0 = _mm_load_si128((const __m128i*)k3k4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Fold the remaining 128-bit blocks */
+    while (size >= 16) {
+        x2 = _mm_loadu_si128((const __m128i*)p);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        p    += 16;
+        size -= 16;
+    }
+
+    /* Fold 128 bits to 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64((const __m128i*)k5k0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduction to 32 bits */
+    x0 = _mm_load_si128((const __m128i*)poly);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    crc = _mm_extract_epi32(x1, 1);
+
+    return ucs_crc32_table_calc(crc, p, size);
+}
+
+#elif UCS_CRC32_HW_ARMV8
+
+static int ucs_crc32_hw_is_supported()
+{
+    return !!(getauxval(AT_HWCAP) & HWCAP_CRC32);
+}
+
+/*
+ * ARMv8 CRC32 instructions implement the same (ISO 3309) polynomial.
+ */
+static __attribute__((target("+crc"))) uint32_t
+ucs_crc32_hw(uint32_t crc, const void *buffer, size_t size)
+{
+    const uint8_t *p = (const uint8_t*)buffer;
+    uint64_t value;
+
+    for (; size >= 8; size -= 8, p += 8) {
+        memcpy(&value, p, sizeof(value));
+        asm volatile ("crc32x %w0, %w0, %x1" : "+r"(crc) : "r"(value));
+    }
+
+    for (; size > 0; --size, ++p) {
+        asm volatile ("crc32b %w0, %w0, %w1" : "+r"(crc) : "r"((uint32_t)*p));
+    }
+
+    return crc;
+}
+
+#else
+
+static int ucs_crc32_hw_is_supported()
+{
+    return 0;
+}
+
+static uint32_t ucs_crc32_hw(uint32_t crc, const void *buffer, size_t size)
+{
+    return ucs_crc32_table_calc(crc, buffer, size);
+}
+
+#endif
+
+static void ucs_crc_init()
+{
+    unsigned i;
+
+    UCS_INIT_ONCE(&ucs_crc_init_once) {
+        for (i = 0; i < 256; ++i) {
+            ucs_crc32_table[0][i] = i;
+            UCS_CRC_CALC_BYTE(32, ucs_crc32_table[0][i]);
+            ucs_crc16_table[0][i] = i;
+            UCS_CRC_CALC_BYTE(16, ucs_crc16_table[0][i]);
+        }
+
+        UCS_CRC_TABLE_INIT(ucs_crc32_table);
+        UCS_CRC_TABLE_INIT(ucs_crc16_table);
+
+        ucs_memory_cpu_store_fence();
+        ucs_crc32_func = ucs_crc32_hw_is_supported() ? ucs_crc32_hw :
+                                                       ucs_crc32_table_calc;
+    }
+}
+
+/* Fast path: the function pointer is published last, after the tables, so a
+ * non-NULL value observed with a load fence means initialization is complete
+ * and the init-once mutex need not be taken */
+static UCS_F_ALWAYS_INLINE ucs_crc32_func_t ucs_crc32_get_func()
+{
+    ucs_crc32_func_t func = ucs_crc32_func;
+
+    if (ucs_unlikely(func == NULL)) {
+        ucs_crc_init();
+        func = ucs_crc32_func;
+    }
+
+    ucs_memory_cpu_load_fence();
+    return func;
+}
+
+static UCS_F_ALWAYS_INLINE void ucs_crc_check_init()
+{
+    (void)ucs_crc32_get_func();
+}
+
+int ucs_crc32_method_is_supported(ucs_crc_method_t method)
+{
+    switch (method) {
+    case UCS_CRC_METHOD_BITWISE:
+    case UCS_CRC_METHOD_TABLE:
+        return 1;
+    case UCS_CRC_METHOD_HW:
+        return ucs_crc32_hw_is_supported();
+    default:
+        return 0;
+    }
+}
+
+uint32_t ucs_crc32_method(ucs_crc_method_t method, uint32_t prev_crc,
+                          const void *buffer, size_t size)
+{
+    uint32_t crc = ~prev_crc;
+
+    ucs_assert(ucs_crc32_method_is_supported(method));
+
+    ucs_crc_check_init();
+    switch (method) {
+    case UCS_CRC_METHOD_BITWISE:
+        crc = ucs_crc32_bitwise(crc, buffer, size);
+        break;
+    case UCS_CRC_METHOD_TABLE:
+        crc = ucs_crc32_table_calc(crc, buffer, size);
+        break;
+    default:
+        crc = ucs_crc32_hw(crc, buffer, size);
+        break;
+    }
+
+    return ~crc;
+}
+
+uint16_t ucs_crc16_method(ucs_crc_method_t method, const void *buffer,
+                          size_t size)
+{
+    uint16_t crc = UINT16_MAX;
+
+    ucs_assert(method != UCS_CRC_METHOD_HW);
+
+    if (method == UCS_CRC_METHOD_BITWISE) {
+        UCS_CRC_CALC(16, buffer, size, crc);
+    } else {
+        ucs_crc_check_init();
+        UCS_CRC_TABLE_CALC(ucs_crc16_table, buffer, size, crc);
+    }
+
+    return ~crc;
+}
+
+uint16_t ucs_crc16(const void *buffer, size_t size)
+{
+    return ucs_crc16_method(UCS_CRC_METHOD_TABLE, buffer, size);
+}
+
 uint16_t ucs_crc16_string(const char *s)
 {
     return ucs_crc16((const char*)s, strlen(s));
@@ -52,7 +400,5 @@ uint16_t ucs_crc16_string(const char *s)
 
 uint32_t ucs_crc32(uint32_t prev_crc, const void *buffer, size_t size)
 {
-    uint32_t crc = ~prev_crc;
-    UCS_CRC_CALC(32, buffer, size, crc);
-    return crc;
+    return ~ucs_crc32_get_func()(~prev_crc, buffer, size);
 }
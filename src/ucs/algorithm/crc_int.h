@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCS_ALGORITHM_CRC_INT_H_
+#define UCS_ALGORITHM_CRC_INT_H_
+
+#include <ucs/algorithm/crc.h>
+
+BEGIN_C_DECLS
+
+
+/**
+ * CRC calculation methods. @ref ucs_crc32 and @ref ucs_crc16 select the
+ * fastest method supported by the CPU, and all methods produce the same result.
+ */
+typedef enum {
+    UCS_CRC_METHOD_BITWISE, /* Bit-by-bit calculation */
+    UCS_CRC_METHOD_TABLE,   /* Slicing-by-8 lookup tables */
+    UCS_CRC_METHOD_HW,      /* CPU instructions: PCLMUL on x86_64, CRC32 on
+                               aarch64. Available only for CRC32. */
+    UCS_CRC_METHOD_LAST
+} ucs_crc_method_t;
+
+
+extern const char *ucs_crc_method_names[];
+
+
+/**
+ * Check whether a CRC32 calculation method is supported on the current CPU.
+ *
+ * @param [in]  method     CRC calculation method.
+ *
+ * @return Nonzero if the method is supported.
+ */
+int ucs_crc32_method_is_supported(ucs_crc_method_t method);
+
+
+/**
+ * Calculate CRC32 of an arbitrary buffer using a specific method, which must
+ * be supported by the CPU.
+ */
+uint32_t ucs_crc32_method(ucs_crc_method_t method, uint32_t prev_crc,
+                          const void *buffer, size_t size);
+
+
+/**
+ * Calculate CRC16 of an arbitrary buffer using a specific method, which must
+ * not be @ref UCS_CRC_METHOD_HW.
+ */
+uint16_t ucs_crc16_method(ucs_crc_method_t method, const void *buffer,
+                          size_t size);
+
+END_C_DECLS
+
+#endif
@@ -11,9 +11,53 @@
 #endif
 
 #include <ucs/arch/cpu.h>
+#include <ucs/sys/ptr_arith.h>
 #include <stdio.h>
 
 
+/* Size of a block copied by one iteration of the LDNP/STNP loop */
+#define UCS_AARCH64_NT_BLOCK_SIZE 64
+
+
+/*
+ * Copy whole 64-byte blocks with the given load/store pair instructions.
+ * "ldnp"/"stnp" hint the memory system that the data will not be reused soon,
+ * so it should not be allocated in the caches.
+ */
+#define UCS_AARCH64_NT_COPY_BLOCKS(_ld, _st, _dst, _src, _len) \
+    asm volatile ("1:                            \n" \
+                  _ld " q0, q1, [%[s]]           \n" \
+                  _ld " q2, q3, [%[s], #32]      \n" \
+                  "add  %[s], %[s], #64          \n" \
+                  "subs %[n], %[n], #64          \n" \
+                  _st " q0, q1, [%[d]]           \n" \
+                  _st " q2, q3, [%[d], #32]      \n" \
+                  "add  %[d], %[d], #64          \n" \
+                  "b.ne 1b                       \n" \
+                  : [d] "+r" (_dst), [s] "+r" (_src), [n] "+r" (_len) \
+                  : \
+                  : "v0", "v1", "v2", "v3", "cc", "memory")
+
+
+#if defined(__ARM_FEATURE_SVE)
+/*
+ * Copy with SVE vectors, using non-temporal LDNT1/STNT1 variants according to
+ * the hint. The predicate handles the tail, so no scalar copy is needed.
+ */
+#define UCS_AARCH64_SVE_COPY(_ld, _st, _dst, _src, _len) \
+    { \
+        uint64_t _i  = 0; \
+        svbool_t _pg = svwhilelt_b8_u64(_i, (uint64_t)(_len)); \
+        \
+        do { \
+            _st(_pg, &(_dst)[_i], _ld(_pg, &(_src)[_i])); \
+            _i  += svcntb(); \
+            _pg  = svwhilelt_b8_u64(_i, (uint64_t)(_len)); \
+        } while (svptest_first(svptrue_b8(), _pg)); \
+    }
+#endif
+
+
 static void ucs_aarch64_cpuid_from_proc(ucs_aarch64_cpuid_t *cpuid)
 {
     char buf[256];
@@ -68,4 +112,79 @@ void ucs_aarch64_cpuid(ucs_aarch64_cpuid_t *cpuid)
     *cpuid = cached_cpuid;
 }
 
+void ucs_cpu_init()
+{
+    size_t *nt_min  = &ucs_global_opts.arch.nt_buffer_transfer_min;
+    size_t *nt_dest = &ucs_global_opts.arch.nt_dest_threshold;
+
+    ucs_cpu_nt_thresh_calibrate(nt_min, nt_dest);
+
+    /* There is no known crossover point for Arm cores, so non-temporal
+     * transfers are used only when configured or calibrated */
+    if (*nt_min == UCS_MEMUNITS_AUTO) {
+        *nt_min = UCS_MEMUNITS_INF;
+    }
+
+    if (*nt_dest == UCS_MEMUNITS_AUTO) {
+        *nt_dest = UCS_MEMUNITS_INF;
+    }
+}
+
+void ucs_aarch64_nt_buffer_transfer(void *dst, const void *src, size_t len,
+                                    ucs_arch_memcpy_hint_t hint,
+                                    size_t total_len, size_t nt_dest_thresh)
+{
+    uint8_t *dst_u8       = (uint8_t*)dst;
+    const uint8_t *src_u8 = (const uint8_t*)src;
+#if !defined(__ARM_FEATURE_SVE)
+    size_t blocks_len;
+#endif
+
+    if (total_len > nt_dest_thresh) {
+        /* The destination would be evicted from the cache anyway */
+        hint |= UCS_ARCH_MEMCPY_NT_DEST;
+    }
+
+    if (hint == UCS_ARCH_MEMCPY_NT_NONE) {
+        memcpy(dst, src, len);
+        return;
+    }
+
+#if defined(__ARM_FEATURE_SVE)
+    switch ((int)hint) {
+    case UCS_ARCH_MEMCPY_NT_SOURCE:
+        UCS_AARCH64_SVE_COPY(svldnt1_u8, svst1_u8, dst_u8, src_u8, len);
+        break;
+    case UCS_ARCH_MEMCPY_NT_DEST:
+        UCS_AARCH64_SVE_COPY(svld1_u8, svstnt1_u8, dst_u8, src_u8, len);
+        break;
+    default:
+        UCS_AARCH64_SVE_COPY(svldnt1_u8, svstnt1_u8, dst_u8, src_u8, len);
+        break;
+    }
+#else
+    blocks_len = ucs_align_down(len, UCS_AARCH64_NT_BLOCK_SIZE);
+    if (blocks_len > 0) {
+        len -= blocks_len;
+        switch ((int)hint) {
+        case UCS_ARCH_MEMCPY_NT_SOURCE:
+            UCS_AARCH64_NT_COPY_BLOCKS("ldnp", "stp", dst_u8, src_u8,
+                                       blocks_len);
+            break;
+        case UCS_ARCH_MEMCPY_NT_DEST:
+            UCS_AARCH64_NT_COPY_BLOCKS("ldp", "stnp", dst_u8, src_u8,
+                                       blocks_len);
+            break;
+        default:
+            UCS_AARCH64_NT_COPY_BLOCKS("ldnp", "stnp", dst_u8, src_u8,
+                                       blocks_len);
+            break;
+        }
+    }
+
+    /* The block loop advanced the pointers past the copied blocks */
+    memcpy(dst_u8, src_u8, len);
+#endif
+}
+
 #endif
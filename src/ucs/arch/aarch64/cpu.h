@@ -18,6 +18,8 @@
 #include <ucs/arch/generic/cpu.h>
 #include <ucs/sys/math.h>
 #include <ucs/type/status.h>
+#include <ucs/config/types.h>
+#include <ucs/config/global_opts.h>
 #ifdef __ARM_NEON
 #include <arm_neon.h>
 #endif
@@ -28,6 +30,9 @@
 
 #define UCS_ARCH_CACHE_LINE_SIZE 64
 
+/* LDNP/STNP are part of the base instruction set */
+#define UCS_ARCH_HAVE_NT_BUFFER_TRANSFER 1
+
 BEGIN_C_DECLS
 
 /** @file cpu.h */
@@ -93,6 +98,16 @@ typedef struct ucs_aarch64_cpuid {
 void ucs_aarch64_cpuid(ucs_aarch64_cpuid_t *cpuid);
 
 
+/**
+ * Copy memory using non-temporal loads and/or stores, according to the hint
+ * and the total transfer length. The destination is written non-temporally
+ * regardless of the hint when the total length is above @a nt_dest_thresh.
+ */
+void ucs_aarch64_nt_buffer_transfer(void *dst, const void *src, size_t len,
+                                    ucs_arch_memcpy_hint_t hint,
+                                    size_t total_len, size_t nt_dest_thresh);
+
+
 #if defined(HAVE_AARCH64_THUNDERX2)
 extern void *__memcpy_thunderx2(void *, const void *, size_t);
 #endif
@@ -155,9 +170,7 @@ static inline int ucs_arch_get_cpu_flag()
     return UCS_CPU_FLAG_UNKNOWN;
 }
 
-static inline void ucs_cpu_init()
-{
-}
+void ucs_cpu_init();
 
 static inline void ucs_arch_wait_mem(void *address)
 {
@@ -274,6 +287,12 @@ static inline void *ucs_memcpy_relaxed(void *dst, const void *src, size_t len,
                                        ucs_arch_memcpy_hint_t hint,
                                        size_t total_len)
 {
+    if (ucs_unlikely(total_len >= ucs_global_opts.arch.nt_buffer_transfer_min)) {
+        ucs_aarch64_nt_buffer_transfer(dst, src, len, hint, total_len,
+                                       ucs_global_opts.arch.nt_dest_threshold);
+        return dst;
+    }
+
 #if defined(HAVE_AARCH64_THUNDERX2)
     return __memcpy_thunderx2(dst, src, len);
 #elif defined(__ARM_FEATURE_SVE)
@@ -283,6 +302,15 @@ static inline void *ucs_memcpy_relaxed(void *dst, const void *src, size_t len,
 #endif
 }
 
+static UCS_F_ALWAYS_INLINE void
+ucs_arch_nt_buffer_transfer(void *dst, const void *src, size_t len,
+                            ucs_arch_memcpy_hint_t hint, size_t total_len,
+                            size_t nt_dest_thresh)
+{
+    ucs_aarch64_nt_buffer_transfer(dst, src, len, hint, total_len,
+                                   nt_dest_thresh);
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucs_memcpy_nontemporal(void *dst, const void *src, size_t len)
 {
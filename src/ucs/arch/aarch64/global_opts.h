@@ -7,15 +7,23 @@
 #ifndef UCS_AARCH64_GLOBAL_OPTS_H_
 #define UCS_AARCH64_GLOBAL_OPTS_H_
 
+#include <stddef.h>
+
 #include <ucs/sys/compiler_def.h>
 
 BEGIN_C_DECLS
 
-#define UCS_ARCH_GLOBAL_OPTS_INITALIZER {}
+#define UCS_ARCH_GLOBAL_OPTS_INITALIZER { \
+    .nt_buffer_transfer_min = UCS_MEMUNITS_AUTO, \
+    .nt_dest_threshold      = UCS_MEMUNITS_AUTO, \
+    .nt_calibrate           = 0                  \
+}
 
-/* built-in memcpy config */
+/* nt-buffer-transfer config */
 typedef struct ucs_arch_global_opts {
-    char dummy;
+    size_t nt_buffer_transfer_min;
+    size_t nt_dest_threshold;
+    int    nt_calibrate;
 } ucs_arch_global_opts_t;
 
 END_C_DECLS
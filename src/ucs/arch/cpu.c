@@ -16,13 +16,27 @@
 #include <ucs/sys/sys.h>
 #include <ucs/sys/string.h>
 #include <ucs/sys/stubs.h>
+#include <ucs/sys/math.h>
+#include <ucs/debug/log_def.h>
+#include <ucs/time/time.h>
 #include <ucs/type/init_once.h>
+#include <ucs/config/global_opts.h>
+#include <sys/mman.h>
+#include <float.h>
 
 #define UCS_CPU_CACHE_FILE_FMT   UCS_SYS_FS_CPUS_PATH "/cpu%d/cache/index%d/%s"
 #define UCS_CPU_CACHE_LEVEL_FILE "level"
 #define UCS_CPU_CACHE_TYPE_FILE  "type"
 #define UCS_CPU_CACHE_SIZE_FILE  "size"
 
+/* Non-temporal transfer calibration parameters */
+#define UCS_CPU_NT_CALIBRATE_MIN_SIZE  (64 * UCS_KBYTE)
+#define UCS_CPU_NT_CALIBRATE_MAX_SIZE  (64 * UCS_MBYTE)
+#define UCS_CPU_NT_CALIBRATE_BYTES     (16 * UCS_MBYTE) /* Copied per test */
+#define UCS_CPU_NT_CALIBRATE_REPS      2
+#define UCS_CPU_NT_CALIBRATE_MARGIN    1.05
+#define UCS_CPU_NT_CALIBRATE_NUM_SIZES 16
+
 
 /* cache size array. index - cache type (ucs_cpu_cache_type_t), value - cache value,
  * 0 means cache is not supported */
@@ -202,3 +216,197 @@ const char *ucs_cpu_model_name()
 
     return cpu_model_names[ucs_arch_get_cpu_model()];
 }
+
+#ifdef UCS_ARCH_HAVE_NT_BUFFER_TRANSFER
+/* Prevents the compiler from dropping the working set reads */
+static volatile uint64_t ucs_cpu_nt_calibrate_sink;
+
+static void ucs_cpu_nt_calibrate_copy(void *dst, const void *src, size_t size,
+                                      ucs_cpu_nt_copy_t copy)
+{
+    /* Thresholds are passed explicitly, so the configured ones which are in
+     * use by other threads are not modified */
+    switch (copy) {
+    case UCS_CPU_NT_COPY_SOURCE:
+        ucs_arch_nt_buffer_transfer(dst, src, size, UCS_ARCH_MEMCPY_NT_SOURCE,
+                                    size, UCS_MEMUNITS_INF);
+        break;
+    case UCS_CPU_NT_COPY_DEST:
+        ucs_arch_nt_buffer_transfer(dst, src, size, UCS_ARCH_MEMCPY_NT_DEST,
+                                    size, UCS_MEMUNITS_INF);
+        break;
+    case UCS_CPU_NT_COPY_ALL:
+        ucs_arch_nt_buffer_transfer(dst, src, size, UCS_ARCH_MEMCPY_NT_SOURCE,
+                                    size, 0);
+        break;
+    default:
+        memcpy(dst, src, size);
+        break;
+    }
+}
+
+static double ucs_cpu_nt_calibrate_bw(void *dst, const void *src, size_t size,
+                                      ucs_cpu_nt_copy_t copy,
+                                      const uint64_t *ws, size_t ws_size)
+{
+    size_t iters       = ucs_max(UCS_CPU_NT_CALIBRATE_BYTES / size, 2);
+    size_t ws_stride   = UCS_SYS_CACHE_LINE_SIZE / sizeof(*ws);
+    double best_time   = DBL_MAX;
+    uint64_t sum       = 0;
+    double start_time;
+    size_t i, j;
+    int rep;
+
+    for (rep = 0; rep < UCS_CPU_NT_CALIBRATE_REPS; ++rep) {
+        start_time = ucs_get_accurate_time();
+        for (i = 0; i < iters; ++i) {
+            ucs_cpu_nt_calibrate_copy(dst, src, size, copy);
+            /* Read the working set back, it may have been evicted by the
+             * copy as a received message would evict application data */
+            for (j = 0; j < ws_size / sizeof(*ws); j += ws_stride) {
+                sum += ws[j];
+            }
+        }
+        best_time = ucs_min(best_time, ucs_get_accurate_time() - start_time);
+    }
+
+    ucs_cpu_nt_calibrate_sink += sum;
+    return (size * iters) / best_time;
+}
+
+static size_t ucs_cpu_nt_calibrate_crossover(const size_t *sizes,
+                                             const double *fast_bw,
+                                             const double *slow_bw,
+                                             unsigned num_sizes)
+{
+    size_t crossover = UCS_MEMUNITS_INF;
+    int i;
+
+    /* Smallest size from which the first copy is faster for all sizes */
+    for (i = num_sizes - 1; i >= 0; --i) {
+        if (fast_bw[i] <= (slow_bw[i] * UCS_CPU_NT_CALIBRATE_MARGIN)) {
+            break;
+        }
+
+        crossover = sizes[i];
+    }
+
+    return crossover;
+}
+
+ucs_status_t ucs_cpu_nt_calibrate(ucs_cpu_nt_calibrate_cb_t cb, void *arg,
+                                  size_t *nt_min_p, size_t *nt_dest_p)
+{
+    size_t sizes[UCS_CPU_NT_CALIBRATE_NUM_SIZES];
+    double bw[UCS_CPU_NT_COPY_LAST][UCS_CPU_NT_CALIBRATE_NUM_SIZES];
+    double hint_bw[UCS_CPU_NT_CALIBRATE_NUM_SIZES];
+    double size_bw[UCS_CPU_NT_COPY_LAST];
+    ucs_cpu_nt_copy_t copy;
+    unsigned num_sizes;
+    size_t size, ws_size;
+    void *src, *dst, *ws;
+
+    /* The working set stands for the application data in the cache */
+    ws_size = ucs_cpu_get_cache_size(UCS_CPU_CACHE_L2);
+    ws_size = ucs_min(ucs_max(ws_size, UCS_MBYTE), 8 * UCS_MBYTE);
+
+    src = mmap(NULL, UCS_CPU_NT_CALIBRATE_MAX_SIZE, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (src == MAP_FAILED) {
+        goto err;
+    }
+
+    dst = mmap(NULL, UCS_CPU_NT_CALIBRATE_MAX_SIZE, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (dst == MAP_FAILED) {
+        goto err_unmap_src;
+    }
+
+    ws = mmap(NULL, ws_size, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ws == MAP_FAILED) {
+        goto err_unmap_dst;
+    }
+
+    memset(src, 1, UCS_CPU_NT_CALIBRATE_MAX_SIZE);
+    memset(dst, 0, UCS_CPU_NT_CALIBRATE_MAX_SIZE);
+    memset(ws, 2, ws_size);
+
+    num_sizes = 0;
+    for (size = UCS_CPU_NT_CALIBRATE_MIN_SIZE;
+         size <= UCS_CPU_NT_CALIBRATE_MAX_SIZE; size *= 2) {
+        ucs_assert(num_sizes < UCS_CPU_NT_CALIBRATE_NUM_SIZES);
+        for (copy = UCS_CPU_NT_COPY_NONE; copy < UCS_CPU_NT_COPY_LAST;
+             ++copy) {
+            size_bw[copy]       = ucs_cpu_nt_calibrate_bw(dst, src, size, copy,
+                                                          ws, ws_size);
+            bw[copy][num_sizes] = size_bw[copy];
+        }
+
+        /* A hint is honored for either copy direction */
+        hint_bw[num_sizes] = ucs_min(size_bw[UCS_CPU_NT_COPY_SOURCE],
+                                     size_bw[UCS_CPU_NT_COPY_DEST]);
+        sizes[num_sizes++] = size;
+
+        if (cb != NULL) {
+            cb(size, size_bw, arg);
+        }
+    }
+
+    *nt_min_p  = ucs_cpu_nt_calibrate_crossover(sizes, hint_bw,
+                                                bw[UCS_CPU_NT_COPY_NONE],
+                                                num_sizes);
+    *nt_dest_p = ucs_cpu_nt_calibrate_crossover(sizes,
+                                                bw[UCS_CPU_NT_COPY_ALL],
+                                                bw[UCS_CPU_NT_COPY_SOURCE],
+                                                num_sizes);
+
+    munmap(ws, ws_size);
+    munmap(dst, UCS_CPU_NT_CALIBRATE_MAX_SIZE);
+    munmap(src, UCS_CPU_NT_CALIBRATE_MAX_SIZE);
+    return UCS_OK;
+
+err_unmap_dst:
+    munmap(dst, UCS_CPU_NT_CALIBRATE_MAX_SIZE);
+err_unmap_src:
+    munmap(src, UCS_CPU_NT_CALIBRATE_MAX_SIZE);
+err:
+    return UCS_ERR_NO_MEMORY;
+}
+
+void ucs_cpu_nt_thresh_calibrate(size_t *nt_min_p, size_t *nt_dest_p)
+{
+    size_t nt_min, nt_dest;
+    ucs_status_t status;
+
+    if (!ucs_global_opts.arch.nt_calibrate ||
+        ((*nt_min_p != UCS_MEMUNITS_AUTO) &&
+         (*nt_dest_p != UCS_MEMUNITS_AUTO))) {
+        return;
+    }
+
+    status = ucs_cpu_nt_calibrate(NULL, NULL, &nt_min, &nt_dest);
+    if (status != UCS_OK) {
+        ucs_debug("failed to calibrate nt-buffer-transfer: %s",
+                  ucs_status_string(status));
+        return;
+    }
+
+    ucs_debug("calibrated nt-buffer-transfer min %zu dest %zu", nt_min,
+              nt_dest);
+
+    if (*nt_min_p == UCS_MEMUNITS_AUTO) {
+        *nt_min_p = nt_min;
+    }
+
+    if (*nt_dest_p == UCS_MEMUNITS_AUTO) {
+        *nt_dest_p = nt_dest;
+    }
+}
+#else
+ucs_status_t ucs_cpu_nt_calibrate(ucs_cpu_nt_calibrate_cb_t cb, void *arg,
+                                  size_t *nt_min_p, size_t *nt_dest_p)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+#endif
@@ -60,7 +60,8 @@ typedef enum ucs_cpu_flag {
     UCS_CPU_FLAG_SSE41      = UCS_BIT(7),
     UCS_CPU_FLAG_SSE42      = UCS_BIT(8),
     UCS_CPU_FLAG_AVX        = UCS_BIT(9),
-    UCS_CPU_FLAG_AVX2       = UCS_BIT(10)
+    UCS_CPU_FLAG_AVX2       = UCS_BIT(10),
+    UCS_CPU_FLAG_PCLMUL     = UCS_BIT(11)
 } ucs_cpu_flag_t;
 
 
@@ -96,6 +97,29 @@ typedef struct ucs_cpu_builtin_memcpy {
 } ucs_cpu_builtin_memcpy_t;
 
 
+/* Copy kinds measured by the non-temporal transfer calibration */
+typedef enum ucs_cpu_nt_copy {
+    UCS_CPU_NT_COPY_NONE,   /**< Regular copy */
+    UCS_CPU_NT_COPY_SOURCE, /**< Non-temporal source loads */
+    UCS_CPU_NT_COPY_DEST,   /**< Non-temporal destination stores */
+    UCS_CPU_NT_COPY_ALL,    /**< Non-temporal loads and stores */
+    UCS_CPU_NT_COPY_LAST
+} ucs_cpu_nt_copy_t;
+
+
+/**
+ * Callback which is called by @ref ucs_cpu_nt_calibrate for every measured
+ * buffer size.
+ *
+ * @param size  Buffer size.
+ * @param bw    Array of UCS_CPU_NT_COPY_LAST bandwidth values in bytes/sec,
+ *              indexed by @ref ucs_cpu_nt_copy_t.
+ * @param arg   User-defined argument.
+ */
+typedef void (*ucs_cpu_nt_calibrate_cb_t)(size_t size, const double *bw,
+                                          void *arg);
+
+
 /* System constants */
 #define UCS_SYS_POINTER_SIZE       (sizeof(void*))
 #define UCS_SYS_PARAGRAPH_SIZE     16
@@ -177,6 +201,34 @@ static inline int ucs_cpu_prefer_relaxed_order()
 const char *ucs_cpu_vendor_name();
 const char *ucs_cpu_model_name();
 
+
+/**
+ * Measure the bandwidth of regular and non-temporal copies of growing buffer
+ * sizes, while the CPU keeps reading a working set which the copy can evict
+ * from the cache. Find the sizes from which non-temporal copies are faster.
+ *
+ * @param [in]  cb         Callback to report the bandwidth of every size, or
+ *                         NULL.
+ * @param [in]  arg        Argument for @a cb.
+ * @param [out] nt_min_p   Minimal size for honoring non-temporal copy hints,
+ *                         or UCS_MEMUNITS_INF.
+ * @param [out] nt_dest_p  Minimal size for non-temporal destination stores
+ *                         regardless of the hint, or UCS_MEMUNITS_INF.
+ *
+ * @return UCS_ERR_UNSUPPORTED if the architecture has no non-temporal copy.
+ */
+ucs_status_t ucs_cpu_nt_calibrate(ucs_cpu_nt_calibrate_cb_t cb, void *arg,
+                                  size_t *nt_min_p, size_t *nt_dest_p);
+
+
+#ifdef UCS_ARCH_HAVE_NT_BUFFER_TRANSFER
+/**
+ * Replace the non-temporal transfer thresholds which are set to "auto" by
+ * measured values, if calibration is enabled in the configuration.
+ */
+void ucs_cpu_nt_thresh_calibrate(size_t *nt_min_p, size_t *nt_dest_p);
+#endif
+
 END_C_DECLS
 
 #endif
@@ -531,6 +531,9 @@ int ucs_arch_get_cpu_flag()
             if (_ecx & 1) {
                 result |= UCS_CPU_FLAG_SSE3;
             }
+            if (_ecx & (1 << 1)) {
+                result |= UCS_CPU_FLAG_PCLMUL;
+            }
             if (_ecx & (1 << 9)) {
                 result |= UCS_CPU_FLAG_SSSE3;
             }
@@ -609,8 +612,12 @@ static size_t ucs_cpu_nt_bt_thresh_min(size_t user_val)
     }
 }
 
-static size_t ucs_cpu_nt_dest_thresh()
+static size_t ucs_cpu_nt_dest_thresh(size_t user_val)
 {
+    if (user_val != UCS_MEMUNITS_AUTO) {
+        return user_val;
+    }
+
     if (ucs_arch_get_cpu_vendor() == UCS_CPU_VENDOR_AMD) {
         return ucs_cpu_get_cache_size(UCS_CPU_CACHE_L3) * 9 / 8;
     } else {
@@ -627,10 +634,15 @@ void ucs_cpu_init()
     ucs_global_opts.arch.builtin_memcpy_max =
         ucs_cpu_memcpy_thresh(ucs_global_opts.arch.builtin_memcpy_max,
                               ucs_cpu_builtin_memcpy[ucs_arch_get_cpu_vendor()].max);
+#endif
+#ifdef UCS_ARCH_HAVE_NT_BUFFER_TRANSFER
+    ucs_cpu_nt_thresh_calibrate(&ucs_global_opts.arch.nt_buffer_transfer_min,
+                                &ucs_global_opts.arch.nt_dest_threshold);
 #endif
     ucs_global_opts.arch.nt_buffer_transfer_min =
         ucs_cpu_nt_bt_thresh_min(ucs_global_opts.arch.nt_buffer_transfer_min);
-    ucs_global_opts.arch.nt_dest_threshold = ucs_cpu_nt_dest_thresh();
+    ucs_global_opts.arch.nt_dest_threshold =
+        ucs_cpu_nt_dest_thresh(ucs_global_opts.arch.nt_dest_threshold);
 }
 
 ucs_status_t ucs_arch_get_cache_size(size_t *cache_sizes)
@@ -1127,7 +1139,8 @@ ucs_x86_copy_bytes_le_128(void *dst, const void *src, uint32_t len)
  * application can choose the cache hotness of the final buffer
  */
 void ucs_x86_nt_buffer_transfer(void *dst, const void *src, size_t len,
-                                ucs_arch_memcpy_hint_t hint, size_t total_len)
+                                ucs_arch_memcpy_hint_t hint, size_t total_len,
+                                size_t nt_dest_thresh)
 {
     size_t tail_bytes;
 
@@ -1135,7 +1148,7 @@ void ucs_x86_nt_buffer_transfer(void *dst, const void *src, size_t len,
         goto copy_bytes_le_128;
     }
 
-    if (ucs_unlikely(total_len > ucs_global_opts.arch.nt_dest_threshold)) {
+    if (ucs_unlikely(total_len > nt_dest_thresh)) {
         if (hint & UCS_ARCH_MEMCPY_NT_SOURCE) {
             /*
              * If the lines prefetched with 'NTA' are in 'MODIFIED' state
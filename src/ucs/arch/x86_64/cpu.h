@@ -33,6 +33,10 @@ BEGIN_C_DECLS
 
 #define UCS_ARCH_CACHE_LINE_SIZE 64
 
+#ifdef __AVX__
+#  define UCS_ARCH_HAVE_NT_BUFFER_TRANSFER 1
+#endif
+
 /**
  * In x86_64, there is strong ordering of each processor with respect to another
  * processor, but weak ordering with respect to the bus.
@@ -58,7 +62,7 @@ ucs_status_t ucs_arch_get_cache_size(size_t *cache_sizes);
 void ucs_x86_memcpy_sse_movntdqa(void *dst, const void *src, size_t len);
 void ucs_x86_nt_buffer_transfer(void *dst, const void *src,
                                 size_t len, ucs_arch_memcpy_hint_t hint,
-                                size_t total_len);
+                                size_t total_len, size_t nt_dest_thresh);
 
 static UCS_F_ALWAYS_INLINE int ucs_arch_x86_rdtsc_enabled()
 {
@@ -121,7 +125,8 @@ static inline void *ucs_memcpy_relaxed(void *dst, const void *src, size_t len,
 
 #ifdef __AVX__
     if (ucs_unlikely(total_len >= ucs_global_opts.arch.nt_buffer_transfer_min)) {
-        ucs_x86_nt_buffer_transfer(dst, src, len, hint, total_len);
+        ucs_x86_nt_buffer_transfer(dst, src, len, hint, total_len,
+                                   ucs_global_opts.arch.nt_dest_threshold);
         return dst;
     }
 #endif
@@ -129,6 +134,22 @@ static inline void *ucs_memcpy_relaxed(void *dst, const void *src, size_t len,
     return memcpy(dst, src, len);
 }
 
+#ifdef __AVX__
+/**
+ * Copy memory using non-temporal loads and/or stores according to the hint.
+ * Both loads and stores are non-temporal when the total transfer length is
+ * above @a nt_dest_thresh and the hint has UCS_ARCH_MEMCPY_NT_SOURCE.
+ */
+static UCS_F_ALWAYS_INLINE void
+ucs_arch_nt_buffer_transfer(void *dst, const void *src, size_t len,
+                            ucs_arch_memcpy_hint_t hint, size_t total_len,
+                            size_t nt_dest_thresh)
+{
+    ucs_x86_nt_buffer_transfer(dst, src, len, hint, total_len,
+                               nt_dest_thresh);
+}
+#endif
+
 static UCS_F_ALWAYS_INLINE void
 ucs_memcpy_nontemporal(void *dst, const void *src, size_t len)
 {
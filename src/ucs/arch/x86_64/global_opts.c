@@ -30,6 +30,19 @@ ucs_config_field_t ucs_arch_global_opts_table[] = {
    "Minimal threshold of buffer length for using non-temporal buffer transfer.",
    ucs_offsetof(ucs_arch_global_opts_t, nt_buffer_transfer_min),
    UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"NT_DEST_THRESHOLD", "auto",
+   "Minimal threshold of total transfer length for writing the destination\n"
+   "with non-temporal stores regardless of the copy hint.",
+   ucs_offsetof(ucs_arch_global_opts_t, nt_dest_threshold),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"NT_CALIBRATE", "n",
+   "Measure the non-temporal buffer transfer thresholds which are set to \"auto\"\n"
+   "at startup, instead of using static values for the CPU model. The measured\n"
+   "values are printed by \"ucx_info -M\" and can be set in the configuration\n"
+   "file to avoid repeating the measurement.",
+   ucs_offsetof(ucs_arch_global_opts_t, nt_calibrate), UCS_CONFIG_TYPE_BOOL},
   {NULL}
 };
 
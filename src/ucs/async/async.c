@@ -365,7 +365,8 @@ ucs_status_t ucs_async_context_init(ucs_async_context_t *async, ucs_async_mode_t
 
     ucs_trace_func("async=%p", async);
 
-    status = ucs_mpmc_queue_init(&async->missed);
+    status = ucs_mpmc_queue_init(&async->missed,
+                                 UCS_MPMC_QUEUE_DEFAULT_LENGTH);
     if (status != UCS_OK) {
         goto err;
     }
@@ -14,81 +14,291 @@
 #include <ucs/arch/atomic.h>
 #include <ucs/arch/bitops.h>
 #include <ucs/debug/assert.h>
+#include <ucs/debug/log.h>
 #include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/ptr_arith.h>
 
+#include <inttypes.h>
 
-#define UCS_MPMC_INVALID_VALUE -1
 
-ucs_status_t ucs_mpmc_queue_init(ucs_mpmc_queue_t *mpmc)
+#define UCS_MPMC_INVALID_VALUE ((uint64_t)-1)
+
+
+static UCS_F_ALWAYS_INLINE ucs_mpmc_slot_t *
+ucs_mpmc_queue_slot(ucs_mpmc_queue_t *mpmc, uint64_t pos)
 {
-    ucs_queue_head_init(&mpmc->queue);
-    return ucs_spinlock_init(&mpmc->lock, 0);
+    return &mpmc->slots[pos & mpmc->mask];
 }
 
-void ucs_mpmc_queue_cleanup(ucs_mpmc_queue_t *mpmc)
+/*
+ * Return the number of consecutive slots, starting from 'pos' and up to
+ * 'max_count', whose sequence number is 'pos + offset' for each of them.
+ * With offset 0 these are free slots which can be claimed by a producer, and
+ * with offset 1 these are full slots which can be claimed by a consumer.
+ */
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_mpmc_queue_ready_count(ucs_mpmc_queue_t *mpmc, uint64_t pos,
+                           unsigned offset, unsigned max_count)
 {
-    ucs_mpmc_elem_t *elem;
+    unsigned count = 0;
 
-    while (!ucs_queue_is_empty(&mpmc->queue)) {
-        elem = ucs_queue_pull_elem_non_empty(&mpmc->queue,
-                                             ucs_mpmc_elem_t, super);
-        ucs_free(elem);
+    while ((count < max_count) &&
+           (ucs_mpmc_queue_slot(mpmc, pos + count)->seq ==
+            (pos + count + offset))) {
+        ++count;
     }
+
+    ucs_memory_cpu_load_fence();
+    return count;
 }
 
-ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value)
+/*
+ * Claim up to 'max_count' consecutive slots starting from '*pos_p', and return
+ * the number of claimed slots, or 0 if the ring is full (for a producer) or
+ * empty (for a consumer).
+ */
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_mpmc_queue_claim(ucs_mpmc_queue_t *mpmc, volatile uint64_t *position,
+                     unsigned offset, unsigned max_count, uint64_t *pos_p)
 {
-    ucs_mpmc_elem_t *elem;
+    unsigned count;
+    uint64_t pos;
+    int64_t diff;
 
-    elem = ucs_malloc(sizeof(ucs_mpmc_elem_t), "mpmc elem");
-    if (elem == NULL) {
-        return UCS_ERR_NO_MEMORY;
+    pos = *position;
+    for (;;) {
+        diff = (int64_t)(ucs_mpmc_queue_slot(mpmc, pos)->seq - (pos + offset));
+        if (diff < 0) {
+            /* Slot was not released yet by the other side */
+            return 0;
+        } else if (diff > 0) {
+            /* Another thread has claimed this position */
+            pos = *position;
+            continue;
+        }
+
+        count = ucs_mpmc_queue_ready_count(mpmc, pos, offset, max_count);
+        if ((count > 0) &&
+            ucs_atomic_bool_cswap64(position, pos, pos + count)) {
+            *pos_p = pos;
+            return count;
+        }
+
+        pos = *position;
     }
+}
 
-    elem->value = value;
+static ucs_status_t
+ucs_mpmc_queue_overflow_push(ucs_mpmc_queue_t *mpmc, const uint64_t *values,
+                             unsigned count)
+{
+    ucs_status_t status = UCS_OK;
+    ucs_mpmc_elem_t *elem;
 
     ucs_spin_lock(&mpmc->lock);
-    ucs_queue_push(&mpmc->queue, &elem->super);
+    while (count-- > 0) {
+        elem = ucs_malloc(sizeof(ucs_mpmc_elem_t), "mpmc elem");
+        if (elem == NULL) {
+            status = UCS_ERR_NO_MEMORY;
+            break;
+        }
+
+        elem->value = *(values++);
+        ucs_queue_push(&mpmc->overflow, &elem->super);
+    }
     ucs_spin_unlock(&mpmc->lock);
 
-    return UCS_OK;
+    return status;
 }
 
-ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p)
+static unsigned
+ucs_mpmc_queue_overflow_pull(ucs_mpmc_queue_t *mpmc, uint64_t *values,
+                             unsigned max_count)
 {
-    ucs_status_t status = UCS_ERR_NO_PROGRESS;
+    unsigned count = 0;
     ucs_mpmc_elem_t *elem;
 
-    if (ucs_mpmc_queue_is_empty(mpmc)) {
-        return status;
+    if (ucs_queue_is_empty_no_deref(&mpmc->overflow)) {
+        return 0;
     }
 
     ucs_spin_lock(&mpmc->lock);
-    while (!ucs_queue_is_empty(&mpmc->queue)) {
-        elem = ucs_queue_pull_elem_non_empty(&mpmc->queue, ucs_mpmc_elem_t,
+    while ((count < max_count) && !ucs_queue_is_empty(&mpmc->overflow)) {
+        elem = ucs_queue_pull_elem_non_empty(&mpmc->overflow, ucs_mpmc_elem_t,
                                              super);
         if (elem->value != UCS_MPMC_INVALID_VALUE) {
-            *value_p = elem->value;
-            status   = UCS_OK;
-            ucs_free(elem);
-            break;
+            values[count++] = elem->value;
         }
 
         ucs_free(elem);
     }
     ucs_spin_unlock(&mpmc->lock);
 
-    return status;
+    return count;
+}
+
+ucs_status_t ucs_mpmc_queue_init(ucs_mpmc_queue_t *mpmc, unsigned length)
+{
+    uint64_t i, ring_length;
+    ucs_status_t status;
+
+    status = ucs_spinlock_init(&mpmc->lock, 0);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ring_length = ucs_roundup_pow2((uint64_t)ucs_max(length, 1));
+    mpmc->slots = ucs_malloc(ring_length * sizeof(*mpmc->slots), "mpmc ring");
+    if (mpmc->slots == NULL) {
+        ucs_error("failed to allocate mpmc ring of length %" PRIu64,
+                  ring_length);
+        ucs_spinlock_destroy(&mpmc->lock);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (i = 0; i < ring_length; ++i) {
+        mpmc->slots[i].seq   = i;
+        mpmc->slots[i].value = UCS_MPMC_INVALID_VALUE;
+    }
+
+    mpmc->producer = 0;
+    mpmc->consumer = 0;
+    mpmc->mask     = ring_length - 1;
+    ucs_queue_head_init(&mpmc->overflow);
+    return UCS_OK;
+}
+
+void ucs_mpmc_queue_cleanup(ucs_mpmc_queue_t *mpmc)
+{
+    ucs_mpmc_elem_t *elem;
+
+    while (!ucs_queue_is_empty(&mpmc->overflow)) {
+        elem = ucs_queue_pull_elem_non_empty(&mpmc->overflow,
+                                             ucs_mpmc_elem_t, super);
+        ucs_free(elem);
+    }
+
+    ucs_spinlock_destroy(&mpmc->lock);
+    ucs_free(mpmc->slots);
+}
+
+ucs_status_t ucs_mpmc_queue_push_batch(ucs_mpmc_queue_t *mpmc,
+                                       const uint64_t *values, unsigned count)
+{
+    ucs_mpmc_slot_t *slot;
+    unsigned i, claimed;
+    uint64_t pos;
+
+    /* Keep FIFO order while older values are waiting in the overflow queue */
+    while ((count > 0) && ucs_queue_is_empty_no_deref(&mpmc->overflow)) {
+        claimed = ucs_mpmc_queue_claim(mpmc, &mpmc->producer, 0, count, &pos);
+        if (claimed == 0) {
+            break;
+        }
+
+        for (i = 0; i < claimed; ++i) {
+            ucs_mpmc_queue_slot(mpmc, pos + i)->value = values[i];
+        }
+
+        ucs_memory_cpu_store_fence();
+        for (i = 0; i < claimed; ++i) {
+            slot      = ucs_mpmc_queue_slot(mpmc, pos + i);
+            slot->seq = pos + i + 1;
+        }
+
+        values += claimed;
+        count  -= claimed;
+    }
+
+    if (count == 0) {
+        return UCS_OK;
+    }
+
+    return ucs_mpmc_queue_overflow_push(mpmc, values, count);
+}
+
+ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value)
+{
+    return ucs_mpmc_queue_push_batch(mpmc, &value, 1);
+}
+
+unsigned ucs_mpmc_queue_pull_batch(ucs_mpmc_queue_t *mpmc, uint64_t *values,
+                                   unsigned max_count)
+{
+    unsigned i, claimed, count = 0;
+    ucs_mpmc_slot_t *slot;
+    uint64_t value, pos;
+
+    while (count < max_count) {
+        claimed = ucs_mpmc_queue_claim(mpmc, &mpmc->consumer, 1,
+                                       max_count - count, &pos);
+        if (claimed == 0) {
+            break;
+        }
+
+        for (i = 0; i < claimed; ++i) {
+            value = ucs_mpmc_queue_slot(mpmc, pos + i)->value;
+            /* Skip values invalidated by ucs_mpmc_queue_remove_if() */
+            if (value != UCS_MPMC_INVALID_VALUE) {
+                values[count++] = value;
+            }
+        }
+
+        /* Values must be read before the slots are released to producers */
+        ucs_memory_cpu_fence();
+        for (i = 0; i < claimed; ++i) {
+            slot      = ucs_mpmc_queue_slot(mpmc, pos + i);
+            slot->seq = pos + i + mpmc->mask + 1;
+        }
+    }
+
+    if (count < max_count) {
+        count += ucs_mpmc_queue_overflow_pull(mpmc, values + count,
+                                              max_count - count);
+    }
+
+    return count;
+}
+
+ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p)
+{
+    if (ucs_mpmc_queue_is_empty(mpmc) ||
+        (ucs_mpmc_queue_pull_batch(mpmc, value_p, 1) == 0)) {
+        return UCS_ERR_NO_PROGRESS;
+    }
+
+    return UCS_OK;
 }
 
 void ucs_mpmc_queue_remove_if(ucs_mpmc_queue_t *mpmc,
                               ucs_mpmc_queue_predicate_t predicate, void *arg)
 {
+    uint64_t pos, producer, value;
+    ucs_mpmc_slot_t *slot;
     ucs_mpmc_elem_t *elem;
     ucs_queue_iter_t iter;
 
+    /*
+     * Invalidate matching values in-place. The value is replaced only if it
+     * was not changed since it was checked, and since the predicate depends
+     * only on the value, it is safe even if the slot was reused meanwhile.
+     */
+    producer = mpmc->producer;
+    for (pos = mpmc->consumer; (int64_t)(producer - pos) > 0; ++pos) {
+        slot = ucs_mpmc_queue_slot(mpmc, pos);
+        if (slot->seq != (pos + 1)) {
+            continue;
+        }
+
+        ucs_memory_cpu_load_fence();
+        value = slot->value;
+        if ((value != UCS_MPMC_INVALID_VALUE) && predicate(value, arg)) {
+            ucs_atomic_cswap64(&slot->value, value, UCS_MPMC_INVALID_VALUE);
+        }
+    }
+
     ucs_spin_lock(&mpmc->lock);
-    ucs_queue_for_each_safe(elem, iter, &mpmc->queue, super) {
+    ucs_queue_for_each_safe(elem, iter, &mpmc->overflow, super) {
         if (predicate(elem->value, arg)) {
             elem->value = UCS_MPMC_INVALID_VALUE;
         }
@@ -9,21 +9,57 @@
 
 #include "queue.h"
 
+#include <ucs/arch/cpu.h>
+#include <ucs/sys/compiler.h>
 #include <ucs/type/status.h>
 #include <ucs/type/spinlock.h>
 
+
+/**
+ * Default length of the MPMC queue ring.
+ */
+#define UCS_MPMC_QUEUE_DEFAULT_LENGTH 256
+
+
+/**
+ * MPMC ring slot. The sequence number tells whether the slot is free for the
+ * producer at position 'seq', or holds a value for the consumer at position
+ * 'seq - 1'.
+ */
+typedef struct ucs_mpmc_slot {
+    volatile uint64_t  seq;
+    volatile uint64_t  value;
+} ucs_mpmc_slot_t;
+
+
 /**
  * A Multi-producer-multi-consumer thread-safe queue.
- * Every push/pull is a single atomic operation in "good" scenario.
+ *
+ * The queue is a fixed-size lock-free ring, where every push/pull is a single
+ * atomic operation in "good" scenario. Producer and consumer positions reside
+ * on separate cache lines, to avoid false sharing between pushing and pulling
+ * threads. If the ring is full, pushed values are kept on a spinlock-protected
+ * overflow queue, so the total number of elements is not limited.
  */
 typedef struct ucs_mpmc_queue {
-    ucs_spinlock_t     lock;        /* Protects 'queue' */
-    ucs_queue_head_t   queue;       /* Queue of data */
+    /* Producer cacheline */
+    volatile uint64_t  producer;    /* Next position to push to */
+    UCS_CACHELINE_PADDING(uint64_t);
+
+    /* Consumer cacheline */
+    volatile uint64_t  consumer;    /* Next position to pull from */
+    UCS_CACHELINE_PADDING(uint64_t);
+
+    /* Read-mostly fields */
+    ucs_mpmc_slot_t    *slots;      /* Ring slots array */
+    uint64_t           mask;        /* Ring length minus 1 */
+    ucs_spinlock_t     lock;        /* Protects 'overflow' */
+    ucs_queue_head_t   overflow;    /* Values which did not fit the ring */
 } ucs_mpmc_queue_t;
 
 
 /**
- * MPMC queue element type.
+ * MPMC queue overflow element type.
  */
 typedef struct ucs_mpmc_elem {
     ucs_queue_elem_t super;
@@ -45,9 +81,9 @@ typedef int (*ucs_mpmc_queue_predicate_t)(uint64_t value, void *arg);
 /**
  * Initialize MPMC queue.
  *
- * @param length   Queue length.
+ * @param length   Ring length, rounded up to a power of 2.
  */
-ucs_status_t ucs_mpmc_queue_init(ucs_mpmc_queue_t *mpmc);
+ucs_status_t ucs_mpmc_queue_init(ucs_mpmc_queue_t *mpmc, unsigned length);
 
 
 /**
@@ -60,11 +96,26 @@ void ucs_mpmc_queue_cleanup(ucs_mpmc_queue_t *mpmc);
  * Atomically push a value to the queue.
  *
  * @param value Value to push.
- * @return UCS_ERR_NO_MEMORY if it fails to allocate the MPMC queue element.
+ * @return UCS_ERR_NO_MEMORY if the ring is full and it fails to allocate an
+ *         overflow element.
  */
 ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value);
 
 
+/**
+ * Push an array of values to the queue. Values which fit the ring are claimed
+ * with a single atomic operation whenever possible.
+ *
+ * @param values  Values to push.
+ * @param count   Number of values in the array.
+ * @return UCS_ERR_NO_MEMORY if the ring is full and it fails to allocate an
+ *         overflow element. In this case, some of the values may have been
+ *         pushed.
+ */
+ucs_status_t ucs_mpmc_queue_push_batch(ucs_mpmc_queue_t *mpmc,
+                                       const uint64_t *values, unsigned count);
+
+
 /**
  * Atomically pull a value from the queue.
  *
@@ -75,6 +126,17 @@ ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value);
 ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p);
 
 
+/**
+ * Pull up to @a max_count values from the queue.
+ *
+ * @param values     Filled with the pulled values.
+ * @param max_count  Maximal number of values to pull.
+ * @return Number of values pulled, may be 0 if the queue is currently empty.
+ */
+unsigned ucs_mpmc_queue_pull_batch(ucs_mpmc_queue_t *mpmc, uint64_t *values,
+                                   unsigned max_count);
+
+
 /**
  * Remove all elements from the MPMC queue with the given value for which the
  * given predicate returns "true" (nonzero) value.
@@ -93,7 +155,8 @@ void ucs_mpmc_queue_remove_if(ucs_mpmc_queue_t *mpmc,
  */
 static inline int ucs_mpmc_queue_is_empty(ucs_mpmc_queue_t *mpmc)
 {
-    return ucs_queue_is_empty_no_deref(&mpmc->queue);
+    return (mpmc->producer == mpmc->consumer) &&
+           ucs_queue_is_empty_no_deref(&mpmc->overflow);
 }
 
 #endif
@@ -11,12 +11,63 @@
 #include "mpool.h"
 #include "mpool.inl"
 #include "queue.h"
+#include "list.h"
 
 #include <ucs/debug/log.h>
 #include <ucs/sys/ptr_arith.h>
 #include <ucs/sys/checker.h>
 #include <ucs/sys/sys.h>
 #include <ucs/arch/cpu.h>
+#include <ucs/type/spinlock.h>
+#include <pthread.h>
+
+
+/* Number of elements in a per-thread magazine */
+#define UCS_MPOOL_MAGAZINE_SIZE 32
+
+
+typedef struct ucs_mpool_magazine ucs_mpool_magazine_t;
+
+
+/*
+ * Fixed-size stack of free elements, owned by a thread or by the central pool.
+ */
+struct ucs_mpool_magazine {
+    ucs_mpool_magazine_t   *next;      /* Next magazine in the central pool */
+    unsigned               count;      /* Number of elements in the stack */
+    ucs_mpool_elem_t       *elems[UCS_MPOOL_MAGAZINE_SIZE];
+};
+
+
+/*
+ * Per-thread cache. Each thread always holds two magazines, so a thread which
+ * alternates between get and put on a magazine boundary does not go to the
+ * central pool every time.
+ */
+typedef struct ucs_mpool_thread_cache {
+    ucs_mpool_magazine_t   *loaded;    /* Magazine to get/put elements from/to */
+    ucs_mpool_magazine_t   *previous;  /* Either full or empty magazine */
+    ucs_mpool_tcache_t     *tcache;    /* Memory pool central cache */
+    ucs_list_link_t        list;       /* Entry in tcache->threads */
+} ucs_mpool_thread_cache_t;
+
+
+/*
+ * Central state of a memory pool with per-thread caches. The spinlock also
+ * protects growing the pool.
+ */
+struct ucs_mpool_tcache {
+    ucs_mpool_t            *mp;        /* Owning memory pool */
+    pthread_key_t          key;        /* Thread-local ucs_mpool_thread_cache_t */
+    ucs_spinlock_t         lock;       /* Protects the fields below */
+    ucs_mpool_magazine_t   *full;      /* Full magazines */
+    ucs_mpool_magazine_t   *empty;     /* Empty magazines */
+    ucs_mpool_elem_t       *freelist;  /* Free elements not in any magazine */
+    ucs_list_link_t        threads;    /* List of thread caches */
+};
+
+
+static void ucs_mpool_grow_next(ucs_mpool_t *mp);
 
 
 static size_t ucs_mpool_elem_total_size(ucs_mpool_data_t *data)
@@ -64,14 +115,336 @@ void ucs_mpool_params_reset(ucs_mpool_params_t *params)
     params->align_offset    = 0;
     params->alignment       = UCS_SYS_CACHE_LINE_SIZE;
     params->malloc_safe     = 0;
+    params->flags           = 0;
     params->elems_per_chunk = 128;
     params->max_chunk_size  = 128 * UCS_MBYTE;
     params->max_elems       = UINT_MAX;
     params->grow_factor     = 1.0;
+    params->numa_node       = UCS_NUMA_NODE_UNDEFINED;
     params->ops             = NULL;
     params->name            = "";
 }
 
+/* Move all elements of a magazine to the pool's main freelist */
+static void ucs_mpool_magazine_drain(ucs_mpool_t *mp,
+                                     ucs_mpool_magazine_t *magazine)
+{
+    ucs_mpool_elem_t *elem;
+
+    while (magazine->count > 0) {
+        elem = magazine->elems[--magazine->count];
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        ucs_mpool_add_to_freelist(mp, elem);
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    }
+}
+
+static void ucs_mpool_magazine_list_release(ucs_mpool_t *mp,
+                                            ucs_mpool_magazine_t *magazine)
+{
+    ucs_mpool_magazine_t *next;
+
+    for (; magazine != NULL; magazine = next) {
+        next = magazine->next;
+        ucs_mpool_magazine_drain(mp, magazine);
+        ucs_free(magazine);
+    }
+}
+
+/*
+ * Return all cached elements to the main freelist, so the regular cleanup and
+ * leak check would treat them as released.
+ */
+static void ucs_mpool_tcache_cleanup(ucs_mpool_t *mp)
+{
+    ucs_mpool_tcache_t *tcache = mp->data->tcache;
+    ucs_mpool_thread_cache_t *tc, *tmp;
+    ucs_mpool_elem_t *elem;
+
+    pthread_key_delete(tcache->key);
+
+    ucs_list_for_each_safe(tc, tmp, &tcache->threads, list) {
+        ucs_mpool_magazine_drain(mp, tc->loaded);
+        ucs_mpool_magazine_drain(mp, tc->previous);
+        ucs_free(tc->loaded);
+        ucs_free(tc->previous);
+        ucs_free(tc);
+    }
+
+    ucs_mpool_magazine_list_release(mp, tcache->full);
+    ucs_mpool_magazine_list_release(mp, tcache->empty);
+
+    while (tcache->freelist != NULL) {
+        elem             = tcache->freelist;
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        tcache->freelist = elem->next;
+        ucs_mpool_add_to_freelist(mp, elem);
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    }
+
+    ucs_spinlock_destroy(&tcache->lock);
+    ucs_free(tcache);
+    mp->data->tcache = NULL;
+}
+
+/* Push the elements of a magazine to the central freelist, with lock held */
+static void ucs_mpool_tcache_flush(ucs_mpool_tcache_t *tcache,
+                                   ucs_mpool_magazine_t *magazine)
+{
+    ucs_mpool_elem_t *elem;
+
+    while (magazine->count > 0) {
+        elem             = magazine->elems[--magazine->count];
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        elem->next       = tcache->freelist;
+        tcache->freelist = elem;
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    }
+}
+
+static void ucs_mpool_thread_cache_release(void *arg)
+{
+    ucs_mpool_thread_cache_t *tc = arg;
+    ucs_mpool_tcache_t *tcache   = tc->tcache;
+
+    ucs_spin_lock(&tcache->lock);
+    ucs_mpool_tcache_flush(tcache, tc->loaded);
+    ucs_mpool_tcache_flush(tcache, tc->previous);
+    ucs_list_del(&tc->list);
+    ucs_spin_unlock(&tcache->lock);
+
+    ucs_free(tc->loaded);
+    ucs_free(tc->previous);
+    ucs_free(tc);
+}
+
+static ucs_status_t ucs_mpool_tcache_init(ucs_mpool_t *mp)
+{
+    ucs_mpool_tcache_t *tcache;
+    ucs_status_t status;
+    int ret;
+
+    tcache = ucs_malloc(sizeof(*tcache), "mpool_tcache");
+    if (tcache == NULL) {
+        ucs_error("failed to allocate mpool %s thread cache",
+                  ucs_mpool_name(mp));
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucs_spinlock_init(&tcache->lock, 0);
+    if (status != UCS_OK) {
+        goto err_free;
+    }
+
+    ret = pthread_key_create(&tcache->key, ucs_mpool_thread_cache_release);
+    if (ret != 0) {
+        ucs_error("mpool %s: pthread_key_create() failed: %m",
+                  ucs_mpool_name(mp));
+        status = UCS_ERR_IO_ERROR;
+        goto err_destroy_lock;
+    }
+
+    tcache->mp       = mp;
+    tcache->full     = NULL;
+    tcache->empty    = NULL;
+    tcache->freelist = NULL;
+    ucs_list_head_init(&tcache->threads);
+    mp->data->tcache = tcache;
+    return UCS_OK;
+
+err_destroy_lock:
+    ucs_spinlock_destroy(&tcache->lock);
+err_free:
+    ucs_free(tcache);
+    return status;
+}
+
+static ucs_mpool_thread_cache_t *
+ucs_mpool_thread_cache_create(ucs_mpool_tcache_t *tcache)
+{
+    ucs_mpool_thread_cache_t *tc;
+
+    tc = ucs_malloc(sizeof(*tc), "mpool_thread_cache");
+    if (tc == NULL) {
+        goto err;
+    }
+
+    tc->loaded = ucs_malloc(sizeof(*tc->loaded), "mpool_magazine");
+    if (tc->loaded == NULL) {
+        goto err_free_tc;
+    }
+
+    tc->previous = ucs_malloc(sizeof(*tc->previous), "mpool_magazine");
+    if (tc->previous == NULL) {
+        goto err_free_loaded;
+    }
+
+    tc->loaded->count   = 0;
+    tc->previous->count = 0;
+    tc->tcache          = tcache;
+
+    ucs_spin_lock(&tcache->lock);
+    ucs_list_add_tail(&tcache->threads, &tc->list);
+    ucs_spin_unlock(&tcache->lock);
+
+    pthread_setspecific(tcache->key, tc);
+    return tc;
+
+err_free_loaded:
+    ucs_free(tc->loaded);
+err_free_tc:
+    ucs_free(tc);
+err:
+    ucs_error("failed to allocate mpool %s thread cache",
+              ucs_mpool_name(tcache->mp));
+    return NULL;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_mpool_thread_cache_t *
+ucs_mpool_thread_cache_get(ucs_mpool_tcache_t *tcache)
+{
+    ucs_mpool_thread_cache_t *tc = pthread_getspecific(tcache->key);
+
+    if (ucs_likely(tc != NULL)) {
+        return tc;
+    }
+
+    return ucs_mpool_thread_cache_create(tcache);
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucs_mpool_thread_cache_swap(ucs_mpool_thread_cache_t *tc)
+{
+    ucs_mpool_magazine_t *magazine = tc->loaded;
+
+    tc->loaded   = tc->previous;
+    tc->previous = magazine;
+}
+
+/* Both magazines are empty: take a full magazine from the central pool, or
+ * refill the loaded magazine from the central freelist */
+static void ucs_mpool_thread_cache_refill(ucs_mpool_t *mp,
+                                          ucs_mpool_thread_cache_t *tc)
+{
+    ucs_mpool_tcache_t *tcache = tc->tcache;
+    ucs_mpool_magazine_t *magazine;
+    ucs_mpool_elem_t *elem;
+
+    ucs_spin_lock(&tcache->lock);
+
+    if (tcache->full != NULL) {
+        magazine           = tcache->full;
+        tcache->full       = magazine->next;
+        tc->previous->next = tcache->empty;
+        tcache->empty      = tc->previous;
+        tc->previous       = tc->loaded;
+        tc->loaded         = magazine;
+        goto out;
+    }
+
+    if (tcache->freelist == NULL) {
+        ucs_mpool_grow_next(mp);
+    }
+
+    magazine = tc->loaded;
+    while ((magazine->count < UCS_MPOOL_MAGAZINE_SIZE) &&
+           (tcache->freelist != NULL)) {
+        elem             = tcache->freelist;
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        tcache->freelist = elem->next;
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+        magazine->elems[magazine->count++] = elem;
+    }
+
+out:
+    ucs_spin_unlock(&tcache->lock);
+}
+
+/* Both magazines are full: exchange the previous magazine with an empty one
+ * from the central pool, or flush it to the central freelist */
+static void ucs_mpool_thread_cache_unload(ucs_mpool_thread_cache_t *tc)
+{
+    ucs_mpool_tcache_t *tcache = tc->tcache;
+    ucs_mpool_magazine_t *magazine;
+
+    ucs_spin_lock(&tcache->lock);
+    if (tcache->empty != NULL) {
+        magazine           = tcache->empty;
+        tcache->empty      = magazine->next;
+        tc->previous->next = tcache->full;
+        tcache->full       = tc->previous;
+        tc->previous       = magazine;
+    } else {
+        ucs_mpool_tcache_flush(tcache, tc->previous);
+    }
+    ucs_spin_unlock(&tcache->lock);
+
+    ucs_mpool_thread_cache_swap(tc);
+}
+
+static void *ucs_mpool_tcache_get(ucs_mpool_t *mp)
+{
+    ucs_mpool_thread_cache_t *tc;
+    ucs_mpool_elem_t *elem;
+    void *obj;
+
+    tc = ucs_mpool_thread_cache_get(mp->data->tcache);
+    if (ucs_unlikely(tc == NULL)) {
+        return NULL;
+    }
+
+    if (ucs_unlikely(tc->loaded->count == 0)) {
+        if (tc->previous->count > 0) {
+            ucs_mpool_thread_cache_swap(tc);
+        } else {
+            ucs_mpool_thread_cache_refill(mp, tc);
+            if (tc->loaded->count == 0) {
+                return NULL;
+            }
+        }
+    }
+
+    elem        = tc->loaded->elems[--tc->loaded->count];
+    VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+    elem->mpool = (ucs_mpool_t*)((uintptr_t)mp | UCS_MPOOL_ELEM_FLAG_TCACHE);
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+
+    obj = elem + 1;
+    VALGRIND_MEMPOOL_ALLOC(mp, obj, mp->data->elem_size - sizeof(ucs_mpool_elem_t));
+    return obj;
+}
+
+void ucs_mpool_tcache_put(void *obj)
+{
+    ucs_mpool_elem_t *elem = ucs_mpool_obj_to_elem(obj);
+    ucs_mpool_t *mp        = ucs_mpool_obj_owner(obj);
+    ucs_mpool_thread_cache_t *tc;
+
+    VALGRIND_MEMPOOL_FREE(mp, obj);
+
+    tc = ucs_mpool_thread_cache_get(mp->data->tcache);
+    if (ucs_unlikely(tc == NULL)) {
+        /* Cannot allocate a thread cache: release to the central freelist */
+        ucs_spin_lock(&mp->data->tcache->lock);
+        elem->next                 = mp->data->tcache->freelist;
+        mp->data->tcache->freelist = elem;
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+        ucs_spin_unlock(&mp->data->tcache->lock);
+        return;
+    }
+
+    if (ucs_unlikely(tc->loaded->count == UCS_MPOOL_MAGAZINE_SIZE)) {
+        if (tc->previous->count == 0) {
+            ucs_mpool_thread_cache_swap(tc);
+        } else {
+            ucs_mpool_thread_cache_unload(tc);
+        }
+    }
+
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    tc->loaded->elems[tc->loaded->count++] = elem;
+}
+
 static size_t ucs_mpool_chunk_size(ucs_mpool_t *mp, unsigned num_elems)
 {
     return sizeof(ucs_mpool_chunk_t) + mp->data->alignment +
@@ -91,7 +464,8 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
         (params->max_elems < params->elems_per_chunk) ||
         (params->ops == NULL) ||
         (!params->ops->chunk_alloc || !params->ops->chunk_release) ||
-        (params->grow_factor < 1))
+        (params->grow_factor < 1) ||
+        ((params->flags & UCS_MPOOL_FLAG_THREAD_CACHE) && params->malloc_safe))
     {
         ucs_error("Invalid memory pool parameter(s)");
         return UCS_ERR_INVALID_PARAM;
@@ -111,9 +485,13 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
     mp->data->align_offset    = sizeof(ucs_mpool_elem_t) + params->align_offset;
     mp->data->elems_per_chunk = params->elems_per_chunk;
     mp->data->malloc_safe     = params->malloc_safe;
+    mp->data->numa_node       = (params->numa_node == UCS_NUMA_NODE_CURRENT) ?
+                                ucs_numa_node_of_current_cpu() :
+                                params->numa_node;
     mp->data->quota           = params->max_elems;
     mp->data->tail            = NULL;
     mp->data->chunks          = NULL;
+    mp->data->tcache          = NULL;
     mp->data->ops             = params->ops;
     mp->data->name            = ucs_strdup(params->name, "mpool_data_name");
 
@@ -131,11 +509,18 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
         goto err_free_name;
     }
 
+    if (params->flags & UCS_MPOOL_FLAG_THREAD_CACHE) {
+        status = ucs_mpool_tcache_init(mp);
+        if (status != UCS_OK) {
+            goto err_free_name;
+        }
+    }
+
     VALGRIND_CREATE_MEMPOOL(mp, 0, 0);
 
-    ucs_debug("mpool %s: align %zu, maxelems %u, elemsize %zu",
+    ucs_debug("mpool %s: align %zu, maxelems %u, elemsize %zu, numa node %d",
               ucs_mpool_name(mp), mp->data->alignment, params->max_elems,
-              mp->data->elem_size);
+              mp->data->elem_size, mp->data->numa_node);
     return UCS_OK;
 
 err_free_name:
@@ -153,6 +538,10 @@ void ucs_mpool_cleanup(ucs_mpool_t *mp, int leak_check)
     ucs_mpool_data_t *data = mp->data;
     void *obj;
 
+    if (data->tcache != NULL) {
+        ucs_mpool_tcache_cleanup(mp);
+    }
+
     /* Cleanup all elements in the freelist and set their header to NULL to mark
      * them as released for the leak check.
      */
@@ -209,6 +598,14 @@ const char *ucs_mpool_name(ucs_mpool_t *mp)
 
 int ucs_mpool_is_empty(ucs_mpool_t *mp)
 {
+    ucs_mpool_tcache_t *tcache = mp->data->tcache;
+
+    if (tcache != NULL) {
+        /* Elements cached by other threads are not taken into account */
+        return (tcache->freelist == NULL) && (tcache->full == NULL) &&
+               (mp->data->quota == 0);
+    }
+
     return (mp->freelist == NULL) && (mp->data->quota == 0);
 }
 
@@ -245,21 +642,48 @@ unsigned ucs_mpool_num_elems_per_chunk(ucs_mpool_t *mp,
     return ucs_min(data->quota, elem_size / ucs_mpool_elem_total_size(data));
 }
 
-void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
+/*
+ * With per-thread caches, new elements go directly to the central freelist
+ * (with lock held), since the main freelist is accessed without a lock.
+ */
+static void ucs_mpool_grow_add_elem(ucs_mpool_t *mp, ucs_mpool_elem_t *elem)
+{
+    ucs_mpool_tcache_t *tcache = mp->data->tcache;
+
+    if (tcache == NULL) {
+        ucs_mpool_add_to_freelist(mp, elem);
+        return;
+    }
+
+    elem->next       = tcache->freelist;
+    tcache->freelist = elem;
+}
+
+static void ucs_mpool_grow_chunk(ucs_mpool_t *mp, unsigned num_elems)
 {
     ucs_mpool_data_t *data = mp->data;
+    ucs_numa_mempolicy_t mempolicy;
     size_t chunk_size;
     ucs_mpool_chunk_t *chunk;
     ucs_mpool_elem_t *elem;
     ucs_status_t status;
     unsigned i;
     unsigned allocated_num_elems;
+    int numa_bound;
     void *ptr;
 
     if (data->quota == 0) {
         return;
     }
 
+    /* The pages of the chunk are placed when first touched, which happens
+     * while allocating the chunk or initializing its elements below, so
+     * prefer the requested node for this thread until the chunk is ready.
+     */
+    numa_bound = (data->numa_node >= 0) &&
+                 (ucs_numa_mempolicy_prefer(data->numa_node, &mempolicy) ==
+                  UCS_OK);
+
     allocated_num_elems = ucs_min(data->quota, num_elems);
     chunk_size          = ucs_mpool_chunk_size(mp, allocated_num_elems);
     chunk_size          = ucs_min(chunk_size, data->max_chunk_size);
@@ -269,7 +693,7 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
             ucs_error("Failed to allocate memory pool (name=%s) chunk: %s",
                       ucs_mpool_name(mp), ucs_status_string(status));
         }
-        return;
+        goto out;
     }
 
     /* Calculate padding, and update element count according to allocated size */
@@ -287,7 +711,7 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
         if (data->ops->obj_init != NULL) {
             data->ops->obj_init(mp, elem + 1, chunk);
         }
-        ucs_mpool_add_to_freelist(mp, elem);
+        ucs_mpool_grow_add_elem(mp, elem);
     }
 
     chunk->next  = data->chunks;
@@ -302,16 +726,36 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
     }
 
     VALGRIND_MAKE_MEM_NOACCESS(chunk + 1, chunk_size - sizeof(*chunk));
+
+out:
+    if (numa_bound) {
+        ucs_numa_mempolicy_restore(&mempolicy);
+    }
 }
 
-void *ucs_mpool_get_grow(ucs_mpool_t *mp)
+void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
 {
-    ucs_mpool_data_t *data = mp->data;
+    ucs_mpool_tcache_t *tcache = mp->data->tcache;
+
+    if (tcache == NULL) {
+        ucs_mpool_grow_chunk(mp, num_elems);
+        return;
+    }
+
+    ucs_spin_lock(&tcache->lock);
+    ucs_mpool_grow_chunk(mp, num_elems);
+    ucs_spin_unlock(&tcache->lock);
+}
+
+static void ucs_mpool_grow_next(ucs_mpool_t *mp)
+{
+    ucs_mpool_data_t *data        = mp->data;
+    ucs_mpool_chunk_t *last_chunk = data->chunks;
     unsigned num_elems;
 
-    ucs_mpool_grow(mp, data->elems_per_chunk);
-    if (mp->freelist == NULL) {
-        return NULL;
+    ucs_mpool_grow_chunk(mp, data->elems_per_chunk);
+    if (data->chunks == last_chunk) {
+        return;
     }
 
     /* Calculate num of elems for next growing */
@@ -319,6 +763,18 @@ void *ucs_mpool_get_grow(ucs_mpool_t *mp)
     num_elems             = ucs_min(data->elems_per_chunk,
                                     data->chunks->num_elems);
     data->elems_per_chunk = (num_elems * data->grow_factor) + 0.5;
+}
+
+void *ucs_mpool_get_grow(ucs_mpool_t *mp)
+{
+    if (mp->data->tcache != NULL) {
+        return ucs_mpool_tcache_get(mp);
+    }
+
+    ucs_mpool_grow_next(mp);
+    if (mp->freelist == NULL) {
+        return NULL;
+    }
 
     return ucs_mpool_get(mp);
 }
@@ -11,6 +11,7 @@
 #include <ucs/type/status.h>
 #include <ucs/sys/compiler_def.h>
 #include <ucs/datastruct/string_buffer.h>
+#include <ucs/memory/numa.h>
 
 
 BEGIN_C_DECLS
@@ -22,6 +23,7 @@ typedef union  ucs_mpool_elem    ucs_mpool_elem_t;
 typedef struct ucs_mpool         ucs_mpool_t;
 typedef struct ucs_mpool_data    ucs_mpool_data_t;
 typedef struct ucs_mpool_ops     ucs_mpool_ops_t;
+typedef struct ucs_mpool_tcache  ucs_mpool_tcache_t;
 
 
 /**
@@ -41,6 +43,27 @@ typedef struct ucs_mpool_ops     ucs_mpool_ops_t;
  */
 
 
+/**
+ * Set in the element header of an allocated element which belongs to a memory
+ * pool with @ref UCS_MPOOL_FLAG_THREAD_CACHE.
+ */
+#define UCS_MPOOL_ELEM_FLAG_TCACHE 1ul
+
+
+/**
+ * Memory pool flags.
+ */
+typedef enum {
+    /**
+     * Keep per-thread caches ("magazines") of free elements, which are
+     * exchanged with the central pool as whole magazines. This makes get/put
+     * operations thread-safe, and most of them do not touch any shared state.
+     * Cannot be used together with malloc_safe.
+     */
+    UCS_MPOOL_FLAG_THREAD_CACHE = UCS_BIT(0)
+} ucs_mpool_flags_t;
+
+
 /**
  * Memory pool element header.
  */
@@ -82,8 +105,10 @@ struct ucs_mpool_data {
     unsigned               elems_per_chunk; /* Number of elements per chunk */
     unsigned               quota;           /* How many more elements can be allocated */
     int                    malloc_safe;     /* Avoid triggering malloc() during put/get */
+    ucs_numa_node_t        numa_node;       /* NUMA node to allocate chunks on */
     ucs_mpool_elem_t       *tail;           /* Free list tail */
     ucs_mpool_chunk_t      *chunks;         /* List of allocated chunks */
+    ucs_mpool_tcache_t     *tcache;         /* Per-thread caches, or NULL */
     const ucs_mpool_ops_t  *ops;            /* Memory pool operations */
     char                   *name;           /* Name - used for debugging */
 };
@@ -209,6 +234,11 @@ typedef struct ucs_mpool_params {
      */
     int                   malloc_safe;
 
+    /**
+     * Memory pool flags, a combination of @ref ucs_mpool_flags_t.
+     */
+    unsigned              flags;
+
     /**
      * Number of elements in first chunk.
      */
@@ -230,6 +260,15 @@ typedef struct ucs_mpool_params {
      */
     double                grow_factor;
 
+    /**
+     * NUMA node to allocate the chunks on: a node number, UCS_NUMA_NODE_CURRENT
+     * for the node of the thread which initializes the pool, or
+     * UCS_NUMA_NODE_UNDEFINED to leave the placement to the operating system.
+     * Applies to the memory which is touched while a chunk is allocated and
+     * its elements are initialized.
+     */
+    ucs_numa_node_t       numa_node;
+
     /**
      * Memory pool operations.
      */
@@ -335,6 +374,16 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems);
 void *ucs_mpool_get_grow(ucs_mpool_t *mp);
 
 
+/**
+ * Return an object to the calling thread's cache of its memory pool.
+ * Used internally by ucs_mpool_put() for pools with
+ * @ref UCS_MPOOL_FLAG_THREAD_CACHE.
+ *
+ * @param obj              Object to return.
+ */
+void ucs_mpool_tcache_put(void *obj);
+
+
 /**
  * Return the number of elements in the chunk.
  * @param mp               Memory pool structure.
@@ -66,7 +66,8 @@ static inline ucs_mpool_elem_t *ucs_mpool_obj_to_elem(void *obj)
 
 static inline ucs_mpool_t *ucs_mpool_obj_owner(void *obj)
 {
-    return ucs_mpool_obj_to_elem(obj)->mpool;
+    return (ucs_mpool_t*)((uintptr_t)ucs_mpool_obj_to_elem(obj)->mpool &
+                          ~UCS_MPOOL_ELEM_FLAG_TCACHE);
 }
 
 static inline void ucs_mpool_put_inline(void *obj)
@@ -76,6 +77,11 @@ static inline void ucs_mpool_put_inline(void *obj)
 
     elem = ucs_mpool_obj_to_elem(obj);
     mp   = elem->mpool;
+    if (ucs_unlikely((uintptr_t)mp & UCS_MPOOL_ELEM_FLAG_TCACHE)) {
+        ucs_mpool_tcache_put(obj);
+        return;
+    }
+
     ucs_mpool_add_to_freelist(mp, elem);
     VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
     VALGRIND_MEMPOOL_FREE(mp, obj);
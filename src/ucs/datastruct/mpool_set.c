@@ -35,7 +35,8 @@ ucs_mpool_set_init(ucs_mpool_set_t *mp_set, size_t *sizes, unsigned sizes_count,
                    size_t max_mp_entry_size, size_t priv_size,
                    size_t priv_elem_size, size_t align_offset, size_t alignment,
                    unsigned elems_per_chunk, unsigned max_elems,
-                   ucs_mpool_ops_t *ops, const char *name)
+                   ucs_numa_node_t numa_node, ucs_mpool_ops_t *ops,
+                   const char *name)
 {
     int i, size_log2, mpools_num;
     int prev_idx, mps_idx, map_idx, max_idx;
@@ -102,6 +103,7 @@ ucs_mpool_set_init(ucs_mpool_set_t *mp_set, size_t *sizes, unsigned sizes_count,
         mp_params.alignment       = alignment;
         mp_params.elems_per_chunk = elems_per_chunk;
         mp_params.max_elems       = max_elems;
+        mp_params.numa_node       = numa_node;
         mp_params.ops             = ops;
         mp_params.name            = name;
         status  = ucs_mpool_init(&mp_params, &mpools[mps_idx]);
@@ -70,6 +70,8 @@ typedef struct ucs_mpool_set {
  * @param max_elems         Maximal number of elements which can be allocated by
  *                          every mpool in the current set. -1 or UINT_MAX means
  *                          no limit.
+ * @param numa_node         NUMA node to allocate the memory of every mpool on,
+ *                          see @ref ucs_mpool_params_t.
  * @param ops               Memory pool operations.
  * @param name              Name of this memory pool set.
  *
@@ -80,7 +82,8 @@ ucs_mpool_set_init(ucs_mpool_set_t *mp_set, size_t *sizes, unsigned sizes_count,
                    size_t max_mp_entry_size, size_t priv_size,
                    size_t priv_elem_size, size_t align_offset, size_t alignment,
                    unsigned elems_per_chunk, unsigned max_elems,
-                   ucs_mpool_ops_t *ops, const char *name);
+                   ucs_numa_node_t numa_node, ucs_mpool_ops_t *ops,
+                   const char *name);
 
 
 /**
@@ -33,6 +33,12 @@
 #define ucs_pgt_is_addr_aligned(_addr) \
     (!((_addr) & (UCS_PGT_ADDR_ALIGN - 1)))
 
+#define ucs_pgt_entries_per_dir(_pgtable) \
+    UCS_BIT((_pgtable)->entry_shift)
+
+#define ucs_pgt_entry_mask(_pgtable) \
+    (ucs_pgt_entries_per_dir(_pgtable) - 1)
+
 #define ucs_pgt_check_ptr(_ptr) \
     do { \
         ucs_assertv(!((uintptr_t)(_ptr) & (UCS_PGT_ENTRY_MIN_ALIGN - 1)), \
@@ -76,7 +82,7 @@ static inline ucs_pgt_dir_t* ucs_pgt_dir_alloc(ucs_pgtable_t *pgtable)
     }
 
     ucs_pgt_check_ptr(pgd);
-    memset(pgd, 0, sizeof(*pgd));
+    memset(pgd, 0, ucs_pgtable_dir_size(pgtable));
     return pgd;
 }
 
@@ -111,9 +117,9 @@ static void ucs_pgt_entry_dump_recurs(const ucs_pgtable_t *pgtable, unsigned ind
         ucs_log(log_level, "%*s[%3u] dir %p for [0x%lx..0x%lx], count %u shift %u mask 0x%lx",
                 indent, " ", pte_index, pgd, base, (base + (1 << shift)) & mask,
                 pgd->count, shift, mask);
-        shift -= UCS_PGT_ENTRY_SHIFT;
-        mask  |= UCS_PGT_ENTRY_MASK << shift;
-        for (i = 0; i < UCS_PGT_ENTRIES_PER_DIR; ++i) {
+        shift -= pgtable->entry_shift;
+        mask  |= ucs_pgt_entry_mask(pgtable) << shift;
+        for (i = 0; i < ucs_pgt_entries_per_dir(pgtable); ++i) {
             ucs_pgt_entry_dump_recurs(pgtable, indent + 2, &pgd->entries[i], i,
                                       base | (i << shift), mask, shift, log_level);
             ++base;
@@ -151,25 +157,25 @@ static void ucs_pgtable_reset(ucs_pgtable_t *pgtable)
 }
 
 /**
- * Make the page table map a wider range of addresses - expands by UCS_PGT_ENTRY_SHIFT.
+ * Make the page table map a wider range of addresses - expands by entry_shift.
  */
 static void ucs_pgtable_expand(ucs_pgtable_t *pgtable)
 {
     ucs_pgt_dir_t *pgd;
 
-    ucs_assertv(pgtable->shift <= (UCS_PGT_ADDR_ORDER - UCS_PGT_ENTRY_SHIFT),
+    ucs_assertv(pgtable->shift <= (UCS_PGT_ADDR_ORDER - pgtable->entry_shift),
                 "shift=%u", pgtable->shift);
 
     if (ucs_pgt_entry_present(&pgtable->root)) {
         pgd = ucs_pgt_dir_alloc(pgtable);
-        pgd->entries[(pgtable->base >> pgtable->shift) & UCS_PGT_ENTRY_MASK] =
-                        pgtable->root;
+        pgd->entries[(pgtable->base >> pgtable->shift) &
+                     ucs_pgt_entry_mask(pgtable)] = pgtable->root;
         pgd->count = 1;
         ucs_pgt_entry_set_dir(&pgtable->root, pgd);
     }
 
-    pgtable->shift += UCS_PGT_ENTRY_SHIFT;
-    pgtable->mask <<= UCS_PGT_ENTRY_SHIFT;
+    pgtable->shift += pgtable->entry_shift;
+    pgtable->mask <<= pgtable->entry_shift;
     pgtable->base  &= pgtable->mask;
     ucs_pgtable_trace(pgtable, "expand");
 }
@@ -205,30 +211,34 @@ static int ucs_pgtable_shrink(ucs_pgtable_t *pgtable)
 
     /* Search for the single PTE in dir */
     for (pte_idx = 0, pte = pgd->entries; !ucs_pgt_entry_present(pte); ++pte_idx, ++pte) {
-        ucs_assert(pte_idx < UCS_PGT_ENTRIES_PER_DIR);
+        ucs_assert(pte_idx < ucs_pgt_entries_per_dir(pgtable));
     }
 
     /* Remove one level */
-    pgtable->shift -= UCS_PGT_ENTRY_SHIFT;
+    pgtable->shift -= pgtable->entry_shift;
     pgtable->base  |= (ucs_pgt_addr_t)pte_idx << pgtable->shift;
-    pgtable->mask  |= UCS_PGT_ENTRY_MASK << pgtable->shift;
+    pgtable->mask  |= ucs_pgt_entry_mask(pgtable) << pgtable->shift;
     pgtable->root   = *pte;
     ucs_pgtable_trace(pgtable, "shrink");
     ucs_pgt_dir_release(pgtable, pgd);
     return 1;
 }
 
-static void ucs_pgtable_check_page(ucs_pgt_addr_t address, unsigned order)
+static void ucs_pgtable_check_page(const ucs_pgtable_t *pgtable,
+                                   ucs_pgt_addr_t address, unsigned order)
 {
     ucs_assert( (address & ((1ul << order) - 1)) == 0 );
-    ucs_assertv( ((order - UCS_PGT_ADDR_SHIFT) % UCS_PGT_ENTRY_SHIFT) == 0, "order=%u", order);
+    ucs_assertv( ((order - UCS_PGT_ADDR_SHIFT) % pgtable->entry_shift) == 0,
+                 "order=%u", order);
 }
 
 /**
  * @return Order of the next whole page starting in "start" and ending before "end"
  *         If both are 0, return the full word size.
  */
-static unsigned ucs_pgtable_get_next_page_order(ucs_pgt_addr_t start, ucs_pgt_addr_t end)
+static unsigned ucs_pgtable_get_next_page_order(const ucs_pgtable_t *pgtable,
+                                                ucs_pgt_addr_t start,
+                                                ucs_pgt_addr_t end)
 {
     unsigned log2_len;
 
@@ -251,9 +261,9 @@ static unsigned ucs_pgtable_get_next_page_order(ucs_pgt_addr_t start, ucs_pgt_ad
                 "log2_len=%u start=0x%lx end=0x%lx",
                 log2_len, start, end);
 
-    /* Order should be: [ADDR_SHIFT + k * ENTRY_SHIFT] */
-    return (((log2_len - UCS_PGT_ADDR_SHIFT) / UCS_PGT_ENTRY_SHIFT) * UCS_PGT_ENTRY_SHIFT)
-            + UCS_PGT_ADDR_SHIFT;
+    /* Order should be: [ADDR_SHIFT + k * entry_shift] */
+    return (((log2_len - UCS_PGT_ADDR_SHIFT) / pgtable->entry_shift) *
+            pgtable->entry_shift) + UCS_PGT_ADDR_SHIFT;
 }
 
 /**
@@ -272,7 +282,7 @@ ucs_pgtable_insert_page(ucs_pgtable_t *pgtable, ucs_pgt_addr_t address,
     ucs_pgt_dir_t *pgd;
     unsigned shift;
 
-    ucs_pgtable_check_page(address, order);
+    ucs_pgtable_check_page(pgtable, address, order);
 
     ucs_trace_func("insert page 0x%lx order %u, for region " UCS_PGT_REGION_FMT,
                    address, order, UCS_PGT_REGION_ARG(region));
@@ -308,7 +318,7 @@ ucs_pgtable_insert_page(ucs_pgtable_t *pgtable, ucs_pgt_addr_t address,
                 goto err;
             }
 
-            ucs_assertv(shift >= UCS_PGT_ENTRY_SHIFT + order,
+            ucs_assertv(shift >= pgtable->entry_shift + order,
                         "shift=%u order=%u", shift, order);  /* sub PTE should be able to hold it */
 
             if (!ucs_pgt_entry_present(pte)) {
@@ -317,8 +327,9 @@ ucs_pgtable_insert_page(ucs_pgtable_t *pgtable, ucs_pgt_addr_t address,
             }
 
             pgd    = ucs_pgt_entry_get_dir(pte);
-            shift -= UCS_PGT_ENTRY_SHIFT;
-            pte    = &pgd->entries[(address >> shift) & UCS_PGT_ENTRY_MASK];
+            shift -= pgtable->entry_shift;
+            pte    = &pgd->entries[(address >> shift) &
+                                   ucs_pgt_entry_mask(pgtable)];
         }
     }
 
@@ -354,8 +365,9 @@ ucs_pgtable_remove_page_recurs(ucs_pgtable_t *pgtable, ucs_pgt_addr_t address,
         return UCS_OK;
     } else if (ucs_pgt_entry_test(pte, UCS_PGT_ENTRY_FLAG_DIR)) {
         next_dir   = ucs_pgt_entry_get_dir(pte);
-        next_shift = shift - UCS_PGT_ENTRY_SHIFT;
-        next_pte   = &next_dir->entries[(address >> next_shift) & UCS_PGT_ENTRY_MASK];
+        next_shift = shift - pgtable->entry_shift;
+        next_pte   = &next_dir->entries[(address >> next_shift) &
+                                        ucs_pgt_entry_mask(pgtable)];
 
         status = ucs_pgtable_remove_page_recurs(pgtable, address, order, next_dir,
                                                 next_pte, next_shift, region);
@@ -382,7 +394,7 @@ ucs_pgtable_remove_page(ucs_pgtable_t *pgtable, ucs_pgt_addr_t address,
     ucs_pgt_dir_t dummy_pgd = {};
     ucs_status_t status;
 
-    ucs_pgtable_check_page(address, order);
+    ucs_pgtable_check_page(pgtable, address, order);
 
     if ((address & pgtable->mask) != pgtable->base) {
         return UCS_ERR_NO_ELEM;
@@ -416,7 +428,7 @@ ucs_status_t ucs_pgtable_insert(ucs_pgtable_t *pgtable, ucs_pgt_region_t *region
 
     ucs_assert(address != end);
     while (address < end) {
-        order = ucs_pgtable_get_next_page_order(address, end);
+        order = ucs_pgtable_get_next_page_order(pgtable, address, end);
         status = ucs_pgtable_insert_page(pgtable, address, order, region);
         if (status != UCS_OK) {
             goto err;
@@ -434,7 +446,7 @@ err:
     end     = address;
     address = region->start;
     while (address < end) {
-        order = ucs_pgtable_get_next_page_order(address, end);
+        order = ucs_pgtable_get_next_page_order(pgtable, address, end);
         ucs_pgtable_remove_page(pgtable, address, order, region);
         ucs_pgt_address_advance(&address, order);
     }
@@ -457,7 +469,7 @@ ucs_status_t ucs_pgtable_remove(ucs_pgtable_t *pgtable, ucs_pgt_region_t *region
     }
 
     while (address < end) {
-        order = ucs_pgtable_get_next_page_order(address, end);
+        order = ucs_pgtable_get_next_page_order(pgtable, address, end);
         status = ucs_pgtable_remove_page(pgtable, address, order, region);
         if (status != UCS_OK) {
             ucs_assert(address == region->start); /* Cannot be partially removed */
@@ -477,6 +489,8 @@ ucs_status_t ucs_pgtable_remove(ucs_pgtable_t *pgtable, ucs_pgt_region_t *region
 ucs_pgt_region_t *ucs_pgtable_lookup(const ucs_pgtable_t *pgtable,
                                      ucs_pgt_addr_t address)
 {
+    ucs_pgt_addr_t entry_mask = ucs_pgt_entry_mask(pgtable);
+    unsigned entry_shift      = pgtable->entry_shift;
     const ucs_pgt_entry_t *pte;
     ucs_pgt_region_t *region;
     ucs_pgt_dir_t *dir;
@@ -499,8 +513,8 @@ ucs_pgt_region_t *ucs_pgtable_lookup(const ucs_pgtable_t *pgtable,
             return region;
         } else if (ucs_pgt_entry_test(pte, UCS_PGT_ENTRY_FLAG_DIR)) {
             dir = ucs_pgt_entry_get_dir(pte);
-            shift -= UCS_PGT_ENTRY_SHIFT;
-            pte = &dir->entries[(address >> shift) & UCS_PGT_ENTRY_MASK];
+            shift -= entry_shift;
+            pte = &dir->entries[(address >> shift) & entry_mask];
         } else {
             return NULL;
         }
@@ -542,18 +556,19 @@ static void ucs_pgtable_search_recurs(const ucs_pgtable_t *pgtable,
 
     } else if (ucs_pgt_entry_test(pte, UCS_PGT_ENTRY_FLAG_DIR)) {
         dir = ucs_pgt_entry_get_dir(pte);
-        ucs_assert(shift >= UCS_PGT_ENTRY_SHIFT);
-        next_shift = shift - UCS_PGT_ENTRY_SHIFT;
+        ucs_assert(shift >= pgtable->entry_shift);
+        next_shift = shift - pgtable->entry_shift;
 
         if (order < shift) {
             /* One of the sub-ptes maps the region */
             ucs_assert(order <= next_shift);
-            next_pte = &dir->entries[(address >> next_shift) & UCS_PGT_ENTRY_MASK];
+            next_pte = &dir->entries[(address >> next_shift) &
+                                     ucs_pgt_entry_mask(pgtable)];
             ucs_pgtable_search_recurs(pgtable, address, order, next_pte,
                                       next_shift, cb, arg, last_p);
         } else {
             /* All sub-ptes contained in the region */
-            for (i = 0; i < UCS_PGT_ENTRIES_PER_DIR; ++i) {
+            for (i = 0; i < ucs_pgt_entries_per_dir(pgtable); ++i) {
                 next_pte = &dir->entries[i];
                 ucs_pgtable_search_recurs(pgtable, address, order, next_pte,
                                           next_shift, cb, arg, last_p);
@@ -582,7 +597,7 @@ void ucs_pgtable_search_range(const ucs_pgtable_t *pgtable,
 
     last = NULL;
     while (address <= to) {
-        order = ucs_pgtable_get_next_page_order(address, end);
+        order = ucs_pgtable_get_next_page_order(pgtable, address, end);
         if ((address & pgtable->mask) == pgtable->base) {
             ucs_pgtable_search_recurs(pgtable, address, order, &pgtable->root,
                                       pgtable->shift, cb, arg, &last);
@@ -655,9 +670,10 @@ out:
     ucs_assertv(pgtable->num_regions == 0, "num_regions=%u", pgtable->num_regions);
 }
 
-ucs_status_t ucs_pgtable_init(ucs_pgtable_t *pgtable,
-                              ucs_pgt_dir_alloc_callback_t alloc_cb,
-                              ucs_pgt_dir_release_callback_t release_cb)
+ucs_status_t ucs_pgtable_init_fanout(ucs_pgtable_t *pgtable,
+                                     unsigned entry_shift,
+                                     ucs_pgt_dir_alloc_callback_t alloc_cb,
+                                     ucs_pgt_dir_release_callback_t release_cb)
 {
     UCS_STATIC_ASSERT(ucs_is_pow2(UCS_PGT_ENTRY_MIN_ALIGN));
 
@@ -667,15 +683,34 @@ ucs_status_t ucs_pgtable_init(ucs_pgtable_t *pgtable,
     /* We must cover all bits of the address up to ADDR_MAX */
     UCS_STATIC_ASSERT(((ucs_ilog2(UCS_PGT_ADDR_MAX) + 1 - UCS_PGT_ADDR_SHIFT) %
                       UCS_PGT_ENTRY_SHIFT) == 0);
+    UCS_STATIC_ASSERT(((ucs_ilog2(UCS_PGT_ADDR_MAX) + 1 - UCS_PGT_ADDR_SHIFT) %
+                      UCS_PGT_ENTRY_SHIFT_WIDE) == 0);
+
+    if ((entry_shift == 0) ||
+        (((ucs_ilog2(UCS_PGT_ADDR_MAX) + 1 - UCS_PGT_ADDR_SHIFT) %
+          entry_shift) != 0)) {
+        ucs_error("unsupported page table directory size: 2^%u entries",
+                  entry_shift);
+        return UCS_ERR_INVALID_PARAM;
+    }
 
     ucs_pgt_entry_clear(&pgtable->root);
     ucs_pgtable_reset(pgtable);
+    pgtable->entry_shift    = entry_shift;
     pgtable->num_regions    = 0;
     pgtable->pgd_alloc_cb   = alloc_cb;
     pgtable->pgd_release_cb = release_cb;
     return UCS_OK;
 }
 
+ucs_status_t ucs_pgtable_init(ucs_pgtable_t *pgtable,
+                              ucs_pgt_dir_alloc_callback_t alloc_cb,
+                              ucs_pgt_dir_release_callback_t release_cb)
+{
+    return ucs_pgtable_init_fanout(pgtable, UCS_PGT_ENTRY_SHIFT, alloc_cb,
+                                   release_cb);
+}
+
 void ucs_pgtable_cleanup(ucs_pgtable_t *pgtable)
 {
     if (pgtable->num_regions != 0) {
@@ -19,6 +19,11 @@
  * UCS_PGT_PTE_FLAG_REGION bit), or another entry (indicated by UCS_PGT_PTE_FLAG_DIR),
  * or be empty - if none of these bits is set.
  *
+ * The number of entries in a directory is selected when the page table is
+ * initialized. A wider directory makes the tree shallower, so a lookup follows
+ * fewer pointers, at the cost of more memory per directory and more entries per
+ * region whose boundaries are not aligned to the directory span.
+ *
  */
 
 
@@ -29,11 +34,15 @@
 #define UCS_PGT_ADDR_ORDER          (sizeof(ucs_pgt_addr_t) * 8)
 #define UCS_PGT_ADDR_MAX           ((ucs_pgt_addr_t)-1)
 
-/* Page table entry/directory constants */
+/* Page table entry/directory constants, for the default directory size */
 #define UCS_PGT_ENTRY_SHIFT        4
 #define UCS_PGT_ENTRIES_PER_DIR    (1ul << (UCS_PGT_ENTRY_SHIFT))
 #define UCS_PGT_ENTRY_MASK         (UCS_PGT_ENTRIES_PER_DIR - 1)
 
+/* Directory size of a page table optimized for lookup speed: 64 entries, which
+ * is also a whole number of cache lines */
+#define UCS_PGT_ENTRY_SHIFT_WIDE   6
+
 /* Page table pointers constants and flags */
 #define UCS_PGT_ENTRY_FLAG_REGION  UCS_BIT(0)
 #define UCS_PGT_ENTRY_FLAG_DIR     UCS_BIT(1)
@@ -66,7 +75,8 @@ typedef struct ucs_pgt_dir         ucs_pgt_dir_t;
  * @param [in]  pgtable  Pointer to the page table to allocate the directory for.
  *
  * @return Pointer to newly allocated pgdir, or NULL if failed. The pointer must
- *         be aligned to UCS_PGT_ENTRY_ALIGN boundary.
+ *         be aligned to UCS_PGT_ENTRY_ALIGN boundary, and point to at least
+ *         @ref ucs_pgtable_dir_size bytes.
  * */
 typedef ucs_pgt_dir_t* (*ucs_pgt_dir_alloc_callback_t)(const ucs_pgtable_t *pgtable);
 
@@ -124,8 +134,8 @@ struct ucs_pgt_entry {
  * Page table directory.
  */
 struct ucs_pgt_dir {
-    ucs_pgt_entry_t                entries[UCS_PGT_ENTRIES_PER_DIR];
     unsigned                       count;       /**< Number of valid entries */
+    ucs_pgt_entry_t                entries[0];  /**< 2^entry_shift entries */
 };
 
 
@@ -139,6 +149,7 @@ struct ucs_pgtable {
     ucs_pgt_addr_t                 base;        /**< base address */
     ucs_pgt_addr_t                 mask;        /**< mask for page table address range */
     unsigned                       shift;       /**< page table address span is 2**shift */
+    unsigned                       entry_shift; /**< log2 of entries per directory */
     unsigned                       num_regions; /**< total number of regions */
     ucs_pgt_dir_alloc_callback_t   pgd_alloc_cb;
     ucs_pgt_dir_release_callback_t pgd_release_cb;
@@ -159,6 +170,26 @@ ucs_status_t ucs_pgtable_init(ucs_pgtable_t *pgtable,
                               ucs_pgt_dir_alloc_callback_t alloc_cb,
                               ucs_pgt_dir_release_callback_t release_cb);
 
+
+/**
+ * Initialize a page table with a given number of entries per directory.
+ *
+ * @param [in]  pgtable     Page table to initialize.
+ * @param [in]  entry_shift Log2 of the number of entries in a page directory,
+ *                           for example UCS_PGT_ENTRY_SHIFT or
+ *                           UCS_PGT_ENTRY_SHIFT_WIDE. The number of address
+ *                           bits above UCS_PGT_ADDR_SHIFT must be a multiple of
+ *                           it.
+ * @param [in]  alloc_cb    Callback to allocate a page directory.
+ * @param [in]  release_cb  Callback to release memory which was allocated by alloc_cb.
+ *
+ * @return UCS_OK, or UCS_ERR_INVALID_PARAM if entry_shift is not supported.
+ */
+ucs_status_t ucs_pgtable_init_fanout(ucs_pgtable_t *pgtable,
+                                     unsigned entry_shift,
+                                     ucs_pgt_dir_alloc_callback_t alloc_cb,
+                                     ucs_pgt_dir_release_callback_t release_cb);
+
 /**
  * Cleanup the page table and release all associated memory.
  *
@@ -246,6 +277,17 @@ void ucs_pgtable_purge(ucs_pgtable_t *pgtable, ucs_pgt_search_callback_t cb,
 void ucs_pgtable_dump(const ucs_pgtable_t *pgtable, ucs_log_level_t log_level);
 
 
+/**
+ * @return Size of a page directory, which should be allocated by the
+ *         directory allocation callback.
+ */
+static inline size_t ucs_pgtable_dir_size(const ucs_pgtable_t *pgtable)
+{
+    return sizeof(ucs_pgt_dir_t) +
+           (sizeof(ucs_pgt_entry_t) << pgtable->entry_shift);
+}
+
+
 /**
  * @return >Number of regions currently present in the page table.
  */
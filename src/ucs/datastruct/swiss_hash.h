@@ -0,0 +1,457 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCS_SWISS_HASH_H_
+#define UCS_SWISS_HASH_H_
+
+#include "khash.h"
+
+#include <ucs/arch/bitops.h>
+#include <ucs/arch/cpu.h>
+#include <ucs/sys/compiler_def.h>
+#include <ucs/sys/math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Open addressing hash table with the same macro interface as khash. Every
+ * bucket has a control byte, which is either empty, deleted, or holds 7 bits
+ * of the key hash. The control bytes are scanned in groups of 16 with one
+ * SIMD compare, so a lookup usually reads one group of control bytes and
+ * compares only the keys whose hash bits matched.
+ *
+ * Usage is the same as khash, with the "kh_" prefix replaced by "ucs_swiss_":
+ *
+ *   UCS_SWISS_HASH_TYPE(my_hash, uint64_t, int)   (in a header)
+ *   UCS_SWISS_HASH_IMPL(my_hash, uint64_t, int, 1, kh_int64_hash_func,
+ *                       kh_int64_hash_equal)      (in a source/inline file)
+ *
+ *   ucs_swiss_hash_t(my_hash) *h = ucs_swiss_init(my_hash);
+ *   iter = ucs_swiss_put(my_hash, h, key, &ret);
+ *   ucs_swiss_value(h, iter) = 5;
+ *   iter = ucs_swiss_get(my_hash, h, key);
+ *   if (iter != ucs_swiss_end(h)) ...
+ *
+ * As with khash, adding a key can move all the values, and the "put" return
+ * codes are the ones from ucs_kh_put_t.
+ */
+
+
+/* Number of buckets whose control bytes are scanned together */
+#define UCS_SWISS_HASH_GROUP_SIZE 16
+
+
+/* Control byte values of buckets without a key */
+#define UCS_SWISS_HASH_CTRL_EMPTY   ((int8_t)-128)
+#define UCS_SWISS_HASH_CTRL_DELETED ((int8_t)-2)
+
+
+/* Mask of the groups matching a condition, and how many bits of the mask
+   every bucket in the group takes */
+#if defined(__SSE2__)
+typedef uint32_t ucs_swiss_hash_mask_t;
+#  define UCS_SWISS_HASH_MASK_SHIFT 0
+#elif defined(__ARM_NEON)
+typedef uint64_t ucs_swiss_hash_mask_t;
+#  define UCS_SWISS_HASH_MASK_SHIFT 2
+#else
+typedef uint32_t ucs_swiss_hash_mask_t;
+#  define UCS_SWISS_HASH_MASK_SHIFT 0
+#endif
+
+
+/* Mix the bits of a hash value, since the low bits select the group and the
+   high bits are kept in the control byte */
+static UCS_F_ALWAYS_INLINE khint_t ucs_swiss_hash_mix(khint_t hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    return hash ^ (hash >> 16);
+}
+
+
+/* Buckets of the group whose control byte is 'ctrl' */
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match(const int8_t *group, int8_t ctrl)
+{
+#if defined(__SSE2__)
+    __m128i ctrls = _mm_loadu_si128((const __m128i*)group);
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrls, _mm_set1_epi8(ctrl)));
+#elif defined(__ARM_NEON)
+    uint8x16_t eq = vceqq_s8(vld1q_s8(group), vdupq_n_s8(ctrl));
+
+    /* Narrow every byte of the compare result to a nibble */
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(
+                                 vreinterpretq_u16_u8(eq), 4)), 0) &
+           0x8888888888888888ull;
+#else
+    ucs_swiss_hash_mask_t mask = 0;
+    unsigned i;
+
+    for (i = 0; i < UCS_SWISS_HASH_GROUP_SIZE; ++i) {
+        mask |= (ucs_swiss_hash_mask_t)(group[i] == ctrl) << i;
+    }
+
+    return mask;
+#endif
+}
+
+
+/* Buckets of the group which are empty or deleted */
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match_free(const int8_t *group)
+{
+#if defined(__SSE2__)
+    /* Free control bytes are the negative ones */
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#elif defined(__ARM_NEON)
+    uint8x16_t neg = vcltq_s8(vld1q_s8(group), vdupq_n_s8(0));
+
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(
+                                 vreinterpretq_u16_u8(neg), 4)), 0) &
+           0x8888888888888888ull;
+#else
+    ucs_swiss_hash_mask_t mask = 0;
+    unsigned i;
+
+    for (i = 0; i < UCS_SWISS_HASH_GROUP_SIZE; ++i) {
+        mask |= (ucs_swiss_hash_mask_t)(group[i] < 0) << i;
+    }
+
+    return mask;
+#endif
+}
+
+
+/* Index in the group of the first bucket in the mask, which must be nonzero */
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_swiss_hash_mask_first(ucs_swiss_hash_mask_t mask)
+{
+    return ucs_count_trailing_zero_bits(mask) >> UCS_SWISS_HASH_MASK_SHIFT;
+}
+
+
+/* Maximal number of keys in a table of 'n_buckets' buckets: 7/8 of them */
+static UCS_F_ALWAYS_INLINE khint_t ucs_swiss_hash_max_load(khint_t n_buckets)
+{
+    return n_buckets - (n_buckets / 8);
+}
+
+
+#define ucs_swiss_hash_mask_for_each(_index, _mask) \
+    for (; ((_mask) != 0) && \
+           ((_index) = ucs_swiss_hash_mask_first(_mask), 1); \
+         (_mask) &= (_mask) - 1)
+
+
+#define UCS_SWISS_HASH_TYPE(name, khkey_t, khval_t) \
+    typedef struct ucs_swiss_##name##_s { \
+        khint_t n_buckets, size, growth_left; \
+        int8_t  *ctrl; \
+        khkey_t *keys; \
+        khval_t *vals; \
+    } ucs_swiss_##name##_t;
+
+
+#define UCS_SWISS_HASH_IMPL(name, khkey_t, khval_t, kh_is_map, __hash_func, \
+                            __hash_equal) \
+    static UCS_F_MAYBE_UNUSED ucs_swiss_##name##_t * \
+    ucs_swiss_init_##name##_inplace(ucs_swiss_##name##_t *h) \
+    { \
+        memset(h, 0, sizeof(*h)); \
+        return h; \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED ucs_swiss_##name##_t *ucs_swiss_init_##name(void) \
+    { \
+        return (ucs_swiss_##name##_t*)calloc(1, sizeof(ucs_swiss_##name##_t)); \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED void \
+    ucs_swiss_destroy_##name##_inplace(ucs_swiss_##name##_t *h) \
+    { \
+        free(h->ctrl); \
+        free((void*)h->keys); \
+        free((void*)h->vals); \
+        memset(h, 0, sizeof(*h)); \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED void \
+    ucs_swiss_destroy_##name(ucs_swiss_##name##_t *h) \
+    { \
+        if (h != NULL) { \
+            ucs_swiss_destroy_##name##_inplace(h); \
+            free(h); \
+        } \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED void \
+    ucs_swiss_clear_##name(ucs_swiss_##name##_t *h) \
+    { \
+        if (h->ctrl != NULL) { \
+            memset(h->ctrl, UCS_SWISS_HASH_CTRL_EMPTY, h->n_buckets); \
+            h->size        = 0; \
+            h->growth_left = ucs_swiss_hash_max_load(h->n_buckets); \
+        } \
+    } \
+    \
+    static UCS_F_ALWAYS_INLINE khint_t \
+    ucs_swiss_get_##name(const ucs_swiss_##name##_t *h, khkey_t key) \
+    { \
+        khint_t hash, group_mask, group, probe, index; \
+        ucs_swiss_hash_mask_t mask; \
+        const int8_t *ctrl; \
+        \
+        if (ucs_unlikely(h->n_buckets == 0)) { \
+            return 0; \
+        } \
+        \
+        hash       = ucs_swiss_hash_mix(__hash_func(key)); \
+        group_mask = (h->n_buckets / UCS_SWISS_HASH_GROUP_SIZE) - 1; \
+        group      = (hash >> 7) & group_mask; \
+        for (probe = 1;; ++probe) { \
+            ctrl = h->ctrl + (group * UCS_SWISS_HASH_GROUP_SIZE); \
+            mask = ucs_swiss_hash_group_match(ctrl, hash & 0x7f); \
+            ucs_swiss_hash_mask_for_each(index, mask) { \
+                index += group * UCS_SWISS_HASH_GROUP_SIZE; \
+                if (ucs_likely(__hash_equal(h->keys[index], key))) { \
+                    return index; \
+                } \
+            } \
+            \
+            if (ucs_likely(ucs_swiss_hash_group_match( \
+                    ctrl, UCS_SWISS_HASH_CTRL_EMPTY) != 0)) { \
+                return h->n_buckets; \
+            } \
+            \
+            /* Triangular probing visits every group exactly once */ \
+            group = (group + probe) & group_mask; \
+        } \
+    } \
+    \
+    /* Find a free bucket for a key which does not exist in the table */ \
+    static UCS_F_MAYBE_UNUSED khint_t \
+    ucs_swiss_find_free_##name(const ucs_swiss_##name##_t *h, khint_t hash) \
+    { \
+        khint_t group_mask = (h->n_buckets / UCS_SWISS_HASH_GROUP_SIZE) - 1; \
+        khint_t group      = (hash >> 7) & group_mask; \
+        ucs_swiss_hash_mask_t mask; \
+        khint_t probe; \
+        \
+        for (probe = 1;; ++probe) { \
+            mask = ucs_swiss_hash_group_match_free( \
+                    h->ctrl + (group * UCS_SWISS_HASH_GROUP_SIZE)); \
+            if (mask != 0) { \
+                return (group * UCS_SWISS_HASH_GROUP_SIZE) + \
+                       ucs_swiss_hash_mask_first(mask); \
+            } \
+            group = (group + probe) & group_mask; \
+        } \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED int \
+    ucs_swiss_resize_##name(ucs_swiss_##name##_t *h, khint_t new_n_buckets) \
+    { \
+        ucs_swiss_##name##_t new_h; \
+        khint_t i, index, hash; \
+        \
+        new_n_buckets = ucs_max(new_n_buckets, UCS_SWISS_HASH_GROUP_SIZE); \
+        kroundup32(new_n_buckets); \
+        if (ucs_swiss_hash_max_load(new_n_buckets) <= h->size) { \
+            return 0; /* Requested size is too small */ \
+        } \
+        \
+        new_h.n_buckets   = new_n_buckets; \
+        new_h.size        = h->size; \
+        new_h.growth_left = ucs_swiss_hash_max_load(new_n_buckets) - h->size; \
+        new_h.ctrl        = (int8_t*)malloc(new_n_buckets); \
+        new_h.keys        = (khkey_t*)malloc(new_n_buckets * sizeof(khkey_t)); \
+        new_h.vals        = kh_is_map ? \
+                            (khval_t*)malloc(new_n_buckets * sizeof(khval_t)) : \
+                            NULL; \
+        if ((new_h.ctrl == NULL) || (new_h.keys == NULL) || \
+            (kh_is_map && (new_h.vals == NULL))) { \
+            free(new_h.ctrl); \
+            free((void*)new_h.keys); \
+            free((void*)new_h.vals); \
+            return -1; \
+        } \
+        \
+        memset(new_h.ctrl, UCS_SWISS_HASH_CTRL_EMPTY, new_n_buckets); \
+        for (i = 0; i < h->n_buckets; ++i) { \
+            if (h->ctrl[i] < 0) { \
+                continue; \
+            } \
+            \
+            hash              = ucs_swiss_hash_mix(__hash_func(h->keys[i])); \
+            index             = ucs_swiss_find_free_##name(&new_h, hash); \
+            new_h.ctrl[index] = hash & 0x7f; \
+            new_h.keys[index] = h->keys[i]; \
+            if (kh_is_map) { \
+                new_h.vals[index] = h->vals[i]; \
+            } \
+        } \
+        \
+        free(h->ctrl); \
+        free((void*)h->keys); \
+        free((void*)h->vals); \
+        *h = new_h; \
+        return 0; \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED khint_t \
+    ucs_swiss_put_##name(ucs_swiss_##name##_t *h, khkey_t key, int *ret) \
+    { \
+        khint_t hash, index, n_buckets; \
+        \
+        index = ucs_swiss_get_##name(h, key); \
+        if (index != h->n_buckets) { \
+            *ret = UCS_KH_PUT_KEY_PRESENT; \
+            return index; \
+        } \
+        \
+        if (h->growth_left == 0) { \
+            /* Grow, or only drop the deleted buckets if there are many */ \
+            n_buckets = h->n_buckets; \
+            if ((n_buckets == 0) || (h->size > (n_buckets * 7 / 16))) { \
+                n_buckets *= 2; \
+            } \
+            if (ucs_swiss_resize_##name(h, n_buckets) < 0) { \
+                *ret = UCS_KH_PUT_FAILED; \
+                return h->n_buckets; \
+            } \
+        } \
+        \
+        hash  = ucs_swiss_hash_mix(__hash_func(key)); \
+        index = ucs_swiss_find_free_##name(h, hash); \
+        if (h->ctrl[index] == UCS_SWISS_HASH_CTRL_EMPTY) { \
+            --h->growth_left; \
+            *ret = UCS_KH_PUT_BUCKET_EMPTY; \
+        } else { \
+            *ret = UCS_KH_PUT_BUCKET_CLEAR; \
+        } \
+        \
+        h->ctrl[index] = hash & 0x7f; \
+        h->keys[index] = key; \
+        ++h->size; \
+        return index; \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED void \
+    ucs_swiss_del_##name(ucs_swiss_##name##_t *h, khint_t x) \
+    { \
+        const int8_t *group; \
+        \
+        if ((x == h->n_buckets) || (h->ctrl[x] < 0)) { \
+            return; \
+        } \
+        \
+        /* A group with an empty bucket ends every probe which reaches it, \
+           so the bucket can become empty and not only deleted */ \
+        group = h->ctrl + (x & ~(UCS_SWISS_HASH_GROUP_SIZE - 1)); \
+        if (ucs_swiss_hash_group_match(group, UCS_SWISS_HASH_CTRL_EMPTY) != \
+            0) { \
+            h->ctrl[x] = UCS_SWISS_HASH_CTRL_EMPTY; \
+            ++h->growth_left; \
+        } else { \
+            h->ctrl[x] = UCS_SWISS_HASH_CTRL_DELETED; \
+        } \
+        --h->size; \
+    }
+
+
+/* Type of the hash table */
+#define ucs_swiss_hash_t(name) ucs_swiss_##name##_t
+
+
+/* Initialize a hash table, the same as kh_init/kh_init_inplace */
+#define ucs_swiss_init(name)            ucs_swiss_init_##name()
+#define ucs_swiss_init_inplace(name, h) ucs_swiss_init_##name##_inplace(h)
+
+
+/* Release a hash table, the same as kh_destroy/kh_destroy_inplace */
+#define ucs_swiss_destroy(name, h)         ucs_swiss_destroy_##name(h)
+#define ucs_swiss_destroy_inplace(name, h) ucs_swiss_destroy_##name##_inplace(h)
+
+
+/* Remove all the keys, the same as kh_clear */
+#define ucs_swiss_clear(name, h) ucs_swiss_clear_##name(h)
+
+
+/* Resize the table to hold at least 's' buckets, the same as kh_resize */
+#define ucs_swiss_resize(name, h, s) ucs_swiss_resize_##name(h, s)
+
+
+/* Add a key, the same as kh_put */
+#define ucs_swiss_put(name, h, k, r) ucs_swiss_put_##name(h, k, r)
+
+
+/* Find a key, the same as kh_get */
+#define ucs_swiss_get(name, h, k) ucs_swiss_get_##name(h, k)
+
+
+/* Remove the key of an iterator, the same as kh_del */
+#define ucs_swiss_del(name, h, x) ucs_swiss_del_##name(h, x)
+
+
+/* Access the buckets, the same as the respective kh_ macros */
+#define ucs_swiss_exist(h, x)     ((h)->ctrl[x] >= 0)
+#define ucs_swiss_key(h, x)       ((h)->keys[x])
+#define ucs_swiss_val(h, x)       ((h)->vals[x])
+#define ucs_swiss_value(h, x)     ((h)->vals[x])
+#define ucs_swiss_begin(h)        (khint_t)(0)
+#define ucs_swiss_end(h)          ((h)->n_buckets)
+#define ucs_swiss_size(h)         ((h)->size)
+#define ucs_swiss_n_buckets(h)    ((h)->n_buckets)
+
+
+/* Iterate over the entries, the same as kh_foreach */
+#define ucs_swiss_foreach(h, kvar, vvar, code) \
+    { \
+        khint_t __i; \
+        for (__i = ucs_swiss_begin(h); __i != ucs_swiss_end(h); ++__i) { \
+            if (!ucs_swiss_exist(h, __i)) { \
+                continue; \
+            } \
+            (kvar) = ucs_swiss_key(h, __i); \
+            (vvar) = ucs_swiss_val(h, __i); \
+            code; \
+        } \
+    }
+
+
+/* Iterate over the values, the same as kh_foreach_value */
+#define ucs_swiss_foreach_value(h, vvar, code) \
+    { \
+        khint_t __i; \
+        for (__i = ucs_swiss_begin(h); __i != ucs_swiss_end(h); ++__i) { \
+            if (!ucs_swiss_exist(h, __i)) { \
+                continue; \
+            } \
+            (vvar) = ucs_swiss_val(h, __i); \
+            code; \
+        } \
+    }
+
+
+/* Iterate over the keys, the same as kh_foreach_key */
+#define ucs_swiss_foreach_key(h, kvar, code) \
+    { \
+        khint_t __i; \
+        for (__i = ucs_swiss_begin(h); __i != ucs_swiss_end(h); ++__i) { \
+            if (!ucs_swiss_exist(h, __i)) { \
+                continue; \
+            } \
+            (kvar) = ucs_swiss_key(h, __i); \
+            code; \
+        } \
+    }
+
+#endif
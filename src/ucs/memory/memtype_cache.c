@@ -107,7 +107,8 @@ static ucs_pgt_dir_t *ucs_memtype_cache_pgt_dir_alloc(const ucs_pgtable_t *pgtab
 
     ret = ucs_posix_memalign(&ptr,
                              ucs_max(sizeof(void *), UCS_PGT_ENTRY_MIN_ALIGN),
-                             sizeof(ucs_pgt_dir_t), "memtype_cache_pgdir");
+                             ucs_pgtable_dir_size(pgtable),
+                             "memtype_cache_pgdir");
     return (ret == 0) ? ptr : NULL;
 }
 
@@ -382,8 +383,9 @@ static UCS_CLASS_INIT_FUNC(ucs_memtype_cache_t)
         goto err;
     }
 
-    status = ucs_pgtable_init(&self->pgtable, ucs_memtype_cache_pgt_dir_alloc,
-                              ucs_memtype_cache_pgt_dir_release);
+    status = ucs_pgtable_init_fanout(&self->pgtable, UCS_PGT_ENTRY_SHIFT_WIDE,
+                                     ucs_memtype_cache_pgt_dir_alloc,
+                                     ucs_memtype_cache_pgt_dir_release);
     if (status != UCS_OK) {
         goto err_destroy_rwlock;
     }
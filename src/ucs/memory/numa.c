@@ -19,12 +19,15 @@
 #include <stdint.h>
 #include <sched.h>
 #include <dirent.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #define UCS_NUMA_MIN_DISTANCE       10
 #define UCS_NUMA_NODE_MAX           INT16_MAX
 #define UCS_NUMA_CORE_DIR_PATH      UCS_SYS_FS_CPUS_PATH "/cpu%d"
 #define UCS_NUMA_NODES_DIR_PATH     UCS_SYS_FS_SYSTEM_PATH "/node"
 #define UCS_NUMA_NODE_DISTANCE_PATH UCS_NUMA_NODES_DIR_PATH "/node%d/distance"
+#define UCS_NUMA_MPOL_PREFERRED     1 /* MPOL_PREFERRED from linux/mempolicy.h */
 
 
 KHASH_MAP_INIT_INT(numa_distance, ucs_numa_distance_t);
@@ -151,6 +154,39 @@ ucs_numa_node_t ucs_numa_node_of_cpu(int cpu)
     return cpu_numa_node[cpu] - 1;
 }
 
+ucs_numa_node_t ucs_numa_node_of_current_cpu()
+{
+    int cpu = sched_getcpu();
+
+    if ((cpu < 0) || (cpu >= __CPU_SETSIZE)) {
+        return UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    return ucs_numa_node_of_cpu(cpu);
+}
+
+ucs_numa_node_t ucs_numa_node_of_cpu_set(const ucs_cpu_set_t *cpu_mask)
+{
+    ucs_numa_node_t node = UCS_NUMA_NODE_UNDEFINED;
+    ucs_numa_node_t cpu_node;
+    int cpu;
+
+    for (cpu = 0; cpu < ucs_min(UCS_CPU_SETSIZE, __CPU_SETSIZE); ++cpu) {
+        if (!ucs_cpu_is_set(cpu, cpu_mask)) {
+            continue;
+        }
+
+        cpu_node = ucs_numa_node_of_cpu(cpu);
+        if (node == UCS_NUMA_NODE_UNDEFINED) {
+            node = cpu_node;
+        } else if (node != cpu_node) {
+            return UCS_NUMA_NODE_UNDEFINED;
+        }
+    }
+
+    return node;
+}
+
 ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path)
 {
     long parsed_node;
@@ -253,6 +289,47 @@ ucs_numa_distance(ucs_numa_node_t node1, ucs_numa_node_t node2)
     return distance;
 }
 
+ucs_status_t ucs_numa_mempolicy_prefer(ucs_numa_node_t node,
+                                       ucs_numa_mempolicy_t *prev)
+{
+#if defined(SYS_get_mempolicy) && defined(SYS_set_mempolicy)
+    const unsigned long bits    = 8 * sizeof(prev->nodemask[0]);
+    ucs_numa_mempolicy_t policy = {};
+
+    if ((node < 0) || (node >= UCS_NUMA_MEMPOLICY_MAX_NODES)) {
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (syscall(SYS_get_mempolicy, &prev->mode, prev->nodemask,
+                UCS_NUMA_MEMPOLICY_MAX_NODES, NULL, 0) != 0) {
+        ucs_trace("get_mempolicy() failed: %m");
+        return UCS_ERR_IO_ERROR;
+    }
+
+    /* The kernel ignores the last bit of the node mask */
+    policy.nodemask[node / bits] = UCS_BIT(node % bits);
+    if (syscall(SYS_set_mempolicy, UCS_NUMA_MPOL_PREFERRED, policy.nodemask,
+                UCS_NUMA_MEMPOLICY_MAX_NODES + 1) != 0) {
+        ucs_trace("set_mempolicy(node=%d) failed: %m", node);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    return UCS_OK;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
+void ucs_numa_mempolicy_restore(const ucs_numa_mempolicy_t *prev)
+{
+#ifdef SYS_set_mempolicy
+    if (syscall(SYS_set_mempolicy, prev->mode, prev->nodemask,
+                UCS_NUMA_MEMPOLICY_MAX_NODES + 1) != 0) {
+        ucs_trace("failed to restore memory policy %d: %m", prev->mode);
+    }
+#endif
+}
+
 void ucs_numa_init()
 {
     ucs_spinlock_init(&ucs_numa_global_ctx.lock, 0);
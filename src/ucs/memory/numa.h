@@ -8,12 +8,18 @@
 #define UCS_NUMA_H_
 
 #include <ucs/sys/compiler_def.h>
+#include <ucs/type/cpu_set.h>
+#include <ucs/type/status.h>
 #include <stdint.h>
 
 BEGIN_C_DECLS
 
 #define UCS_NUMA_NODE_DEFAULT    0
 #define UCS_NUMA_NODE_UNDEFINED -1
+#define UCS_NUMA_NODE_CURRENT   -2 /* Node of the calling thread */
+
+/* Maximal number of nodes in a saved memory policy */
+#define UCS_NUMA_MEMPOLICY_MAX_NODES 1024
 
 typedef int ucs_numa_distance_t;
 
@@ -21,6 +27,14 @@ typedef int ucs_numa_distance_t;
 typedef int16_t ucs_numa_node_t;
 
 
+/* Memory allocation policy of a thread */
+typedef struct {
+    int           mode;
+    unsigned long nodemask[UCS_NUMA_MEMPOLICY_MAX_NODES /
+                           (8 * sizeof(unsigned long))];
+} ucs_numa_mempolicy_t;
+
+
 extern const char *ucs_numa_policy_names[];
 
 
@@ -50,6 +64,21 @@ unsigned ucs_numa_num_configured_nodes(void);
 ucs_numa_node_t ucs_numa_node_of_cpu(int cpu);
 
 
+/**
+ * @return The NUMA node of the CPU the calling thread is running on.
+ */
+ucs_numa_node_t ucs_numa_node_of_current_cpu(void);
+
+
+/**
+ * @param [in]  cpu_mask Set of CPUs to query.
+ *
+ * @return The NUMA node all CPUs in the set belong to, or
+ *         UCS_NUMA_NODE_UNDEFINED if the set is empty or spans several nodes.
+ */
+ucs_numa_node_t ucs_numa_node_of_cpu_set(const ucs_cpu_set_t *cpu_mask);
+
+
 /**
  * @param [in]  dev_path sysfs path of the device.
  *
@@ -69,6 +98,30 @@ ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path);
 ucs_numa_distance_t
 ucs_numa_distance(ucs_numa_node_t node1, ucs_numa_node_t node2);
 
+
+/**
+ * Make the memory first touched by the calling thread to be allocated on a
+ * given node when possible, and save the previous memory policy of the thread.
+ *
+ * @param [in]  node   NUMA node to allocate memory on.
+ * @param [out] prev   Filled with the previous memory policy, which should be
+ *                     restored with @ref ucs_numa_mempolicy_restore.
+ *
+ * @return UCS_OK, or an error if the memory policy could not be changed. In
+ *         this case, the policy of the thread remains unchanged.
+ */
+ucs_status_t ucs_numa_mempolicy_prefer(ucs_numa_node_t node,
+                                       ucs_numa_mempolicy_t *prev);
+
+
+/**
+ * Restore a memory policy of the calling thread saved by
+ * @ref ucs_numa_mempolicy_prefer.
+ *
+ * @param [in]  prev   Memory policy to restore.
+ */
+void ucs_numa_mempolicy_restore(const ucs_numa_mempolicy_t *prev);
+
 END_C_DECLS
 
 #endif
@@ -92,6 +92,7 @@ static ucs_stats_class_t ucs_rcache_stats_class = {
         [UCS_RCACHE_PUTS]               = "puts",
         [UCS_RCACHE_REGS]               = "mem_regs",
         [UCS_RCACHE_DEREGS]             = "mem_deregs",
+        [UCS_RCACHE_HITS_TCACHE]        = "hits_tcache",
     }
 };
 #endif
@@ -122,6 +123,19 @@ ucs_config_field_t ucs_config_rcache_table[] = {
      "Purge registration cache upon fork",
      ucs_offsetof(ucs_rcache_config_t, purge_on_fork), UCS_CONFIG_TYPE_BOOL},
 
+    {"RCACHE_NUM_SHARDS", "1",
+     "Number of shards to split the registration cache into. Each shard has its\n"
+     "own page table and locks, and caches the regions of a part of the address\n"
+     "space, so threads registering distinct buffers contend less. Regions\n"
+     "crossing a shard address block boundary are kept in an additional shard.",
+     ucs_offsetof(ucs_rcache_config_t, num_shards), UCS_CONFIG_TYPE_UINT},
+
+    {"RCACHE_THREAD_CACHE", "n",
+     "Keep a small per-thread cache of recently hit regions, which allows\n"
+     "repeated lookups of the same buffers to skip the page table lookup and\n"
+     "the page table lock.",
+     ucs_offsetof(ucs_rcache_config_t, thread_cache), UCS_CONFIG_TYPE_BOOL},
+
     {NULL}
 };
 
@@ -188,6 +202,7 @@ void ucs_rcache_set_default_params(ucs_rcache_params_t *rcache_params)
     rcache_params->max_regions        = UCS_MEMUNITS_INF;
     rcache_params->max_size           = UCS_MEMUNITS_INF;
     rcache_params->max_unreleased     = UCS_MEMUNITS_INF;
+    rcache_params->num_shards         = 1;
 }
 
 void ucs_rcache_set_params(ucs_rcache_params_t *rcache_params,
@@ -199,8 +214,11 @@ void ucs_rcache_set_params(ucs_rcache_params_t *rcache_params,
     rcache_params->max_regions        = rcache_config->max_regions;
     rcache_params->max_size           = rcache_config->max_size;
     rcache_params->max_unreleased     = rcache_config->max_unreleased;
-    rcache_params->flags              = !rcache_config->purge_on_fork ? 0 :
-                                        UCS_RCACHE_FLAG_PURGE_ON_FORK;
+    rcache_params->num_shards         = rcache_config->num_shards;
+    rcache_params->flags              = (!rcache_config->purge_on_fork ? 0 :
+                                         UCS_RCACHE_FLAG_PURGE_ON_FORK) |
+                                        (!rcache_config->thread_cache ? 0 :
+                                         UCS_RCACHE_FLAG_THREAD_CACHE);
 }
 
 static size_t ucs_rcache_stat_max_pow2()
@@ -215,12 +233,13 @@ static int ucs_rcache_stat_min_lz()
 
 static ucs_pgt_dir_t *ucs_rcache_pgt_dir_alloc(const ucs_pgtable_t *pgtable)
 {
-    ucs_rcache_t *rcache = ucs_container_of(pgtable, ucs_rcache_t, pgtable);
+    ucs_rcache_shard_t *shard = ucs_container_of(pgtable, ucs_rcache_shard_t,
+                                                 pgtable);
     ucs_pgt_dir_t *dir;
 
-    ucs_spin_lock(&rcache->lock);
-    dir = ucs_mpool_get(&rcache->mp);
-    ucs_spin_unlock(&rcache->lock);
+    ucs_spin_lock(&shard->lock);
+    dir = ucs_mpool_get(&shard->mp);
+    ucs_spin_unlock(&shard->lock);
 
     return dir;
 }
@@ -228,11 +247,12 @@ static ucs_pgt_dir_t *ucs_rcache_pgt_dir_alloc(const ucs_pgtable_t *pgtable)
 static void ucs_rcache_pgt_dir_release(const ucs_pgtable_t *pgtable,
                                        ucs_pgt_dir_t *dir)
 {
-    ucs_rcache_t *rcache = ucs_container_of(pgtable, ucs_rcache_t, pgtable);
+    ucs_rcache_shard_t *shard = ucs_container_of(pgtable, ucs_rcache_shard_t,
+                                                 pgtable);
 
-    ucs_spin_lock(&rcache->lock);
+    ucs_spin_lock(&shard->lock);
     ucs_mpool_put(dir);
-    ucs_spin_unlock(&rcache->lock);
+    ucs_spin_unlock(&shard->lock);
 }
 
 static ucs_status_t ucs_rcache_mp_chunk_alloc(ucs_mpool_t *mp, size_t *size_p,
@@ -363,11 +383,13 @@ static void ucs_rcache_region_collect_callback(const ucs_pgtable_t *pgtable,
 }
 
 /* Lock must be held */
-static void ucs_rcache_find_regions(ucs_rcache_t *rcache, ucs_pgt_addr_t from,
-                                    ucs_pgt_addr_t to, ucs_list_link_t *list)
+static void ucs_rcache_find_regions(ucs_rcache_t *rcache,
+                                    ucs_rcache_shard_t *shard,
+                                    ucs_pgt_addr_t from, ucs_pgt_addr_t to,
+                                    ucs_list_link_t *list)
 {
     ucs_trace("%s: find regions in 0x%lx..0x%lx", rcache->name, from, to);
-    ucs_pgtable_search_range(&rcache->pgtable, from, to,
+    ucs_pgtable_search_range(&shard->pgtable, from, to,
                              ucs_rcache_region_collect_callback, list);
 }
 
@@ -383,12 +405,165 @@ ucs_rcache_region_lru_get(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
 static void
 ucs_rcache_region_lru_put(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
 {
-    /* When we finish using a region, it's a candidate for LRU eviction */
+    /* When we finish using a region, it's a candidate for LRU eviction. A
+     * region found in a thread cache is not removed from the LRU list while in
+     * use, so move it to the tail as the most recently used one.
+     */
     ucs_spin_lock(&rcache->lru.lock);
+    ucs_rcache_region_lru_remove(rcache, region);
     ucs_rcache_region_lru_add(rcache, region);
     ucs_spin_unlock(&rcache->lru.lock);
 }
 
+static UCS_F_ALWAYS_INLINE void ucs_rcache_gen_bump(ucs_rcache_t *rcache)
+{
+    ucs_atomic_add64(&rcache->gen, 1);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_rcache_tcache_entry_t *
+ucs_rcache_tcache_entry(ucs_rcache_thread_cache_t *tc, ucs_pgt_addr_t address)
+{
+    uint64_t page = address >> UCS_PGT_ADDR_SHIFT;
+
+    return &tc->entries[(page ^ (page >> 8)) & (UCS_RCACHE_TCACHE_SIZE - 1)];
+}
+
+static void ucs_rcache_thread_cache_release(void *arg)
+{
+    ucs_rcache_thread_cache_t *tc = arg;
+    ucs_rcache_t *rcache          = tc->rcache;
+
+    ucs_spin_lock(&rcache->tcache.lock);
+    rcache->tcache.lookups += tc->lookups;
+    rcache->tcache.hits    += tc->hits;
+    ucs_list_del(&tc->list);
+    ucs_spin_unlock(&rcache->tcache.lock);
+
+    ucs_spinlock_destroy(&tc->lock);
+    ucs_free(tc);
+}
+
+static ucs_rcache_thread_cache_t *
+ucs_rcache_thread_cache_create(ucs_rcache_t *rcache)
+{
+    ucs_rcache_thread_cache_t *tc;
+    ucs_status_t status;
+
+    tc = ucs_calloc(1, sizeof(*tc), "rcache_thread_cache");
+    if (tc == NULL) {
+        ucs_error("%s: failed to allocate thread cache", rcache->name);
+        return NULL;
+    }
+
+    status = ucs_spinlock_init(&tc->lock, 0);
+    if (status != UCS_OK) {
+        ucs_free(tc);
+        return NULL;
+    }
+
+    tc->rcache = rcache;
+
+    ucs_spin_lock(&rcache->tcache.lock);
+    ucs_list_add_tail(&rcache->tcache.threads, &tc->list);
+    ucs_spin_unlock(&rcache->tcache.lock);
+
+    pthread_setspecific(rcache->tcache.key, tc);
+    return tc;
+}
+
+/*
+ * Look up the calling thread's cache. The entry is valid if no region was
+ * invalidated since it was filled, and the region is kept alive while the
+ * thread cache lock is held, since destroying a region drops it from all
+ * thread caches first. The region could still be released concurrently, so
+ * take a reference only if it was not dropped to zero.
+ */
+static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
+ucs_rcache_tcache_lookup(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                         size_t length, size_t alignment, int prot)
+{
+    ucs_rcache_thread_cache_t *tc = pthread_getspecific(rcache->tcache.key);
+    ucs_rcache_tcache_entry_t *entry;
+    ucs_rcache_region_t *region;
+    uint32_t refcount;
+
+    if (ucs_unlikely(tc == NULL)) {
+        return NULL;
+    }
+
+    ++tc->lookups;
+    entry = ucs_rcache_tcache_entry(tc, start);
+
+    ucs_spin_lock(&tc->lock);
+    region = entry->region;
+    if ((region == NULL) || (entry->gen != rcache->gen) ||
+        (start < region->super.start) ||
+        ((start + length) > region->super.end) ||
+        !ucs_rcache_region_test(region, prot, alignment)) {
+        goto out_miss;
+    }
+
+    do {
+        refcount = region->refcount;
+        if (refcount == 0) {
+            goto out_miss;
+        }
+    } while (ucs_atomic_cswap32(&region->refcount, refcount, refcount + 1) !=
+             refcount);
+
+    ucs_spin_unlock(&tc->lock);
+
+    ++tc->hits;
+    ucs_rcache_region_trace(rcache, region, "thread cache hit");
+    return region;
+
+out_miss:
+    ucs_spin_unlock(&tc->lock);
+    return NULL;
+}
+
+/* Remember a region which was found in the page table at generation 'gen' */
+static void ucs_rcache_tcache_fill(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                                   ucs_rcache_region_t *region, uint64_t gen)
+{
+    ucs_rcache_thread_cache_t *tc = pthread_getspecific(rcache->tcache.key);
+    ucs_rcache_tcache_entry_t *entry;
+
+    if (ucs_unlikely(tc == NULL)) {
+        tc = ucs_rcache_thread_cache_create(rcache);
+        if (tc == NULL) {
+            return;
+        }
+    }
+
+    entry = ucs_rcache_tcache_entry(tc, start);
+
+    ucs_spin_lock(&tc->lock);
+    entry->region = region;
+    entry->gen    = gen;
+    ucs_spin_unlock(&tc->lock);
+}
+
+/* Drop a region which is about to be released from all thread caches */
+static void
+ucs_rcache_tcache_forget(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
+{
+    ucs_rcache_thread_cache_t *tc;
+    unsigned i;
+
+    ucs_spin_lock(&rcache->tcache.lock);
+    ucs_list_for_each(tc, &rcache->tcache.threads, list) {
+        ucs_spin_lock(&tc->lock);
+        for (i = 0; i < UCS_RCACHE_TCACHE_SIZE; ++i) {
+            if (tc->entries[i].region == region) {
+                tc->entries[i].region = NULL;
+            }
+        }
+        ucs_spin_unlock(&tc->lock);
+    }
+    ucs_spin_unlock(&rcache->tcache.lock);
+}
+
 static ucs_rcache_distribution_t *
 ucs_rcache_distribution_get_bin(ucs_rcache_t *rcache, size_t region_size)
 {
@@ -411,6 +586,7 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
                                      ucs_rcache_region_t *region,
                                      int drop_lock)
 {
+    ucs_rcache_shard_t *shard = ucs_rcache_region_shard(rcache, region);
     ucs_rcache_comp_entry_t *comp;
     size_t region_size;
     ucs_rcache_distribution_t *distribution_bin;
@@ -425,7 +601,7 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
         UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_DEREGS, 1);
 
         if (drop_lock) {
-            ucs_rw_spinlock_write_unlock(&rcache->pgt_lock);
+            ucs_rw_spinlock_write_unlock(&shard->pgt_lock);
         }
 
         UCS_PROFILE_NAMED_CALL_VOID_ALWAYS("mem_dereg",
@@ -434,7 +610,7 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
                                            region);
 
         if (drop_lock) {
-            ucs_rw_spinlock_write_lock(&rcache->pgt_lock);
+            ucs_rw_spinlock_write_lock(&shard->pgt_lock);
         }
     }
 
@@ -443,25 +619,28 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
         ucs_free(ucs_rcache_region_pfn_ptr(region));
     }
 
+    if (rcache->params.flags & UCS_RCACHE_FLAG_THREAD_CACHE) {
+        ucs_rcache_tcache_forget(rcache, region);
+    }
+
+    region_size      = region->super.end - region->super.start;
+    distribution_bin = ucs_rcache_distribution_get_bin(rcache, region_size);
+
     ucs_spin_lock(&rcache->lru.lock);
     ucs_rcache_region_lru_remove(rcache, region);
-    ucs_spin_unlock(&rcache->lru.lock);
-
     --rcache->num_regions;
-    region_size         = region->super.end - region->super.start;
     rcache->total_size -= region_size;
-
-    distribution_bin = ucs_rcache_distribution_get_bin(rcache, region_size);
     --distribution_bin->count;
     distribution_bin->total_size -= region_size;
+    ucs_spin_unlock(&rcache->lru.lock);
 
     while (!ucs_list_is_empty(&region->comp_list)) {
         comp = ucs_list_extract_head(&region->comp_list,
                                      ucs_rcache_comp_entry_t, list);
         comp->func(comp->arg);
-        ucs_spin_lock(&rcache->lock);
+        ucs_spin_lock(&shard->lock);
         ucs_mpool_put(comp);
-        ucs_spin_unlock(&rcache->lock);
+        ucs_spin_unlock(&shard->lock);
     }
 
     ucs_free(region);
@@ -472,6 +651,8 @@ static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
                                                   ucs_rcache_region_t *region,
                                                   unsigned flags)
 {
+    ucs_rcache_shard_t *shard;
+
     ucs_rcache_region_trace(rcache, region, "put region, flags 0x%x", flags);
 
     ucs_assert(region->refcount > 0);
@@ -480,28 +661,29 @@ static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
         return;
     }
 
+    shard = ucs_rcache_region_shard(rcache, region);
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC) {
         /* Put the region on garbage collection list */
         ucs_assert(!(flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK));
-        ucs_spin_lock(&rcache->lock);
+        ucs_spin_lock(&shard->lock);
         ucs_rcache_region_trace(rcache, region, "put on GC list, flags 0x%x",
                                 flags);
-        rcache->unreleased_size += (region->super.end - region->super.start);
-        ucs_list_add_tail(&rcache->gc_list, &region->tmp_list);
-        ucs_spin_unlock(&rcache->lock);
+        shard->unreleased_size += (region->super.end - region->super.start);
+        ucs_list_add_tail(&shard->gc_list, &region->tmp_list);
+        ucs_spin_unlock(&shard->lock);
         return;
     }
 
     /* Destroy region and de-register memory */
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK) {
-        ucs_rw_spinlock_write_lock(&rcache->pgt_lock);
+        ucs_rw_spinlock_write_lock(&shard->pgt_lock);
     }
 
     ucs_mem_region_destroy_internal(rcache, region,
                                     flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK);
 
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK) {
-        ucs_rw_spinlock_write_unlock(&rcache->pgt_lock);
+        ucs_rw_spinlock_write_unlock(&shard->pgt_lock);
     }
 }
 
@@ -518,12 +700,14 @@ static void ucs_rcache_region_invalidate_internal(ucs_rcache_t *rcache,
 
     /* Remove the memory region from page table, if it's there */
     if (region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE) {
-        status = ucs_pgtable_remove(&rcache->pgtable, &region->super);
+        status = ucs_pgtable_remove(&ucs_rcache_region_shard(rcache, region)->pgtable,
+                                    &region->super);
         if (status != UCS_OK) {
             ucs_rcache_region_warn(rcache, region, "failed to remove (%s)",
                                    ucs_status_string(status));
         }
         region->flags &= ~UCS_RCACHE_REGION_FLAG_PGTABLE;
+        ucs_rcache_gen_bump(rcache);
         /* coverity[double_unlock] */
         /* coverity[double_lock] */
         ucs_rcache_region_put_internal(rcache, region, flags);
@@ -533,8 +717,10 @@ static void ucs_rcache_region_invalidate_internal(ucs_rcache_t *rcache,
 }
 
 /* Lock must be held in write mode */
-static void ucs_rcache_invalidate_range(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
-                                        ucs_pgt_addr_t end, unsigned flags)
+static void ucs_rcache_invalidate_range(ucs_rcache_t *rcache,
+                                        ucs_rcache_shard_t *shard,
+                                        ucs_pgt_addr_t start, ucs_pgt_addr_t end,
+                                        unsigned flags)
 {
     ucs_rcache_region_t *region, *tmp;
     ucs_list_link_t region_list;
@@ -542,7 +728,7 @@ static void ucs_rcache_invalidate_range(ucs_rcache_t *rcache, ucs_pgt_addr_t sta
     ucs_trace_func("rcache=%s, start=0x%lx, end=0x%lx", rcache->name, start, end);
 
     ucs_list_head_init(&region_list);
-    ucs_rcache_find_regions(rcache, start, end - 1, &region_list);
+    ucs_rcache_find_regions(rcache, shard, start, end - 1, &region_list);
     ucs_list_for_each_safe(region, tmp, &region_list, tmp_list) {
         /* all regions on the list are in the page table */
         /* coverity[double_unlock] */
@@ -553,80 +739,157 @@ static void ucs_rcache_invalidate_range(ucs_rcache_t *rcache, ucs_pgt_addr_t sta
     }
 }
 
-static void ucs_rcache_remove_from_unreleased(ucs_rcache_t *rcache,
+static void ucs_rcache_remove_from_unreleased(ucs_rcache_shard_t *shard,
                                               ucs_pgt_addr_t entry_start,
                                               ucs_pgt_addr_t entry_end)
 {
     size_t entry_size = entry_end - entry_start;
-    ucs_assert(rcache->unreleased_size >= entry_size);
-    rcache->unreleased_size -= entry_size;
+    ucs_assert(shard->unreleased_size >= entry_size);
+    shard->unreleased_size -= entry_size;
+}
+
+static size_t ucs_rcache_unreleased_size(ucs_rcache_t *rcache)
+{
+    size_t unreleased_size = 0;
+    unsigned i;
+
+    for (i = 0; i < rcache->num_shards; ++i) {
+        unreleased_size += rcache->shards[i].unreleased_size;
+    }
+
+    return unreleased_size;
 }
 
 /* Lock must be held in write mode */
-static void ucs_rcache_check_inv_queue(ucs_rcache_t *rcache, unsigned flags)
+static void ucs_rcache_check_inv_queue(ucs_rcache_t *rcache,
+                                       ucs_rcache_shard_t *shard, unsigned flags)
 {
     ucs_rcache_inv_entry_t *entry;
 
     ucs_trace_func("rcache=%s", rcache->name);
 
-    ucs_spin_lock(&rcache->lock);
-    while (!ucs_queue_is_empty(&rcache->inv_q)) {
-        entry = ucs_queue_pull_elem_non_empty(&rcache->inv_q,
+    ucs_spin_lock(&shard->lock);
+    while (!ucs_queue_is_empty(&shard->inv_q)) {
+        entry = ucs_queue_pull_elem_non_empty(&shard->inv_q,
                                               ucs_rcache_inv_entry_t, queue);
-        ucs_rcache_remove_from_unreleased(rcache, entry->start, entry->end);
+        ucs_rcache_remove_from_unreleased(shard, entry->start, entry->end);
 
         /* We need to drop the lock since the following code may trigger memory
          * operations, which could trigger vm_unmapped event which also takes
          * this lock.
          */
-        ucs_spin_unlock(&rcache->lock);
+        ucs_spin_unlock(&shard->lock);
 
-        ucs_rcache_invalidate_range(rcache, entry->start, entry->end, flags);
+        ucs_rcache_invalidate_range(rcache, shard, entry->start, entry->end,
+                                    flags);
 
-        ucs_spin_lock(&rcache->lock);
+        ucs_spin_lock(&shard->lock);
 
         ucs_mpool_put(entry); /* Must be done with the lock held */
     }
-    ucs_spin_unlock(&rcache->lock);
+    ucs_spin_unlock(&shard->lock);
 }
 
-static void ucs_rcache_check_gc_list(ucs_rcache_t *rcache, int drop_lock)
+static void ucs_rcache_check_gc_list(ucs_rcache_t *rcache,
+                                     ucs_rcache_shard_t *shard, int drop_lock)
 {
     ucs_rcache_region_t *region;
 
     ucs_trace_func("rcache=%s", rcache->name);
 
-    ucs_spin_lock(&rcache->lock);
-    while (!ucs_list_is_empty(&rcache->gc_list)) {
-        region = ucs_list_extract_head(&rcache->gc_list, ucs_rcache_region_t,
+    ucs_spin_lock(&shard->lock);
+    while (!ucs_list_is_empty(&shard->gc_list)) {
+        region = ucs_list_extract_head(&shard->gc_list, ucs_rcache_region_t,
                                        tmp_list);
-        ucs_rcache_remove_from_unreleased(rcache, region->super.start,
+        ucs_rcache_remove_from_unreleased(shard, region->super.start,
                                           region->super.end);
 
         /* We need to drop the lock since the following code may trigger memory
          * operations, which could trigger vm_unmapped event which also takes
          * this lock.
          */
-        ucs_spin_unlock(&rcache->lock);
+        ucs_spin_unlock(&shard->lock);
 
         ucs_mem_region_destroy_internal(rcache, region, drop_lock);
 
-        ucs_spin_lock(&rcache->lock);
+        ucs_spin_lock(&shard->lock);
     }
-    ucs_spin_unlock(&rcache->lock);
+    ucs_spin_unlock(&shard->lock);
+}
+
+/* Shards which may hold regions overlapping the address range [start, end) */
+static uint64_t ucs_rcache_shards_mask(ucs_rcache_t *rcache,
+                                       ucs_pgt_addr_t start, ucs_pgt_addr_t end)
+{
+    uint64_t all_shards = UCS_MASK(rcache->num_shards);
+    ucs_pgt_addr_t block;
+    uint64_t mask;
+
+    /* The spanning shard may hold a region overlapping any range */
+    mask = UCS_BIT(rcache->num_shards - 1);
+    for (block = start >> UCS_RCACHE_SHARD_SHIFT;
+         (block <= ((end - 1) >> UCS_RCACHE_SHARD_SHIFT)) &&
+         (mask != all_shards);
+         ++block) {
+        mask |= UCS_BIT(block % (rcache->num_shards - 1));
+    }
+
+    return mask;
+}
+
+static void ucs_rcache_shard_unmapped(ucs_rcache_t *rcache,
+                                      ucs_rcache_shard_t *shard,
+                                      ucs_pgt_addr_t start, ucs_pgt_addr_t end)
+{
+    ucs_rcache_inv_entry_t *entry;
+
+    /*
+     * Try to lock the page table and invalidate the region immediately.
+     * This way we avoid queuing endless events on the invalidation queue when
+     * no rcache operations are performed to clean it.
+     */
+    if (!(rcache->params.flags & UCS_RCACHE_FLAG_SYNC_EVENTS) &&
+        ucs_rw_spinlock_write_trylock(&shard->pgt_lock)) {
+        /* coverity[double_lock] */
+        ucs_rcache_invalidate_range(rcache, shard, start, end,
+                                    UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
+        /* coverity[double_lock] */
+        ucs_rcache_check_inv_queue(rcache, shard,
+                                   UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
+        /* coverity[double_unlock] */
+        ucs_rw_spinlock_write_unlock(&shard->pgt_lock);
+        return;
+    }
+
+    /* Could not lock - add region to invalidation queue */
+    ucs_spin_lock(&shard->lock);
+    entry = ucs_mpool_get(&shard->mp);
+    if (entry != NULL) {
+        entry->start            = start;
+        entry->end              = end;
+        shard->unreleased_size += (entry->end - entry->start);
+        ucs_queue_push(&shard->inv_q, &entry->queue);
+        /* Thread caches must not return the regions of this range anymore */
+        ucs_rcache_gen_bump(rcache);
+    } else {
+        ucs_error("Failed to allocate invalidation entry for 0x%lx..0x%lx, "
+                  "data corruption may occur", start, end);
+    }
+    ucs_spin_unlock(&shard->lock);
 }
 
 static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
                                          ucm_event_t *event, void *arg)
 {
     ucs_rcache_t *rcache = arg;
-    ucs_rcache_inv_entry_t *entry;
     ucs_pgt_addr_t start, end;
+    uint64_t shards_mask;
+    unsigned shard_index;
 
     ucs_assert(event_type == UCM_EVENT_VM_UNMAPPED ||
                event_type == UCM_EVENT_MEM_TYPE_FREE);
 
-    if (rcache->unreleased_size > rcache->params.max_unreleased) {
+    if (ucs_rcache_unreleased_size(rcache) > rcache->params.max_unreleased) {
         /* Trigger a cleanup when the pending size exceeds the threshold */
         ucs_async_pipe_push(&ucs_rcache_global_context.pipe);
     }
@@ -644,42 +907,17 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
 
     ucs_trace_func("%s: event vm_unmapped 0x%lx..0x%lx", rcache->name, start, end);
 
-    /*
-     * Try to lock the page table and invalidate the region immediately.
-     * This way we avoid queuing endless events on the invalidation queue when
-     * no rcache operations are performed to clean it.
-     */
-    if (!(rcache->params.flags & UCS_RCACHE_FLAG_SYNC_EVENTS) &&
-        ucs_rw_spinlock_write_trylock(&rcache->pgt_lock)) {
-        /* coverity[double_lock] */
-        ucs_rcache_invalidate_range(rcache, start, end,
-                                    UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
-        UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_UNMAPS, 1);
-        /* coverity[double_lock] */
-        ucs_rcache_check_inv_queue(rcache, UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
-        /* coverity[double_unlock] */
-        ucs_rw_spinlock_write_unlock(&rcache->pgt_lock);
-        return;
+    shards_mask = ucs_rcache_shards_mask(rcache, start, end);
+    ucs_for_each_bit(shard_index, shards_mask) {
+        ucs_rcache_shard_unmapped(rcache, &rcache->shards[shard_index], start,
+                                  end);
     }
 
-    /* Could not lock - add region to invalidation queue */
-    ucs_spin_lock(&rcache->lock);
-    entry = ucs_mpool_get(&rcache->mp);
-    if (entry != NULL) {
-        entry->start             = start;
-        entry->end               = end;
-        rcache->unreleased_size += (entry->end - entry->start);
-        ucs_queue_push(&rcache->inv_q, &entry->queue);
-        UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_UNMAPS, 1);
-    } else {
-        ucs_error("Failed to allocate invalidation entry for 0x%lx..0x%lx, "
-                  "data corruption may occur", start, end);
-    }
-    ucs_spin_unlock(&rcache->lock);
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_UNMAPS, 1);
 }
 
 /* Clear all regions, called only during cleanup without holding the lock */
-static void ucs_rcache_purge(ucs_rcache_t *rcache)
+static void ucs_rcache_purge(ucs_rcache_t *rcache, ucs_rcache_shard_t *shard)
 {
     ucs_rcache_region_t *region, *tmp;
     ucs_list_link_t region_list;
@@ -687,7 +925,7 @@ static void ucs_rcache_purge(ucs_rcache_t *rcache)
     ucs_trace_func("rcache=%s", rcache->name);
 
     ucs_list_head_init(&region_list);
-    ucs_pgtable_purge(&rcache->pgtable, ucs_rcache_region_collect_callback,
+    ucs_pgtable_purge(&shard->pgtable, ucs_rcache_region_collect_callback,
                       &region_list);
     ucs_list_for_each_safe(region, tmp, &region_list, tmp_list) {
         if (region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE) {
@@ -701,20 +939,25 @@ static void ucs_rcache_purge(ucs_rcache_t *rcache)
     }
 }
 
-/* Lock must be held in write mode */
 static void ucs_rcache_clean(ucs_rcache_t *rcache)
 {
-    ucs_rw_spinlock_write_lock(&rcache->pgt_lock);
-    /* coverity[double_lock]*/
-    ucs_rcache_check_inv_queue(rcache, 0);
-    ucs_rcache_check_gc_list(rcache, 1);
-    ucs_rw_spinlock_write_unlock(&rcache->pgt_lock);
+    ucs_rcache_shard_t *shard;
+
+    for (shard = rcache->shards; shard < rcache->shards + rcache->num_shards;
+         ++shard) {
+        ucs_rw_spinlock_write_lock(&shard->pgt_lock);
+        /* coverity[double_lock]*/
+        ucs_rcache_check_inv_queue(rcache, shard, 0);
+        ucs_rcache_check_gc_list(rcache, shard, 1);
+        ucs_rw_spinlock_write_unlock(&shard->pgt_lock);
+    }
 }
 
-/* Lock must be held in write mode */
-static void ucs_rcache_lru_evict(ucs_rcache_t *rcache)
+/* Page table lock of 'shard' must be held in write mode */
+static void ucs_rcache_lru_evict(ucs_rcache_t *rcache, ucs_rcache_shard_t *shard)
 {
     int num_evicted, num_skipped;
+    ucs_rcache_shard_t *region_shard;
     ucs_rcache_region_t *region;
 
     num_evicted = 0;
@@ -728,27 +971,42 @@ static void ucs_rcache_lru_evict(ucs_rcache_t *rcache)
                                lru_list);
         ucs_assert(region->lru_flags & UCS_RCACHE_LRU_FLAG_IN_LRU);
 
+        /* The LRU list is shared by all shards. Do not wait for the page table
+         * lock of another shard, since its owner may be waiting for ours; the
+         * region will be evicted by a later call instead.
+         */
+        region_shard = ucs_rcache_region_shard(rcache, region);
+        if ((region_shard != shard) &&
+            !ucs_rw_spinlock_write_trylock(&region_shard->pgt_lock)) {
+            break;
+        }
+
         if (!(region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE) ||
             (region->refcount > 1)) {
             /* region is in use or not in page table - remove from lru */
             ucs_rcache_region_lru_remove(rcache, region);
             ++num_skipped;
-            continue;
-        }
+        } else {
+            ucs_spin_unlock(&rcache->lru.lock);
 
-        ucs_spin_unlock(&rcache->lru.lock);
+            /* The region is expected to have refcount=1 and present in pgt, so
+             * it would be destroyed immediately by this function, unless it
+             * was just taken from a thread cache
+             */
+            ucs_rcache_region_trace(rcache, region, "evict");
+            ucs_rcache_region_invalidate_internal(
+                    rcache, region,
+                    ((rcache->params.flags & UCS_RCACHE_FLAG_THREAD_CACHE) ?
+                             0 : UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY) |
+                            UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE);
+            ++num_evicted;
 
-        /* The region is expected to have refcount=1 and present in pgt, so it
-         * would be destroyed immediately by this function
-         */
-        ucs_rcache_region_trace(rcache, region, "evict");
-        ucs_rcache_region_invalidate_internal(
-                rcache, region,
-                UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY |
-                        UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE);
-        ++num_evicted;
+            ucs_spin_lock(&rcache->lru.lock);
+        }
 
-        ucs_spin_lock(&rcache->lru.lock);
+        if (region_shard != shard) {
+            ucs_rw_spinlock_write_unlock(&region_shard->pgt_lock);
+        }
     }
 
     ucs_spin_unlock(&rcache->lru.lock);
@@ -835,9 +1093,10 @@ ucs_rcache_check_overlap_one(ucs_rcache_t *rcache, ucs_pgt_addr_t *start,
 
 /* Lock must be held */
 static ucs_status_t
-ucs_rcache_check_overlap(ucs_rcache_t *rcache, void *arg, ucs_pgt_addr_t *start,
-                         ucs_pgt_addr_t *end, size_t *alignment, int *prot,
-                         int *merged, ucs_rcache_region_t **region_p)
+ucs_rcache_check_overlap(ucs_rcache_t *rcache, ucs_rcache_shard_t *shard,
+                         void *arg, ucs_pgt_addr_t *start, ucs_pgt_addr_t *end,
+                         size_t *alignment, int *prot, int *merged,
+                         ucs_rcache_region_t **region_p)
 {
     ucs_rcache_region_t *region, *tmp;
     ucs_pgt_addr_t old_start, old_end;
@@ -847,12 +1106,12 @@ ucs_rcache_check_overlap(ucs_rcache_t *rcache, void *arg, ucs_pgt_addr_t *start,
     ucs_trace_func("rcache=%s, *start=0x%lx, *end=0x%lx", rcache->name, *start,
                    *end);
 
-    ucs_rcache_check_inv_queue(rcache, 0);
+    ucs_rcache_check_inv_queue(rcache, shard, 0);
     /* coverity[double_unlock] */
-    ucs_rcache_check_gc_list(rcache, 1);
+    ucs_rcache_check_gc_list(rcache, shard, 1);
 
     ucs_list_head_init(&region_list);
-    ucs_rcache_find_regions(rcache, *start, *end - 1, &region_list);
+    ucs_rcache_find_regions(rcache, shard, *start, *end - 1, &region_list);
 
     if (!ucs_list_is_empty(&region_list)) {
         region = ucs_list_next(&region_list, ucs_rcache_region_t, tmp_list);
@@ -888,8 +1147,10 @@ ucs_rcache_check_overlap(ucs_rcache_t *rcache, void *arg, ucs_pgt_addr_t *start,
          * in turn, can result in even more overlapping regions.
          */
         ucs_list_head_init(&region_list);
-        ucs_rcache_find_regions(rcache, *start, old_start - 1, &region_list);
-        ucs_rcache_find_regions(rcache, old_end, *end - 1, &region_list);
+        ucs_rcache_find_regions(rcache, shard, *start, old_start - 1,
+                                &region_list);
+        ucs_rcache_find_regions(rcache, shard, old_end, *end - 1,
+                                &region_list);
     } while (!ucs_list_is_empty(&region_list));
 
     return UCS_OK;
@@ -931,6 +1192,7 @@ ucs_status_t ucs_rcache_create_region(ucs_rcache_t *rcache, void *address,
                                       size_t length, size_t alignment, int prot,
                                       void *arg, ucs_rcache_region_t **region_p)
 {
+    ucs_rcache_shard_t *shard;
     ucs_rcache_region_t *region;
     ucs_pgt_addr_t start, end;
     ucs_status_t status;
@@ -941,8 +1203,6 @@ ucs_status_t ucs_rcache_create_region(ucs_rcache_t *rcache, void *address,
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    ucs_rw_spinlock_write_lock(&rcache->pgt_lock);
-
 retry:
     /* Align to page size */
     start  = ucs_align_down_pow2((uintptr_t)address, alignment);
@@ -950,11 +1210,19 @@ retry:
     region = NULL;
     merged = 0;
 
+    /* Merging only extends the range within the same address block, since
+     * the alignment of a region which fits in a block is not larger than the
+     * block itself, so the shard does not change by the overlap check.
+     */
+    shard = ucs_rcache_shard_get(rcache, start, end);
+    ucs_rw_spinlock_write_lock(&shard->pgt_lock);
+
     /* Check overlap with existing regions */
     /* coverity[double_unlock] */
     /* coverity[double_lock] */
-    status = UCS_PROFILE_CALL(ucs_rcache_check_overlap, rcache, arg, &start,
-                              &end, &alignment, &prot, &merged, &region);
+    status = UCS_PROFILE_CALL(ucs_rcache_check_overlap, rcache, shard, arg,
+                              &start, &end, &alignment, &prot, &merged,
+                              &region);
     if (status == UCS_ERR_ALREADY_EXISTS) {
         /* Found a matching region (it could have been added after we released
          * the lock)
@@ -970,6 +1238,8 @@ retry:
         goto out_unlock;
     }
 
+    ucs_assert(ucs_rcache_shard_get(rcache, start, end) == shard);
+
     /* Allocate structure for new region */
     error = ucs_posix_memalign((void **)&region,
                                ucs_max(sizeof(void *), UCS_PGT_ENTRY_MIN_ALIGN),
@@ -986,7 +1256,8 @@ retry:
 
     region->super.start = start;
     region->super.end   = end;
-    status = UCS_PROFILE_CALL(ucs_pgtable_insert, &rcache->pgtable, &region->super);
+    status = UCS_PROFILE_CALL(ucs_pgtable_insert, &shard->pgtable,
+                              &region->super);
     if (status != UCS_OK) {
         ucs_error("failed to insert region " UCS_PGT_REGION_FMT ": %s",
                   UCS_PGT_REGION_ARG(&region->super), ucs_status_string(status));
@@ -1006,14 +1277,15 @@ retry:
     region->status    = UCS_INPROGRESS;
     region->alignment = alignment;
 
-    ++rcache->num_regions;
+    region_size      = region->super.end - region->super.start;
+    distribution_bin = ucs_rcache_distribution_get_bin(rcache, region_size);
 
-    region_size         = region->super.end - region->super.start;
+    ucs_spin_lock(&rcache->lru.lock);
+    ++rcache->num_regions;
     rcache->total_size += region_size;
-
-    distribution_bin = ucs_rcache_distribution_get_bin(rcache, region_size);
     ++distribution_bin->count;
     distribution_bin->total_size += region_size;
+    ucs_spin_unlock(&rcache->lru.lock);
 
     region->status = status = UCS_PROFILE_NAMED_CALL_ALWAYS(
             "mem_reg", rcache->params.ops->mem_reg, rcache->params.context,
@@ -1032,6 +1304,7 @@ retry:
                     rcache, region,
                     UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE |
                             UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY);
+            ucs_rw_spinlock_write_unlock(&shard->pgt_lock);
             goto retry;
         } else {
             ucs_debug("failed to register region " UCS_PGT_REGION_FMT ": %s",
@@ -1051,7 +1324,7 @@ retry:
             goto out_unlock;
         }
 
-        ucs_rcache_lru_evict(rcache);
+        ucs_rcache_lru_evict(rcache, shard);
     }
 
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_MISSES, 1);
@@ -1062,7 +1335,7 @@ out_set_region:
     *region_p = region;
 out_unlock:
     /* coverity[double_unlock]*/
-    ucs_rw_spinlock_write_unlock(&rcache->pgt_lock);
+    ucs_rw_spinlock_write_unlock(&shard->pgt_lock);
     return status;
 }
 
@@ -1076,33 +1349,59 @@ ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
                             size_t alignment, int prot, void *arg,
                             ucs_rcache_region_t **region_p)
 {
-    ucs_pgt_addr_t start = (uintptr_t)address;
-    ucs_pgt_region_t *pgt_region;
+    ucs_pgt_addr_t start         = (uintptr_t)address;
+    ucs_rcache_shard_t *spanning = ucs_rcache_shard_spanning(rcache);
+    ucs_rcache_shard_t *shard;
     ucs_rcache_region_t *region;
+    uint64_t gen;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    ucs_rw_spinlock_read_lock(&rcache->pgt_lock);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
-    if (ucs_queue_is_empty(&rcache->inv_q)) {
-        pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable,
-                                      start);
-        if (ucs_likely(pgt_region != NULL)) {
-            region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
-            if (((start + length) <= region->super.end) &&
-                ucs_rcache_region_test(region, prot, alignment)) {
-                ucs_rcache_region_hold(rcache, region);
-                ucs_rcache_region_validate_pfn(rcache, region);
-                ucs_rcache_region_lru_get(rcache, region);
-                *region_p = region;
-                UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
-                ucs_rw_spinlock_read_unlock(&rcache->pgt_lock);
-                return UCS_OK;
+
+    if (rcache->params.flags & UCS_RCACHE_FLAG_THREAD_CACHE) {
+        region = ucs_rcache_tcache_lookup(rcache, start, length, alignment,
+                                          prot);
+        if (region != NULL) {
+            ucs_rcache_region_validate_pfn(rcache, region);
+            *region_p = region;
+            UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_TCACHE, 1);
+            return UCS_OK;
+        }
+    }
+
+    /* Look in the shard of the address block first, and then in the shard of
+     * the regions crossing block boundaries */
+    shard = ucs_rcache_shard_get(rcache, start, start + ucs_max(length, 1));
+    for (;;) {
+        ucs_rw_spinlock_read_lock(&shard->pgt_lock);
+        /* Read the generation before checking the invalidation queue, which is
+         * updated before the generation is bumped */
+        gen = rcache->gen;
+        ucs_memory_cpu_load_fence();
+        region = ucs_rcache_shard_find(shard, start, length, alignment, prot);
+        if (ucs_likely(region != NULL)) {
+            ucs_rcache_region_hold(rcache, region);
+            ucs_rcache_region_validate_pfn(rcache, region);
+            ucs_rcache_region_lru_get(rcache, region);
+            *region_p = region;
+            UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
+            ucs_rw_spinlock_read_unlock(&shard->pgt_lock);
+
+            if (rcache->params.flags & UCS_RCACHE_FLAG_THREAD_CACHE) {
+                ucs_rcache_tcache_fill(rcache, start, region, gen);
             }
+            return UCS_OK;
+        }
+        ucs_rw_spinlock_read_unlock(&shard->pgt_lock);
+
+        if (shard == spanning) {
+            break;
         }
+
+        shard = spanning;
     }
-    ucs_rw_spinlock_read_unlock(&rcache->pgt_lock);
 
     /* Fall back to slow version (with rw lock) in following cases:
      * - invalidation list not empty
@@ -1126,14 +1425,15 @@ void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
                                   ucs_rcache_invalidate_comp_func_t cb,
                                   void *arg)
 {
+    ucs_rcache_shard_t *shard = ucs_rcache_region_shard(rcache, region);
     ucs_rcache_comp_entry_t *comp;
 
     /* Completion entry should be added before region is invalidated */
-    ucs_spin_lock(&rcache->lock);
-    comp = ucs_mpool_get(&rcache->mp);
-    ucs_spin_unlock(&rcache->lock);
+    ucs_spin_lock(&shard->lock);
+    comp = ucs_mpool_get(&shard->mp);
+    ucs_spin_unlock(&shard->lock);
 
-    ucs_rw_spinlock_write_lock(&rcache->pgt_lock);
+    ucs_rw_spinlock_write_lock(&shard->pgt_lock);
     if (comp != NULL) {
         comp->func = cb;
         comp->arg  = arg;
@@ -1146,12 +1446,13 @@ void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
     /* coverity[double_lock] */
     ucs_rcache_region_invalidate_internal(rcache, region, 0);
     /* coverity[double_unlock] */
-    ucs_rw_spinlock_write_unlock(&rcache->pgt_lock);
+    ucs_rw_spinlock_write_unlock(&shard->pgt_lock);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_PUTS, 1);
 }
 
 static void ucs_rcache_before_fork(void)
 {
+    ucs_rcache_shard_t *shard;
     ucs_rcache_t *rcache;
 
     pthread_mutex_lock(&ucs_rcache_global_context.lock);
@@ -1171,10 +1472,14 @@ static void ucs_rcache_before_fork(void)
              *   again on-demand.
              * - Other use cases shouldn't be affected
              */
-            ucs_rw_spinlock_write_lock(&rcache->pgt_lock);
-            /* coverity[double_lock] */
-            ucs_rcache_invalidate_range(rcache, 0, UCS_PGT_ADDR_MAX, 0);
-            ucs_rw_spinlock_write_unlock(&rcache->pgt_lock);
+            for (shard = rcache->shards;
+                 shard < rcache->shards + rcache->num_shards; ++shard) {
+                ucs_rw_spinlock_write_lock(&shard->pgt_lock);
+                /* coverity[double_lock] */
+                ucs_rcache_invalidate_range(rcache, shard, 0, UCS_PGT_ADDR_MAX,
+                                            0);
+                ucs_rw_spinlock_write_unlock(&shard->pgt_lock);
+            }
         }
     }
     pthread_mutex_unlock(&ucs_rcache_global_context.lock);
@@ -1268,48 +1573,31 @@ size_t ucs_rcache_distribution_get_num_bins()
     return ucs_ilog2(ucs_rcache_stat_max_pow2() / UCS_RCACHE_STAT_MIN_POW2) + 2;
 }
 
-static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
-                           const char *name, ucs_stats_node_t *stats_parent)
+static ucs_status_t ucs_rcache_shard_init(ucs_rcache_shard_t *shard)
 {
-    ucs_status_t status;
     size_t mp_obj_size, mp_align;
     ucs_mpool_params_t mp_params;
+    ucs_status_t status;
 
-    if (params->region_struct_size < sizeof(ucs_rcache_region_t)) {
-        status = UCS_ERR_INVALID_PARAM;
-        goto err;
-    }
-
-    self->name = ucs_strdup(name, "ucs rcache name");
-    if (self->name == NULL) {
-        status = UCS_ERR_NO_MEMORY;
-        goto err;
-    }
-
-    status = UCS_STATS_NODE_ALLOC(&self->stats, &ucs_rcache_stats_class,
-                                  stats_parent, "-%s", self->name);
-    if (status != UCS_OK) {
-        goto err_free_name;
-    }
-
-    self->params = *params;
-
-    ucs_rw_spinlock_init(&self->pgt_lock);
-    status = ucs_spinlock_init(&self->lock, 0);
+    ucs_rw_spinlock_init(&shard->pgt_lock);
+    status = ucs_spinlock_init(&shard->lock, 0);
     if (status != UCS_OK) {
-        goto err_destroy_stats;
+        goto err;
     }
 
-    status = ucs_pgtable_init(&self->pgtable, ucs_rcache_pgt_dir_alloc,
-                              ucs_rcache_pgt_dir_release);
+    /* Use wide page directories to make lookups traverse fewer levels */
+    status = ucs_pgtable_init_fanout(&shard->pgtable, UCS_PGT_ENTRY_SHIFT_WIDE,
+                                     ucs_rcache_pgt_dir_alloc,
+                                     ucs_rcache_pgt_dir_release);
     if (status != UCS_OK) {
         goto err_destroy_inv_q_lock;
     }
 
-    mp_obj_size = ucs_max(sizeof(ucs_pgt_dir_t), sizeof(ucs_rcache_inv_entry_t));
+    mp_obj_size = ucs_max(ucs_pgtable_dir_size(&shard->pgtable),
+                          sizeof(ucs_rcache_inv_entry_t));
     mp_obj_size = ucs_max(mp_obj_size, sizeof(ucs_rcache_comp_entry_t));
 
-    mp_align    = ucs_max(sizeof(void *), UCS_PGT_ENTRY_MIN_ALIGN);
+    mp_align    = ucs_max(UCS_SYS_CACHE_LINE_SIZE, UCS_PGT_ENTRY_MIN_ALIGN);
 
     ucs_mpool_params_reset(&mp_params);
     mp_params.elem_size       = mp_obj_size;
@@ -1318,28 +1606,108 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
     mp_params.elems_per_chunk = 1024;
     mp_params.ops             = &ucs_rcache_mp_ops;
     mp_params.name            = "rcache_mp";
-    status = ucs_mpool_init(&mp_params, &self->mp);
+    status = ucs_mpool_init(&mp_params, &shard->mp);
     if (status != UCS_OK) {
         goto err_cleanup_pgtable;
     }
 
-    ucs_queue_head_init(&self->inv_q);
+    ucs_queue_head_init(&shard->inv_q);
 
     /* coverity[missing_lock] */
-    self->unreleased_size = 0;
-    ucs_list_head_init(&self->gc_list);
+    shard->unreleased_size = 0;
+    ucs_list_head_init(&shard->gc_list);
+    return UCS_OK;
+
+err_cleanup_pgtable:
+    ucs_pgtable_cleanup(&shard->pgtable);
+err_destroy_inv_q_lock:
+    ucs_spinlock_destroy(&shard->lock);
+err:
+    return status;
+}
+
+static void ucs_rcache_shard_cleanup(ucs_rcache_shard_t *shard)
+{
+    ucs_mpool_cleanup(&shard->mp, 1);
+    ucs_pgtable_cleanup(&shard->pgtable);
+    ucs_spinlock_destroy(&shard->lock);
+}
+
+static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
+                           const char *name, ucs_stats_node_t *stats_parent)
+{
+    ucs_status_t status;
+    unsigned i;
+    int ret;
+
+    if ((params->region_struct_size < sizeof(ucs_rcache_region_t)) ||
+        (params->num_shards > UCS_RCACHE_MAX_SHARDS)) {
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
+    self->name = ucs_strdup(name, "ucs rcache name");
+    if (self->name == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err;
+    }
+
+    status = UCS_STATS_NODE_ALLOC(&self->stats, &ucs_rcache_stats_class,
+                                  stats_parent, "-%s", self->name);
+    if (status != UCS_OK) {
+        goto err_free_name;
+    }
+
+    self->params     = *params;
+    self->num_shards = ucs_max(params->num_shards, 1);
+
+    ret = ucs_posix_memalign((void**)&self->shards, UCS_SYS_CACHE_LINE_SIZE,
+                             sizeof(*self->shards) * self->num_shards,
+                             "rcache_shards");
+    if (ret != 0) {
+        ucs_error("failed to allocate %u rcache shards", self->num_shards);
+        status = UCS_ERR_NO_MEMORY;
+        goto err_destroy_stats;
+    }
+
+    for (i = 0; i < self->num_shards; ++i) {
+        status = ucs_rcache_shard_init(&self->shards[i]);
+        if (status != UCS_OK) {
+            goto err_cleanup_shards;
+        }
+    }
+
     self->num_regions = 0;
     self->total_size  = 0;
+    self->gen         = 0;
     ucs_list_head_init(&self->lru.list);
     ucs_spinlock_init(&self->lru.lock, 0);
 
+    self->tcache.lookups = 0;
+    self->tcache.hits    = 0;
+    if (params->flags & UCS_RCACHE_FLAG_THREAD_CACHE) {
+        /* Thread-specific keys are a limited resource, so create one only
+         * when the thread cache is used */
+        ret = pthread_key_create(&self->tcache.key,
+                                 ucs_rcache_thread_cache_release);
+        if (ret != 0) {
+            ucs_error("rcache %s: pthread_key_create() failed: %s",
+                      self->name, strerror(ret));
+            status = UCS_ERR_IO_ERROR;
+            goto err_destroy_lru_lock;
+        }
+
+        ucs_spinlock_init(&self->tcache.lock, 0);
+        ucs_list_head_init(&self->tcache.threads);
+    }
+
     self->distribution = ucs_calloc(ucs_rcache_distribution_get_num_bins(),
                                     sizeof(*self->distribution),
                                     "rcache_distribution");
     if (self->distribution == NULL) {
         ucs_error("failed to allocate rcache regions distribution array");
         status = UCS_ERR_NO_MEMORY;
-        goto err_destroy_mp;
+        goto err_delete_key;
     }
 
     status = ucs_rcache_global_list_add(self);
@@ -1364,12 +1732,18 @@ err_remove_vfs:
     ucs_rcache_global_list_remove(self);
 err_destroy_dist:
     ucs_free(self->distribution);
-err_destroy_mp:
-    ucs_mpool_cleanup(&self->mp, 1);
-err_cleanup_pgtable:
-    ucs_pgtable_cleanup(&self->pgtable);
-err_destroy_inv_q_lock:
-    ucs_spinlock_destroy(&self->lock);
+err_delete_key:
+    if (params->flags & UCS_RCACHE_FLAG_THREAD_CACHE) {
+        ucs_spinlock_destroy(&self->tcache.lock);
+        pthread_key_delete(self->tcache.key);
+    }
+err_destroy_lru_lock:
+    ucs_spinlock_destroy(&self->lru.lock);
+err_cleanup_shards:
+    while (i-- > 0) {
+        ucs_rcache_shard_cleanup(&self->shards[i]);
+    }
+    ucs_free(self->shards);
 err_destroy_stats:
     UCS_STATS_NODE_FREE(self->stats);
 err_free_name:
@@ -1380,13 +1754,20 @@ err:
 
 static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
 {
+    ucs_rcache_thread_cache_t *tc, *tmp_tc;
+    ucs_rcache_shard_t *shard;
+
     ucm_unset_event_handler(self->params.ucm_events, ucs_rcache_unmapped_callback,
                             self);
     ucs_vfs_obj_remove(self);
     ucs_rcache_global_list_remove(self);
-    ucs_rcache_check_inv_queue(self, 0);
-    ucs_rcache_check_gc_list(self, 0);
-    ucs_rcache_purge(self);
+
+    for (shard = self->shards; shard < self->shards + self->num_shards;
+         ++shard) {
+        ucs_rcache_check_inv_queue(self, shard, 0);
+        ucs_rcache_check_gc_list(self, shard, 0);
+        ucs_rcache_purge(self, shard);
+    }
 
     if (!ucs_list_is_empty(&self->lru.list)) {
         ucs_warn(
@@ -1397,9 +1778,21 @@ static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
 
     ucs_spinlock_destroy(&self->lru.lock);
 
-    ucs_mpool_cleanup(&self->mp, 1);
-    ucs_pgtable_cleanup(&self->pgtable);
-    ucs_spinlock_destroy(&self->lock);
+    if (self->params.flags & UCS_RCACHE_FLAG_THREAD_CACHE) {
+        pthread_key_delete(self->tcache.key);
+        ucs_list_for_each_safe(tc, tmp_tc, &self->tcache.threads, list) {
+            ucs_spinlock_destroy(&tc->lock);
+            ucs_free(tc);
+        }
+        ucs_spinlock_destroy(&self->tcache.lock);
+    }
+
+    for (shard = self->shards; shard < self->shards + self->num_shards;
+         ++shard) {
+        ucs_rcache_shard_cleanup(shard);
+    }
+
+    ucs_free(self->shards);
     UCS_STATS_NODE_FREE(self->stats);
     ucs_free(self->name);
     ucs_free(self->distribution);
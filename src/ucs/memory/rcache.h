@@ -61,6 +61,8 @@ enum {
     UCS_RCACHE_FLAG_NO_PFN_CHECK  = UCS_BIT(0), /**< PFN check not supported for this rcache */
     UCS_RCACHE_FLAG_PURGE_ON_FORK = UCS_BIT(1), /**< purge rcache on fork */
     UCS_RCACHE_FLAG_SYNC_EVENTS   = UCS_BIT(2), /**< Synchronize memory events handling */
+    UCS_RCACHE_FLAG_THREAD_CACHE  = UCS_BIT(3), /**< Keep a per-thread cache of
+                                                     recently hit regions */
 };
 
 /*
@@ -154,6 +156,9 @@ struct ucs_rcache_params {
     unsigned long          max_regions;         /**< Maximal number of regions */
     size_t                 max_size;            /**< Maximal total size of regions */
     size_t                 max_unreleased;      /**< Threshold for triggering a cleanup */
+    unsigned               num_shards;          /**< Number of independently locked
+                                                     shards to split the address
+                                                     space into, 0 means 1 */
 };
 
 
@@ -167,6 +172,8 @@ struct ucs_rcache_config {
     size_t        max_size;       /**< Maximal size of mapped memory */
     size_t        max_unreleased; /**< Threshold for triggering a cleanup */
     int           purge_on_fork;  /**< Enable/disable rcache purge on fork */
+    unsigned      num_shards;     /**< Number of rcache shards */
+    int           thread_cache;   /**< Enable/disable per-thread region cache */
 };
 
 
@@ -8,6 +8,7 @@
 #define UCS_RCACHE_INL_
 
 #include "rcache_int.h"
+#include <ucs/arch/atomic.h>
 #include <ucs/profile/profile.h>
 
 static UCS_F_ALWAYS_INLINE int
@@ -47,23 +48,50 @@ ucs_rcache_region_lru_remove(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
 }
 
 
+/* Shard which holds the regions crossing an address block boundary */
+static UCS_F_ALWAYS_INLINE ucs_rcache_shard_t *
+ucs_rcache_shard_spanning(ucs_rcache_t *rcache)
+{
+    return &rcache->shards[rcache->num_shards - 1];
+}
+
+
+/* Shard which holds the regions of the address range [start, end) */
+static UCS_F_ALWAYS_INLINE ucs_rcache_shard_t *
+ucs_rcache_shard_get(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                     ucs_pgt_addr_t end)
+{
+    ucs_pgt_addr_t block = start >> UCS_RCACHE_SHARD_SHIFT;
+
+    if ((rcache->num_shards == 1) ||
+        (block != ((end - 1) >> UCS_RCACHE_SHARD_SHIFT))) {
+        return ucs_rcache_shard_spanning(rcache);
+    }
+
+    return &rcache->shards[block % (rcache->num_shards - 1)];
+}
+
+
+static UCS_F_ALWAYS_INLINE ucs_rcache_shard_t *
+ucs_rcache_region_shard(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
+{
+    return ucs_rcache_shard_get(rcache, region->super.start, region->super.end);
+}
+
+
+/* Shard page table lock must be held */
 static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
-ucs_rcache_lookup_unsafe(ucs_rcache_t *rcache, void *address, size_t length,
-                         size_t alignment, int prot)
+ucs_rcache_shard_find(ucs_rcache_shard_t *shard, ucs_pgt_addr_t start,
+                      size_t length, size_t alignment, int prot)
 {
-    ucs_pgt_addr_t start = (uintptr_t)address;
     ucs_pgt_region_t *pgt_region;
     ucs_rcache_region_t *region;
 
-    ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
-                   length);
-
-    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
-    if (ucs_unlikely(!ucs_queue_is_empty(&rcache->inv_q))) {
+    if (ucs_unlikely(!ucs_queue_is_empty(&shard->inv_q))) {
         return NULL;
     }
 
-    pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable, start);
+    pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &shard->pgtable, start);
     if (ucs_unlikely(pgt_region == NULL)) {
         return NULL;
     }
@@ -75,9 +103,45 @@ ucs_rcache_lookup_unsafe(ucs_rcache_t *rcache, void *address, size_t length,
         return NULL;
     }
 
-    region->refcount++;
+    return region;
+}
+
+
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_lookup_hit(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
+{
+    /* Thread cache hits update the reference count without a lock */
+    ucs_atomic_add32(&region->refcount, 1);
     ucs_rcache_region_lru_remove(rcache, region);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
+}
+
+
+static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
+ucs_rcache_lookup_unsafe(ucs_rcache_t *rcache, void *address, size_t length,
+                         size_t alignment, int prot)
+{
+    ucs_pgt_addr_t start = (uintptr_t)address;
+    ucs_rcache_shard_t *shard;
+    ucs_rcache_region_t *region;
+
+    ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
+                   length);
+
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
+
+    shard  = ucs_rcache_shard_get(rcache, start, start + ucs_max(length, 1));
+    region = ucs_rcache_shard_find(shard, start, length, alignment, prot);
+    if ((region == NULL) && (shard != ucs_rcache_shard_spanning(rcache))) {
+        region = ucs_rcache_shard_find(ucs_rcache_shard_spanning(rcache), start,
+                                       length, alignment, prot);
+    }
+
+    if (ucs_unlikely(region == NULL)) {
+        return NULL;
+    }
+
+    ucs_rcache_lookup_hit(rcache, region);
     return region;
 }
 
@@ -85,12 +149,28 @@ static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
 ucs_rcache_lookup(ucs_rcache_t *rcache, void *address, size_t length,
                   size_t alignment, int prot)
 {
+    ucs_pgt_addr_t start         = (uintptr_t)address;
+    ucs_rcache_shard_t *spanning = ucs_rcache_shard_spanning(rcache);
+    ucs_rcache_shard_t *shard;
     ucs_rcache_region_t *region;
 
-    ucs_rw_spinlock_read_lock(&rcache->pgt_lock);
-    region = ucs_rcache_lookup_unsafe(rcache, address, length, alignment, prot);
-    ucs_rw_spinlock_read_unlock(&rcache->pgt_lock);
-    return region;
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
+
+    shard = ucs_rcache_shard_get(rcache, start, start + ucs_max(length, 1));
+    for (;;) {
+        ucs_rw_spinlock_read_lock(&shard->pgt_lock);
+        region = ucs_rcache_shard_find(shard, start, length, alignment, prot);
+        if (region != NULL) {
+            ucs_rcache_lookup_hit(rcache, region);
+        }
+        ucs_rw_spinlock_read_unlock(&shard->pgt_lock);
+
+        if ((region != NULL) || (shard == spanning)) {
+            return region;
+        }
+
+        shard = spanning;
+    }
 }
 
 static UCS_F_ALWAYS_INLINE void
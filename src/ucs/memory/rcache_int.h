@@ -10,10 +10,12 @@
 #include "rcache.h"
 
 #include <ucs/datastruct/list.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/stats/stats.h>
 #include <ucs/sys/ptr_arith.h>
 #include <ucs/type/spinlock.h>
 #include <ucs/type/rwlock.h>
+#include <pthread.h>
 
 
 #define ucs_rcache_region_log_lvl(_level, _message, ...) \
@@ -52,6 +54,7 @@ enum {
     UCS_RCACHE_PUTS,                /* number of put operations */
     UCS_RCACHE_REGS,                /* number of memory registrations */
     UCS_RCACHE_DEREGS,              /* number of memory deregistrations */
+    UCS_RCACHE_HITS_TCACHE,         /* number of per-thread cache hits */
     UCS_RCACHE_STAT_LAST
 };
 
@@ -64,14 +67,22 @@ typedef struct ucs_rcache_distribution {
     size_t total_size; /**< Total size of regions in the group */
 } ucs_rcache_distribution_t;
 
-struct ucs_rcache {
-    ucs_rcache_params_t params;          /**< rcache parameters (immutable) */
+/* Maximal number of shards a registration cache can be split into */
+#define UCS_RCACHE_MAX_SHARDS    64
+
+
+/* Log2 of the address space block size which is mapped to a single shard.
+   Regions which do not fit in one block are kept in the spanning shard. */
+#define UCS_RCACHE_SHARD_SHIFT   26
+
 
+/* A part of the registration cache, which manages the regions of a subset of
+   the address space with its own page table and locks. */
+typedef struct ucs_rcache_shard {
     ucs_rw_spinlock_t   pgt_lock;        /**< Protects the page table and all
                                               regions whose refcount is 0 */
     ucs_pgtable_t       pgtable;         /**< page table to hold the regions */
 
-
     ucs_spinlock_t      lock;            /**< Protects 'mp', 'inv_q' and 'gc_list'.
                                               This is a separate lock because we
                                               may want to invalidate regions
@@ -88,10 +99,52 @@ struct ucs_rcache {
                                               memory events */
     ucs_list_link_t     gc_list;         /**< list for regions to destroy, regions
                                               could not be destroyed from memhook */
-
-    unsigned long       num_regions;     /**< Total number of managed regions */
-    size_t              total_size;      /**< Total size of registered memory */
     size_t              unreleased_size; /**< Total size of the regions in gc_list and in inv_q */
+} UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) ucs_rcache_shard_t;
+
+
+/* Number of entries in a per-thread region cache, must be a power of 2 */
+#define UCS_RCACHE_TCACHE_SIZE   16
+
+
+/* Entry of a per-thread region cache */
+typedef struct ucs_rcache_tcache_entry {
+    ucs_rcache_region_t *region;         /**< Recently hit region, or NULL */
+    uint64_t            gen;             /**< rcache generation when the region
+                                              was found in the page table */
+} ucs_rcache_tcache_entry_t;
+
+
+/* Direct-mapped cache of regions recently hit by a thread. The lock is taken
+   by the owner thread while using an entry, and by region destroy to drop the
+   entries which point to the region, so it is almost never contended. */
+typedef struct ucs_rcache_thread_cache {
+    ucs_spinlock_t            lock;      /**< Protects 'entries' */
+    ucs_rcache_t              *rcache;   /**< Owning registration cache */
+    ucs_list_link_t           list;      /**< Entry in rcache->tcache.threads */
+    uint64_t                  lookups;   /**< Number of lookups */
+    uint64_t                  hits;      /**< Number of hits */
+    ucs_rcache_tcache_entry_t entries[UCS_RCACHE_TCACHE_SIZE];
+} ucs_rcache_thread_cache_t;
+
+
+struct ucs_rcache {
+    ucs_rcache_params_t params;          /**< rcache parameters (immutable) */
+
+    ucs_rcache_shard_t  *shards;         /**< Array of shards. The last one holds
+                                              the regions crossing a block
+                                              boundary, the others are selected
+                                              by the address block index */
+    unsigned            num_shards;      /**< Number of shards */
+    volatile uint64_t   gen;             /**< Generation of cached lookups, bumped
+                                              whenever a region is removed from a
+                                              page table or an invalidation is
+                                              queued */
+
+    unsigned long       num_regions;     /**< Total number of managed regions,
+                                              protected by 'lru.lock' */
+    size_t              total_size;      /**< Total size of registered memory,
+                                              protected by 'lru.lock' */
 
     struct {
         ucs_spinlock_t  lock;            /**< Lock for this structure */
@@ -101,13 +154,25 @@ struct ucs_rcache {
                                               is the most recently used region. */
     } lru;
 
+    struct {
+        pthread_key_t   key;             /**< Thread-local ucs_rcache_thread_cache_t */
+        ucs_spinlock_t  lock;            /**< Protects the fields below.
+                                              @note: This lock is taken **after**
+                                              'pgt_lock' and before the lock of
+                                              a thread cache. */
+        ucs_list_link_t threads;         /**< List of thread caches */
+        uint64_t        lookups;         /**< Lookups done by exited threads */
+        uint64_t        hits;            /**< Hits of exited threads */
+    } tcache;
+
     char                *name;           /**< Name of the cache, for debug purpose */
 
     UCS_STATS_NODE_DECLARE(stats)
 
     ucs_list_link_t           list; /**< List entry in global ucs_rcache list */
     ucs_rcache_distribution_t *distribution; /**< Distribution of registration
-                                                  cache regions by size */
+                                                  cache regions by size,
+                                                  protected by 'lru.lock' */
 };
 
 
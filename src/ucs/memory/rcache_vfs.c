@@ -15,6 +15,7 @@
 #include <ucs/sys/string.h>
 #include <ucs/vfs/base/vfs_cb.h>
 #include <ucs/vfs/base/vfs_obj.h>
+#include <inttypes.h>
 #include "rcache_int.h"
 
 
@@ -25,12 +26,16 @@ static void ucs_rcache_vfs_read_inv_q_length(void *obj,
                                              ucs_string_buffer_t *strb,
                                              void *arg_ptr, uint64_t arg_u64)
 {
-    ucs_rcache_t *rcache = obj;
-    size_t rcache_inv_q_length;
-
-    ucs_spin_lock(&rcache->lock);
-    rcache_inv_q_length = ucs_queue_length(&rcache->inv_q);
-    ucs_spin_unlock(&rcache->lock);
+    ucs_rcache_t *rcache       = obj;
+    size_t rcache_inv_q_length = 0;
+    ucs_rcache_shard_t *shard;
+
+    for (shard = rcache->shards; shard < rcache->shards + rcache->num_shards;
+         ++shard) {
+        ucs_spin_lock(&shard->lock);
+        rcache_inv_q_length += ucs_queue_length(&shard->inv_q);
+        ucs_spin_unlock(&shard->lock);
+    }
 
     ucs_string_buffer_appendf(strb, "%zu\n", rcache_inv_q_length);
 }
@@ -39,12 +44,16 @@ static void ucs_rcache_vfs_read_gc_list_length(void *obj,
                                                ucs_string_buffer_t *strb,
                                                void *arg_ptr, uint64_t arg_u64)
 {
-    ucs_rcache_t *rcache = obj;
-    unsigned long rcache_gc_list_length;
-
-    ucs_spin_lock(&rcache->lock);
-    rcache_gc_list_length = ucs_list_length(&rcache->gc_list);
-    ucs_spin_unlock(&rcache->lock);
+    ucs_rcache_t *rcache                = obj;
+    unsigned long rcache_gc_list_length = 0;
+    ucs_rcache_shard_t *shard;
+
+    for (shard = rcache->shards; shard < rcache->shards + rcache->num_shards;
+         ++shard) {
+        ucs_spin_lock(&shard->lock);
+        rcache_gc_list_length += ucs_list_length(&shard->gc_list);
+        ucs_spin_unlock(&shard->lock);
+    }
 
     ucs_string_buffer_appendf(strb, "%lu\n", rcache_gc_list_length);
 }
@@ -54,9 +63,58 @@ static void ucs_rcache_vfs_show_primitive(void *obj, ucs_string_buffer_t *strb,
 {
     ucs_rcache_t *rcache = obj;
 
-    ucs_rw_spinlock_read_lock(&rcache->pgt_lock);
+    ucs_spin_lock(&rcache->lru.lock);
     ucs_vfs_show_primitive(obj, strb, arg_ptr, arg_u64);
-    ucs_rw_spinlock_read_unlock(&rcache->pgt_lock);
+    ucs_spin_unlock(&rcache->lru.lock);
+}
+
+static void ucs_rcache_vfs_tcache_counters(ucs_rcache_t *rcache,
+                                           uint64_t *lookups_p,
+                                           uint64_t *hits_p)
+{
+    ucs_rcache_thread_cache_t *tc;
+
+    ucs_spin_lock(&rcache->tcache.lock);
+    *lookups_p = rcache->tcache.lookups;
+    *hits_p    = rcache->tcache.hits;
+    ucs_list_for_each(tc, &rcache->tcache.threads, list) {
+        *lookups_p += tc->lookups;
+        *hits_p    += tc->hits;
+    }
+    ucs_spin_unlock(&rcache->tcache.lock);
+}
+
+static void ucs_rcache_vfs_read_tcache_lookups(void *obj,
+                                               ucs_string_buffer_t *strb,
+                                               void *arg_ptr, uint64_t arg_u64)
+{
+    uint64_t lookups, hits;
+
+    ucs_rcache_vfs_tcache_counters(obj, &lookups, &hits);
+    ucs_string_buffer_appendf(strb, "%" PRIu64 "\n", lookups);
+}
+
+static void ucs_rcache_vfs_read_tcache_hits(void *obj,
+                                            ucs_string_buffer_t *strb,
+                                            void *arg_ptr, uint64_t arg_u64)
+{
+    uint64_t lookups, hits;
+
+    ucs_rcache_vfs_tcache_counters(obj, &lookups, &hits);
+    ucs_string_buffer_appendf(strb, "%" PRIu64 "\n", hits);
+}
+
+static void ucs_rcache_vfs_read_tcache_hit_ratio(void *obj,
+                                                 ucs_string_buffer_t *strb,
+                                                 void *arg_ptr,
+                                                 uint64_t arg_u64)
+{
+    uint64_t lookups, hits;
+
+    ucs_rcache_vfs_tcache_counters(obj, &lookups, &hits);
+    ucs_string_buffer_appendf(strb, "%.2f%%\n",
+                              (lookups == 0) ? 0.0 :
+                                               (100.0 * hits) / lookups);
 }
 
 static void ucs_rcache_vfs_init_regions_distribution(ucs_rcache_t *rcache)
@@ -92,6 +150,8 @@ void ucs_rcache_vfs_init(ucs_rcache_t *rcache)
                             "num_regions");
     ucs_vfs_obj_add_ro_file(rcache, ucs_vfs_show_primitive, &rcache->total_size,
                             UCS_VFS_TYPE_SIZET, "total_size");
+    ucs_vfs_obj_add_ro_file(rcache, ucs_vfs_show_primitive, &rcache->num_shards,
+                            UCS_VFS_TYPE_U32, "num_shards");
     ucs_vfs_obj_add_ro_file(rcache, ucs_vfs_show_ulunits,
                             &rcache->params.max_regions, 0, "max_regions");
     ucs_vfs_obj_add_ro_file(rcache, ucs_vfs_show_memunits,
@@ -101,5 +161,14 @@ void ucs_rcache_vfs_init(ucs_rcache_t *rcache)
     ucs_vfs_obj_add_ro_file(rcache, ucs_rcache_vfs_read_gc_list_length, NULL, 0,
                             "gc_list/length");
 
+    if (rcache->params.flags & UCS_RCACHE_FLAG_THREAD_CACHE) {
+        ucs_vfs_obj_add_ro_file(rcache, ucs_rcache_vfs_read_tcache_lookups,
+                                NULL, 0, "thread_cache/lookups");
+        ucs_vfs_obj_add_ro_file(rcache, ucs_rcache_vfs_read_tcache_hits, NULL,
+                                0, "thread_cache/hits");
+        ucs_vfs_obj_add_ro_file(rcache, ucs_rcache_vfs_read_tcache_hit_ratio,
+                                NULL, 0, "thread_cache/fast_hit_ratio");
+    }
+
     ucs_rcache_vfs_init_regions_distribution(rcache);
 }
@@ -20,15 +20,87 @@
 #include <errno.h>
 #include <unistd.h>
 #include <sys/epoll.h>
+#ifdef HAVE_IO_URING
+#include <ucs/datastruct/array.h>
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <poll.h>
+#endif
+
+
+/* Number of io_uring submission queue entries */
+#define UCS_EVENT_SET_IO_URING_SQ_ENTRIES 256
+
+/* Number of io_uring completion queue entries, the kernel keeps the
+ * completions which do not fit the queue until they are reaped */
+#define UCS_EVENT_SET_IO_URING_CQ_ENTRIES 4096
+
+/* user_data of the requests whose completions are ignored */
+#define UCS_EVENT_SET_IO_URING_IGNORE     UINT64_MAX
 
 
 enum {
     UCS_SYS_EVENT_SET_EXTERNAL_EVENT_FD = UCS_BIT(0),
+    UCS_SYS_EVENT_SET_IO_URING          = UCS_BIT(1)
 };
 
+
+#ifdef HAVE_IO_URING
+enum {
+    UCS_EVENT_SET_IO_URING_FD_ADDED = UCS_BIT(0),
+    UCS_EVENT_SET_IO_URING_FD_ARMED = UCS_BIT(1)
+};
+
+
+/* File descriptor registered in io_uring event set */
+typedef struct {
+    void                  *callback_data;
+    uint32_t              gen;    /* Generation of the poll request, is a part
+                                     of user_data to filter out stale
+                                     completions */
+    ucs_event_set_types_t events;
+    uint8_t               flags;
+} ucs_event_set_io_uring_fd_t;
+
+
+UCS_ARRAY_DECLARE_TYPE(ucs_event_set_io_uring_fds_t, unsigned,
+                       ucs_event_set_io_uring_fd_t);
+
+
+typedef struct {
+    void                         *ring;       /* Shared SQ and CQ rings */
+    size_t                       ring_size;
+    struct io_uring_sqe          *sqes;       /* Submission queue entries */
+    size_t                       sqes_size;
+    struct {
+        unsigned                 *head;
+        unsigned                 *tail;
+        unsigned                 *flags;
+        unsigned                 *array;
+        unsigned                 mask;
+        unsigned                 entries;
+        unsigned                 sqe_tail;    /* Tail of the filled entries,
+                                                 not yet seen by the kernel */
+    } sq;
+    struct {
+        unsigned                 *head;
+        unsigned                 *tail;
+        struct io_uring_cqe      *cqes;
+        unsigned                 mask;
+    } cq;
+    ucs_event_set_io_uring_fds_t fds;         /* Registered FDs, indexed by
+                                                 FD number */
+} ucs_event_set_io_uring_t;
+#endif
+
+
 struct ucs_sys_event_set {
-    int      event_fd;
-    unsigned flags;
+    int                      event_fd;
+    unsigned                 flags;
+#ifdef HAVE_IO_URING
+    ucs_event_set_io_uring_t uring;
+#endif
 };
 
 const unsigned ucs_sys_event_set_max_wait_events =
@@ -88,6 +160,476 @@ static ucs_sys_event_set_t *ucs_event_set_alloc(int event_fd, unsigned flags)
     return event_set;
 }
 
+#ifdef HAVE_IO_URING
+static inline unsigned
+ucs_event_set_io_uring_map_to_raw_events(ucs_event_set_types_t events)
+{
+    unsigned raw_events = 0;
+
+    if (events & UCS_EVENT_SET_EVREAD) {
+        raw_events |= POLLIN;
+    }
+    if (events & UCS_EVENT_SET_EVWRITE) {
+        raw_events |= POLLOUT;
+    }
+    if (events & UCS_EVENT_SET_EVERR) {
+        raw_events |= POLLERR;
+    }
+
+#if __BYTE_ORDER == __BIG_ENDIAN
+    /* The kernel reads poll32_events as two swapped 16-bit halves */
+    raw_events = (raw_events << 16) | (raw_events >> 16);
+#endif
+    return raw_events;
+}
+
+static inline ucs_event_set_types_t
+ucs_event_set_io_uring_map_to_events(int raw_events)
+{
+    ucs_event_set_types_t events = 0;
+
+    if (raw_events & POLLIN) {
+        events |= UCS_EVENT_SET_EVREAD;
+    }
+    if (raw_events & POLLOUT) {
+        events |= UCS_EVENT_SET_EVWRITE;
+    }
+    if (raw_events & POLLERR) {
+        events |= UCS_EVENT_SET_EVERR;
+    }
+    return events;
+}
+
+static inline uint64_t ucs_event_set_io_uring_user_data(int fd, uint32_t gen)
+{
+    return ((uint64_t)fd << 32) | gen;
+}
+
+static ucs_status_t ucs_event_set_io_uring_submit(ucs_sys_event_set_t *event_set)
+{
+    ucs_event_set_io_uring_t *uring = &event_set->uring;
+    unsigned to_submit;
+    int ret;
+
+    to_submit = uring->sq.sqe_tail -
+                __atomic_load_n(uring->sq.head, __ATOMIC_ACQUIRE);
+    if (to_submit == 0) {
+        return UCS_OK;
+    }
+
+    __atomic_store_n(uring->sq.tail, uring->sq.sqe_tail, __ATOMIC_RELEASE);
+
+    ret = syscall(__NR_io_uring_enter, event_set->event_fd, to_submit, 0, 0,
+                  NULL, 0);
+    if (ucs_unlikely(ret < 0)) {
+        if ((errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY)) {
+            /* The entries are submitted by the next call */
+            return UCS_INPROGRESS;
+        }
+
+        ucs_error("io_uring_enter(fd=%d, to_submit=%u) failed: %m",
+                  event_set->event_fd, to_submit);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    return UCS_OK;
+}
+
+static struct io_uring_sqe *
+ucs_event_set_io_uring_get_sqe(ucs_sys_event_set_t *event_set)
+{
+    ucs_event_set_io_uring_t *uring = &event_set->uring;
+    struct io_uring_sqe *sqe;
+    unsigned index;
+
+    if ((uring->sq.sqe_tail -
+         __atomic_load_n(uring->sq.head, __ATOMIC_ACQUIRE)) ==
+        uring->sq.entries) {
+        /* Make room by passing the filled entries to the kernel */
+        ucs_event_set_io_uring_submit(event_set);
+        if ((uring->sq.sqe_tail -
+             __atomic_load_n(uring->sq.head, __ATOMIC_ACQUIRE)) ==
+            uring->sq.entries) {
+            ucs_error("io_uring(fd=%d) submission queue is full",
+                      event_set->event_fd);
+            return NULL;
+        }
+    }
+
+    index                  = uring->sq.sqe_tail & uring->sq.mask;
+    sqe                    = &uring->sqes[index];
+    uring->sq.array[index] = index;
+    ++uring->sq.sqe_tail;
+
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_arm(ucs_sys_event_set_t *event_set, int fd)
+{
+    ucs_event_set_io_uring_fd_t *entry = &ucs_array_elem(&event_set->uring.fds,
+                                                         fd);
+    struct io_uring_sqe *sqe;
+
+    ucs_assert(!(entry->flags & UCS_EVENT_SET_IO_URING_FD_ARMED));
+
+    sqe = ucs_event_set_io_uring_get_sqe(event_set);
+    if (sqe == NULL) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    sqe->opcode        = IORING_OP_POLL_ADD;
+    sqe->fd            = fd;
+    sqe->poll32_events = ucs_event_set_io_uring_map_to_raw_events(
+                                 entry->events);
+    sqe->user_data     = ucs_event_set_io_uring_user_data(fd, entry->gen);
+#ifdef IORING_POLL_ADD_MULTI
+    if (entry->events & UCS_EVENT_SET_EDGE_TRIGGERED) {
+        /* Multishot poll request completes on every wakeup of the FD and
+         * stays armed, which provides edge-triggered notifications */
+        sqe->len = IORING_POLL_ADD_MULTI;
+    }
+#endif
+
+    entry->flags |= UCS_EVENT_SET_IO_URING_FD_ARMED;
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_disarm(ucs_sys_event_set_t *event_set, int fd)
+{
+    ucs_event_set_io_uring_fd_t *entry = &ucs_array_elem(&event_set->uring.fds,
+                                                         fd);
+    struct io_uring_sqe *sqe;
+
+    if (entry->flags & UCS_EVENT_SET_IO_URING_FD_ARMED) {
+        sqe = ucs_event_set_io_uring_get_sqe(event_set);
+        if (sqe == NULL) {
+            return UCS_ERR_NO_RESOURCE;
+        }
+
+        sqe->opcode    = IORING_OP_POLL_REMOVE;
+        sqe->fd        = -1;
+        sqe->addr      = ucs_event_set_io_uring_user_data(fd, entry->gen);
+        sqe->user_data = UCS_EVENT_SET_IO_URING_IGNORE;
+    }
+
+    /* Completions of the removed request are ignored */
+    entry->flags &= ~UCS_EVENT_SET_IO_URING_FD_ARMED;
+    ++entry->gen;
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_check_events(ucs_event_set_types_t events)
+{
+#ifndef IORING_POLL_ADD_MULTI
+    if (events & UCS_EVENT_SET_EDGE_TRIGGERED) {
+        ucs_error("edge-triggered mode is not supported by io_uring event set");
+        return UCS_ERR_UNSUPPORTED;
+    }
+#endif
+
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_add(ucs_sys_event_set_t *event_set, int fd,
+                           ucs_event_set_types_t events, void *callback_data)
+{
+    static const ucs_event_set_io_uring_fd_t empty_entry = {NULL, 0, 0, 0};
+    ucs_event_set_io_uring_fds_t *fds = &event_set->uring.fds;
+    ucs_event_set_io_uring_fd_t *entry;
+    ucs_status_t status;
+
+    status = ucs_event_set_io_uring_check_events(events);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if (fd >= ucs_array_length(fds)) {
+        ucs_array_resize(fds, fd + 1, empty_entry,
+                         ucs_error("failed to grow io_uring(fd=%d) FD table "
+                                   "to %d entries", event_set->event_fd,
+                                   fd + 1);
+                         return UCS_ERR_NO_MEMORY);
+    }
+
+    entry = &ucs_array_elem(fds, fd);
+    if (entry->flags & UCS_EVENT_SET_IO_URING_FD_ADDED) {
+        ucs_error("fd %d is already added to io_uring(fd=%d)", fd,
+                  event_set->event_fd);
+        return UCS_ERR_ALREADY_EXISTS;
+    }
+
+    entry->callback_data = callback_data;
+    entry->events        = events;
+    entry->flags         = UCS_EVENT_SET_IO_URING_FD_ADDED;
+    return ucs_event_set_io_uring_arm(event_set, fd);
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_mod(ucs_sys_event_set_t *event_set, int fd,
+                           ucs_event_set_types_t events, void *callback_data)
+{
+    ucs_event_set_io_uring_fds_t *fds = &event_set->uring.fds;
+    ucs_event_set_io_uring_fd_t *entry;
+    ucs_status_t status;
+
+    status = ucs_event_set_io_uring_check_events(events);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if ((fd >= ucs_array_length(fds)) ||
+        !(ucs_array_elem(fds, fd).flags & UCS_EVENT_SET_IO_URING_FD_ADDED)) {
+        ucs_error("fd %d is not added to io_uring(fd=%d)", fd,
+                  event_set->event_fd);
+        return UCS_ERR_NO_ELEM;
+    }
+
+    entry                = &ucs_array_elem(fds, fd);
+    entry->callback_data = callback_data;
+    if (entry->events == events) {
+        return UCS_OK;
+    }
+
+    entry->events = events;
+    if (!(entry->flags & UCS_EVENT_SET_IO_URING_FD_ARMED)) {
+        /* Called from the event handler, the request is armed after it */
+        return UCS_OK;
+    }
+
+    status = ucs_event_set_io_uring_disarm(event_set, fd);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    return ucs_event_set_io_uring_arm(event_set, fd);
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_del(ucs_sys_event_set_t *event_set, int fd)
+{
+    ucs_event_set_io_uring_fds_t *fds = &event_set->uring.fds;
+    ucs_status_t status;
+
+    if ((fd >= ucs_array_length(fds)) ||
+        !(ucs_array_elem(fds, fd).flags & UCS_EVENT_SET_IO_URING_FD_ADDED)) {
+        ucs_error("fd %d is not added to io_uring(fd=%d)", fd,
+                  event_set->event_fd);
+        return UCS_ERR_NO_ELEM;
+    }
+
+    status = ucs_event_set_io_uring_disarm(event_set, fd);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucs_array_elem(fds, fd).flags = 0;
+
+    /* The poll request holds a reference to the file, submit the removal now
+     * to not delay releasing it when the FD is closed */
+    status = ucs_event_set_io_uring_submit(event_set);
+    return (status == UCS_INPROGRESS) ? UCS_OK : status;
+}
+
+static unsigned
+ucs_event_set_io_uring_reap(ucs_sys_event_set_t *event_set,
+                            unsigned max_events,
+                            ucs_event_set_handler_t event_set_handler,
+                            void *arg)
+{
+    ucs_event_set_io_uring_t *uring = &event_set->uring;
+    unsigned head                   = *uring->cq.head;
+    unsigned count                  = 0;
+    ucs_event_set_io_uring_fd_t *entry;
+    struct io_uring_cqe *cqe;
+    uint64_t user_data;
+    uint32_t cqe_flags;
+    int fd, res;
+
+    while ((count < max_events) &&
+           (head != __atomic_load_n(uring->cq.tail, __ATOMIC_ACQUIRE))) {
+        cqe       = &uring->cq.cqes[head & uring->cq.mask];
+        user_data = cqe->user_data;
+        res       = cqe->res;
+        cqe_flags = cqe->flags;
+        __atomic_store_n(uring->cq.head, ++head, __ATOMIC_RELEASE);
+
+        if (user_data == UCS_EVENT_SET_IO_URING_IGNORE) {
+            continue;
+        }
+
+        fd    = user_data >> 32;
+        entry = &ucs_array_elem(&uring->fds, fd);
+        if (!(entry->flags & UCS_EVENT_SET_IO_URING_FD_ADDED) ||
+            (entry->gen != (uint32_t)user_data)) {
+            /* Completion of a request which was removed */
+            continue;
+        }
+
+#ifdef IORING_CQE_F_MORE
+        if (!(cqe_flags & IORING_CQE_F_MORE))
+#endif
+        {
+            entry->flags &= ~UCS_EVENT_SET_IO_URING_FD_ARMED;
+        }
+
+        if (ucs_likely(res >= 0)) {
+            event_set_handler(entry->callback_data,
+                              ucs_event_set_io_uring_map_to_events(res), arg);
+            ++count;
+        } else {
+            ucs_debug("io_uring(fd=%d) poll request for fd %d failed: %s",
+                      event_set->event_fd, fd, strerror(-res));
+        }
+
+        /* The handler could add new FDs and reallocate the table, or remove
+         * this FD */
+        entry = &ucs_array_elem(&uring->fds, fd);
+        if ((entry->flags & (UCS_EVENT_SET_IO_URING_FD_ADDED |
+                             UCS_EVENT_SET_IO_URING_FD_ARMED)) ==
+            UCS_EVENT_SET_IO_URING_FD_ADDED) {
+            ucs_event_set_io_uring_arm(event_set, fd);
+        }
+    }
+
+    return count;
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_wait(ucs_sys_event_set_t *event_set,
+                            unsigned *num_events, int timeout_ms,
+                            ucs_event_set_handler_t event_set_handler,
+                            void *arg)
+{
+    ucs_event_set_io_uring_t *uring = &event_set->uring;
+    struct pollfd pfd;
+    ucs_status_t status;
+    int ret;
+
+    /* Submit the requests posted by add/mod since the last wait */
+    status = ucs_event_set_io_uring_submit(event_set);
+    if (ucs_unlikely(UCS_STATUS_IS_ERR(status))) {
+        *num_events = 0;
+        return status;
+    }
+
+#ifdef IORING_SQ_CQ_OVERFLOW
+    if (ucs_unlikely(__atomic_load_n(uring->sq.flags, __ATOMIC_RELAXED) &
+                     IORING_SQ_CQ_OVERFLOW)) {
+        /* Let the kernel move the completions which did not fit the CQ */
+        syscall(__NR_io_uring_enter, event_set->event_fd, 0, 0,
+                IORING_ENTER_GETEVENTS, NULL, 0);
+    }
+#endif
+
+    if ((timeout_ms != 0) &&
+        (*uring->cq.head == __atomic_load_n(uring->cq.tail, __ATOMIC_ACQUIRE))) {
+        /* The ring FD is readable when there are completions */
+        pfd.fd      = event_set->event_fd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        ret         = poll(&pfd, 1, timeout_ms);
+        if (ucs_unlikely(ret < 0)) {
+            *num_events = 0;
+            if (errno == EINTR) {
+                return UCS_INPROGRESS;
+            }
+            ucs_error("poll(io_uring fd=%d) failed: %m", event_set->event_fd);
+            return UCS_ERR_IO_ERROR;
+        }
+    }
+
+    *num_events = ucs_event_set_io_uring_reap(event_set, *num_events,
+                                              event_set_handler, arg);
+    ucs_trace_poll("io_uring(fd=%d, timeout=%d) returned %u",
+                   event_set->event_fd, timeout_ms, *num_events);
+
+    /* Re-arm the completed poll requests */
+    status = ucs_event_set_io_uring_submit(event_set);
+    return UCS_STATUS_IS_ERR(status) ? status : UCS_OK;
+}
+
+static void ucs_event_set_io_uring_cleanup(ucs_sys_event_set_t *event_set)
+{
+    ucs_event_set_io_uring_t *uring = &event_set->uring;
+
+    munmap(uring->sqes, uring->sqes_size);
+    munmap(uring->ring, uring->ring_size);
+    ucs_array_cleanup_dynamic(&uring->fds);
+}
+
+static ucs_status_t ucs_event_set_io_uring_init(ucs_sys_event_set_t *event_set)
+{
+    ucs_event_set_io_uring_t *uring = &event_set->uring;
+    struct io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+    params.flags      = IORING_SETUP_CQSIZE;
+    params.cq_entries = UCS_EVENT_SET_IO_URING_CQ_ENTRIES;
+
+    event_set->event_fd = syscall(__NR_io_uring_setup,
+                                  UCS_EVENT_SET_IO_URING_SQ_ENTRIES, &params);
+    if (event_set->event_fd < 0) {
+        ucs_debug("io_uring_setup() failed: %m");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) ||
+        !(params.features & IORING_FEAT_NODROP)) {
+        ucs_debug("io_uring features 0x%x are not supported", params.features);
+        goto err_close;
+    }
+
+    uring->ring_size = ucs_max(params.sq_off.array +
+                               (params.sq_entries * sizeof(unsigned)),
+                               params.cq_off.cqes +
+                               (params.cq_entries *
+                                sizeof(struct io_uring_cqe)));
+    uring->ring      = mmap(NULL, uring->ring_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, event_set->event_fd,
+                            IORING_OFF_SQ_RING);
+    if (uring->ring == MAP_FAILED) {
+        ucs_debug("mmap(io_uring rings) failed: %m");
+        goto err_close;
+    }
+
+    uring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    uring->sqes      = mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, event_set->event_fd,
+                            IORING_OFF_SQES);
+    if (uring->sqes == MAP_FAILED) {
+        ucs_debug("mmap(io_uring SQEs) failed: %m");
+        goto err_unmap_ring;
+    }
+
+    uring->sq.head     = UCS_PTR_BYTE_OFFSET(uring->ring, params.sq_off.head);
+    uring->sq.tail     = UCS_PTR_BYTE_OFFSET(uring->ring, params.sq_off.tail);
+    uring->sq.flags    = UCS_PTR_BYTE_OFFSET(uring->ring, params.sq_off.flags);
+    uring->sq.array    = UCS_PTR_BYTE_OFFSET(uring->ring, params.sq_off.array);
+    uring->sq.mask     = *(unsigned*)UCS_PTR_BYTE_OFFSET(uring->ring,
+                                                         params.sq_off.ring_mask);
+    uring->sq.entries  = params.sq_entries;
+    uring->sq.sqe_tail = *uring->sq.tail;
+    uring->cq.head     = UCS_PTR_BYTE_OFFSET(uring->ring, params.cq_off.head);
+    uring->cq.tail     = UCS_PTR_BYTE_OFFSET(uring->ring, params.cq_off.tail);
+    uring->cq.cqes     = UCS_PTR_BYTE_OFFSET(uring->ring, params.cq_off.cqes);
+    uring->cq.mask     = *(unsigned*)UCS_PTR_BYTE_OFFSET(uring->ring,
+                                                         params.cq_off.ring_mask);
+    ucs_array_init_dynamic(&uring->fds);
+    return UCS_OK;
+
+err_unmap_ring:
+    munmap(uring->ring, uring->ring_size);
+err_close:
+    close(event_set->event_fd);
+    return UCS_ERR_UNSUPPORTED;
+}
+#endif
+
 ucs_status_t ucs_event_set_create_from_fd(ucs_sys_event_set_t **event_set_p,
                                           int event_fd)
 {
@@ -125,6 +667,30 @@ err_close_event_fd:
     return status;
 }
 
+ucs_status_t ucs_event_set_create_io_uring(ucs_sys_event_set_t **event_set_p)
+{
+#ifdef HAVE_IO_URING
+    ucs_sys_event_set_t *event_set;
+    ucs_status_t status;
+
+    event_set = ucs_event_set_alloc(-1, UCS_SYS_EVENT_SET_IO_URING);
+    if (event_set == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucs_event_set_io_uring_init(event_set);
+    if (status != UCS_OK) {
+        ucs_free(event_set);
+        return status;
+    }
+
+    *event_set_p = event_set;
+    return UCS_OK;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 ucs_status_t ucs_event_set_add(ucs_sys_event_set_t *event_set, int fd,
                                ucs_event_set_types_t events,
                                void *callback_data)
@@ -132,6 +698,13 @@ ucs_status_t ucs_event_set_add(ucs_sys_event_set_t *event_set, int fd,
     struct epoll_event raw_event;
     int ret;
 
+#ifdef HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        return ucs_event_set_io_uring_add(event_set, fd, events,
+                                          callback_data);
+    }
+#endif
+
     memset(&raw_event, 0, sizeof(raw_event));
     raw_event.events   = ucs_event_set_map_to_raw_events(events);
     raw_event.data.ptr = callback_data;
@@ -153,6 +726,13 @@ ucs_status_t ucs_event_set_mod(ucs_sys_event_set_t *event_set, int fd,
     struct epoll_event raw_event;
     int ret;
 
+#ifdef HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        return ucs_event_set_io_uring_mod(event_set, fd, events,
+                                          callback_data);
+    }
+#endif
+
     memset(&raw_event, 0, sizeof(raw_event));
     raw_event.events   = ucs_event_set_map_to_raw_events(events);
     raw_event.data.ptr = callback_data;
@@ -171,6 +751,12 @@ ucs_status_t ucs_event_set_del(ucs_sys_event_set_t *event_set, int fd)
 {
     int ret;
 
+#ifdef HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        return ucs_event_set_io_uring_del(event_set, fd);
+    }
+#endif
+
     ret = epoll_ctl(event_set->event_fd, EPOLL_CTL_DEL, fd, NULL);
     if (ret < 0) {
         ucs_error("epoll_ctl(event_fd=%d, DEL, fd=%d) failed: %m",
@@ -193,6 +779,13 @@ ucs_status_t ucs_event_set_wait(ucs_sys_event_set_t *event_set,
     ucs_assert(num_events != NULL);
     ucs_assert(*num_events <= ucs_sys_event_set_max_wait_events);
 
+#ifdef HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        return ucs_event_set_io_uring_wait(event_set, num_events, timeout_ms,
+                                           event_set_handler, arg);
+    }
+#endif
+
     events = ucs_alloca(sizeof(*events) * *num_events);
 
     nready = epoll_wait(event_set->event_fd, events, *num_events, timeout_ms);
@@ -221,6 +814,12 @@ ucs_status_t ucs_event_set_wait(ucs_sys_event_set_t *event_set,
 
 void ucs_event_set_cleanup(ucs_sys_event_set_t *event_set)
 {
+#ifdef HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        ucs_event_set_io_uring_cleanup(event_set);
+    }
+#endif
+
     if (!(event_set->flags & UCS_SYS_EVENT_SET_EXTERNAL_EVENT_FD)) {
         close(event_set->event_fd);
     }
@@ -70,6 +70,18 @@ ucs_status_t ucs_event_set_create_from_fd(ucs_sys_event_set_t **event_set_p,
  */
 ucs_status_t ucs_event_set_create(ucs_sys_event_set_t **event_set_p);
 
+/**
+ * Allocate ucs_sys_event_set_t structure which waits for events using io_uring
+ * poll requests. Checking for events does not require a system call when none
+ * of the requests has completed.
+ *
+ * @param [out] event_set_p  Event set pointer to initialize.
+ *
+ * @return UCS_OK on success, UCS_ERR_UNSUPPORTED if io_uring is not supported
+ *         by the system, or other error code on failure.
+ */
+ucs_status_t ucs_event_set_create_io_uring(ucs_sys_event_set_t **event_set_p);
+
 /**
  * Register the target event.
  *
@@ -20,6 +20,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/sendfile.h>
 #include <ifaddrs.h>
 #include <unistd.h>
 #include <errno.h>
@@ -288,7 +289,7 @@ const char *ucs_socket_getname_str(int fd, char *str, size_t max_size)
                             str, max_size);
 }
 
-static ucs_status_t ucs_socket_check_errno(int io_errno)
+ucs_status_t ucs_socket_check_errno(int io_errno)
 {
     if ((io_errno == EAGAIN) || (io_errno == EWOULDBLOCK) || (io_errno == EINTR)) {
         /* IO operation or connection establishment procedure was interrupted
@@ -296,7 +297,11 @@ static ucs_status_t ucs_socket_check_errno(int io_errno)
         return UCS_ERR_NO_PROGRESS;
     }
 
-    if (io_errno == ECONNRESET) {
+    if (io_errno == EINPROGRESS) {
+        /* The connection of a TCP Fast Open socket is not established yet, and
+         * the data was not queued */
+        return UCS_INPROGRESS;
+    } else if (io_errno == ECONNRESET) {
         /* Connection reset by peer */
         return UCS_ERR_CONNECTION_RESET;
     } else if (io_errno == ECONNREFUSED) {
@@ -623,7 +628,7 @@ ucs_socket_do_io_b(int fd, void *data, size_t length,
 
 static inline ucs_status_t
 ucs_socket_do_iov_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p,
-                     ucs_socket_iov_func_t iov_func, const char *name)
+                     ucs_socket_iov_func_t iov_func, const char *name, int flags)
 {
     struct msghdr msg = {
         .msg_iov    = iov,
@@ -631,7 +636,7 @@ ucs_socket_do_iov_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p
     };
     ssize_t ret;
 
-    ret = iov_func(fd, &msg, MSG_NOSIGNAL);
+    ret = iov_func(fd, &msg, MSG_NOSIGNAL | flags);
     return ucs_socket_handle_io(fd, iov, iov_cnt, length_p, 1, ret, errno, name);
 }
 
@@ -668,7 +673,32 @@ ucs_status_t ucs_socket_recv(int fd, void *data, size_t length)
 ucs_status_t
 ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p)
 {
-    return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, sendmsg, "sendv");
+    return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, sendmsg, "sendv",
+                                0);
+}
+
+ucs_status_t ucs_socket_sendmsg_nb(int fd, struct iovec *iov, size_t iov_cnt,
+                                   int flags, size_t *length_p)
+{
+    return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, sendmsg, "sendv",
+                                flags);
+}
+
+ucs_status_t ucs_socket_sendfile_nb(int fd, int in_fd, off_t offset,
+                                    size_t *length_p)
+{
+    ssize_t ret = sendfile(fd, in_fd, &offset, *length_p);
+
+    if (ucs_unlikely((ret == 0) && (*length_p != 0))) {
+        /* 0 is returned only if the offset is at the end of the file */
+        ucs_debug("sendfile(%d, in_fd=%d, offset=%ld) reached end of file",
+                  fd, in_fd, (long)offset);
+        *length_p = 0;
+        return UCS_ERR_IO_ERROR;
+    }
+
+    return ucs_socket_handle_io(fd, NULL, *length_p, length_p, 0, ret, errno,
+                                "sendfile");
 }
 
 ucs_status_t ucs_sockaddr_sizeof(const struct sockaddr *addr, size_t *size_p)
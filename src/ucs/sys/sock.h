@@ -257,6 +257,17 @@ ucs_status_t ucs_socket_server_init(const struct sockaddr *saddr, socklen_t sock
 int ucs_socket_max_conn(void);
 
 
+/**
+ * Convert the errno of a failed socket operation to a status code.
+ *
+ * @param [in]      io_errno        errno of the operation.
+ *
+ * @return UCS_ERR_NO_PROGRESS if the operation should be retried, otherwise
+ *         the status which corresponds to the error.
+ */
+ucs_status_t ucs_socket_check_errno(int io_errno);
+
+
 /**
  * Non-blocking send operation sends data on the connected (or bound
  * connectionless) socket referred to by the file descriptor `fd`.
@@ -300,7 +311,9 @@ ucs_status_t ucs_socket_recv_nb(int fd, void *data, int flags, size_t *length_p)
  * @param [in/out]  length          The length, in bytes, of the data in buffer
  *                                  pointed to by the `data` parameter.
  *
- * @return UCS_OK on success or an error code on failure.
+ * @return UCS_OK on success, UCS_INPROGRESS if nothing was sent since the
+ *         connection of a TCP Fast Open socket is not established yet, or an
+ *         error code on failure.
  */
 ucs_status_t ucs_socket_send(int fd, const void *data, size_t length);
 
@@ -322,6 +335,43 @@ ucs_status_t ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt,
                                  size_t *length_p);
 
 
+/**
+ * Non-blocking send operation sends I/O vector on the connected (or bound
+ * connectionless) socket referred to by the file descriptor `fd`, the same as
+ * @ref ucs_socket_sendv_nb, with additional sendmsg flags.
+ *
+ * @param [in]      fd              Socket fd.
+ * @param [in]      iov             A pointer to an array of iovec buffers.
+ * @param [in]      iov_cnt         The number of buffers pointed to by
+ *                                  the iov parameter.
+ * @param [in]      flags           sendmsg flags.
+ * @param [out]     length_p        The amount of data transmitted is written to
+ *                                  this argument.
+ *
+ * @return UCS_OK on success or an error code on failure.
+ */
+ucs_status_t ucs_socket_sendmsg_nb(int fd, struct iovec *iov, size_t iov_cnt,
+                                   int flags, size_t *length_p);
+
+
+/**
+ * Non-blocking send operation sends data from the file referred to by the
+ * file descriptor `in_fd` on the connected socket referred to by the file
+ * descriptor `fd`, without copying the data to user space.
+ *
+ * @param [in]      fd              Socket fd.
+ * @param [in]      in_fd           File fd to read the data from.
+ * @param [in]      offset          File offset to start reading from.
+ * @param [in/out]  length_p        The length, in bytes, of the data to send.
+ *                                  The amount of data transmitted is written
+ *                                  to this argument.
+ *
+ * @return UCS_OK on success or an error code on failure.
+ */
+ucs_status_t ucs_socket_sendfile_nb(int fd, int in_fd, off_t offset,
+                                    size_t *length_p);
+
+
 /**
  * Blocking receive operation receives data from the connected (or bound
  * connectionless) socket referred to by the file descriptor `fd`.
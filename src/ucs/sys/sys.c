@@ -1198,6 +1198,34 @@ ucs_status_t ucs_sys_fcntl_modfl(int fd, int add, int rem)
     return UCS_OK;
 }
 
+ucs_status_t ucs_sys_pidfd_getfd(pid_t pid, int remote_fd, int *fd_p)
+{
+#if defined(SYS_pidfd_open) && defined(SYS_pidfd_getfd)
+    int pidfd, fd, err;
+
+    pidfd = syscall(SYS_pidfd_open, pid, 0);
+    if (pidfd < 0) {
+        ucs_debug("pidfd_open(pid=%d) failed: %m", pid);
+        return (errno == ENOSYS) ? UCS_ERR_UNSUPPORTED : UCS_ERR_IO_ERROR;
+    }
+
+    fd  = syscall(SYS_pidfd_getfd, pidfd, remote_fd, 0);
+    err = errno;
+    close(pidfd);
+
+    if (fd < 0) {
+        ucs_debug("pidfd_getfd(pid=%d, fd=%d) failed: %s", pid, remote_fd,
+                  strerror(err));
+        return (err == ENOSYS) ? UCS_ERR_UNSUPPORTED : UCS_ERR_IO_ERROR;
+    }
+
+    *fd_p = fd;
+    return UCS_OK;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 pid_t ucs_get_tid(void)
 {
 #ifdef SYS_gettid
@@ -454,6 +454,21 @@ ucs_status_t ucs_sys_enum_pfn(uintptr_t address, unsigned page_count,
 ucs_status_t ucs_sys_fcntl_modfl(int fd, int add, int remove);
 
 
+/**
+ * Duplicate a file descriptor of another process into the current process,
+ * using pidfd_getfd(2). The caller must have ptrace access to the process.
+ *
+ * @param [in]  pid       Process id of the process which owns the descriptor.
+ * @param [in]  remote_fd File descriptor number in the other process.
+ * @param [out] fd_p      Filled with the new file descriptor, which has the
+ *                        close-on-exec flag set.
+ *
+ * @return UCS_OK if the descriptor was duplicated, UCS_ERR_UNSUPPORTED if the
+ *         system does not support it, or another error otherwise.
+ */
+ucs_status_t ucs_sys_pidfd_getfd(pid_t pid, int remote_fd, int *fd_p);
+
+
 /**
  * Get process command line
  */
@@ -10,19 +10,119 @@
 
 #include "timerq.h"
 
+#include <ucs/arch/bitops.h>
+#include <ucs/debug/assert.h>
 #include <ucs/debug/log.h>
 #include <ucs/debug/memtrack_int.h>
 #include <ucs/sys/math.h>
 #include <stdlib.h>
 
 
+KHASH_IMPL(ucs_timerq_hash, int, ucs_timer_t*, 1, kh_int_hash_func,
+           kh_int_hash_equal);
+
+
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_timerq_slot_index(ucs_time_t time, unsigned level)
+{
+    return (time >> (level * UCS_TIMERQ_LEVEL_BITS)) &
+           (UCS_TIMERQ_LEVEL_SLOTS - 1);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_list_link_t *
+ucs_timerq_slot(ucs_timer_queue_t *timerq, unsigned level, unsigned slot)
+{
+    return &timerq->wheel[(level * UCS_TIMERQ_LEVEL_SLOTS) + slot];
+}
+
+/* Level of the most significant bit which differs between two times */
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_timerq_level(ucs_time_t time1, ucs_time_t time2)
+{
+    ucs_assert(time1 != time2);
+    return ucs_ilog2(time1 ^ time2) / UCS_TIMERQ_LEVEL_BITS;
+}
+
+/*
+ * Place a timer on the wheel according to its expiration time, or on the
+ * given list if it already expired.
+ */
+static void ucs_timerq_insert(ucs_timer_queue_t *timerq, ucs_timer_t *timer,
+                              ucs_list_link_t *expired_list)
+{
+    unsigned level, slot;
+
+    if (timer->expiration <= timerq->now) {
+        ucs_list_add_tail(expired_list, &timer->list);
+        return;
+    }
+
+    level = ucs_timerq_level(timer->expiration, timerq->now);
+    slot  = ucs_timerq_slot_index(timer->expiration, level);
+    ucs_list_add_tail(ucs_timerq_slot(timerq, level, slot), &timer->list);
+    timerq->slot_mask[level] |= UCS_BIT(slot);
+}
+
+/* Move all timers in a slot to the list of expired timers */
+static void ucs_timerq_expire_slot(ucs_timer_queue_t *timerq, unsigned level,
+                                   unsigned slot)
+{
+    ucs_list_link_t *head = ucs_timerq_slot(timerq, level, slot);
+
+    ucs_list_splice_tail(&timerq->expired, head);
+    ucs_list_head_init(head);
+    timerq->slot_mask[level] &= ~UCS_BIT(slot);
+}
+
+static void ucs_timerq_add_interval(ucs_timer_queue_t *timerq,
+                                    ucs_time_t interval)
+{
+    if (interval < timerq->min_interval) {
+        timerq->min_interval = interval;
+        timerq->min_count    = 1;
+    } else if (interval == timerq->min_interval) {
+        ++timerq->min_count;
+    }
+}
+
+/* Called when the last timer with the minimal interval is removed */
+static void ucs_timerq_update_min_interval(ucs_timer_queue_t *timerq)
+{
+    ucs_timer_t *timer;
+
+    timerq->min_interval = UCS_TIME_INFINITY;
+    timerq->min_count    = 0;
+    kh_foreach_value(&timerq->hash, timer, {
+        ucs_timerq_add_interval(timerq, timer->interval);
+    })
+}
+
 ucs_status_t ucs_timerq_init(ucs_timer_queue_t *timerq)
 {
+    unsigned level, slot;
+
     ucs_trace_func("timerq=%p", timerq);
 
+    timerq->wheel = ucs_malloc(sizeof(*timerq->wheel) * UCS_TIMERQ_NUM_LEVELS *
+                               UCS_TIMERQ_LEVEL_SLOTS, "timerq_wheel");
+    if (timerq->wheel == NULL) {
+        ucs_error("failed to allocate timer queue wheel");
+        return UCS_ERR_NO_MEMORY;
+    }
+
     ucs_recursive_spinlock_init(&timerq->lock, 0);
-    timerq->timers       = NULL;
-    timerq->num_timers   = 0;
+    kh_init_inplace(ucs_timerq_hash, &timerq->hash);
+    ucs_list_head_init(&timerq->ready);
+    ucs_list_head_init(&timerq->expired);
+    for (level = 0; level < UCS_TIMERQ_NUM_LEVELS; ++level) {
+        for (slot = 0; slot < UCS_TIMERQ_LEVEL_SLOTS; ++slot) {
+            ucs_list_head_init(ucs_timerq_slot(timerq, level, slot));
+        }
+        timerq->slot_mask[level] = 0;
+    }
+
+    timerq->now          = 0;
+    timerq->min_count    = 0;
     /* coverity[missing_lock] */
     timerq->min_interval = UCS_TIME_INFINITY;
     return UCS_OK;
@@ -30,12 +130,20 @@ ucs_status_t ucs_timerq_init(ucs_timer_queue_t *timerq)
 
 void ucs_timerq_cleanup(ucs_timer_queue_t *timerq)
 {
+    ucs_timer_t *timer;
+
     ucs_trace_func("timerq=%p", timerq);
 
-    if (timerq->num_timers > 0) {
-        ucs_warn("timer queue with %d timers being destroyed", timerq->num_timers);
+    if (ucs_timerq_size(timerq) > 0) {
+        ucs_warn("timer queue with %d timers being destroyed",
+                 ucs_timerq_size(timerq));
     }
-    ucs_free(timerq->timers);
+
+    kh_foreach_value(&timerq->hash, timer, {
+        ucs_free(timer);
+    })
+    kh_destroy_inplace(ucs_timerq_hash, &timerq->hash);
+    ucs_free(timerq->wheel);
     ucs_recursive_spinlock_destroy(&timerq->lock);
 }
 
@@ -43,7 +151,9 @@ ucs_status_t ucs_timerq_add(ucs_timer_queue_t *timerq, int timer_id,
                             ucs_time_t interval)
 {
     ucs_status_t status;
-    ucs_timer_t *ptr;
+    ucs_timer_t *timer;
+    khiter_t iter;
+    int ret;
 
     ucs_trace_func("timerq=%p interval=%.2fus timer_id=%d", timerq,
                    ucs_time_to_usec(interval), timer_id);
@@ -51,30 +161,31 @@ ucs_status_t ucs_timerq_add(ucs_timer_queue_t *timerq, int timer_id,
     ucs_recursive_spin_lock(&timerq->lock);
 
     /* Make sure ID is unique */
-    for (ptr = timerq->timers; ptr < timerq->timers + timerq->num_timers; ++ptr) {
-        if (ptr->id == timer_id) {
-            status = UCS_ERR_ALREADY_EXISTS;
-            goto out_unlock;
-        }
+    iter = kh_put(ucs_timerq_hash, &timerq->hash, timer_id, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        status = UCS_ERR_NO_MEMORY;
+        goto out_unlock;
+    } else if (ret == UCS_KH_PUT_KEY_PRESENT) {
+        status = UCS_ERR_ALREADY_EXISTS;
+        goto out_unlock;
     }
 
-    /* Resize timer array */
-    ptr = ucs_realloc(timerq->timers, (timerq->num_timers + 1) * sizeof(ucs_timer_t),
-                      "timerq");
-    if (ptr == NULL) {
+    timer = ucs_malloc(sizeof(*timer), "timerq");
+    if (timer == NULL) {
+        kh_del(ucs_timerq_hash, &timerq->hash, iter);
         status = UCS_ERR_NO_MEMORY;
         goto out_unlock;
     }
-    timerq->timers = ptr;
-    ++timerq->num_timers;
-    timerq->min_interval = ucs_min(interval, timerq->min_interval);
+
+    kh_val(&timerq->hash, iter) = timer;
+    ucs_timerq_add_interval(timerq, interval);
     ucs_assert(timerq->min_interval != UCS_TIME_INFINITY);
 
     /* Initialize the new timer */
-    ptr = &timerq->timers[timerq->num_timers - 1];
-    ptr->expiration = 0; /* will fire the next time sweep is called */
-    ptr->interval   = interval;
-    ptr->id         = timer_id;
+    timer->expiration = 0; /* will fire the next time sweep is called */
+    timer->interval   = interval;
+    timer->id         = timer_id;
+    ucs_list_add_tail(&timerq->ready, &timer->list);
 
     status = UCS_OK;
 
@@ -86,34 +197,94 @@ out_unlock:
 ucs_status_t ucs_timerq_remove(ucs_timer_queue_t *timerq, int timer_id)
 {
     ucs_status_t status;
-    ucs_timer_t *ptr;
+    ucs_timer_t *timer;
+    khiter_t iter;
 
     ucs_trace_func("timerq=%p timer_id=%d", timerq, timer_id);
 
-    status = UCS_ERR_NO_ELEM;
-
     ucs_recursive_spin_lock(&timerq->lock);
-    timerq->min_interval = UCS_TIME_INFINITY;
-    ptr = timerq->timers;
-    while (ptr < timerq->timers + timerq->num_timers) {
-        if (ptr->id == timer_id) {
-            *ptr = timerq->timers[--timerq->num_timers];
-            status = UCS_OK;
-        } else {
-            timerq->min_interval = ucs_min(timerq->min_interval, ptr->interval);
-            ++ptr;
-        }
+
+    iter = kh_get(ucs_timerq_hash, &timerq->hash, timer_id);
+    if (iter == kh_end(&timerq->hash)) {
+        status = UCS_ERR_NO_ELEM;
+        goto out_unlock;
     }
 
-    /* TODO realloc - shrink */
-    if (timerq->num_timers == 0) {
-        ucs_assert(timerq->min_interval == UCS_TIME_INFINITY);
-        ucs_free(timerq->timers);
-        timerq->timers = NULL;
-    } else {
-        ucs_assert(timerq->min_interval != UCS_TIME_INFINITY);
+    /* The slot mask is not updated, empty slots are skipped by the sweep */
+    timer = kh_val(&timerq->hash, iter);
+    kh_del(ucs_timerq_hash, &timerq->hash, iter);
+    ucs_list_del(&timer->list);
+
+    if ((timer->interval == timerq->min_interval) &&
+        (--timerq->min_count == 0)) {
+        ucs_timerq_update_min_interval(timerq);
     }
 
+    ucs_assert((timerq->min_interval == UCS_TIME_INFINITY) ==
+               (ucs_timerq_size(timerq) == 0));
+    ucs_free(timer);
+    status = UCS_OK;
+
+out_unlock:
     ucs_recursive_spin_unlock(&timerq->lock);
     return status;
 }
+
+void ucs_timerq_sweep(ucs_timer_queue_t *timerq, ucs_time_t current_time)
+{
+    unsigned level, top_level, slot, current_slot;
+    ucs_list_link_t cascade, *head;
+    ucs_timer_t *timer;
+    uint64_t mask;
+
+    /* Newly added timers and timers expired on previous sweep */
+    ucs_list_splice_tail(&timerq->expired, &timerq->ready);
+    ucs_list_head_init(&timerq->ready);
+
+    if (current_time <= timerq->now) {
+        return;
+    }
+
+    /* All timers below the top level which changed have expired, since they
+     * were in the future only in the bits below that level */
+    top_level = ucs_timerq_level(current_time, timerq->now);
+    for (level = 0; level < top_level; ++level) {
+        mask = timerq->slot_mask[level];
+        ucs_for_each_bit(slot, mask) {
+            ucs_timerq_expire_slot(timerq, level, slot);
+        }
+    }
+
+    /* On the top level, slots before the current one have expired, and the
+     * timers in the current slot should move to lower levels */
+    current_slot = ucs_timerq_slot_index(current_time, top_level);
+    mask         = timerq->slot_mask[top_level] & UCS_MASK(current_slot);
+    ucs_for_each_bit(slot, mask) {
+        ucs_timerq_expire_slot(timerq, top_level, slot);
+    }
+
+    timerq->now = current_time;
+
+    if (!(timerq->slot_mask[top_level] & UCS_BIT(current_slot))) {
+        return;
+    }
+
+    ucs_list_head_init(&cascade);
+    head = ucs_timerq_slot(timerq, top_level, current_slot);
+    ucs_list_splice_tail(&cascade, head);
+    ucs_list_head_init(head);
+    timerq->slot_mask[top_level] &= ~UCS_BIT(current_slot);
+
+    while (!ucs_list_is_empty(&cascade)) {
+        timer = ucs_list_extract_head(&cascade, ucs_timer_t, list);
+        ucs_timerq_insert(timerq, timer, &timerq->expired);
+    }
+}
+
+void ucs_timerq_reschedule(ucs_timer_queue_t *timerq, ucs_timer_t *timer,
+                           ucs_time_t expiration)
+{
+    ucs_list_del(&timer->list);
+    timer->expiration = expiration;
+    ucs_timerq_insert(timerq, timer, &timerq->ready);
+}
@@ -7,25 +7,56 @@
 #ifndef UCS_TIMERQ_H
 #define UCS_TIMERQ_H
 
+#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/list.h>
 #include <ucs/datastruct/queue.h>
 #include <ucs/time/time.h>
 #include <ucs/type/status.h>
+#include <ucs/sys/math.h>
 #include <ucs/sys/preprocessor.h>
 #include <ucs/type/spinlock.h>
 
 
+/* Number of expiration time bits handled by each level of the timer wheel */
+#define UCS_TIMERQ_LEVEL_BITS    6
+#define UCS_TIMERQ_LEVEL_SLOTS   UCS_BIT(UCS_TIMERQ_LEVEL_BITS)
+#define UCS_TIMERQ_NUM_LEVELS    \
+    ucs_div_round_up(64, UCS_TIMERQ_LEVEL_BITS)
+
+
 typedef struct ucs_timer {
     ucs_time_t                 expiration;/* Absolute timer expiration time */
     ucs_time_t                 interval;  /* Re-scheduling interval */
     int                        id;
+    ucs_list_link_t            list;      /* Link in a wheel slot or a list of
+                                             expired timers */
 } ucs_timer_t;
 
 
+KHASH_TYPE(ucs_timerq_hash, int, ucs_timer_t*);
+
+
+/**
+ * Timer queue, implemented as a hierarchical timer wheel. A timer is placed on
+ * the level of the most significant bit in which its expiration time differs
+ * from the time of the last sweep, in the slot indexed by its expiration time
+ * bits of that level. Therefore, a sweep only has to look at the levels below
+ * the most significant bit which was changed since the last sweep, and the
+ * timers are moved to lower levels as their expiration time approaches.
+ */
 typedef struct ucs_timer_queue {
     ucs_recursive_spinlock_t   lock;
     ucs_time_t                 min_interval; /* Expiration of next timer */
-    ucs_timer_t                *timers;      /* Array of timers */
-    unsigned                   num_timers;   /* Number of timers */
+    unsigned                   min_count;    /* Number of timers with
+                                                'min_interval' */
+    ucs_time_t                 now;          /* Time of the last sweep */
+    khash_t(ucs_timerq_hash)   hash;         /* Timer ID to timer */
+    ucs_list_link_t            ready;        /* Timers to dispatch on next sweep */
+    ucs_list_link_t            expired;      /* Timers to dispatch on current
+                                                sweep */
+    uint64_t                   slot_mask[UCS_TIMERQ_NUM_LEVELS]; /* Non-empty
+                                                                    slots */
+    ucs_list_link_t            *wheel;       /* Slots of all levels */
 } ucs_timer_queue_t;
 
 
@@ -77,7 +108,7 @@ static inline ucs_time_t ucs_timerq_min_interval(ucs_timer_queue_t *timerq) {
  * @return Number of timers in the queue.
  */
 static inline int ucs_timerq_size(ucs_timer_queue_t *timerq) {
-    return timerq->num_timers;
+    return kh_size(&timerq->hash);
 }
 
 
@@ -89,6 +120,28 @@ static inline int ucs_timerq_is_empty(ucs_timer_queue_t *timerq) {
 }
 
 
+/**
+ * Move all timers which expired by the given time to the list of expired
+ * timers. Used internally by @ref ucs_timerq_for_each_expired.
+ *
+ * @param timerq        Timer queue to sweep.
+ * @param current_time  Current time to sweep the timers for.
+ */
+void ucs_timerq_sweep(ucs_timer_queue_t *timerq, ucs_time_t current_time);
+
+
+/**
+ * Set a new expiration time for a timer, which is in the timer queue. Used
+ * internally by @ref ucs_timerq_for_each_expired.
+ *
+ * @param timerq        Timer queue the timer is scheduled on.
+ * @param timer         Timer to reschedule.
+ * @param expiration    New absolute expiration time.
+ */
+void ucs_timerq_reschedule(ucs_timer_queue_t *timerq, ucs_timer_t *timer,
+                           ucs_time_t expiration);
+
+
 /**
  * Go through the expired timers in the timer queue.
  *
@@ -98,20 +151,20 @@ static inline int ucs_timerq_is_empty(ucs_timer_queue_t *timerq) {
  *
  * @note Timers which expired between calls to this function will also be dispatched.
  * @note There is no guarantee on the order of dispatching.
+ * @note If @a _code breaks out of the loop, the remaining expired timers are
+ *       dispatched by the next call.
  */
 #define ucs_timerq_for_each_expired(_timer, _timerq, _current_time, _code) \
     { \
         ucs_time_t __current_time = _current_time; \
         ucs_recursive_spin_lock(&(_timerq)->lock); /* Grab lock */ \
-        for (_timer = (_timerq)->timers; \
-             _timer != (_timerq)->timers + (_timerq)->num_timers; \
-             ++_timer) \
-        { \
-            if (__current_time >= (_timer)->expiration) { \
-                /* Update expiration time */ \
-                (_timer)->expiration = __current_time + (_timer)->interval; \
-                _code; \
-            } \
+        ucs_timerq_sweep(_timerq, __current_time); \
+        while (!ucs_list_is_empty(&(_timerq)->expired)) { \
+            _timer = ucs_list_head(&(_timerq)->expired, ucs_timer_t, list); \
+            /* Update expiration time */ \
+            ucs_timerq_reschedule(_timerq, _timer, \
+                                  __current_time + (_timer)->interval); \
+            _code; \
         } \
         ucs_recursive_spin_unlock(&(_timerq)->lock); /* Release lock  */ \
     }
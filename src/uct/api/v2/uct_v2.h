@@ -225,7 +225,9 @@ typedef struct {
 typedef enum {
     UCT_MD_MEM_REG_FIELD_FLAGS         = UCS_BIT(0),
     UCT_MD_MEM_REG_FIELD_DMABUF_FD     = UCS_BIT(1),
-    UCT_MD_MEM_REG_FIELD_DMABUF_OFFSET = UCS_BIT(2)
+    UCT_MD_MEM_REG_FIELD_DMABUF_OFFSET = UCS_BIT(2),
+    UCT_MD_MEM_REG_FIELD_FILE_FD       = UCS_BIT(3),
+    UCT_MD_MEM_REG_FIELD_FILE_OFFSET   = UCS_BIT(4)
 } uct_md_mem_reg_field_mask_t;
 
 
@@ -490,6 +492,32 @@ typedef struct uct_md_mem_reg_params {
      * dmabuf region, then this field must be omitted or set to 0.
      */
     size_t                       dmabuf_offset;
+
+    /**
+     * File descriptor of a regular file which holds the data of the memory
+     * region to register, e.g. the region is a mapping of this file.
+     *
+     * If is set (along with its corresponding bit in the field_mask -
+     * @ref UCT_MD_MEM_REG_FIELD_FILE_FD), zero-copy send operations with the
+     * memory handle may transmit the data from the file without copying it
+     * to user space. Can be used only if the memory domain returns
+     * @ref UCT_MD_FLAG_REG_FILE flag from @ref uct_md_query_v2.
+     *
+     * The file descriptor must remain open until the memory is deregistered,
+     * and the memory region must be readable, since transports may still
+     * access it directly.
+     */
+    int                          file_fd;
+
+    /**
+     * When @ref uct_md_mem_reg_params_t.file_fd is provided, this field
+     * specifies the file offset of the data at the address parameter passed
+     * to @ref uct_md_mem_reg_v2.
+     *
+     * If not set (along with its corresponding bit in the field_mask -
+     * @ref UCT_MD_MEM_REG_FIELD_FILE_OFFSET) it's assumed to be 0.
+     */
+    size_t                       file_offset;
 } uct_md_mem_reg_params_t;
 
 
@@ -1014,7 +1042,14 @@ typedef enum {
     /**
      * Memory domain performs memory type related copy operations.
      */
-    UCT_MD_FLAG_MEMTYPE_COPY   = UCS_BIT(13)
+    UCT_MD_FLAG_MEMTYPE_COPY   = UCS_BIT(13),
+
+    /**
+     * Memory domain supports registering a memory region backed by a file,
+     * see @ref uct_md_mem_reg_params_t.file_fd. Zero-copy operations with
+     * such memory handle send the data directly from the file.
+     */
+    UCT_MD_FLAG_REG_FILE       = UCS_BIT(14)
 } uct_md_flags_v2_t;
 
 
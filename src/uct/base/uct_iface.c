@@ -20,6 +20,7 @@
 #include <ucs/sys/string.h>
 #include <ucs/time/time.h>
 #include <ucs/debug/debug_int.h>
+#include <ucs/sys/topo/base/topo.h>
 #include <ucs/vfs/base/vfs_obj.h>
 
 
@@ -636,6 +637,48 @@ UCS_CLASS_CLEANUP_FUNC(uct_iface_t)
 UCS_CLASS_DEFINE(uct_iface_t, void);
 
 
+static ucs_numa_node_t
+uct_base_iface_device_numa_node(uct_md_h md, const uct_iface_params_t *params)
+{
+    ucs_numa_node_t numa_node = UCS_NUMA_NODE_UNDEFINED;
+    uct_tl_device_resource_t *tl_devices;
+    unsigned i, num_tl_devices;
+    ucs_status_t status;
+    uct_tl_t *tl;
+
+    if (!(params->field_mask & UCT_IFACE_PARAM_FIELD_OPEN_MODE) ||
+        !(params->open_mode & UCT_IFACE_OPEN_MODE_DEVICE) ||
+        (params->mode.device.tl_name == NULL) ||
+        (params->mode.device.dev_name == NULL)) {
+        return UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    ucs_list_for_each(tl, &md->component->tl_list, list) {
+        if (strcmp(tl->name, params->mode.device.tl_name)) {
+            continue;
+        }
+
+        status = tl->query_devices(md, &tl_devices, &num_tl_devices);
+        if (status != UCS_OK) {
+            break;
+        }
+
+        for (i = 0; i < num_tl_devices; ++i) {
+            if (!strcmp(tl_devices[i].name, params->mode.device.dev_name) &&
+                (tl_devices[i].sys_device != UCS_SYS_DEVICE_ID_UNKNOWN)) {
+                numa_node = ucs_topo_sys_device_get_numa_node(
+                        tl_devices[i].sys_device);
+                break;
+            }
+        }
+
+        ucs_free(tl_devices);
+        break;
+    }
+
+    return numa_node;
+}
+
 UCS_CLASS_INIT_FUNC(uct_base_iface_t, uct_iface_ops_t *ops,
                     uct_iface_internal_ops_t *internal_ops, uct_md_h md,
                     uct_worker_h worker, const uct_iface_params_t *params,
@@ -696,6 +739,18 @@ UCS_CLASS_INIT_FUNC(uct_base_iface_t, uct_iface_ops_t *ops,
     self->config.failure_level = (ucs_log_level_t)config->failure;
     self->config.max_num_eps   = config->max_num_eps;
 
+    /* Allocate buffers close to the CPUs which are going to use the iface,
+     * or close to the device if the CPUs are not known */
+    if (params->field_mask & UCT_IFACE_PARAM_FIELD_CPU_MASK) {
+        self->config.numa_node = ucs_numa_node_of_cpu_set(&params->cpu_mask);
+    } else {
+        self->config.numa_node = UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    if (self->config.numa_node == UCS_NUMA_NODE_UNDEFINED) {
+        self->config.numa_node = uct_base_iface_device_numa_node(md, params);
+    }
+
     return UCS_STATS_NODE_ALLOC(&self->stats, &uct_iface_stats_class,
                                 stats_parent, "-%s-%p", iface_name, self);
 }
@@ -337,6 +337,7 @@ typedef struct uct_base_iface {
         uct_alloc_method_t   alloc_methods[UCT_ALLOC_METHOD_LAST];
         ucs_log_level_t      failure_level;
         size_t               max_num_eps;
+        ucs_numa_node_t      numa_node; /* Node to allocate buffers on */
     } config;
 
     UCS_STATS_NODE_DECLARE(stats)            /* Statistics */
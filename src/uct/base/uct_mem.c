@@ -547,6 +547,7 @@ ucs_status_t uct_iface_mpool_init(uct_base_iface_t *iface, ucs_mpool_t *mp,
     mp_params.elem_size       = elem_size;
     mp_params.align_offset    = align_offset;
     mp_params.alignment       = alignment;
+    mp_params.numa_node       = iface->config.numa_node;
     mp_params.ops             = &uct_iface_mpool_ops;
     mp_params.name            = name;
     /* Create memory pool of bounce buffers */
@@ -28,3 +28,11 @@ AC_CHECK_DECLS([IPPROTO_TCP, SOL_SOCKET, SO_KEEPALIVE,
                 [#include <netinet/in.h>]])
 AS_IF([test "x$tcp_keepalive_happy" != "xno"],
       [AC_DEFINE([UCT_TCP_EP_KEEPALIVE], 1, [Enable TCP keepalive configuration])]);
+
+AC_CHECK_DECLS([SO_ZEROCOPY, MSG_ZEROCOPY, SO_EE_ORIGIN_ZEROCOPY],
+               [],
+               [tcp_msg_zcopy_happy=no],
+               [[#include <sys/socket.h>]
+                [#include <linux/errqueue.h>]])
+AS_IF([test "x$tcp_msg_zcopy_happy" != "xno"],
+      [AC_DEFINE([UCT_TCP_EP_MSG_ZCOPY], 1, [Enable TCP MSG_ZEROCOPY send])]);
@@ -89,7 +89,8 @@ static ucs_pgt_dir_t *uct_cuda_ipc_cache_pgt_dir_alloc(const ucs_pgtable_t *pgta
 
     ret = ucs_posix_memalign(&ptr,
                              ucs_max(sizeof(void *), UCS_PGT_ENTRY_MIN_ALIGN),
-                             sizeof(ucs_pgt_dir_t), "cuda_ipc_cache_pgdir");
+                             ucs_pgtable_dir_size(pgtable),
+                             "cuda_ipc_cache_pgdir");
     return (ret == 0) ? ptr : NULL;
 }
 
@@ -26,7 +26,8 @@ uct_rocm_copy_cache_pgt_dir_alloc(const ucs_pgtable_t *pgtable)
 
     ret = ucs_posix_memalign(&ptr,
                              ucs_max(sizeof(void *), UCS_PGT_ENTRY_MIN_ALIGN),
-                             sizeof(ucs_pgt_dir_t), "rocm_copy_cache_pgdir");
+                             ucs_pgtable_dir_size(pgtable),
+                             "rocm_copy_cache_pgdir");
     return (ret == 0) ? ptr : NULL;
 }
 
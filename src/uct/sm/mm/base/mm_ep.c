@@ -15,6 +15,8 @@
 
 #include <uct/base/uct_iov.inl>
 #include <ucs/arch/atomic.h>
+#include <ucs/async/eventfd.h>
+#include <ucs/sys/string.h>
 
 
 /* send modes */
@@ -108,7 +110,7 @@ uct_mm_ep_get_remote_seg(uct_mm_ep_t *ep, uct_mm_seg_id_t seg_id, size_t length,
     return uct_mm_ep_attach_remote_seg(ep, seg_id, length, address_p);
 }
 
-/* send a signal to remote interface using Unix-domain socket */
+/* send a signal to remote interface using its eventfd or Unix-domain socket */
 static void uct_mm_ep_signal_remote(uct_mm_ep_t *ep)
 {
     uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface, uct_mm_iface_t);
@@ -117,6 +119,13 @@ static void uct_mm_ep_signal_remote(uct_mm_ep_t *ep)
 
     ucs_trace("ep %p: signal remote", ep);
 
+    if (ep->signal_eventfd != UCS_ASYNC_EVENTFD_INVALID_FD) {
+        /* the receiver resets the eventfd counter when it arms, so the
+         * counter can't overflow */
+        ucs_async_eventfd_signal(ep->signal_eventfd);
+        return;
+    }
+
     for (;;) {
         ret = sendto(iface->signal_fd, &dummy, sizeof(dummy), 0,
                      (const struct sockaddr*)&ep->fifo_ctl->signal_sockaddr,
@@ -146,6 +155,70 @@ static void uct_mm_ep_signal_remote(uct_mm_ep_t *ep)
     }
 }
 
+static int uct_mm_ep_is_eventfd(int fd)
+{
+    static const char *eventfd_link = "anon_inode:[eventfd]";
+    char path[64], link[32];
+    ssize_t len;
+
+    ucs_snprintf_safe(path, sizeof(path), "/proc/self/fd/%d", fd);
+    len = readlink(path, link, sizeof(link) - 1);
+    if (len < 0) {
+        return 0;
+    }
+
+    link[len] = '\0';
+    return !strcmp(link, eventfd_link);
+}
+
+/* Duplicate the remote eventfd, if the remote process published one and this
+ * process is allowed to access it. Otherwise, signal through the socket */
+static void uct_mm_ep_get_signal_eventfd(uct_mm_ep_t *ep)
+{
+    const uct_mm_fifo_ctl_t *fifo_ctl = ep->fifo_ctl;
+    ucs_status_t status;
+    int fd;
+
+    ep->signal_eventfd = UCS_ASYNC_EVENTFD_INVALID_FD;
+    if ((fifo_ctl->signal_eventfd == UCS_ASYNC_EVENTFD_INVALID_FD) ||
+        (fifo_ctl->pid_ns != ucs_sys_get_ns(UCS_SYS_NS_TYPE_PID))) {
+        return;
+    }
+
+    status = ucs_sys_pidfd_getfd(fifo_ctl->pid, fifo_ctl->signal_eventfd, &fd);
+    if (status != UCS_OK) {
+        ucs_debug("mm ep %p: failed to get eventfd %d of pid %d, using the "
+                  "signal socket", ep, fifo_ctl->signal_eventfd, fifo_ctl->pid);
+        return;
+    }
+
+    /* the remote process could close the descriptor and reuse its number
+     * before it was duplicated */
+    if (!uct_mm_ep_is_eventfd(fd)) {
+        ucs_debug("mm ep %p: fd %d of pid %d is not an eventfd", ep,
+                  fifo_ctl->signal_eventfd, fifo_ctl->pid);
+        close(fd);
+        return;
+    }
+
+    ucs_debug("mm ep %p: signal eventfd %d of pid %d as fd %d", ep,
+              fifo_ctl->signal_eventfd, fifo_ctl->pid, fd);
+    ep->signal_eventfd = fd;
+}
+
+static void uct_mm_ep_release_fifo_lane(uct_mm_ep_t *ep)
+{
+    if (ep->lane_ctl == NULL) {
+        return;
+    }
+
+    /* The messages which were written to the lane stay there until the
+     * receiver reads them, the next owner continues from the lane head */
+    ucs_memory_cpu_store_fence();
+    ep->lane_ctl->lane_owner = 0;
+    ep->lane_ctl             = NULL;
+}
+
 void uct_mm_ep_cleanup_remote_segs(uct_mm_ep_t *ep)
 {
     uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -159,6 +232,57 @@ void uct_mm_ep_cleanup_remote_segs(uct_mm_ep_t *ep)
     kh_destroy_inplace(uct_mm_remote_seg, &ep->remote_segs);
 }
 
+/* Claim a free lane of the remote FIFO, so this ep would be its only writer */
+static void uct_mm_ep_claim_fifo_lane(uct_mm_ep_t *ep)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                           uct_mm_iface_t);
+    uct_mm_fifo_ctl_t *fifo_ctl = ep->fifo_ctl;
+    uct_mm_fifo_ctl_t *lane_ctl;
+    unsigned i, num_lanes;
+
+    if ((iface->config.fifo_lanes == 0) || (fifo_ctl->fifo_lanes == 0)) {
+        return;
+    }
+
+    /* The lanes are located by the local configuration, which also
+     * determined the size of the attached FIFO segment, so use only the lanes
+     * of the receiver which match it */
+    if (fifo_ctl->fifo_lane_size != iface->config.fifo_lane_size) {
+        ucs_debug("mm ep %p: remote FIFO lane size %u does not match local "
+                  "%u, using the shared FIFO", ep, fifo_ctl->fifo_lane_size,
+                  iface->config.fifo_lane_size);
+        return;
+    }
+
+    num_lanes = ucs_min(fifo_ctl->fifo_lanes, iface->config.fifo_lanes);
+    for (i = 0; i < num_lanes; ++i) {
+        lane_ctl = UCT_MM_IFACE_GET_FIFO_LANE(iface, fifo_ctl, i);
+        if ((lane_ctl->lane_owner != 0) ||
+            (ucs_atomic_cswap32(ucs_unaligned_ptr(&lane_ctl->lane_owner), 0,
+                                1) != 0)) {
+            continue;
+        }
+
+        ep->lane_ctl          = lane_ctl;
+        ep->lane_switch_index = 0;
+
+        /* The receiver assigns descriptors to the lane elements and releases
+         * the lane tail when it notices the claim, wake it up to do that if
+         * it sleeps. Until then, the ep keeps sending to the shared FIFO */
+        ucs_atomic_add32(ucs_unaligned_ptr(&fifo_ctl->lanes_gen), 1);
+        if (fifo_ctl->head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) {
+            uct_mm_ep_signal_remote(ep);
+        }
+
+        ucs_debug("mm ep %p: claimed FIFO lane %u", ep, i);
+        return;
+    }
+
+    ucs_debug("mm ep %p: no free FIFO lane out of %u, using the shared FIFO",
+              ep, num_lanes);
+}
+
 static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
 {
     uct_mm_iface_t            *iface = ucs_derived_of(params->iface, uct_mm_iface_t);
@@ -197,6 +321,10 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
 
     /* Initialize remote FIFO control structure */
     uct_mm_iface_set_fifo_ptrs(fifo_ptr, &self->fifo_ctl, &self->fifo_elems);
+    uct_mm_ep_get_signal_eventfd(self);
+    self->fifo_size   = iface->config.fifo_size;
+    self->lane_ctl    = NULL;
+    uct_mm_ep_claim_fifo_lane(self);
     self->cached_tail = self->fifo_ctl->tail;
     ucs_arbiter_elem_init(&self->arb_elem);
 
@@ -211,6 +339,8 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
     return UCS_OK;
 
 err_free_segs:
+    uct_mm_ep_release_fifo_lane(self);
+    ucs_async_eventfd_destroy(self->signal_eventfd);
     uct_mm_ep_cleanup_remote_segs(self);
 err_free_md_addr:
     ucs_free(self->remote_iface_addr);
@@ -221,6 +351,8 @@ err:
 static UCS_CLASS_CLEANUP_FUNC(uct_mm_ep_t)
 {
     uct_mm_ep_pending_purge(&self->super.super, NULL, NULL);
+    uct_mm_ep_release_fifo_lane(self);
+    ucs_async_eventfd_destroy(self->signal_eventfd);
     uct_mm_ep_cleanup_remote_segs(self);
     ucs_free(self->remote_iface_addr);
 }
@@ -238,7 +370,7 @@ uct_mm_ep_get_remote_elem(uct_mm_ep_t *ep, uint64_t head,
     uint64_t new_head, prev_head;
     uint64_t elem_index;   /* index of the element to write */
 
-    elem_index = head & iface->fifo_mask;
+    elem_index = head & (ep->fifo_size - 1);
     *elem      = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems, elem_index);
     new_head   = (head + 1) & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
 
@@ -258,6 +390,44 @@ static inline void uct_mm_ep_update_cached_tail(uct_mm_ep_t *ep)
     ep->cached_tail = ep->fifo_ctl->tail;
 }
 
+static UCS_F_ALWAYS_INLINE int uct_mm_ep_is_lane_pending(uct_mm_ep_t *ep)
+{
+    return ucs_unlikely(ep->lane_ctl != NULL) &&
+           (ep->fifo_ctl != ep->lane_ctl);
+}
+
+/* Move the ep to its lane once the receiver opened the lane. The receiver
+ * reads the lane only after the messages the ep sent to the shared FIFO, so
+ * the send order is kept */
+static void uct_mm_ep_switch_to_lane(uct_mm_ep_t *ep)
+{
+    uct_mm_iface_t *iface       = ucs_derived_of(ep->super.super.iface,
+                                                 uct_mm_iface_t);
+    uct_mm_fifo_ctl_t *lane_ctl = ep->lane_ctl;
+    uint64_t lane_tail;
+
+    if (!ucs_arbiter_group_is_empty(&ep->arb_group)) {
+        return;
+    }
+
+    lane_tail = lane_ctl->tail;
+    ucs_memory_cpu_load_fence();
+    if (!UCT_MM_EP_IS_ABLE_TO_SEND(lane_ctl->head, lane_tail,
+                                   iface->config.fifo_lane_size)) {
+        return;
+    }
+
+    /* ordered before the first lane element by the store fence in the send
+     * path */
+    lane_ctl->lane_fifo_index = ep->lane_switch_index;
+
+    ep->fifo_ctl    = lane_ctl;
+    ep->fifo_elems  = UCS_PTR_BYTE_OFFSET(lane_ctl, UCT_MM_FIFO_CTL_SIZE);
+    ep->fifo_size   = iface->config.fifo_lane_size;
+    ep->cached_tail = lane_tail;
+    ucs_debug("mm ep %p: switched to FIFO lane %p", ep, lane_ctl);
+}
+
 static UCS_F_ALWAYS_INLINE void uct_mm_ep_peer_check(uct_mm_ep_t *ep,
                                                      unsigned flags)
 {
@@ -294,10 +464,14 @@ static UCS_F_ALWAYS_INLINE ssize_t uct_mm_ep_am_common_send(
 
     UCT_CHECK_AM_ID(am_id);
 
+    if (uct_mm_ep_is_lane_pending(ep)) {
+        uct_mm_ep_switch_to_lane(ep);
+    }
+
 retry:
     head = ep->fifo_ctl->head;
     /* check if there is room in the remote process's receive FIFO to write */
-    if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail, iface->config.fifo_size)) {
+    if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail, ep->fifo_size)) {
         if (!ucs_arbiter_group_is_empty(&ep->arb_group)) {
             /* pending isn't empty. don't send now to prevent out-of-order sending */
             return uct_mm_ep_no_resources_handle(ep, flags);
@@ -305,7 +479,8 @@ retry:
             /* pending is empty. update the local copy of the tail to its
              * actual value on the remote peer */
             uct_mm_ep_update_cached_tail(ep);
-            if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail, iface->config.fifo_size)) {
+            if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail,
+                                           ep->fifo_size)) {
                 ucs_arbiter_group_push_head_elem_always(&ep->arb_group,
                                                         &ep->arb_elem);
                 ucs_arbiter_group_schedule_nonempty(&iface->arbiter,
@@ -322,6 +497,10 @@ retry:
         goto retry;
     }
 
+    if (uct_mm_ep_is_lane_pending(ep)) {
+        ep->lane_switch_index = (head + 1) & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+    }
+
     switch (send_op) {
     case UCT_MM_SEND_AM_SHORT:
         /* write to the remote FIFO */
@@ -376,7 +555,7 @@ retry:
 
     /* set the owner bit to indicate that the writing is complete.
      * the owner bit flips after every FIFO wraparound */
-    if (head & iface->config.fifo_size) {
+    if (head & ep->fifo_size) {
         elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
     }
     elem->flags = elem_flags;
@@ -442,9 +621,8 @@ ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_
 
 static inline int uct_mm_ep_has_tx_resources(uct_mm_ep_t *ep)
 {
-    uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface, uct_mm_iface_t);
     return UCT_MM_EP_IS_ABLE_TO_SEND(ep->fifo_ctl->head, ep->cached_tail,
-                                     iface->config.fifo_size);
+                                     ep->fifo_size);
 }
 
 ucs_status_t uct_mm_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *n,
@@ -30,6 +30,23 @@ typedef struct uct_mm_ep {
     /* fifo elements (destination's receive fifo) */
     void                       *fifo_elems;
 
+    /* number of elements in the destination FIFO, which is either the shared
+       receive FIFO or a lane of it owned by this ep */
+    unsigned                   fifo_size;
+
+    /* lane of the destination's receive FIFO owned by this ep, or NULL.
+       the ep sends to the shared FIFO until it switches to the lane */
+    uct_mm_fifo_ctl_t          *lane_ctl;
+
+    /* shared FIFO index following the last message this ep sent to it, the
+       receiver reads the lane only after it consumed the shared FIFO up to
+       this index */
+    uint64_t                   lane_switch_index;
+
+    /* the destination's eventfd duplicated into this process, or -1 to wake
+       up the destination through its unix socket */
+    int                        signal_eventfd;
+
     /* the sender's own copy of the remote FIFO's tail.
        it is not always updated with the actual remote tail value */
     uint64_t                   cached_tail;
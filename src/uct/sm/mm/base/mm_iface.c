@@ -17,6 +17,7 @@
 #include <ucs/arch/atomic.h>
 #include <ucs/arch/bitops.h>
 #include <ucs/async/async.h>
+#include <ucs/async/eventfd.h>
 #include <ucs/sys/string.h>
 #include <sys/poll.h>
 
@@ -60,10 +61,30 @@ ucs_config_field_t uct_mm_iface_config_table[] = {
      "Size of the FIFO element size (data + header) in the MM UCTs.",
      ucs_offsetof(uct_mm_iface_config_t, fifo_elem_size), UCS_CONFIG_TYPE_UINT},
 
+    {"FIFO_LANES", "0",
+     "Number of single-producer lanes in the receive FIFO. Every connected sender\n"
+     "claims a free lane, if there is one, and writes only to it, so senders do\n"
+     "not contend on the FIFO head. Senders which did not get a lane use the\n"
+     "shared FIFO. 0 disables the lanes.",
+     ucs_offsetof(uct_mm_iface_config_t, fifo_lanes), UCS_CONFIG_TYPE_UINT},
+
+    {"FIFO_LANE_SIZE", "32",
+     "Number of elements in a receive FIFO lane, must be a power of two and\n"
+     "bigger than 1. A receive descriptor is allocated for every element of a\n"
+     "lane after the lane is claimed by a sender for the first time.",
+     ucs_offsetof(uct_mm_iface_config_t, fifo_lane_size), UCS_CONFIG_TYPE_UINT},
+
     {"FIFO_MAX_POLL", UCS_PP_MAKE_STRING(UCT_MM_IFACE_FIFO_MAX_POLL),
      "Maximal number of receive completions to pick during RX poll",
      ucs_offsetof(uct_mm_iface_config_t, fifo_max_poll), UCS_CONFIG_TYPE_ULUNITS},
 
+    {"EVENTFD_WAKEUP", "y",
+     "Wake up a sleeping receiver by writing to its eventfd, which the sender\n"
+     "duplicates with pidfd_getfd(2) when it connects. A sender which cannot\n"
+     "duplicate the eventfd, for example because of ptrace restrictions, wakes up\n"
+     "the receiver through a unix domain socket.",
+     ucs_offsetof(uct_mm_iface_config_t, eventfd_wakeup), UCS_CONFIG_TYPE_BOOL},
+
     {"ERROR_HANDLING", "n", "Expose error handling support capability",
      ucs_offsetof(uct_mm_iface_config_t, error_handling), UCS_CONFIG_TYPE_BOOL},
 
@@ -295,9 +316,10 @@ uct_mm_assign_desc_to_fifo_elem(uct_mm_iface_t *iface,
     return UCS_OK;
 }
 
-static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
+static UCS_F_ALWAYS_INLINE void
+uct_mm_iface_process_recv(uct_mm_iface_t *iface, uct_mm_fifo_element_t *elem,
+                          uint64_t read_index)
 {
-    uct_mm_fifo_element_t *elem = iface->read_index_elem;
     ucs_status_t status;
     void *data;
 
@@ -305,7 +327,7 @@ static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
         /* read short (inline) messages from the FIFO elements */
         uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_RECV, elem->flags,
                               elem->am_id, elem + 1, elem->length,
-                              iface->read_index);
+                              read_index);
         uct_mm_iface_invoke_am(iface, elem->am_id, elem + 1, elem->length, 0);
         return;
     }
@@ -320,7 +342,7 @@ static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
     data = elem->desc_data;
     VALGRIND_MAKE_MEM_DEFINED(data, elem->length);
     uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_RECV, elem->flags,
-                          elem->am_id, data, elem->length, iface->read_index);
+                          elem->am_id, data, elem->length, read_index);
 
     status = uct_mm_iface_invoke_am(iface, elem->am_id, data, elem->length,
                                     UCT_CB_PARAM_FLAG_DESC);
@@ -354,7 +376,7 @@ uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
     ucs_assert(iface->read_index <=
                (iface->recv_fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
 
-    uct_mm_iface_process_recv(iface);
+    uct_mm_iface_process_recv(iface, iface->read_index_elem, iface->read_index);
 
     /* raise the read_index */
     iface->read_index++;
@@ -369,6 +391,154 @@ uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
     return 1;
 }
 
+static UCS_F_ALWAYS_INLINE unsigned
+uct_mm_iface_poll_lane(uct_mm_iface_t *iface, uct_mm_iface_lane_t *lane)
+{
+    /* same as the shared FIFO, the owner bit flips every lane wraparound */
+    if (((lane->read_index >> iface->lanes.shift) & 1) !=
+        (lane->read_index_elem->flags & 1)) {
+        return 0;
+    }
+
+    ucs_memory_cpu_load_fence();
+
+    /* the messages the lane owner sent to the shared FIFO before it switched
+     * to the lane are delivered first */
+    if (ucs_unlikely(iface->read_index < lane->ctl->lane_fifo_index)) {
+        return 0;
+    }
+
+    uct_mm_iface_process_recv(iface, lane->read_index_elem, lane->read_index);
+
+    lane->read_index++;
+    lane->read_index_elem =
+        UCT_MM_IFACE_GET_FIFO_ELEM(iface, lane->elems,
+                                   lane->read_index &
+                                   (iface->config.fifo_lane_size - 1));
+
+    if (!(lane->read_index & iface->lanes.release_factor_mask)) {
+        ucs_memory_cpu_store_fence();
+        lane->ctl->tail = lane->read_index;
+    }
+
+    return 1;
+}
+
+/* Poll the active lanes and the shared FIFO round-robin, until all of them are
+ * empty or the FIFO window is consumed */
+static unsigned uct_mm_iface_poll_lanes(uct_mm_iface_t *iface)
+{
+    unsigned num_rings   = iface->lanes.num_active + 1;
+    unsigned total_count = 0;
+    unsigned num_empty   = 0;
+    unsigned index, count;
+
+    do {
+        index                   = iface->lanes.poll_index;
+        iface->lanes.poll_index = ((index + 1) == num_rings) ? 0 : (index + 1);
+
+        if (index == iface->lanes.num_active) {
+            count = uct_mm_iface_poll_fifo(iface);
+        } else {
+            count = uct_mm_iface_poll_lane(iface, &iface->lanes.rx[index]);
+        }
+
+        num_empty    = (count == 0) ? (num_empty + 1) : 0;
+        total_count += count;
+    } while ((num_empty < num_rings) && (total_count < iface->fifo_poll_count));
+
+    return total_count;
+}
+
+static int uct_mm_iface_lane_is_active(uct_mm_iface_t *iface,
+                                       const uct_mm_fifo_ctl_t *lane_ctl)
+{
+    unsigned i;
+
+    for (i = 0; i < iface->lanes.num_active; ++i) {
+        if (iface->lanes.rx[i].ctl == lane_ctl) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface, void *elems,
+                                       unsigned num_elems)
+{
+    uct_mm_fifo_element_t *elem;
+    uct_mm_recv_desc_t *desc;
+    unsigned i;
+
+    for (i = 0; i < num_elems; i++) {
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, elems, i);
+        desc = (uct_mm_recv_desc_t*)UCS_PTR_BYTE_OFFSET(elem->desc_data,
+                                                        -iface->rx_headroom) - 1;
+        ucs_mpool_put(desc);
+    }
+}
+
+/* Assign receive descriptors to the lane elements and open the lane for its
+ * sender, which sends to the shared FIFO until the tail is released */
+static ucs_status_t
+uct_mm_iface_activate_lane(uct_mm_iface_t *iface, uct_mm_fifo_ctl_t *lane_ctl)
+{
+    uct_mm_iface_lane_t *lane = &iface->lanes.rx[iface->lanes.num_active];
+    uct_mm_fifo_element_t *elem;
+    ucs_status_t status;
+    unsigned i;
+
+    lane->ctl        = lane_ctl;
+    lane->elems      = UCS_PTR_BYTE_OFFSET(lane_ctl, UCT_MM_FIFO_CTL_SIZE);
+    lane->read_index = 0;
+
+    for (i = 0; i < iface->config.fifo_lane_size; i++) {
+        elem        = UCT_MM_IFACE_GET_FIFO_ELEM(iface, lane->elems, i);
+        elem->flags = UCT_MM_FIFO_ELEM_FLAG_OWNER;
+
+        status = uct_mm_assign_desc_to_fifo_elem(iface, elem, 1);
+        if (status != UCS_OK) {
+            uct_mm_iface_free_rx_descs(iface, lane->elems, i);
+            return status;
+        }
+    }
+
+    lane->read_index_elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, lane->elems, 0);
+    ++iface->lanes.num_active;
+
+    ucs_memory_cpu_store_fence();
+    lane_ctl->tail = 0;
+
+    ucs_debug("mm iface %p: activated FIFO lane %p", iface, lane_ctl);
+    return UCS_OK;
+}
+
+static void uct_mm_iface_activate_lanes(uct_mm_iface_t *iface)
+{
+    uint32_t lanes_gen = iface->recv_fifo_ctl->lanes_gen;
+    uct_mm_fifo_ctl_t *lane_ctl;
+    unsigned i;
+
+    ucs_memory_cpu_load_fence();
+
+    for (i = 0; i < iface->config.fifo_lanes; ++i) {
+        lane_ctl = UCT_MM_IFACE_GET_FIFO_LANE(iface, iface->recv_fifo_ctl, i);
+        if ((lane_ctl->lane_owner == 0) ||
+            uct_mm_iface_lane_is_active(iface, lane_ctl)) {
+            continue;
+        }
+
+        if (uct_mm_iface_activate_lane(iface, lane_ctl) != UCS_OK) {
+            /* retry from the next progress call */
+            ucs_debug("mm iface %p: failed to activate FIFO lane %u", iface, i);
+            return;
+        }
+    }
+
+    iface->lanes.gen = lanes_gen;
+}
+
 static UCS_F_ALWAYS_INLINE void
 uct_mm_iface_fifo_window_adjust(uct_mm_iface_t *iface,
                                 unsigned fifo_poll_count)
@@ -405,13 +575,21 @@ static unsigned uct_mm_iface_progress(uct_iface_h tl_iface)
 
     ucs_assert(iface->fifo_poll_count >= UCT_MM_IFACE_FIFO_MIN_POLL);
 
+    if (ucs_unlikely(iface->recv_fifo_ctl->lanes_gen != iface->lanes.gen)) {
+        uct_mm_iface_activate_lanes(iface);
+    }
+
     /* progress receive */
-    do {
-        count = uct_mm_iface_poll_fifo(iface);
-        ucs_assert(count < 2);
-        total_count += count;
-        ucs_assert(total_count < UINT_MAX);
-    } while ((count != 0) && (total_count < iface->fifo_poll_count));
+    if (ucs_likely(iface->lanes.num_active == 0)) {
+        do {
+            count = uct_mm_iface_poll_fifo(iface);
+            ucs_assert(count < 2);
+            total_count += count;
+            ucs_assert(total_count < UINT_MAX);
+        } while ((count != 0) && (total_count < iface->fifo_poll_count));
+    } else {
+        total_count = uct_mm_iface_poll_lanes(iface);
+    }
 
     uct_mm_iface_fifo_window_adjust(iface, total_count);
 
@@ -424,17 +602,58 @@ static unsigned uct_mm_iface_progress(uct_iface_h tl_iface)
 
 static ucs_status_t uct_mm_iface_event_fd_get(uct_iface_h tl_iface, int *fd_p)
 {
-    *fd_p = ucs_derived_of(tl_iface, uct_mm_iface_t)->signal_fd;
+    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
+
+    if (iface->signal_event_set != NULL) {
+        return ucs_event_set_fd_get(iface->signal_event_set, fd_p);
+    }
+
+    *fd_p = iface->signal_fd;
     return UCS_OK;
 }
 
 
+/* Make the next sender which writes to the FIFO signal the receiver */
+static ucs_status_t
+uct_mm_iface_fifo_arm(uct_mm_iface_t *iface, uct_mm_fifo_ctl_t *fifo_ctl,
+                      uint64_t read_index)
+{
+    uint64_t head, prev_head;
+
+    head = fifo_ctl->head;
+    if ((head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) > read_index) {
+        /* head element was not read yet */
+        ucs_trace("iface %p: cannot arm, head %" PRIu64 " read_index %" PRIu64,
+                  iface, head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED,
+                  read_index);
+        return UCS_ERR_BUSY;
+    }
+
+    if (!(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
+        /* Try to mark the head index as armed in an atomic way; fail if any
+           sender managed to update the head at the same time */
+        prev_head = ucs_atomic_cswap64(ucs_unaligned_ptr(&fifo_ctl->head), head,
+                                       head | UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
+        if (prev_head != head) {
+            /* race with sender; need to retry */
+            ucs_assert(!(prev_head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
+            ucs_trace("iface %p: cannot arm, head %" PRIu64
+                      " prev_head %" PRIu64,
+                      iface, head, prev_head);
+            return UCS_ERR_BUSY;
+        }
+    }
+
+    return UCS_OK;
+}
+
 static ucs_status_t
 uct_mm_iface_event_fd_arm(uct_iface_h tl_iface, unsigned events)
 {
     uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
     char dummy[UCT_MM_IFACE_MAX_SIG_EVENTS]; /* pop multiple signals at once */
-    uint64_t head, prev_head;
+    uct_mm_iface_lane_t *lane;
+    ucs_status_t status;
     int ret;
 
     if ((events & UCT_EVENT_SEND_COMP) &&
@@ -448,41 +667,45 @@ uct_mm_iface_event_fd_arm(uct_iface_h tl_iface, unsigned events)
         return UCS_OK;
     }
 
-    /* Make the next sender which writes to the FIFO signal the receiver */
-    head = iface->recv_fifo_ctl->head;
-    if ((head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) > iface->read_index) {
-        /* head element was not read yet */
-        ucs_trace("iface %p: cannot arm, head %" PRIu64 " read_index %" PRIu64,
-                  iface, head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED,
-                  iface->read_index);
+    status = uct_mm_iface_fifo_arm(iface, iface->recv_fifo_ctl,
+                                   iface->read_index);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* a sender which claims a lane after the shared FIFO was armed signals,
+     * otherwise its claim is noticed here */
+    if (iface->recv_fifo_ctl->lanes_gen != iface->lanes.gen) {
+        ucs_trace("iface %p: cannot arm, FIFO lanes were claimed", iface);
         return UCS_ERR_BUSY;
     }
 
-    if (!(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
-        /* Try to mark the head index as armed in an atomic way; fail if any
-           sender managed to update the head at the same time */
-        prev_head = ucs_atomic_cswap64(
-                ucs_unaligned_ptr(&iface->recv_fifo_ctl->head), head,
-                head | UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
-        if (prev_head != head) {
-            /* race with sender; need to retry */
-            ucs_assert(!(prev_head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
-            ucs_trace("iface %p: cannot arm, head %" PRIu64
-                      " prev_head %" PRIu64,
-                      iface, head, prev_head);
+    for (lane = iface->lanes.rx;
+         lane < (iface->lanes.rx + iface->lanes.num_active); ++lane) {
+        status = uct_mm_iface_fifo_arm(iface, lane->ctl, lane->read_index);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    /* check for pending events, the eventfd counts all of them */
+    if (iface->signal_eventfd != UCS_ASYNC_EVENTFD_INVALID_FD) {
+        status = ucs_async_eventfd_poll(iface->signal_eventfd);
+        if (status == UCS_OK) {
+            ucs_trace("iface %p: cannot arm, got an eventfd signal", iface);
             return UCS_ERR_BUSY;
+        } else if (status != UCS_ERR_NO_PROGRESS) {
+            return status;
         }
     }
 
-    /* check for pending events */
     ret = recvfrom(iface->signal_fd, &dummy, sizeof(dummy), 0, NULL, 0);
     if (ret > 0) {
         ucs_trace("iface %p: cannot arm, got a signal", iface);
         return UCS_ERR_BUSY;
     } else if (ret == -1) {
         if (errno == EAGAIN) {
-            ucs_trace("iface %p: armed head %" PRIu64 " read_index %" PRIu64,
-                      iface, head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED,
+            ucs_trace("iface %p: armed read_index %" PRIu64, iface,
                       iface->read_index);
             return UCS_OK;
         } else if (errno == EINTR) {
@@ -635,20 +858,6 @@ static void uct_mm_iface_recv_desc_init(uct_iface_h tl_iface, void *obj,
     desc->info.offset   = offset;
 }
 
-static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface, unsigned num_elems)
-{
-    uct_mm_fifo_element_t *elem;
-    uct_mm_recv_desc_t *desc;
-    unsigned i;
-
-    for (i = 0; i < num_elems; i++) {
-        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems, i);
-        desc = (uct_mm_recv_desc_t*)UCS_PTR_BYTE_OFFSET(elem->desc_data,
-                                                        -iface->rx_headroom) - 1;
-        ucs_mpool_put(desc);
-    }
-}
-
 void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
                                 void **fifo_elems_p)
 {
@@ -673,11 +882,65 @@ void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
     *fifo_elems_p = UCS_PTR_BYTE_OFFSET(fifo_ctl, UCT_MM_FIFO_CTL_SIZE);
 }
 
-static ucs_status_t uct_mm_iface_create_signal_fd(uct_mm_iface_t *iface)
+/* Create an eventfd the senders can duplicate to wake up this process, and an
+ * event set which polls it together with the signal socket */
+static ucs_status_t
+uct_mm_iface_create_signal_eventfd(uct_mm_iface_t *iface,
+                                   const uct_mm_iface_config_t *mm_config)
+{
+    ucs_status_t status;
+
+    iface->signal_eventfd                = UCS_ASYNC_EVENTFD_INVALID_FD;
+    iface->signal_event_set              = NULL;
+    iface->recv_fifo_ctl->signal_eventfd = UCS_ASYNC_EVENTFD_INVALID_FD;
+    iface->recv_fifo_ctl->pid_ns         = ucs_sys_get_ns(UCS_SYS_NS_TYPE_PID);
+    if (!mm_config->eventfd_wakeup) {
+        return UCS_OK;
+    }
+
+    status = ucs_async_eventfd_create(&iface->signal_eventfd);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucs_event_set_create(&iface->signal_event_set);
+    if (status != UCS_OK) {
+        goto err_destroy_eventfd;
+    }
+
+    status = ucs_event_set_add(iface->signal_event_set, iface->signal_fd,
+                               UCS_EVENT_SET_EVREAD, NULL);
+    if (status != UCS_OK) {
+        goto err_cleanup_event_set;
+    }
+
+    status = ucs_event_set_add(iface->signal_event_set, iface->signal_eventfd,
+                               UCS_EVENT_SET_EVREAD, NULL);
+    if (status != UCS_OK) {
+        goto err_cleanup_event_set;
+    }
+
+    iface->recv_fifo_ctl->signal_eventfd = iface->signal_eventfd;
+    return UCS_OK;
+
+err_cleanup_event_set:
+    ucs_event_set_cleanup(iface->signal_event_set);
+    iface->signal_event_set = NULL;
+err_destroy_eventfd:
+    ucs_async_eventfd_destroy(iface->signal_eventfd);
+    iface->signal_eventfd = UCS_ASYNC_EVENTFD_INVALID_FD;
+    return status;
+}
+
+static ucs_status_t
+uct_mm_iface_create_signal_fd(uct_mm_iface_t *iface,
+                              const uct_mm_iface_config_t *mm_config)
 {
     ucs_status_t status;
     socklen_t addrlen;
     struct sockaddr_un bind_addr;
+    uct_mm_fifo_ctl_t *lane_ctl;
+    unsigned i;
     int ret;
 
     /* Create a UNIX domain socket to send and receive wakeup signal from remote processes */
@@ -719,6 +982,21 @@ static ucs_status_t uct_mm_iface_create_signal_fd(uct_mm_iface_t *iface)
     }
 
     iface->recv_fifo_ctl->signal_addrlen = addrlen;
+
+    /* A sender which owns a lane signals the receiver using the lane */
+    for (i = 0; i < iface->config.fifo_lanes; ++i) {
+        lane_ctl = UCT_MM_IFACE_GET_FIFO_LANE(iface, iface->recv_fifo_ctl, i);
+        lane_ctl->signal_addrlen = addrlen;
+        memcpy(ucs_unaligned_ptr(&lane_ctl->signal_sockaddr),
+               ucs_unaligned_ptr(&iface->recv_fifo_ctl->signal_sockaddr),
+               addrlen);
+    }
+
+    status = uct_mm_iface_create_signal_eventfd(iface, mm_config);
+    if (status != UCS_OK) {
+        goto err_close;
+    }
+
     return UCS_OK;
 
 err_close:
@@ -727,14 +1005,69 @@ err:
     return status;
 }
 
+static void uct_mm_iface_close_signal_fds(uct_mm_iface_t *iface)
+{
+    if (iface->signal_event_set != NULL) {
+        ucs_event_set_cleanup(iface->signal_event_set);
+    }
+
+    ucs_async_eventfd_destroy(iface->signal_eventfd);
+    close(iface->signal_fd);
+}
+
+static ucs_status_t
+uct_mm_iface_lanes_init(uct_mm_iface_t *iface,
+                        const uct_mm_iface_config_t *mm_config)
+{
+    uct_mm_fifo_ctl_t *lane_ctl;
+    unsigned i;
+
+    iface->lanes.rx         = NULL;
+    iface->lanes.num_active = 0;
+    iface->lanes.poll_index = 0;
+    iface->lanes.gen        = 0;
+    if (iface->config.fifo_lanes == 0) {
+        return UCS_OK;
+    }
+
+    iface->lanes.shift               = ucs_count_trailing_zero_bits(
+                                               iface->config.fifo_lane_size);
+    iface->lanes.release_factor_mask = UCS_MASK(ucs_ilog2(ucs_max((int)
+            (iface->config.fifo_lane_size * mm_config->release_fifo_factor),
+            1)));
+
+    iface->lanes.rx = ucs_calloc(iface->config.fifo_lanes,
+                                 sizeof(*iface->lanes.rx), "mm_fifo_lanes");
+    if (iface->lanes.rx == NULL) {
+        ucs_error("failed to allocate %u MM FIFO lanes",
+                  iface->config.fifo_lanes);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    /* The lane elements are initialized when a sender claims the lane, until
+     * then the tail makes the lane look full to the sender */
+    for (i = 0; i < iface->config.fifo_lanes; ++i) {
+        lane_ctl                  = UCT_MM_IFACE_GET_FIFO_LANE(
+                                            iface, iface->recv_fifo_ctl, i);
+        lane_ctl->head            = 0;
+        lane_ctl->tail            = -(uint64_t)iface->config.fifo_lane_size;
+        lane_ctl->pid             = iface->recv_fifo_ctl->pid;
+        lane_ctl->lane_owner      = 0;
+        lane_ctl->lane_fifo_index = 0;
+    }
+
+    return UCS_OK;
+}
+
 static void uct_mm_iface_log_created(uct_mm_iface_t *iface)
 {
     uct_mm_seg_t *seg = iface->recv_fifo_mem.memh;
 
     ucs_debug("created mm iface %p FIFO id 0x%"PRIx64
-              " va %p size %zu (%u x %u elems)",
+              " va %p size %zu (%u x %u elems, %u lanes x %u elems)",
               iface, seg->seg_id, seg->address, seg->length,
-              iface->config.fifo_elem_size, iface->config.fifo_size);
+              iface->config.fifo_elem_size, iface->config.fifo_size,
+              iface->config.fifo_lanes, iface->config.fifo_lane_size);
 }
 
 static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
@@ -764,6 +1097,16 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto err;
     }
 
+    /* check that the lane size is a power of two and bigger than 1 */
+    if ((mm_config->fifo_lanes > 0) &&
+        ((mm_config->fifo_lane_size <= 1) ||
+         !ucs_is_pow2(mm_config->fifo_lane_size))) {
+        ucs_error("The MM FIFO lane size must be a power of two and bigger "
+                  "than 1.");
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     /* check the value defining the FIFO batch release */
     if ((mm_config->release_fifo_factor < 0) || (mm_config->release_fifo_factor >= 1)) {
         ucs_error("The MM release FIFO factor must be: (0 =< factor < 1).");
@@ -783,6 +1126,9 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
     self->config.overhead          = mm_config->overhead;
     self->config.fifo_size         = mm_config->fifo_size;
     self->config.fifo_elem_size    = mm_config->fifo_elem_size;
+    self->config.fifo_lanes        = mm_config->fifo_lanes;
+    self->config.fifo_lane_size    = (mm_config->fifo_lanes > 0) ?
+                                     mm_config->fifo_lane_size : 0;
     self->config.seg_size          = mm_config->seg_size;
     self->config.fifo_max_poll     = ((mm_config->fifo_max_poll == UCS_ULUNITS_AUTO) ?
                                       UCT_MM_IFACE_FIFO_MAX_POLL :
@@ -817,9 +1163,18 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
 
     uct_mm_iface_set_fifo_ptrs(self->recv_fifo_mem.address,
                                &self->recv_fifo_ctl, &self->recv_fifo_elems);
-    self->recv_fifo_ctl->head = 0;
-    self->recv_fifo_ctl->tail = 0;
-    self->recv_fifo_ctl->pid  = getpid();
+    self->recv_fifo_ctl->head           = 0;
+    self->recv_fifo_ctl->tail           = 0;
+    self->recv_fifo_ctl->pid            = getpid();
+    self->recv_fifo_ctl->lanes_gen      = 0;
+    self->recv_fifo_ctl->fifo_lanes     = self->config.fifo_lanes;
+    self->recv_fifo_ctl->fifo_lane_size = self->config.fifo_lane_size;
+
+    status = uct_mm_iface_lanes_init(self, mm_config);
+    if (status != UCS_OK) {
+        goto err_free_fifo;
+    }
+
     self->read_index          = 0;
     self->read_index_elem     = UCT_MM_IFACE_GET_FIFO_ELEM(self,
                                                            self->recv_fifo_elems,
@@ -827,9 +1182,9 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
     payload_offset            = sizeof(uct_mm_recv_desc_t) + self->rx_headroom;
 
     /* create a unix file descriptor to receive event notifications */
-    status = uct_mm_iface_create_signal_fd(self);
+    status = uct_mm_iface_create_signal_fd(self, mm_config);
     if (status != UCS_OK) {
-        goto err_free_fifo;
+        goto err_free_lanes;
     }
 
     status = uct_iface_param_am_alignment(params, self->config.seg_size,
@@ -878,12 +1233,14 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
     return UCS_OK;
 
 destroy_descs:
-    uct_mm_iface_free_rx_descs(self, i);
+    uct_mm_iface_free_rx_descs(self, self->recv_fifo_elems, i);
     ucs_mpool_put(self->last_recv_desc);
 destroy_recv_mpool:
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
 err_close_signal_fd:
-    close(self->signal_fd);
+    uct_mm_iface_close_signal_fds(self);
+err_free_lanes:
+    ucs_free(self->lanes.rx);
 err_free_fifo:
     uct_iface_mem_free(&self->recv_fifo_mem);
 err:
@@ -892,16 +1249,24 @@ err:
 
 static UCS_CLASS_CLEANUP_FUNC(uct_mm_iface_t)
 {
+    unsigned i;
+
     uct_base_iface_progress_disable(&self->super.super.super,
                                     UCT_PROGRESS_SEND | UCT_PROGRESS_RECV);
 
     /* return all the descriptors that are now 'assigned' to the FIFO,
      * to their mpool */
-    uct_mm_iface_free_rx_descs(self, self->config.fifo_size);
+    uct_mm_iface_free_rx_descs(self, self->recv_fifo_elems,
+                               self->config.fifo_size);
+    for (i = 0; i < self->lanes.num_active; ++i) {
+        uct_mm_iface_free_rx_descs(self, self->lanes.rx[i].elems,
+                                   self->config.fifo_lane_size);
+    }
+    ucs_free(self->lanes.rx);
 
     ucs_mpool_put(self->last_recv_desc);
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
-    close(self->signal_fd);
+    uct_mm_iface_close_signal_fds(self);
     uct_iface_mem_free(&self->recv_fifo_mem);
     ucs_arbiter_cleanup(&self->arbiter);
 }
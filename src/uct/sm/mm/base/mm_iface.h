@@ -16,6 +16,7 @@
 #include <ucs/debug/memtrack_int.h>
 #include <ucs/datastruct/arbiter.h>
 #include <ucs/sys/compiler.h>
+#include <ucs/sys/event_set.h>
 #include <ucs/sys/ptr_arith.h>
 #include <ucs/sys/sys.h>
 #include <sys/shm.h>
@@ -36,9 +37,24 @@ enum {
     ucs_align_up(sizeof(uct_mm_fifo_ctl_t), UCS_SYS_CACHE_LINE_SIZE)
 
 
+/* Offset of the first FIFO lane from the FIFO control structure */
+#define UCT_MM_FIFO_LANES_OFFSET(_iface) \
+    ucs_align_up(UCT_MM_FIFO_CTL_SIZE + \
+                 ((_iface)->config.fifo_size * (_iface)->config.fifo_elem_size), \
+                 UCS_SYS_CACHE_LINE_SIZE)
+
+
+/* Size of a FIFO lane, which is a control structure followed by elements */
+#define UCT_MM_FIFO_LANE_SIZE(_iface) \
+    ucs_align_up(UCT_MM_FIFO_CTL_SIZE + \
+                 ((_iface)->config.fifo_lane_size * \
+                  (_iface)->config.fifo_elem_size), \
+                 UCS_SYS_CACHE_LINE_SIZE)
+
+
 #define UCT_MM_GET_FIFO_SIZE(_iface) \
-    (UCT_MM_FIFO_CTL_SIZE + \
-     ((_iface)->config.fifo_size * (_iface)->config.fifo_elem_size) + \
+    (UCT_MM_FIFO_LANES_OFFSET(_iface) + \
+     ((_iface)->config.fifo_lanes * UCT_MM_FIFO_LANE_SIZE(_iface)) + \
       (UCS_SYS_CACHE_LINE_SIZE - 1))
 
 
@@ -47,6 +63,12 @@ enum {
      UCS_PTR_BYTE_OFFSET(_fifo, (_index) * (_iface)->config.fifo_elem_size))
 
 
+#define UCT_MM_IFACE_GET_FIFO_LANE(_iface, _fifo_ctl, _index) \
+    ((uct_mm_fifo_ctl_t*) \
+     UCS_PTR_BYTE_OFFSET(_fifo_ctl, UCT_MM_FIFO_LANES_OFFSET(_iface) + \
+                                    ((_index) * UCT_MM_FIFO_LANE_SIZE(_iface))))
+
+
 #define uct_mm_iface_mapper_call(_iface, _func, ...) \
     ({ \
         uct_mm_md_t *md = ucs_derived_of((_iface)->super.super.md, uct_mm_md_t); \
@@ -114,6 +136,12 @@ typedef struct uct_mm_iface_config {
     ucs_ternary_auto_value_t hugetlb_mode;        /* Enable using huge pages for
                                                    * shared memory buffers */
     unsigned                 fifo_elem_size;      /* Size of the FIFO element size */
+    unsigned                 fifo_lanes;          /* Number of single-producer
+                                                   * lanes in the receive FIFO */
+    unsigned                 fifo_lane_size;      /* Number of elements in a
+                                                   * FIFO lane */
+    int                      eventfd_wakeup;      /* Wake up the receiver through
+                                                   * an eventfd */
     int                      error_handling; /* Exposing of error handling cap */
     uct_iface_mpool_config_t mp;
     uct_mm_iface_overhead_t  overhead;
@@ -144,6 +172,23 @@ typedef struct uct_mm_fifo_ctl {
     /* 2nd cacheline */
     volatile uint64_t         tail;           /* How much was consumed */
     pid_t                     pid;            /* Process owner pid */
+    ucs_sys_ns_t              pid_ns;         /* PID namespace of the owner */
+    int                       signal_eventfd; /* Owner's eventfd for wakeup
+                                                 signals, or -1 */
+    volatile uint32_t         lanes_gen;      /* Incremented by a sender after
+                                                 it claimed a lane, used only
+                                                 in the shared FIFO */
+    uint32_t                  fifo_lanes;     /* Number of FIFO lanes, used
+                                                 only in the shared FIFO */
+    uint32_t                  fifo_lane_size; /* Number of elements in a FIFO
+                                                 lane, used only in the shared
+                                                 FIFO */
+    volatile uint32_t         lane_owner;     /* Non-zero if the lane is claimed
+                                                 by a sender, used only in the
+                                                 FIFO lanes */
+    volatile uint64_t         lane_fifo_index;/* Shared FIFO index the lane
+                                                 owner's messages follow, used
+                                                 only in the FIFO lanes */
 } UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) uct_mm_fifo_ctl_t;
 
 
@@ -190,6 +235,17 @@ typedef struct uct_mm_recv_desc {
 } uct_mm_recv_desc_t;
 
 
+/**
+ * Receive side of a FIFO lane, which is written by a single sender
+ */
+typedef struct uct_mm_iface_lane {
+    uct_mm_fifo_ctl_t       *ctl;             /* Lane control structure */
+    void                    *elems;           /* First element of the lane */
+    uct_mm_fifo_element_t   *read_index_elem;
+    uint64_t                read_index;       /* Actual reading location */
+} uct_mm_iface_lane_t;
+
+
 /**
  * MM transport interface
  */
@@ -219,10 +275,27 @@ typedef struct uct_mm_iface {
     int                     fifo_prev_wnd_cons;  /* Was FIFO window size fully consumed by
                                                   * the previous call to iface progress */
 
+    struct {
+        uct_mm_iface_lane_t *rx;              /* Receive state of every lane,
+                                                 the first num_active are
+                                                 polled */
+        unsigned            num_active;       /* Number of lanes claimed by
+                                                 senders at least once */
+        unsigned            poll_index;       /* Next lane to poll, num_active
+                                                 stands for the shared FIFO */
+        uint32_t            gen;              /* Last seen value of lanes_gen */
+        uint8_t             shift;            /* = log2(fifo_lane_size) */
+        uint64_t            release_factor_mask;
+    } lanes;
+
     ucs_mpool_t             recv_desc_mp;
     uct_mm_recv_desc_t      *last_recv_desc;  /* next receive descriptor to use */
 
     int                     signal_fd;        /* Unix socket for receiving remote signal */
+    int                     signal_eventfd;   /* Eventfd for receiving remote
+                                                 signal, or -1 */
+    ucs_sys_event_set_t     *signal_event_set;/* Polls both signal fds, NULL if
+                                                 there is no eventfd */
 
     size_t                  rx_headroom;
     ucs_arbiter_t           arbiter;
@@ -231,6 +304,8 @@ typedef struct uct_mm_iface {
     struct {
         unsigned                fifo_size;
         unsigned                fifo_elem_size;
+        unsigned                fifo_lanes;
+        unsigned                fifo_lane_size;
         /* size of the receive descriptor (for payload) */
         unsigned                seg_size;
         unsigned                fifo_max_poll;
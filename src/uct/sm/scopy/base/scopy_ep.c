@@ -29,8 +29,35 @@ UCS_CLASS_INIT_FUNC(uct_scopy_ep_t, const uct_ep_params_t *params)
     return UCS_OK;
 }
 
+static ucs_arbiter_cb_result_t
+uct_scopy_ep_purge_cb(ucs_arbiter_t *arbiter, ucs_arbiter_group_t *group,
+                      ucs_arbiter_elem_t *elem, void *arg)
+{
+    uct_scopy_iface_t *iface = (uct_scopy_iface_t*)arg;
+    uct_scopy_tx_t *tx       = ucs_container_of(elem, uct_scopy_tx_t,
+                                                arb_elem);
+
+    if (tx->mt.length != 0) {
+        /* Helper threads must not access the endpoint and the operation
+         * after they are released */
+        uct_scopy_iface_mt_cancel(iface, tx);
+    }
+
+    if (tx->comp != NULL) {
+        uct_invoke_completion(tx->comp, UCS_ERR_CANCELED);
+    }
+
+    ucs_mpool_put_inline(tx);
+    return UCS_ARBITER_CB_RESULT_REMOVE_ELEM;
+}
+
 static UCS_CLASS_CLEANUP_FUNC(uct_scopy_ep_t)
 {
+    uct_scopy_iface_t *iface = ucs_derived_of(self->super.super.iface,
+                                              uct_scopy_iface_t);
+
+    ucs_arbiter_group_purge(&iface->arbiter, &self->arb_group,
+                            uct_scopy_ep_purge_cb, iface);
     ucs_arbiter_group_cleanup(&self->arb_group);
 }
 
@@ -40,8 +67,9 @@ static UCS_F_ALWAYS_INLINE void
 uct_scopy_ep_tx_init_common(uct_scopy_tx_t *tx, uct_scopy_tx_op_t tx_op,
                             uct_completion_t *comp)
 {
-    tx->comp = comp;
-    tx->op   = tx_op;
+    tx->comp      = comp;
+    tx->op        = tx_op;
+    tx->mt.length = 0;
     ucs_arbiter_elem_init(&tx->arb_elem);
 }
 
@@ -124,6 +152,111 @@ ucs_status_t uct_scopy_ep_get_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
                                 rkey, comp, UCT_SCOPY_TX_GET_ZCOPY);
 }
 
+static void uct_scopy_ep_tx_iov_iter_seek(const uct_scopy_tx_t *tx,
+                                          size_t offset,
+                                          ucs_iov_iter_t *iov_iter)
+{
+    size_t iov_length;
+
+    ucs_iov_iter_init(iov_iter);
+    for (;;) {
+        ucs_assert(iov_iter->iov_index < tx->iov_cnt);
+        iov_length = uct_iov_get_length(&tx->iov[iov_iter->iov_index]);
+        if (offset < iov_length) {
+            break;
+        }
+
+        offset -= iov_length;
+        ++iov_iter->iov_index;
+    }
+
+    iov_iter->buffer_offset = offset;
+}
+
+ucs_status_t uct_scopy_ep_tx_segment(uct_scopy_ep_t *ep, uct_scopy_tx_t *tx,
+                                     uct_scopy_ep_tx_func_t tx_func,
+                                     size_t offset, size_t length)
+{
+    ucs_iov_iter_t iov_iter;
+    size_t seg_length;
+    ucs_status_t status;
+
+    while (length > 0) {
+        uct_scopy_ep_tx_iov_iter_seek(tx, offset, &iov_iter);
+        seg_length = length;
+        status     = tx_func(&ep->super.super, tx->iov, tx->iov_cnt, &iov_iter,
+                             &seg_length, tx->remote_addr + offset, tx->rkey,
+                             tx->op);
+        if (ucs_unlikely(status != UCS_OK)) {
+            return status;
+        } else if (ucs_unlikely(seg_length == 0)) {
+            return UCS_ERR_IO_ERROR;
+        }
+
+        offset += seg_length;
+        length -= seg_length;
+    }
+
+    return UCS_OK;
+}
+
+/* Copy a segment of the operation split between helper threads and check
+ * whether all segments are completed */
+static ucs_status_t
+uct_scopy_ep_progress_tx_mt(uct_scopy_iface_t *iface, uct_scopy_ep_t *ep,
+                            uct_scopy_tx_t *tx, unsigned *count)
+{
+    size_t offset, length;
+    ucs_status_t status;
+
+    length = uct_scopy_iface_mt_claim(iface, tx, &offset);
+    if (length != 0) {
+        status = uct_scopy_ep_tx_segment(ep, tx, iface->mt.tx, offset, length);
+        uct_scopy_iface_mt_seg_done(iface, tx, offset, length, status);
+        (*count)++;
+    }
+
+    if (tx->mt.done < tx->mt.length) {
+        return UCS_INPROGRESS;
+    }
+
+    ucs_memory_cpu_load_fence();
+    if (ucs_likely(tx->mt.status == UCS_OK)) {
+        return UCS_OK;
+    }
+
+    /* Repeat the failed segment from the progress context to report the
+     * error on the endpoint */
+    length = ucs_min(iface->config.seg_size,
+                     tx->mt.length - tx->mt.failed_offset);
+    status = uct_scopy_ep_tx_segment(ep, tx, iface->tx, tx->mt.failed_offset,
+                                     length);
+    return (status == UCS_OK) ? tx->mt.status : status;
+}
+
+/* Split a large operation between helper threads when it reaches the head of
+ * the endpoint's group, so it is not copied before the preceding operations */
+static void uct_scopy_ep_tx_mt_post(uct_scopy_iface_t *iface,
+                                    uct_scopy_ep_t *ep, uct_scopy_tx_t *tx)
+{
+    size_t length;
+
+    if ((tx->mt.length != 0) || (tx->op == UCT_SCOPY_TX_FLUSH_COMP) ||
+        (tx->iov_iter.iov_index != 0) || (tx->iov_iter.buffer_offset != 0)) {
+        return;
+    }
+
+    length = uct_iov_total_length(tx->iov, tx->iov_cnt);
+    if (length < iface->mt.thresh) {
+        return;
+    }
+
+    uct_scopy_iface_mt_post(iface, ep, tx, length);
+    ucs_trace_data("%s [tx %p length %zu] to %" PRIx64 "(%+ld) posted to "
+                   "%u helper threads", uct_scopy_tx_op_str[tx->op], tx,
+                   length, tx->remote_addr, tx->rkey, iface->mt.num_threads);
+}
+
 ucs_arbiter_cb_result_t uct_scopy_ep_progress_tx(ucs_arbiter_t *arbiter,
                                                  ucs_arbiter_group_t *group,
                                                  ucs_arbiter_elem_t *elem,
@@ -143,7 +276,13 @@ ucs_arbiter_cb_result_t uct_scopy_ep_progress_tx(ucs_arbiter_t *arbiter,
         return UCS_ARBITER_CB_RESULT_STOP;
     }
 
-    if (tx->op != UCT_SCOPY_TX_FLUSH_COMP) {
+    uct_scopy_ep_tx_mt_post(iface, ep, tx);
+    if (tx->mt.length != 0) {
+        status = uct_scopy_ep_progress_tx_mt(iface, ep, tx, count);
+        if (status == UCS_INPROGRESS) {
+            return UCS_ARBITER_CB_RESULT_RESCHED_GROUP;
+        }
+    } else if (tx->op != UCT_SCOPY_TX_FLUSH_COMP) {
         ucs_assert((tx->op == UCT_SCOPY_TX_GET_ZCOPY) ||
                    (tx->op == UCT_SCOPY_TX_PUT_ZCOPY));
         seg_size = iface->config.seg_size;
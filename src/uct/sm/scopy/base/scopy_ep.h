@@ -8,6 +8,7 @@
 
 #include <uct/base/uct_iface.h>
 #include <uct/sm/base/sm_ep.h>
+#include <ucs/datastruct/list.h>
 #include <ucs/sys/iovec.h>
 
 
@@ -52,6 +53,22 @@ typedef struct uct_scopy_tx {
     uct_rkey_t                      rkey;               /* User-passed UCT rkey */
     uct_completion_t                *comp;              /* The pointer to the user's passed completion */
     ucs_iov_iter_t                  iov_iter;           /* UCT IOVs iterator */
+    struct {
+        ucs_list_link_t             list;               /* Entry in the queue of
+                                                         * helper threads */
+        struct uct_scopy_ep         *ep;                /* Endpoint of the operation */
+        size_t                      length;             /* Total length, or 0 if the
+                                                         * operation is not split
+                                                         * between helper threads */
+        size_t                      offset;             /* Offset of the first
+                                                         * unclaimed segment */
+        volatile uint64_t           done;               /* Length of the completed
+                                                         * segments */
+        ucs_status_t                status;             /* Status of the first
+                                                         * failed segment */
+        size_t                      failed_offset;      /* Offset of the first
+                                                         * failed segment */
+    } mt;
     size_t                          iov_cnt;            /* The number of the UCT IOVs */
     uct_iov_t                       iov[];              /* UCT IOVs */
 } uct_scopy_tx_t;
@@ -78,6 +95,10 @@ ucs_arbiter_cb_result_t uct_scopy_ep_progress_tx(ucs_arbiter_t *arbiter,
                                                  ucs_arbiter_elem_t *elem,
                                                  void *arg);
 
+ucs_status_t uct_scopy_ep_tx_segment(uct_scopy_ep_t *ep, uct_scopy_tx_t *tx,
+                                     uct_scopy_ep_tx_func_t tx_func,
+                                     size_t offset, size_t length);
+
 ucs_status_t uct_scopy_ep_flush(uct_ep_h tl_ep, unsigned flags,
                                 uct_completion_t *comp);
 
@@ -10,7 +10,9 @@
 #include "scopy_iface.h"
 #include "scopy_ep.h"
 
+#include <ucs/arch/atomic.h>
 #include <ucs/arch/cpu.h>
+#include <ucs/memory/numa.h>
 #include <ucs/sys/string.h>
 
 #include <uct/sm/base/sm_iface.h>
@@ -51,6 +53,19 @@ ucs_config_field_t uct_scopy_iface_config_table[] = {
     UCT_IFACE_MPOOL_CONFIG_FIELDS("TX_", -1, 8, 128m, 1.0, "send",
                                   ucs_offsetof(uct_scopy_iface_config_t, tx_mpool), ""),
 
+    {"TX_THREADS", "0",
+     "Number of helper threads which copy segments of large GET/PUT Zcopy\n"
+     "operations in parallel with the progress thread. The threads run on the\n"
+     "CPUs of the NUMA node where the interface is created. 0 disables the\n"
+     "helper threads.",
+     ucs_offsetof(uct_scopy_iface_config_t, tx_threads), UCS_CONFIG_TYPE_UINT},
+
+    {"TX_THREADS_THRESH", "4m",
+     "Minimal length of a GET/PUT Zcopy operation which is split between the\n"
+     "helper threads",
+     ucs_offsetof(uct_scopy_iface_config_t, tx_threads_thresh),
+     UCS_CONFIG_TYPE_MEMUNITS},
+
     {NULL}
 };
 
@@ -116,6 +131,232 @@ uct_scopy_iface_estimate_perf(uct_iface_h iface, uct_perf_attr_t *perf_attr)
     return UCS_OK;
 }
 
+/* Must be called with the lock held */
+static size_t
+uct_scopy_iface_mt_claim_locked(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx,
+                                size_t *offset_p)
+{
+    size_t length;
+
+    *offset_p = tx->mt.offset;
+    if (tx->mt.offset == tx->mt.length) {
+        return 0;
+    }
+
+    length         = ucs_min(iface->config.seg_size,
+                             tx->mt.length - tx->mt.offset);
+    tx->mt.offset += length;
+    if (tx->mt.offset == tx->mt.length) {
+        ucs_list_del(&tx->mt.list);
+    }
+
+    return length;
+}
+
+static void *uct_scopy_iface_mt_thread_func(void *arg)
+{
+    uct_scopy_iface_t *iface = arg;
+    uct_scopy_tx_t *tx;
+    size_t offset, length;
+    ucs_status_t status;
+
+    if (ucs_sys_setaffinity(&iface->mt.cpuset) == -1) {
+        ucs_debug("failed to set affinity of scopy helper thread: %m");
+    }
+
+    pthread_mutex_lock(&iface->mt.lock);
+    while (!iface->mt.stop) {
+        if (ucs_list_is_empty(&iface->mt.queue)) {
+            pthread_cond_wait(&iface->mt.cond, &iface->mt.lock);
+            continue;
+        }
+
+        tx     = ucs_list_head(&iface->mt.queue, uct_scopy_tx_t, mt.list);
+        length = uct_scopy_iface_mt_claim_locked(iface, tx, &offset);
+        pthread_mutex_unlock(&iface->mt.lock);
+
+        /* The operation may be released by the progress thread as soon as the
+         * segment is marked as done, so it must not be accessed after that */
+        status = uct_scopy_ep_tx_segment(tx->mt.ep, tx, iface->mt.tx, offset,
+                                         length);
+        uct_scopy_iface_mt_seg_done(iface, tx, offset, length, status);
+
+        pthread_mutex_lock(&iface->mt.lock);
+    }
+    pthread_mutex_unlock(&iface->mt.lock);
+
+    return NULL;
+}
+
+/* Use the CPUs of the current NUMA node, except the current one, which runs
+ * the progress thread */
+static void uct_scopy_iface_mt_init_cpuset(ucs_sys_cpuset_t *cpuset)
+{
+    ucs_numa_node_t node = ucs_numa_node_of_current_cpu();
+    int current_cpu      = sched_getcpu();
+    ucs_sys_cpuset_t allowed;
+    int cpu;
+
+    if (ucs_sys_pthread_getaffinity(&allowed) != UCS_OK) {
+        ucs_sys_getaffinity(&allowed);
+    }
+
+    CPU_ZERO(cpuset);
+    for (cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed) && (cpu != current_cpu) &&
+            (ucs_numa_node_of_cpu(cpu) == node)) {
+            CPU_SET(cpu, cpuset);
+        }
+    }
+
+    if (CPU_COUNT(cpuset) == 0) {
+        *cpuset = allowed;
+    }
+}
+
+static void uct_scopy_iface_mt_cleanup(uct_scopy_iface_t *iface)
+{
+    unsigned i;
+
+    if (iface->mt.threads == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&iface->mt.lock);
+    iface->mt.stop = 1;
+    pthread_cond_broadcast(&iface->mt.cond);
+    pthread_mutex_unlock(&iface->mt.lock);
+
+    for (i = 0; i < iface->mt.num_threads; ++i) {
+        pthread_join(iface->mt.threads[i], NULL);
+    }
+
+    ucs_assert(ucs_list_is_empty(&iface->mt.queue));
+    pthread_cond_destroy(&iface->mt.cond);
+    pthread_mutex_destroy(&iface->mt.lock);
+    ucs_free(iface->mt.threads);
+}
+
+static ucs_status_t
+uct_scopy_iface_mt_init(uct_scopy_iface_t *iface,
+                        uct_scopy_ep_tx_func_t tx_mt,
+                        const uct_scopy_iface_config_t *config)
+{
+    ucs_status_t status;
+
+    iface->mt.tx          = tx_mt;
+    iface->mt.thresh      = SIZE_MAX;
+    iface->mt.threads     = NULL;
+    iface->mt.num_threads = 0;
+    iface->mt.stop        = 0;
+
+    if (config->tx_threads == 0) {
+        return UCS_OK;
+    }
+
+    if (tx_mt == NULL) {
+        ucs_debug("iface %p: helper threads are not supported", iface);
+        return UCS_OK;
+    }
+
+    iface->mt.threads = ucs_calloc(config->tx_threads, sizeof(pthread_t),
+                                   "scopy_tx_threads");
+    if (iface->mt.threads == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    pthread_mutex_init(&iface->mt.lock, NULL);
+    pthread_cond_init(&iface->mt.cond, NULL);
+    ucs_list_head_init(&iface->mt.queue);
+    uct_scopy_iface_mt_init_cpuset(&iface->mt.cpuset);
+
+    while (iface->mt.num_threads < config->tx_threads) {
+        status = ucs_pthread_create(&iface->mt.threads[iface->mt.num_threads],
+                                    uct_scopy_iface_mt_thread_func, iface,
+                                    "scopy_tx%u", iface->mt.num_threads);
+        if (status != UCS_OK) {
+            uct_scopy_iface_mt_cleanup(iface);
+            return status;
+        }
+
+        ++iface->mt.num_threads;
+    }
+
+    iface->mt.thresh = ucs_max(config->tx_threads_thresh,
+                               iface->config.seg_size + 1);
+    ucs_debug("iface %p: %u helper threads for operations of %zu bytes or more",
+              iface, iface->mt.num_threads, iface->mt.thresh);
+    return UCS_OK;
+}
+
+void uct_scopy_iface_mt_post(uct_scopy_iface_t *iface, uct_scopy_ep_t *ep,
+                             uct_scopy_tx_t *tx, size_t length)
+{
+    tx->mt.ep     = ep;
+    tx->mt.length = length;
+    tx->mt.offset = 0;
+    tx->mt.done   = 0;
+    tx->mt.status = UCS_OK;
+
+    pthread_mutex_lock(&iface->mt.lock);
+    ucs_list_add_tail(&iface->mt.queue, &tx->mt.list);
+    pthread_cond_broadcast(&iface->mt.cond);
+    pthread_mutex_unlock(&iface->mt.lock);
+}
+
+size_t uct_scopy_iface_mt_claim(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx,
+                                size_t *offset_p)
+{
+    size_t length;
+
+    pthread_mutex_lock(&iface->mt.lock);
+    length = uct_scopy_iface_mt_claim_locked(iface, tx, offset_p);
+    pthread_mutex_unlock(&iface->mt.lock);
+
+    return length;
+}
+
+void uct_scopy_iface_mt_seg_done(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx,
+                                 size_t offset, size_t length,
+                                 ucs_status_t status)
+{
+    if (ucs_unlikely(status != UCS_OK)) {
+        pthread_mutex_lock(&iface->mt.lock);
+        if (tx->mt.status == UCS_OK) {
+            tx->mt.status        = status;
+            tx->mt.failed_offset = offset;
+        }
+
+        /* Skip the segments which were not claimed yet */
+        if (tx->mt.offset < tx->mt.length) {
+            length       += tx->mt.length - tx->mt.offset;
+            tx->mt.offset = tx->mt.length;
+            ucs_list_del(&tx->mt.list);
+        }
+        pthread_mutex_unlock(&iface->mt.lock);
+    }
+
+    ucs_atomic_add64(&tx->mt.done, length);
+}
+
+void uct_scopy_iface_mt_cancel(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx)
+{
+    size_t claimed;
+
+    pthread_mutex_lock(&iface->mt.lock);
+    claimed = tx->mt.offset;
+    if (claimed < tx->mt.length) {
+        tx->mt.offset = tx->mt.length;
+        ucs_list_del(&tx->mt.list);
+    }
+    pthread_mutex_unlock(&iface->mt.lock);
+
+    /* Helper threads may still copy the segments claimed before */
+    while (tx->mt.done < claimed) {
+        sched_yield();
+    }
+}
+
 UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_iface_ops_t *ops,
                     uct_scopy_iface_ops_t *scopy_ops, uct_md_h md,
                     uct_worker_h worker, const uct_iface_params_t *params,
@@ -146,12 +387,27 @@ UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_iface_ops_t *ops,
     mp_params.ops             = &uct_scopy_mpool_ops;
     mp_params.name            = "uct_scopy_iface_tx_mp";
     status = ucs_mpool_init(&mp_params, &self->tx_mpool);
+    if (status != UCS_OK) {
+        goto err_cleanup_arbiter;
+    }
+
+    status = uct_scopy_iface_mt_init(self, scopy_ops->ep_tx_mt, config);
+    if (status != UCS_OK) {
+        goto err_cleanup_mpool;
+    }
+
+    return UCS_OK;
 
+err_cleanup_mpool:
+    ucs_mpool_cleanup(&self->tx_mpool, 1);
+err_cleanup_arbiter:
+    ucs_arbiter_cleanup(&self->arbiter);
     return status;
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_scopy_iface_t)
 {
+    uct_scopy_iface_mt_cleanup(self);
     uct_worker_progress_unregister_safe(&self->super.super.worker->super,
                                         &self->super.super.prog.id);
     ucs_mpool_cleanup(&self->tx_mpool, 1);
@@ -10,6 +10,9 @@
 
 #include <uct/base/uct_iface.h>
 #include <uct/sm/base/sm_iface.h>
+#include <ucs/sys/sys.h>
+
+#include <pthread.h>
 
 #define uct_scopy_trace_data(_tx) \
     ucs_trace_data("%s [tx %p iov %zu/%zu length %zu/%zu] to %" PRIx64 "(%+ld)", \
@@ -32,6 +35,10 @@ typedef struct uct_scopy_iface_config {
     unsigned                      tx_quota;   /* How many TX segments can be dispatched
                                                * during iface progress */
     uct_iface_mpool_config_t      tx_mpool;   /* TX memory pool configuration */
+    unsigned                      tx_threads; /* Number of helper threads */
+    size_t                        tx_threads_thresh; /* Minimal length of operations
+                                                      * which are split between
+                                                      * helper threads */
 } uct_scopy_iface_config_t;
 
 
@@ -50,12 +57,32 @@ typedef struct uct_scopy_iface {
         unsigned                  tx_quota;    /* How many TX segments can be dispatched
                                                 * during iface progress */
     } config;
+    struct {
+        uct_scopy_ep_tx_func_t    tx;          /* Thread-safe TX function */
+        size_t                    thresh;      /* Minimal length of operations
+                                                * which are split between helper
+                                                * threads, SIZE_MAX if disabled */
+        pthread_t                 *threads;    /* Helper threads */
+        unsigned                  num_threads; /* Number of helper threads */
+        int                       stop;        /* Helper threads should exit */
+        pthread_mutex_t           lock;        /* Protects the queue and claiming
+                                                * of segments */
+        pthread_cond_t            cond;        /* Signaled when the queue is not
+                                                * empty */
+        ucs_list_link_t           queue;       /* Operations which have unclaimed
+                                                * segments */
+        ucs_sys_cpuset_t          cpuset;      /* CPUs of the helper threads */
+    } mt;
 } uct_scopy_iface_t;
 
 
 typedef struct uct_scopy_iface_ops {
     uct_iface_internal_ops_t super;
     uct_scopy_ep_tx_func_t   ep_tx;
+    /* Variant of ep_tx which can be called from helper threads. It must not
+     * report errors, which are reported by repeating the failed segment with
+     * ep_tx from the progress context. NULL if not supported. */
+    uct_scopy_ep_tx_func_t   ep_tx_mt;
 } uct_scopy_iface_ops_t;
 
 
@@ -70,6 +97,18 @@ UCS_CLASS_DECLARE(uct_scopy_iface_t, uct_iface_ops_t*, uct_scopy_iface_ops_t*,
 
 unsigned uct_scopy_iface_progress(uct_iface_h tl_iface);
 
+void uct_scopy_iface_mt_post(uct_scopy_iface_t *iface, uct_scopy_ep_t *ep,
+                             uct_scopy_tx_t *tx, size_t length);
+
+size_t uct_scopy_iface_mt_claim(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx,
+                                size_t *offset_p);
+
+void uct_scopy_iface_mt_seg_done(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx,
+                                 size_t offset, size_t length,
+                                 ucs_status_t status);
+
+void uct_scopy_iface_mt_cancel(uct_scopy_iface_t *iface, uct_scopy_tx_t *tx);
+
 ucs_status_t uct_scopy_iface_event_arm(uct_iface_h tl_iface, unsigned events);
 
 ucs_status_t uct_scopy_iface_flush(uct_iface_h tl_iface, unsigned flags,
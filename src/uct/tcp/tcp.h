@@ -47,6 +47,10 @@
  * operation */
 #define UCT_TCP_EP_PUT_ZCOPY_MAX              SIZE_MAX
 
+/* Maximum size of a data that can be read by GET Zcopy
+ * operation */
+#define UCT_TCP_EP_GET_ZCOPY_MAX              SIZE_MAX
+
 /* Length of a data that is used by PUT protocol */
 #define UCT_TCP_EP_PUT_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
                                               sizeof(uct_tcp_ep_put_req_hdr_t))
@@ -114,7 +118,24 @@ enum {
     /* EP is on EP PTR map. */
     UCT_TCP_EP_FLAG_ON_PTR_MAP         = UCS_BIT(9),
     /* EP has some operations done without flush */
-    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10)
+    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10),
+    /* Zcopy TX operation in progress is sent with MSG_ZEROCOPY. */
+    UCT_TCP_EP_FLAG_MSG_ZCOPY_TX       = UCS_BIT(11),
+    /* The kernel reported that it copied the data sent with MSG_ZEROCOPY,
+     * so zero-copy send is not used on this EP anymore. */
+    UCT_TCP_EP_FLAG_MSG_ZCOPY_COPIED   = UCS_BIT(12),
+    /* GET RX operation is in progress on a given EP, i.e. the payload of
+     * GET response is being received to the user's buffer. */
+    UCT_TCP_EP_FLAG_GET_RX             = UCS_BIT(13),
+    /* EP received data recently and is on the iface list of EPs which are
+     * polled for RX without waiting for socket events */
+    UCT_TCP_EP_FLAG_BUSY_POLL          = UCS_BIT(14),
+    /* TX buffer holds small AMs which were not sent yet, so next AMs are
+     * appended to them and all are sent together by the iface progress */
+    UCT_TCP_EP_FLAG_TX_COALESCE        = UCS_BIT(15),
+    /* Zcopy TX operation in progress sends its payload from a file with
+     * sendfile(), the payload is the last IOV of the operation */
+    UCT_TCP_EP_FLAG_FILE_TX            = UCS_BIT(16)
 };
 
 
@@ -219,13 +240,19 @@ typedef struct uct_tcp_am_hdr {
  */
 typedef enum uct_tcp_ep_am_id {
     /* AM ID reserved for TCP internal Connection Manager messages */
-    UCT_TCP_EP_CM_AM_ID        = UCT_AM_ID_MAX,
+    UCT_TCP_EP_CM_AM_ID         = UCT_AM_ID_MAX,
     /* AM ID reserved for TCP internal PUT REQ message */
-    UCT_TCP_EP_PUT_REQ_AM_ID   = UCT_AM_ID_MAX + 1,
+    UCT_TCP_EP_PUT_REQ_AM_ID    = UCT_AM_ID_MAX + 1,
     /* AM ID reserved for TCP internal PUT ACK message */
-    UCT_TCP_EP_PUT_ACK_AM_ID   = UCT_AM_ID_MAX + 2,
+    UCT_TCP_EP_PUT_ACK_AM_ID    = UCT_AM_ID_MAX + 2,
     /* AM ID reserved for TCP internal keepalive message */
-    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3
+    UCT_TCP_EP_KEEPALIVE_AM_ID  = UCT_AM_ID_MAX + 3,
+    /* AM ID reserved for TCP internal GET REQ message */
+    UCT_TCP_EP_GET_REQ_AM_ID    = UCT_AM_ID_MAX + 4,
+    /* AM ID reserved for TCP internal GET RESP message */
+    UCT_TCP_EP_GET_RESP_AM_ID   = UCT_AM_ID_MAX + 5,
+    /* AM ID reserved for TCP internal ATOMIC REQ message */
+    UCT_TCP_EP_ATOMIC_REQ_AM_ID = UCT_AM_ID_MAX + 6
 } uct_tcp_ep_am_id_t;
 
 
@@ -247,6 +274,62 @@ typedef struct uct_tcp_ep_put_ack_hdr {
 } UCS_S_PACKED uct_tcp_ep_put_ack_hdr_t;
 
 
+/**
+ * TCP GET request header
+ */
+typedef struct uct_tcp_ep_get_req_hdr {
+    uint64_t                      addr;        /* Address of a remote memory buffer */
+    size_t                        length;      /* Length of a remote memory buffer */
+} UCS_S_PACKED uct_tcp_ep_get_req_hdr_t;
+
+
+/**
+ * TCP GET response header
+ */
+typedef struct uct_tcp_ep_get_resp_hdr {
+    size_t                        length;      /* Length of the payload which
+                                                * follows the header */
+} UCS_S_PACKED uct_tcp_ep_get_resp_hdr_t;
+
+
+/**
+ * TCP atomic request header. The result of a fetching operation is sent
+ * back in GET RESP message, other operations are acknowledged by PUT ACK.
+ */
+typedef struct uct_tcp_ep_atomic_req_hdr {
+    uint64_t                      addr;        /* Address of a remote atomic variable */
+    uint64_t                      value;       /* Operand, or the new value of CSWAP */
+    uint64_t                      compare;     /* Value to compare with for CSWAP */
+    uint8_t                       opcode;      /* Atomic operation, uct_atomic_op_t */
+    uint8_t                       size;        /* Size of the atomic variable */
+    uint8_t                       fetch;       /* Whether to respond with the
+                                                * previous value */
+    uint32_t                      sn;          /* Sequence number to acknowledge
+                                                * a non-fetching operation with
+                                                * PUT ACK */
+} UCS_S_PACKED uct_tcp_ep_atomic_req_hdr_t;
+
+
+/**
+ * TCP GET operation, either sent by the EP and waiting for a response, or
+ * received by the EP and waiting for TX resources to send a response
+ */
+typedef struct uct_tcp_ep_get_op {
+    uct_completion_t              *comp;       /* User's completion passed to
+                                                * uct_ep_get_zcopy */
+    void                          *buffer;     /* Local buffer to receive the
+                                                * payload to or to send it from,
+                                                * NULL if the received payload has
+                                                * to be dropped */
+    size_t                        length;      /* Remaining length of the payload */
+    uint64_t                      result;      /* Result of an atomic operation
+                                                * which is sent instead of the
+                                                * memory region */
+    ucs_queue_elem_t              elem;        /* Element to insert the operation
+                                                * into TCP EP GET queue */
+} uct_tcp_ep_get_op_t;
+
+
 /**
  * TCP PUT completion
  */
@@ -274,16 +357,38 @@ typedef struct uct_tcp_ep_ctx {
 } uct_tcp_ep_ctx_t;
 
 
+/**
+ * TCP memory handle of a memory region backed by a file
+ */
+typedef struct uct_tcp_mem {
+    void                          *address;       /* Start address of the region */
+    size_t                        length;         /* Length of the region */
+    int                           fd;             /* File descriptor of the file
+                                                   * which holds the data */
+    off_t                         offset;         /* File offset of the data at
+                                                   * the start address */
+} uct_tcp_mem_t;
+
+
 /**
  * TCP AM/PUT Zcopy communication context mapped to
  * buffer from TCP EP context
  */
 typedef struct uct_tcp_ep_zcopy_tx {
-    uct_tcp_am_hdr_t              super;     /* UCT TCP AM header */
-    uct_completion_t              *comp;     /* Local UCT completion object */
-    size_t                        iov_index; /* Current IOV index */
-    size_t                        iov_cnt;   /* Number of IOVs that should be sent */
-    struct iovec                  iov[0];    /* IOVs that should be sent */
+    uct_tcp_am_hdr_t              super;          /* UCT TCP AM header */
+    uct_completion_t              *comp;          /* Local UCT completion object */
+    uint32_t                      msg_zcopy_sn;   /* Sequence number of the last
+                                                   * MSG_ZEROCOPY send of the
+                                                   * operation */
+    ucs_queue_elem_t              msg_zcopy_elem; /* Element to insert the context
+                                                   * into TCP EP queue of MSG_ZEROCOPY
+                                                   * operations */
+    const uct_tcp_mem_t           *file_memh;     /* Memory handle of the file
+                                                   * which the payload is sent
+                                                   * from, if FILE_TX is set */
+    size_t                        iov_index;      /* Current IOV index */
+    size_t                        iov_cnt;        /* Number of IOVs that should be sent */
+    struct iovec                  iov[0];         /* IOVs that should be sent */
 } uct_tcp_ep_zcopy_tx_t;
 
 
@@ -338,7 +443,7 @@ struct uct_tcp_ep {
     uint8_t                       conn_retries; /* Number of connection attempts done */
     uint8_t                       conn_state;   /* State of connection with peer */
     ucs_event_set_types_t         events;       /* Current notifications */
-    uint16_t                      flags;        /* Endpoint flags */
+    uint32_t                      flags;        /* Endpoint flags */
     int                           fd;           /* Socket file descriptor */
     int                           stale_fd;     /* Old file descriptor which should be
                                                  * closed as soon as the EP is connected
@@ -349,6 +454,26 @@ struct uct_tcp_ep {
     ucs_queue_head_t              pending_q;    /* Pending operations */
     ucs_queue_head_t              put_comp_q;   /* Flush completions waiting for
                                                  * outstanding PUTs acknowledgment */
+    ucs_queue_head_t              get_req_q;    /* Sent GET requests waiting for
+                                                 * the responses */
+    ucs_queue_head_t              get_resp_q;   /* Received GET requests waiting
+                                                 * for TX resources to respond */
+    struct {
+        uint32_t                  sn;           /* Number of MSG_ZEROCOPY sends done
+                                                 * on the socket, the kernel numbers
+                                                 * its notifications the same way */
+        ucs_queue_head_t          comp_q;       /* Zcopy operations waiting for the
+                                                 * kernel to release their buffers */
+    } msg_zcopy;
+    struct {
+        ucs_time_t                last_rx;      /* Time of the last data received
+                                                 * by busy-polling the socket */
+        ucs_list_link_t           list;         /* List element to insert into TCP
+                                                 * iface busy-poll EP list */
+    } busy_poll;
+    ucs_list_link_t               tx_coalesce_list; /* List element to insert into
+                                                     * TCP iface TX coalescing
+                                                     * EP list */
     union {
         ucs_list_link_t           list;         /* List element to insert into TCP EP list */
         ucs_conn_match_elem_t     elem;         /* Connection matching element, used by EPs
@@ -381,14 +506,49 @@ typedef struct uct_tcp_iface {
                                                       * + how many non-blocking connections
                                                       * are in progress + how many EPs are
                                                       * waiting for PUT Zcopy operation ACKs
-                                                      * (0/1 for each EP) */
+                                                      * (0/1 for each EP) + how many GET Zcopy
+                                                      * operations are waiting for responses */
     ucs_range_spec_t              port_range;        /** Range of ports to use for bind() */
 
+    struct {
+        ucs_list_link_t           ep_list;           /* EPs which received data recently
+                                                      * and are polled for RX before
+                                                      * waiting for socket events */
+        unsigned                  wait_skips;        /* Progress calls which skipped
+                                                      * waiting for socket events */
+    } busy_poll;
+
+    ucs_list_link_t               tx_coalesce_list;  /* EPs which have AMs coalesced
+                                                      * in the TX buffer to be sent
+                                                      * by the progress */
+
+    struct {
+        unsigned long             progress;          /* Number of progress calls */
+        unsigned long             syscalls;          /* Number of event set waits
+                                                      * and RX attempts done by
+                                                      * busy-polling EPs */
+        unsigned long             busy_poll_skip;    /* Number of progress calls
+                                                      * which busy-polled EPs
+                                                      * and did not wait for
+                                                      * socket events */
+        unsigned long             busy_poll_rx;      /* Number of RX attempts done
+                                                      * by busy-polling EPs */
+        unsigned long             tx_coalesce;       /* Number of AMs which were
+                                                      * coalesced in TX buffers */
+    } counters;
+
     struct {
         size_t                    tx_seg_size;       /* TX AM buffer size */
         size_t                    rx_seg_size;       /* RX AM buffer size */
+        size_t                    tx_buf_size;       /* TX buffer size, larger than
+                                                      * TX AM buffer size to allow
+                                                      * coalescing of AMs */
+        size_t                    tx_coalesce_thresh; /* Maximum size of AM payload
+                                                       * which can be coalesced */
         size_t                    sendv_thresh;      /* Minimum size of user's payload from which
                                                       * non-blocking vector send should be used */
+        size_t                    msg_zcopy_thresh;  /* Minimum size of user's Zcopy payload from
+                                                      * which MSG_ZEROCOPY send should be used */
         size_t                    max_iov;           /* Maximum supported IOVs limited by
                                                       * user configuration and service buffers
                                                       * (TCP protocol and user's AM headers) */
@@ -403,7 +563,12 @@ typedef struct uct_tcp_iface {
         ucs_ternary_auto_value_t  ep_bind_src_addr;  /* Bind EP's FD to ifaddr */
         int                       prefer_default;    /* Prefer default gateway */
         int                       put_enable;        /* Enable PUT Zcopy operation support */
+        int                       get_enable;        /* Enable GET Zcopy operation support */
+        int                       atomic_enable;     /* Enable atomic operations support */
+        unsigned                  num_paths;         /* Number of connections to create
+                                                      * between a pair of endpoints */
         int                       conn_nb;           /* Use non-blocking connect() */
+        ucs_ternary_auto_value_t  conn_fast_open;    /* Use TCP Fast Open */
         unsigned                  max_poll;          /* Number of events to poll per socket*/
         uint8_t                   max_conn_retries;  /* How many connection establishment attempts
                                                       * should be done if dropped connection was
@@ -412,6 +577,14 @@ typedef struct uct_tcp_iface {
                                                       * before aborting the attempt to connect.
                                                       * It cannot exceed 255. */
         double                    max_bw;            /* Upper bound to TCP iface bandwidth */
+        struct {
+            ucs_time_t            idle;              /* How long an EP is busy-polled
+                                                      * for RX after the last received
+                                                      * data, 0 - busy-poll is disabled */
+            unsigned              wait_interval;     /* Wait for socket events at least
+                                                      * once in this number of progress
+                                                      * calls while busy-polling EPs */
+        } busy_poll;
         struct {
             ucs_time_t            idle;              /* The time the connection needs to remain
                                                       * idle before TCP starts sending keepalive
@@ -428,6 +601,7 @@ typedef struct uct_tcp_iface {
         int                       nodelay;           /* TCP_NODELAY */
         size_t                    sndbuf;            /* SO_SNDBUF */
         size_t                    rcvbuf;            /* SO_RCVBUF */
+        unsigned                  busy_poll;         /* SO_BUSY_POLL, in usec */
     } sockopt;
 } uct_tcp_iface_t;
 
@@ -441,9 +615,15 @@ typedef struct uct_tcp_iface_config {
     size_t                         rx_seg_size;
     size_t                         max_iov;
     size_t                         sendv_thresh;
+    size_t                         msg_zcopy_thresh;
+    size_t                         tx_coalesce_thresh;
     int                            prefer_default;
     int                            put_enable;
+    int                            get_enable;
+    int                            atomic_enable;
+    unsigned                       num_paths;
     int                            conn_nb;
+    ucs_ternary_auto_value_t       conn_fast_open;
     unsigned                       max_poll;
     unsigned                       max_conn_retries;
     int                            sockopt_nodelay;
@@ -453,11 +633,17 @@ typedef struct uct_tcp_iface_config {
     uct_iface_mpool_config_t       rx_mpool;
     ucs_range_spec_t               port_range;
     double                         max_bw;
+    struct {
+        ucs_time_t                 idle;
+        unsigned                   wait_interval;
+        ucs_time_t                 sockopt;
+    } busy_poll;
     struct {
         ucs_time_t                 idle;
         unsigned long              cnt;
         ucs_time_t                 intvl;
     } keepalive;
+    ucs_ternary_auto_value_t       io_uring;
     ucs_ternary_auto_value_t       ep_bind_src_addr;
 } uct_tcp_iface_config_t;
 
@@ -526,6 +712,10 @@ void uct_tcp_iface_add_ep(uct_tcp_ep_t *ep);
 
 void uct_tcp_iface_remove_ep(uct_tcp_ep_t *ep);
 
+void uct_tcp_iface_busy_poll_add_ep(uct_tcp_ep_t *ep);
+
+void uct_tcp_iface_busy_poll_remove_ep(uct_tcp_ep_t *ep);
+
 int uct_tcp_cm_ep_accept_conn(uct_tcp_ep_t *ep);
 
 int uct_tcp_iface_is_self_addr(uct_tcp_iface_t *iface,
@@ -588,6 +778,10 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, ucs_event_set_types_t add,
 
 void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep);
 
+unsigned uct_tcp_ep_progress_msg_zcopy(uct_tcp_ep_t *ep);
+
+unsigned uct_tcp_ep_tx_coalesce_flush(uct_tcp_ep_t *ep);
+
 ucs_status_t uct_tcp_ep_am_short(uct_ep_h uct_ep, uint8_t am_id, uint64_t header,
                                  const void *payload, unsigned length);
 
@@ -607,6 +801,38 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
                                   size_t iovcnt, uint64_t remote_addr,
                                   uct_rkey_t rkey, uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_atomic32_post(uct_ep_h tl_ep, unsigned opcode,
+                                      uint32_t value, uint64_t remote_addr,
+                                      uct_rkey_t rkey);
+
+ucs_status_t uct_tcp_ep_atomic64_post(uct_ep_h tl_ep, unsigned opcode,
+                                      uint64_t value, uint64_t remote_addr,
+                                      uct_rkey_t rkey);
+
+ucs_status_t uct_tcp_ep_atomic32_fetch(uct_ep_h tl_ep, uct_atomic_op_t opcode,
+                                       uint32_t value, uint32_t *result,
+                                       uint64_t remote_addr, uct_rkey_t rkey,
+                                       uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_atomic64_fetch(uct_ep_h tl_ep, uct_atomic_op_t opcode,
+                                       uint64_t value, uint64_t *result,
+                                       uint64_t remote_addr, uct_rkey_t rkey,
+                                       uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_atomic_cswap32(uct_ep_h tl_ep, uint32_t compare,
+                                       uint32_t swap, uint64_t remote_addr,
+                                       uct_rkey_t rkey, uint32_t *result,
+                                       uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_atomic_cswap64(uct_ep_h tl_ep, uint64_t compare,
+                                       uint64_t swap, uint64_t remote_addr,
+                                       uct_rkey_t rkey, uint64_t *result,
+                                       uct_completion_t *comp);
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags);
 
@@ -246,6 +246,16 @@ ucs_status_t uct_tcp_cm_send_event(uct_tcp_ep_t *ep,
     if (status == UCS_OK) {
         uct_tcp_cm_trace_conn_pkt(ep, UCS_LOG_LEVEL_TRACE,
                                   "%s sent to", event);
+    } else if ((status == UCS_INPROGRESS) &&
+               (ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTING) &&
+               (iface->config.conn_fast_open != UCS_NO)) {
+        /* The peer's TCP Fast Open cookie is not cached, so the SYN packet
+         * was sent without data. Send the connection request again once the
+         * socket is connected */
+        ucs_assert(event == UCT_TCP_CM_CONN_REQ);
+        uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
+        uct_tcp_cm_trace_conn_pkt(ep, UCS_LOG_LEVEL_TRACE,
+                                  "%s postponed to", event);
     } else {
         ucs_assert(status != UCS_ERR_NO_PROGRESS);
         status = uct_tcp_ep_handle_io_err(ep, "send", status);
@@ -734,7 +744,9 @@ static void uct_tcp_cm_conn_complete(uct_tcp_ep_t *ep)
 
     status = uct_tcp_cm_send_event(ep, UCT_TCP_CM_CONN_REQ, 1);
     if (status != UCS_OK) {
-        /* error handling was done inside sending event operation */
+        /* error handling was done inside sending event operation, or the
+         * connection request will be sent again when the socket is
+         * connected */
         return;
     }
 
@@ -11,7 +11,11 @@
 #include "tcp.h"
 #include "tcp/tcp.h"
 
+#include <ucs/arch/atomic.h>
 #include <ucs/async/async.h>
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+#include <linux/errqueue.h>
+#endif
 
 
 /* Forward declarations */
@@ -63,6 +67,12 @@ static inline int uct_tcp_ep_ctx_buf_need_progress(uct_tcp_ep_ctx_t *ctx)
 
 static inline ucs_status_t uct_tcp_ep_check_tx_res(uct_tcp_ep_t *ep)
 {
+    if (ucs_unlikely(ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE)) {
+        /* Send the coalesced AMs before the operation which can't be
+         * appended to them */
+        uct_tcp_ep_tx_coalesce_flush(ep);
+    }
+
     if (ucs_likely((ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
                    uct_tcp_ep_ctx_buf_empty(&ep->tx))) {
         return UCS_OK;
@@ -123,6 +133,14 @@ static inline void uct_tcp_ep_ctx_reset(uct_tcp_ep_ctx_t *ctx)
     uct_tcp_ep_ctx_rewind(ctx);
 }
 
+static void uct_tcp_ep_tx_coalesce_remove(uct_tcp_ep_t *ep)
+{
+    ucs_assert(ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE);
+
+    ucs_list_del(&ep->tx_coalesce_list);
+    ep->flags &= ~UCT_TCP_EP_FLAG_TX_COALESCE;
+}
+
 int uct_tcp_ep_is_self(const uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -132,10 +150,34 @@ int uct_tcp_ep_is_self(const uct_tcp_ep_t *ep)
 
 static void uct_tcp_ep_cleanup(uct_tcp_ep_t *ep)
 {
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx;
+    uct_tcp_ep_get_op_t *get_op;
+
     if (ep->tx.buf != NULL) {
         uct_tcp_ep_ctx_reset(&ep->tx);
     }
 
+    /* Completions of GET requests were already invoked by purge */
+    ucs_queue_for_each_extract(get_op, &ep->get_req_q, elem, 1) {
+        ucs_assert(get_op->comp == NULL);
+        ucs_mpool_put_inline(get_op);
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+
+    ucs_queue_for_each_extract(get_op, &ep->get_resp_q, elem, 1) {
+        ucs_mpool_put_inline(get_op);
+    }
+
+    /* Completions were already invoked by purge, the kernel doesn't access
+     * the buffers after the socket is closed */
+    ucs_queue_for_each_extract(ctx, &ep->msg_zcopy.comp_q, msg_zcopy_elem, 1) {
+        ucs_assert(ctx->comp == NULL);
+        ucs_mpool_put_inline(ctx);
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+
     if (ep->rx.buf != NULL) {
         uct_tcp_ep_ctx_reset(&ep->rx);
     }
@@ -241,6 +283,11 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface, int fd,
     ucs_list_head_init(&self->list);
     ucs_queue_head_init(&self->pending_q);
     ucs_queue_head_init(&self->put_comp_q);
+    ucs_queue_head_init(&self->get_req_q);
+    ucs_queue_head_init(&self->get_resp_q);
+    ucs_queue_head_init(&self->msg_zcopy.comp_q);
+    self->msg_zcopy.sn      = 0;
+    self->busy_poll.last_rx = 0;
 
     if (dest_addr != NULL) {
         memcpy(&self->peer_addr[0], dest_addr, iface->config.sockaddr_len);
@@ -345,7 +392,13 @@ static UCS_F_ALWAYS_INLINE void
 uct_tcp_ep_zcopy_completed(uct_tcp_ep_t *ep, uct_completion_t *comp,
                            ucs_status_t status)
 {
-    ep->flags &= ~UCT_TCP_EP_FLAG_ZCOPY_TX;
+    ep->flags &= ~(UCT_TCP_EP_FLAG_ZCOPY_TX | UCT_TCP_EP_FLAG_FILE_TX);
+    if ((status == UCS_OK) && (ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX)) {
+        /* Completed when the kernel releases the buffers */
+        return;
+    }
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
     if (comp != NULL) {
         uct_invoke_completion(comp, status);
     }
@@ -355,6 +408,7 @@ static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
 {
     uct_tcp_ep_put_completion_t *put_comp;
     uct_tcp_ep_zcopy_tx_t *ctx;
+    uct_tcp_ep_get_op_t *get_op;
 
     ucs_debug("tcp_ep %p: purge outstanding operations with status %s", ep,
               ucs_status_string(status));
@@ -369,6 +423,26 @@ static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
         uct_invoke_completion(put_comp->comp, status);
         ucs_mpool_put_inline(put_comp);
     }
+
+    /* The kernel may still read the buffers of MSG_ZEROCOPY operations, so
+     * keep them until the notifications arrive or the EP is destroyed */
+    ucs_queue_for_each(ctx, &ep->msg_zcopy.comp_q, msg_zcopy_elem) {
+        if (ctx->comp != NULL) {
+            uct_invoke_completion(ctx->comp, status);
+            ctx->comp = NULL;
+        }
+    }
+
+    /* The peer still sends the responses to GET requests which were already
+     * posted, so keep the requests to drop their payload */
+    ucs_queue_for_each(get_op, &ep->get_req_q, elem) {
+        if (get_op->comp != NULL) {
+            uct_invoke_completion(get_op->comp, status);
+            get_op->comp = NULL;
+        }
+
+        get_op->buffer = NULL;
+    }
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
@@ -387,6 +461,14 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
         uct_tcp_iface_remove_ep(self);
     }
 
+    if (self->flags & UCT_TCP_EP_FLAG_BUSY_POLL) {
+        uct_tcp_iface_busy_poll_remove_ep(self);
+    }
+
+    if (self->flags & UCT_TCP_EP_FLAG_TX_COALESCE) {
+        uct_tcp_ep_tx_coalesce_remove(self);
+    }
+
     if (self->flags & UCT_TCP_EP_FLAG_ON_PTR_MAP) {
         uct_tcp_ep_ptr_map_del(self);
     }
@@ -672,6 +754,26 @@ static ucs_status_t uct_tcp_ep_bind_src_iface(uct_tcp_ep_t *ep)
     return UCS_OK;
 }
 
+static ucs_status_t uct_tcp_ep_fast_open_enable(uct_tcp_ep_t *ep)
+{
+#ifdef TCP_FASTOPEN_CONNECT
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    const int optval       = 1;
+
+    if (iface->config.conn_fast_open == UCS_NO) {
+        return UCS_OK;
+    }
+
+    /* connect() returns immediately if the peer's cookie is cached, and the
+     * connection request sent after that is carried in the SYN packet */
+    return ucs_socket_setopt(ep->fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT,
+                             &optval, sizeof(optval));
+#else
+    return UCS_OK;
+#endif
+}
+
 static ucs_status_t uct_tcp_ep_create_socket_and_connect(uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -684,6 +786,10 @@ static ucs_status_t uct_tcp_ep_create_socket_and_connect(uct_tcp_ep_t *ep)
         goto err;
     }
 
+    /* The kernel numbers MSG_ZEROCOPY sends per socket */
+    ucs_assert(ucs_queue_is_empty(&ep->msg_zcopy.comp_q));
+    ep->msg_zcopy.sn = 0;
+
     status = uct_tcp_ep_bind_src_iface(ep);
     if (status != UCS_OK) {
         goto err;
@@ -699,6 +805,11 @@ static ucs_status_t uct_tcp_ep_create_socket_and_connect(uct_tcp_ep_t *ep)
         goto err;
     }
 
+    status = uct_tcp_ep_fast_open_enable(ep);
+    if (status != UCS_OK) {
+        goto err;
+    }
+
     status = uct_tcp_cm_conn_start(ep);
     if (status != UCS_OK) {
         goto err;
@@ -735,12 +846,20 @@ void uct_tcp_ep_replace_ep(uct_tcp_ep_t *to_ep, uct_tcp_ep_t *from_ep)
 
     ucs_queue_splice(&to_ep->pending_q, &from_ep->pending_q);
     ucs_queue_splice(&to_ep->put_comp_q, &from_ep->put_comp_q);
+    ucs_queue_splice(&to_ep->get_req_q, &from_ep->get_req_q);
+    ucs_queue_splice(&to_ep->get_resp_q, &from_ep->get_resp_q);
+    ucs_queue_splice(&to_ep->msg_zcopy.comp_q, &from_ep->msg_zcopy.comp_q);
+    to_ep->msg_zcopy.sn = from_ep->msg_zcopy.sn;
 
     to_ep->flags |= from_ep->flags & (UCT_TCP_EP_FLAG_ZCOPY_TX           |
                                       UCT_TCP_EP_FLAG_PUT_RX             |
                                       UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK |
                                       UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK |
-                                      UCT_TCP_EP_FLAG_NEED_FLUSH);
+                                      UCT_TCP_EP_FLAG_NEED_FLUSH         |
+                                      UCT_TCP_EP_FLAG_MSG_ZCOPY_TX       |
+                                      UCT_TCP_EP_FLAG_MSG_ZCOPY_COPIED   |
+                                      UCT_TCP_EP_FLAG_FILE_TX            |
+                                      UCT_TCP_EP_FLAG_GET_RX);
 
     if (uct_tcp_ep_ctx_buf_need_progress(&to_ep->rx)) {
         /* If some data was already read, we have to process it */
@@ -991,9 +1110,10 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, ucs_event_set_types_t add,
     if (new_events != ep->events) {
         ucs_assert(ep->fd != -1);
         ep->events = new_events;
-        ucs_trace("tcp_ep %p: set events to %c%c", ep,
+        ucs_trace("tcp_ep %p: set events to %c%c%c", ep,
                   (new_events & UCS_EVENT_SET_EVREAD)  ? 'r' : '-',
-                  (new_events & UCS_EVENT_SET_EVWRITE) ? 'w' : '-');
+                  (new_events & UCS_EVENT_SET_EVWRITE) ? 'w' : '-',
+                  (new_events & UCS_EVENT_SET_EVERR)   ? 'e' : '-');
         if (new_events == 0) {
             status = ucs_event_set_del(iface->event_set, ep->fd);
         } else if (old_events != 0) {
@@ -1038,7 +1158,8 @@ void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep)
     uct_pending_req_priv_queue_t *priv;
 
     uct_pending_queue_dispatch(priv, &ep->pending_q,
-                               uct_tcp_ep_ctx_buf_empty(&ep->tx));
+                               uct_tcp_ep_ctx_buf_empty(&ep->tx) ||
+                               (ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE));
     if (uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
         ucs_assert(ucs_queue_is_empty(&ep->pending_q));
         uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVWRITE);
@@ -1052,6 +1173,10 @@ static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep, ucs_status_t status
 
     ucs_debug("tcp_ep %p: remote disconnected", ep);
 
+    if (ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE) {
+        uct_tcp_ep_tx_coalesce_remove(ep);
+    }
+
     if (ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX) {
         if (ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_RX) {
             uct_tcp_ep_remove_ctx_cap(ep, UCT_TCP_EP_FLAG_CTX_TYPE_RX);
@@ -1104,6 +1229,102 @@ static inline ucs_status_t uct_tcp_ep_handle_send_err(uct_tcp_ep_t *ep,
     return status;
 }
 
+static ucs_status_t
+uct_tcp_ep_sendv_file_nb(uct_tcp_ep_t *ep, struct iovec *iov, size_t iov_cnt,
+                         size_t *sent_length_p)
+{
+    const uct_tcp_ep_zcopy_tx_t *ctx = (const uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
+    const uct_tcp_mem_t *memh        = ctx->file_memh;
+    struct iovec *file_iov           = &iov[iov_cnt - 1];
+    size_t hdr_length                = 0;
+    size_t file_length;
+    ucs_status_t status;
+
+    /* The headers which precede the payload are sent first, MSG_MORE lets
+     * the kernel to merge them with the beginning of the file data */
+    if (iov_cnt > 1) {
+        hdr_length = ucs_iovec_total_length(iov, iov_cnt - 1);
+        status     = ucs_socket_sendmsg_nb(ep->fd, iov, iov_cnt - 1, MSG_MORE,
+                                           sent_length_p);
+        if ((status != UCS_OK) || (*sent_length_p < hdr_length)) {
+            return status;
+        }
+    }
+
+    ucs_assertv((file_iov->iov_base >= memh->address) &&
+                (UCS_PTR_BYTE_OFFSET(file_iov->iov_base, file_iov->iov_len) <=
+                 UCS_PTR_BYTE_OFFSET(memh->address, memh->length)),
+                "ep=%p iov=%p/%zu memh=%p/%zu", ep, file_iov->iov_base,
+                file_iov->iov_len, memh->address, memh->length);
+
+    file_length = file_iov->iov_len;
+    status      = ucs_socket_sendfile_nb(ep->fd, memh->fd,
+                                         memh->offset +
+                                         UCS_PTR_BYTE_DIFF(memh->address,
+                                                           file_iov->iov_base),
+                                         &file_length);
+    if (status == UCS_ERR_NO_PROGRESS) {
+        file_length = 0;
+        status      = (hdr_length != 0) ? UCS_OK : UCS_ERR_NO_PROGRESS;
+    }
+
+    *sent_length_p = hdr_length + file_length;
+    return status;
+}
+
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_tcp_ep_sendv_msg_zcopy_nb(uct_tcp_ep_t *ep, struct iovec *iov,
+                              size_t iov_cnt, size_t *sent_length_p)
+{
+    struct msghdr msg = {
+        .msg_iov    = iov,
+        .msg_iovlen = iov_cnt
+    };
+    ssize_t ret;
+    int io_errno;
+
+    ret = sendmsg(ep->fd, &msg, MSG_NOSIGNAL | MSG_ZEROCOPY);
+    if (ucs_likely(ret > 0)) {
+        /* Each send call which queued data gets the next notification ID
+         * from the kernel */
+        ep->msg_zcopy.sn++;
+        *sent_length_p = ret;
+        return UCS_OK;
+    }
+
+    ucs_assert(ret < 0);
+    io_errno       = errno;
+    *sent_length_p = 0;
+    if (io_errno == ENOBUFS) {
+        /* Socket memory is taken by the notifications which weren't reaped
+         * yet, retry later */
+        return UCS_ERR_NO_PROGRESS;
+    }
+
+    ucs_debug("tcp_ep %p: sendmsg(fd=%d, MSG_ZEROCOPY) failed: %s", ep,
+              ep->fd, strerror(io_errno));
+    return ucs_socket_check_errno(io_errno);
+}
+#endif
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_tcp_ep_sendv_nb(uct_tcp_ep_t *ep, struct iovec *iov, size_t iov_cnt,
+                    size_t *sent_length_p)
+{
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+    if (ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX) {
+        return uct_tcp_ep_sendv_msg_zcopy_nb(ep, iov, iov_cnt, sent_length_p);
+    }
+#endif
+
+    if (ucs_unlikely(ep->flags & UCT_TCP_EP_FLAG_FILE_TX)) {
+        return uct_tcp_ep_sendv_file_nb(ep, iov, iov_cnt, sent_length_p);
+    }
+
+    return ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, sent_length_p);
+}
+
 static inline ssize_t uct_tcp_ep_send(uct_tcp_ep_t *ep)
 {
     size_t sent_length;
@@ -1135,7 +1356,7 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
     ucs_assertv((ep->tx.offset < ep->tx.length) &&
                 (ctx->iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, &ctx->iov[ctx->iov_index],
+    status = uct_tcp_ep_sendv_nb(ep, &ctx->iov[ctx->iov_index],
                                  ctx->iov_cnt - ctx->iov_index, &sent_length);
     if (ucs_unlikely(status != UCS_OK)) {
         if (status == UCS_ERR_NO_PROGRESS) {
@@ -1270,20 +1491,23 @@ static inline void uct_tcp_ep_handle_recv_err(uct_tcp_ep_t *ep,
     if ((status == UCS_ERR_NO_PROGRESS) || (status == UCS_ERR_CANCELED)) {
         /* If no data were read to the allocated buffer,
          * we can safely reset it for further reuse and to
-         * avoid overwriting this buffer, because `rx::length == 0` */
-        if (ep->rx.length == 0) {
+         * avoid overwriting this buffer, because `rx::length == 0`.
+         * GET RX receives to the user's buffer and may have no RX buffer */
+        if ((ep->rx.length == 0) && (ep->rx.buf != NULL)) {
             uct_tcp_ep_ctx_reset(&ep->rx);
         }
     } else {
-        uct_tcp_ep_ctx_reset(&ep->rx);
+        if (ep->rx.buf != NULL) {
+            uct_tcp_ep_ctx_reset(&ep->rx);
+        }
         uct_tcp_ep_handle_disconnected(ep, status);
     }
 }
 
 static inline unsigned uct_tcp_ep_recv(uct_tcp_ep_t *ep, size_t recv_length)
 {
-    uct_tcp_iface_t UCS_V_UNUSED *iface = ucs_derived_of(ep->super.super.iface,
-                                                         uct_tcp_iface_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
     ucs_status_t status;
 
     if (ucs_unlikely(recv_length == 0)) {
@@ -1304,21 +1528,74 @@ static inline unsigned uct_tcp_ep_recv(uct_tcp_ep_t *ep, size_t recv_length)
     ucs_trace_data("tcp_ep %p: recvd %zu bytes", ep, recv_length);
     ucs_assert(ep->rx.length <= (iface->config.rx_seg_size * 2));
 
+    if (iface->config.busy_poll.idle != 0) {
+        /* Keep polling the socket for the next messages without waiting for
+         * socket events */
+        ep->busy_poll.last_rx = ucs_get_time();
+        if (!(ep->flags & UCT_TCP_EP_FLAG_BUSY_POLL)) {
+            uct_tcp_iface_busy_poll_add_ep(ep);
+        }
+    }
+
     return 1;
 }
 
+static void uct_tcp_ep_msg_zcopy_tx_completed(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface     = ucs_derived_of(ep->super.super.iface,
+                                                uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
+
+    /* Keep the TX buffer, since it holds the headers which the kernel
+     * sends from, until the notification of the last send call arrives */
+    ucs_assert(ep->msg_zcopy.sn != 0);
+    ctx->msg_zcopy_sn = ep->msg_zcopy.sn - 1;
+    ucs_queue_push(&ep->msg_zcopy.comp_q, &ctx->msg_zcopy_elem);
+    uct_tcp_iface_outstanding_inc(iface);
+    uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVERR, 0);
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
+    ep->tx.buf = NULL;
+    uct_tcp_ep_ctx_rewind(&ep->tx);
+}
+
 static inline void uct_tcp_ep_check_tx_completion(uct_tcp_ep_t *ep)
 {
     if (ucs_likely(!uct_tcp_ep_ctx_buf_need_progress(&ep->tx))) {
-        uct_tcp_ep_ctx_reset(&ep->tx);
+        if (ucs_unlikely(ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX)) {
+            uct_tcp_ep_msg_zcopy_tx_completed(ep);
+        } else {
+            uct_tcp_ep_ctx_reset(&ep->tx);
+        }
     } else {
         uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
     }
 }
 
-/* Forward declaration - the function depends on AM send
+unsigned uct_tcp_ep_tx_coalesce_flush(uct_tcp_ep_t *ep)
+{
+    ssize_t offset;
+
+    uct_tcp_ep_tx_coalesce_remove(ep);
+    ucs_assertv((ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
+                (ep->tx.offset == 0) && (ep->tx.length != 0), "ep=%p", ep);
+
+    offset = uct_tcp_ep_send(ep);
+    if (ucs_unlikely(offset < 0)) {
+        return 1;
+    }
+
+    ucs_trace_data("ep %p fd %d sent %zu/%zu coalesced bytes", ep, ep->fd,
+                   ep->tx.offset, ep->tx.length);
+
+    uct_tcp_ep_check_tx_completion(ep);
+    return offset > 0;
+}
+
+/* Forward declarations - the functions depend on AM send
  * functions implemented below */
 static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep);
+static void uct_tcp_ep_post_get_resp(uct_tcp_ep_t *ep);
 
 static unsigned uct_tcp_ep_progress_data_tx(void *arg)
 {
@@ -1328,6 +1605,11 @@ static unsigned uct_tcp_ep_progress_data_tx(void *arg)
 
     ucs_trace_func("ep=%p", ep);
 
+    if (ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE) {
+        /* The coalesced AMs are sent below */
+        uct_tcp_ep_tx_coalesce_remove(ep);
+    }
+
     if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
         offset = (!(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_TX) ?
                   uct_tcp_ep_send(ep) : uct_tcp_ep_sendv(ep));
@@ -1343,6 +1625,12 @@ static unsigned uct_tcp_ep_progress_data_tx(void *arg)
         uct_tcp_ep_check_tx_completion(ep);
     }
 
+    /* GET responses go before PUT ACK, since the peer relies on the order
+     * to complete its GET operations when flush is completed */
+    if (!ucs_queue_is_empty(&ep->get_resp_q)) {
+        uct_tcp_ep_post_get_resp(ep);
+    }
+
     if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK) {
         uct_tcp_ep_post_put_ack(ep);
     }
@@ -1431,15 +1719,206 @@ static inline void uct_tcp_ep_handle_put_req(uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_PUT_RX;
 }
 
+static ucs_status_t
+uct_tcp_ep_handle_get_req(uct_tcp_ep_t *ep, uct_tcp_ep_get_req_hdr_t *get_req)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_get_op_t *get_op;
+
+    ucs_assert(get_req->addr || !get_req->length);
+
+    get_op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(get_op == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate GET response from mpool", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    get_op->comp   = NULL;
+    get_op->buffer = (void*)(uintptr_t)get_req->addr;
+    get_op->length = get_req->length;
+    ucs_queue_push(&ep->get_resp_q, &get_op->elem);
+
+    /* Responses are sent in the order of the requests */
+    uct_tcp_ep_post_get_resp(ep);
+    return UCS_OK;
+}
+
+static void
+uct_tcp_ep_atomic_do_op(const uct_tcp_ep_atomic_req_hdr_t *atomic_req,
+                        void *result)
+{
+    void *ptr = (void*)(uintptr_t)atomic_req->addr;
+    uint32_t result32;
+    uint64_t result64;
+
+    if (atomic_req->size == sizeof(uint32_t)) {
+        switch (atomic_req->opcode) {
+        case UCT_ATOMIC_OP_ADD:
+            result32 = ucs_atomic_fadd32(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_AND:
+            result32 = ucs_atomic_fand32(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_OR:
+            result32 = ucs_atomic_for32(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_XOR:
+            result32 = ucs_atomic_fxor32(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_SWAP:
+            result32 = ucs_atomic_swap32(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_CSWAP:
+            result32 = ucs_atomic_cswap32(ptr, atomic_req->compare,
+                                          atomic_req->value);
+            break;
+        default:
+            ucs_fatal("incorrect atomic opcode: %d", atomic_req->opcode);
+        }
+
+        memcpy(result, &result32, sizeof(result32));
+    } else {
+        ucs_assertv(atomic_req->size == sizeof(uint64_t), "size=%u",
+                    atomic_req->size);
+        switch (atomic_req->opcode) {
+        case UCT_ATOMIC_OP_ADD:
+            result64 = ucs_atomic_fadd64(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_AND:
+            result64 = ucs_atomic_fand64(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_OR:
+            result64 = ucs_atomic_for64(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_XOR:
+            result64 = ucs_atomic_fxor64(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_SWAP:
+            result64 = ucs_atomic_swap64(ptr, atomic_req->value);
+            break;
+        case UCT_ATOMIC_OP_CSWAP:
+            result64 = ucs_atomic_cswap64(ptr, atomic_req->compare,
+                                          atomic_req->value);
+            break;
+        default:
+            ucs_fatal("incorrect atomic opcode: %d", atomic_req->opcode);
+        }
+
+        memcpy(result, &result64, sizeof(result64));
+    }
+}
+
+static ucs_status_t
+uct_tcp_ep_handle_atomic_req(uct_tcp_ep_t *ep,
+                             const uct_tcp_ep_atomic_req_hdr_t *atomic_req)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_get_op_t *get_op;
+    uint64_t result;
+
+    if (!atomic_req->fetch) {
+        uct_tcp_ep_atomic_do_op(atomic_req, &result);
+        ep->rx.put_sn = atomic_req->sn;
+        uct_tcp_ep_post_put_ack(ep);
+        return UCS_OK;
+    }
+
+    get_op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(get_op == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate atomic response from mpool",
+                  ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    uct_tcp_ep_atomic_do_op(atomic_req, &get_op->result);
+    get_op->comp   = NULL;
+    get_op->buffer = &get_op->result;
+    get_op->length = atomic_req->size;
+    ucs_queue_push(&ep->get_resp_q, &get_op->elem);
+
+    /* The result is sent in GET RESP, in the order of the requests */
+    uct_tcp_ep_post_get_resp(ep);
+    return UCS_OK;
+}
+
+static void uct_tcp_ep_get_rx_advance(uct_tcp_ep_t *ep, size_t recv_length)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_get_op_t *get_op;
+
+    get_op = ucs_queue_head_elem_non_empty(&ep->get_req_q,
+                                           uct_tcp_ep_get_op_t, elem);
+    ucs_assert(recv_length <= get_op->length);
+
+    if (get_op->buffer != NULL) {
+        get_op->buffer = UCS_PTR_BYTE_OFFSET(get_op->buffer, recv_length);
+    }
+
+    get_op->length -= recv_length;
+    if (get_op->length != 0) {
+        ep->flags |= UCT_TCP_EP_FLAG_GET_RX;
+        return;
+    }
+
+    if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+        if (ep->rx.buf != NULL) {
+            /* Release the buffer used to drop the payload */
+            uct_tcp_ep_ctx_reset(&ep->rx);
+        }
+    }
+
+    ucs_queue_pull_non_empty(&ep->get_req_q);
+    if (get_op->comp != NULL) {
+        uct_invoke_completion(get_op->comp, UCS_OK);
+    }
+
+    ucs_mpool_put_inline(get_op);
+    uct_tcp_iface_outstanding_dec(iface);
+}
+
+static void uct_tcp_ep_handle_get_resp(uct_tcp_ep_t *ep,
+                                       uct_tcp_ep_get_resp_hdr_t *get_resp,
+                                       size_t extra_recvd_length)
+{
+    uct_tcp_ep_get_op_t *get_op;
+    size_t copied_length;
+
+    ucs_assertv(!ucs_queue_is_empty(&ep->get_req_q), "ep=%p", ep);
+    get_op = ucs_queue_head_elem_non_empty(&ep->get_req_q,
+                                           uct_tcp_ep_get_op_t, elem);
+    ucs_assertv(get_resp->length == get_op->length, "ep=%p: %zu vs %zu", ep,
+                get_resp->length, get_op->length);
+
+    copied_length = ucs_min(get_op->length, extra_recvd_length);
+    if (get_op->buffer != NULL) {
+        memcpy(get_op->buffer, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
+               copied_length);
+    }
+
+    ep->rx.offset += copied_length;
+    uct_tcp_ep_get_rx_advance(ep, copied_length);
+    ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_GET_RX) ||
+               (ep->rx.offset == ep->rx.length));
+}
+
 static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
+    /* RX buffer can hold two AM segments, so the message which is partially
+     * received at the end of the buffer can be completed by the next receive
+     * together with the messages that follow it */
+    size_t buf_size        = iface->config.rx_seg_size * 2;
     unsigned handled       = 0;
     uct_tcp_am_hdr_t *hdr;
     size_t recv_length;
-    size_t recvd_length;
+    size_t msg_length;
     size_t remaining;
+    ucs_status_t status;
 
     ucs_trace_func("ep=%p", ep);
 
@@ -1450,21 +1929,38 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
         }
 
         /* post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size;
-    } else if (ep->rx.length < sizeof(*hdr)) {
-        ucs_assert((ep->rx.buf != NULL) && (ep->rx.offset == 0));
-
-        /* do partial receive of the remaining part of the hdr
-         * and post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size - ep->rx.length;
+        recv_length = buf_size;
     } else {
-        ucs_assert((ep->rx.buf != NULL) &&
-                   ((ep->rx.length - ep->rx.offset) >= sizeof(*hdr)));
+        ucs_assert(ep->rx.buf != NULL);
+
+        remaining = ep->rx.length - ep->rx.offset;
+        if (remaining < sizeof(*hdr)) {
+            /* the length of the message is unknown yet, assume the maximal */
+            msg_length = iface->config.rx_seg_size;
+        } else {
+            hdr        = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
+            msg_length = sizeof(*hdr) + hdr->length;
+        }
+
+        if (remaining >= msg_length) {
+            /* the buffer already has a complete message, e.g. the context
+             * was moved from another EP, so handle it without receiving */
+            recv_length = 0;
+        } else {
+            if ((ep->rx.offset + msg_length) > buf_size) {
+                /* wrap around: move the partially received message to the
+                 * beginning of the buffer, so it fits there entirely */
+                memmove(ep->rx.buf,
+                        UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
+                        remaining);
+                ep->rx.offset = 0;
+                ep->rx.length = remaining;
+            }
 
-        /* do partial receive of the remaining user data */
-        hdr          = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
-        recvd_length = ep->rx.length - ep->rx.offset - sizeof(*hdr);
-        recv_length  = ucs_max(0, (ssize_t)(hdr->length - recvd_length));
+            /* receive the rest of the partial message along with as many
+             * following messages as the buffer can hold */
+            recv_length = buf_size - ep->rx.length;
+        }
     }
 
     if (!uct_tcp_ep_recv(ep, recv_length)) {
@@ -1475,11 +1971,7 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
     while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
         remaining = ep->rx.length - ep->rx.offset;
         if (remaining < sizeof(*hdr)) {
-            /* Move the partially received hdr to the beginning of the buffer */
-            memmove(ep->rx.buf, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
-                    remaining);
-            ep->rx.offset = 0;
-            ep->rx.length = remaining;
+            /* The header is completed by the next receive */
             handled++;
             goto out;
         }
@@ -1526,6 +2018,31 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
             ucs_assert(hdr->length == sizeof(uint32_t));
             uct_tcp_ep_handle_put_ack(ep, (uct_tcp_ep_put_ack_hdr_t*)(hdr + 1));
             handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REQ_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_req_hdr_t));
+            status = uct_tcp_ep_handle_get_req(
+                    ep, (uct_tcp_ep_get_req_hdr_t*)(hdr + 1));
+            handled++;
+            if (ucs_unlikely(status != UCS_OK)) {
+                goto err_disconnect;
+            }
+        } else if (hdr->am_id == UCT_TCP_EP_ATOMIC_REQ_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_atomic_req_hdr_t));
+            status = uct_tcp_ep_handle_atomic_req(
+                    ep, (uct_tcp_ep_atomic_req_hdr_t*)(hdr + 1));
+            handled++;
+            if (ucs_unlikely(status != UCS_OK)) {
+                goto err_disconnect;
+            }
+        } else if (hdr->am_id == UCT_TCP_EP_GET_RESP_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_resp_hdr_t));
+            uct_tcp_ep_handle_get_resp(ep,
+                                       (uct_tcp_ep_get_resp_hdr_t*)(hdr + 1),
+                                       ep->rx.length - ep->rx.offset);
+            handled++;
+            /* If GET RX is in progress, the rest of the payload is received
+             * directly to the user's buffer, so RX buffer is released below
+             * since all received data was handled */
         } else if (hdr->am_id == UCT_TCP_EP_KEEPALIVE_AM_ID) {
             /* just ignore keepalive requests */
             handled++;
@@ -1545,14 +2062,29 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
 
 out:
     return handled;
+
+err_disconnect:
+    /* The response cannot be sent, so fail the connection to let the peer
+     * complete its operation with an error */
+    uct_tcp_ep_ctx_reset(&ep->rx);
+    uct_tcp_ep_handle_disconnected(ep, status);
+    return handled;
 }
 
 static inline ucs_status_t
 uct_tcp_ep_am_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
-                      uint8_t am_id, uct_tcp_am_hdr_t **hdr)
+                      uint8_t am_id, int coalesce, uct_tcp_am_hdr_t **hdr)
 {
     ucs_status_t status;
 
+    if (coalesce && (ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE)) {
+        /* There is room for an AM of the maximal size after the coalesced
+         * ones, see uct_tcp_ep_am_send() */
+        *hdr          = UCS_PTR_BYTE_OFFSET(ep->tx.buf, ep->tx.length);
+        (*hdr)->am_id = am_id;
+        return UCS_OK;
+    }
+
     status = uct_tcp_ep_check_tx_res(ep);
     if (ucs_unlikely(status != UCS_OK)) {
         if (ucs_likely(status == UCS_ERR_NO_RESOURCE)) {
@@ -1600,14 +2132,55 @@ static unsigned uct_tcp_ep_progress_put_rx(uct_tcp_ep_t *ep)
     return 1;
 }
 
+static unsigned uct_tcp_ep_progress_get_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_get_op_t *get_op;
+    size_t recv_length;
+    ucs_status_t status;
+    void *buffer;
+
+    get_op = ucs_queue_head_elem_non_empty(&ep->get_req_q,
+                                           uct_tcp_ep_get_op_t, elem);
+    if (ucs_likely(get_op->buffer != NULL)) {
+        buffer      = get_op->buffer;
+        recv_length = get_op->length;
+    } else {
+        /* The operation was canceled, drop the payload using RX buffer */
+        if ((ep->rx.buf == NULL) &&
+            (uct_tcp_ep_ctx_buf_alloc(ep, &ep->rx,
+                                      &iface->rx_mpool) != UCS_OK)) {
+            return 0;
+        }
+
+        buffer      = ep->rx.buf;
+        recv_length = ucs_min(get_op->length, iface->config.rx_seg_size);
+    }
+
+    status = ucs_socket_recv_nb(ep->fd, buffer, 0, &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        uct_tcp_ep_handle_recv_err(ep, status);
+        return 0;
+    }
+
+    ucs_assertv(recv_length, "ep=%p", ep);
+
+    uct_tcp_ep_get_rx_advance(ep, recv_length);
+
+    return 1;
+}
+
 static unsigned uct_tcp_ep_progress_data_rx(void *arg)
 {
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)arg;
 
-    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_RX)) {
-        return uct_tcp_ep_progress_am_rx(ep);
-    } else {
+    if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX) {
         return uct_tcp_ep_progress_put_rx(ep);
+    } else if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        return uct_tcp_ep_progress_get_rx(ep);
+    } else {
+        return uct_tcp_ep_progress_am_rx(ep);
     }
 }
 
@@ -1659,7 +2232,9 @@ static unsigned uct_tcp_ep_progress_magic_number_rx(void *arg)
 
     uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_ACCEPTING);
 
-    return 1;
+    /* The connection request is sent together with the magic number, so
+     * handle it now instead of waiting for the next socket event */
+    return 1 + uct_tcp_ep_progress_data_rx(ep);
 
 err:
     uct_tcp_ep_destroy_internal(&ep->super.super);
@@ -1675,6 +2250,8 @@ uct_tcp_ep_set_outstanding_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_ZCOPY_TX;
 
     if ((header_length != 0) &&
+        /* MSG_ZEROCOPY send already uses a copy of the header */
+        !(ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_TX) &&
         /* check whether a user's header was sent or not */
         (ep->tx.offset < (sizeof(uct_tcp_am_hdr_t) + header_length))) {
         ucs_assert(header_length <= iface->config.zcopy.max_hdr);
@@ -1693,11 +2270,40 @@ uct_tcp_ep_set_outstanding_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
 static inline ucs_status_t
 uct_tcp_ep_am_send(uct_tcp_ep_t *ep, const uct_tcp_am_hdr_t *hdr)
 {
-    uct_tcp_iface_t UCS_V_UNUSED *iface = ucs_derived_of(ep->super.super.iface,
-                                                         uct_tcp_iface_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
     ssize_t offset;
 
-    uct_tcp_ep_tx_started(ep, hdr);
+    if (ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE) {
+        /* The AM was appended to the coalesced ones */
+        ep->tx.length      += sizeof(*hdr) + hdr->length;
+        iface->outstanding += sizeof(*hdr) + hdr->length;
+    } else {
+        uct_tcp_ep_tx_started(ep, hdr);
+    }
+
+    /* Keep a small user's AM in the TX buffer if an AM of the maximal size
+     * can still be appended, it is sent by the progress or by the operation
+     * which can't be coalesced */
+    if ((hdr->length <= iface->config.tx_coalesce_thresh) &&
+        (hdr->am_id < UCT_AM_ID_MAX) &&
+        ((ep->tx.length + iface->config.tx_seg_size) <=
+         iface->config.tx_buf_size)) {
+        if (!(ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE)) {
+            ucs_list_add_tail(&iface->tx_coalesce_list, &ep->tx_coalesce_list);
+            ep->flags |= UCT_TCP_EP_FLAG_TX_COALESCE;
+        }
+
+        ++iface->counters.tx_coalesce;
+        uct_iface_trace_am(&iface->super, UCT_AM_TRACE_TYPE_SEND, hdr->am_id,
+                           hdr + 1, hdr->length, "SEND: ep %p fd %d coalesced "
+                           "%zu bytes", ep, ep->fd, ep->tx.length);
+        return UCS_OK;
+    }
+
+    if (ep->flags & UCT_TCP_EP_FLAG_TX_COALESCE) {
+        uct_tcp_ep_tx_coalesce_remove(ep);
+    }
 
     offset = uct_tcp_ep_send(ep);
     if (ucs_unlikely(offset < 0)) {
@@ -1746,7 +2352,7 @@ uct_tcp_ep_am_sendv(uct_tcp_ep_t *ep, int short_sendv, uct_tcp_am_hdr_t *hdr,
     ucs_assertv((ep->tx.length <= send_limit) &&
                 (iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, &sent_length);
+    status = uct_tcp_ep_sendv_nb(ep, iov, iov_cnt, &sent_length);
     if (ucs_unlikely((status != UCS_OK) && (status != UCS_ERR_NO_PROGRESS))) {
         return uct_tcp_ep_handle_send_err(ep, status);
     }
@@ -1784,11 +2390,18 @@ static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep)
     uct_tcp_ep_put_ack_hdr_t *put_ack;
     ucs_status_t status;
 
+    if (!ucs_queue_is_empty(&ep->get_resp_q)) {
+        /* PUT ACK must not overtake GET responses, which were requested
+         * before the PUT operations completed by the ACK */
+        ep->flags |= UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK;
+        return;
+    }
+
     /* Make sure that we are sending nothing through this EP at the moment.
      * This check is needed to avoid mixing AM/PUT data sent from this EP
      * and this PUT ACK message */
     status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_PUT_ACK_AM_ID,
-                                   &hdr);
+                                   0, &hdr);
     if (status != UCS_OK) {
         if (status == UCS_ERR_NO_RESOURCE) {
             ep->flags |= UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK;
@@ -1812,6 +2425,71 @@ static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep)
     ep->flags &= ~UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK;
 }
 
+static void uct_tcp_ep_post_get_resp(uct_tcp_ep_t *ep)
+{
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_get_resp_hdr_t *get_resp;
+    uct_tcp_ep_zcopy_tx_t *ctx;
+    uct_tcp_ep_get_op_t *get_op;
+    ucs_status_t status;
+
+    while (!ucs_queue_is_empty(&ep->get_resp_q)) {
+        status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_RESP_AM_ID,
+                                       0, &hdr);
+        if (status != UCS_OK) {
+            if (status != UCS_ERR_NO_RESOURCE) {
+                ucs_error("tcp_ep %p: failed to prepare AM data", ep);
+            }
+            return;
+        }
+
+        ucs_assertv(hdr != NULL, "ep=%p", ep);
+        get_op = ucs_queue_pull_elem_non_empty(&ep->get_resp_q,
+                                               uct_tcp_ep_get_op_t, elem);
+
+        /* The response header is kept in the EP TX buffer, and the payload
+         * is sent directly from the requested memory region */
+        ctx               = ucs_derived_of(hdr, uct_tcp_ep_zcopy_tx_t);
+        ctx->super.length = sizeof(*get_resp);
+        get_resp          = UCS_PTR_BYTE_OFFSET(ep->tx.buf,
+                                                iface->config.zcopy.hdr_offset);
+        get_resp->length  = get_op->length;
+
+        ctx->iov[0].iov_base = hdr;
+        ctx->iov[0].iov_len  = sizeof(*hdr);
+        ctx->iov[1].iov_base = get_resp;
+        ctx->iov[1].iov_len  = sizeof(*get_resp);
+        ctx->iov[2].iov_base = get_op->buffer;
+        ctx->iov[2].iov_len  = get_op->length;
+        ctx->iov_cnt         = (get_op->length != 0) ? 3 : 2;
+        ep->tx.length        = get_op->length;
+
+        if (get_op->buffer == &get_op->result) {
+            /* The result of an atomic operation is released together with
+             * the operation, so it is sent from the TX buffer */
+            memcpy(get_resp + 1, &get_op->result, get_op->length);
+            ctx->iov[1].iov_len += get_op->length;
+            ctx->iov_cnt         = 2;
+        }
+
+        ucs_mpool_put_inline(get_op);
+
+        status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super,
+                                     UCT_TCP_EP_GET_ZCOPY_MAX, get_resp,
+                                     ctx->iov, ctx->iov_cnt);
+        if (ucs_unlikely(status != UCS_OK)) {
+            return;
+        }
+
+        if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+            uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, NULL, 0, NULL);
+            return;
+        }
+    }
+}
+
 static inline ucs_status_t
 uct_tcp_ep_am_short_sendv(uct_tcp_ep_t *ep, uct_tcp_iface_t *iface,
                           uct_tcp_am_hdr_t *hdr, uint64_t header, struct iovec *iov,
@@ -1854,7 +2532,8 @@ ucs_status_t uct_tcp_ep_am_short(uct_ep_h uct_ep, uint8_t am_id, uint64_t header
                      "am_short");
     UCT_CHECK_AM_ID(am_id);
 
-    status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
+    status = uct_tcp_ep_am_prepare(iface, ep, am_id,
+                                   length <= iface->config.sendv_thresh, &hdr);
     if (status != UCS_OK) {
         return status;
     }
@@ -1909,7 +2588,7 @@ ucs_status_t uct_tcp_ep_am_short_iov(uct_ep_h uct_ep, uint8_t am_id,
                      iface->config.tx_seg_size - sizeof(uct_tcp_am_hdr_t),
                      "am_short_iov");
 
-    status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
+    status = uct_tcp_ep_am_prepare(iface, ep, am_id, 0, &hdr);
     if (status != UCS_OK) {
         return status;
     }
@@ -1945,7 +2624,7 @@ ssize_t uct_tcp_ep_am_bcopy(uct_ep_h uct_ep, uint8_t am_id,
 
     UCT_CHECK_AM_ID(am_id);
 
-    status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
+    status = uct_tcp_ep_am_prepare(iface, ep, am_id, 1, &hdr);
     if (status != UCS_OK) {
         return status;
     }
@@ -1981,15 +2660,16 @@ uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id
     UCT_CHECK_IOV_SIZE(iovcnt, iface->config.max_iov, name);
     UCT_CHECK_LENGTH(header_length, 0, iface->config.zcopy.max_hdr, name);
 
-    status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
+    status = uct_tcp_ep_am_prepare(iface, ep, am_id, 0, &hdr);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
 
     ucs_assertv(hdr != NULL, "ep=%p", ep);
 
-    ctx          = ucs_derived_of(hdr, uct_tcp_ep_zcopy_tx_t);
-    ctx->iov_cnt = 0;
+    ctx            = ucs_derived_of(hdr, uct_tcp_ep_zcopy_tx_t);
+    ctx->iov_cnt   = 0;
+    ctx->file_memh = NULL;
 
     /* TCP transport header */
     ctx->iov[ctx->iov_cnt].iov_base = hdr;
@@ -2015,6 +2695,33 @@ uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id
     return UCS_OK;
 }
 
+static UCS_F_ALWAYS_INLINE int
+uct_tcp_ep_msg_zcopy_start(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                           uct_tcp_ep_zcopy_tx_t *ctx, const void *header,
+                           unsigned header_length, size_t payload_length,
+                           uct_completion_t *comp)
+{
+    if (ucs_likely((payload_length < iface->config.msg_zcopy_thresh) ||
+                   (payload_length == 0) ||
+                   (ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_COPIED))) {
+        return 0;
+    }
+
+    /* The kernel reads all the data after the send call returns, so the
+     * user's header, which may be on the caller's stack, is sent from
+     * the EP TX buffer */
+    if (header_length != 0) {
+        ucs_assert(header_length <= iface->config.zcopy.max_hdr);
+        ctx->iov[1].iov_base = UCS_PTR_BYTE_OFFSET(ep->tx.buf,
+                                                   iface->config.zcopy.hdr_offset);
+        memcpy(ctx->iov[1].iov_base, header, header_length);
+    }
+
+    ctx->comp  = comp;
+    ep->flags |= UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
+    return 1;
+}
+
 ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *header,
                                  unsigned header_length, const uct_iov_t *iov,
                                  size_t iovcnt, unsigned flags,
@@ -2025,6 +2732,7 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     uct_tcp_ep_zcopy_tx_t *ctx = NULL;
     size_t payload_length      = 0;
     ucs_status_t status;
+    int msg_zcopy;
 
     UCT_CHECK_LENGTH(header_length + uct_iov_total_length(iov, iovcnt), 0,
                      iface->config.rx_seg_size - sizeof(uct_tcp_am_hdr_t),
@@ -2039,10 +2747,14 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     }
 
     ctx->super.length = payload_length + header_length;
+    msg_zcopy         = uct_tcp_ep_msg_zcopy_start(iface, ep, ctx, header,
+                                                   header_length,
+                                                   payload_length, comp);
 
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, iface->config.rx_seg_size,
                                  header, ctx->iov, ctx->iov_cnt);
     if (ucs_unlikely(status != UCS_OK)) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZCOPY_TX;
         return status;
     }
 
@@ -2054,7 +2766,7 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
         return UCS_INPROGRESS;
     }
 
-    return UCS_OK;
+    return msg_zcopy ? UCS_INPROGRESS : UCS_OK;
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
@@ -2082,6 +2794,21 @@ uct_tcp_ep_put_comp_add(uct_tcp_ep_t *ep, uct_completion_t *comp, int wait_sn)
     return UCS_OK;
 }
 
+static void uct_tcp_ep_put_sn_advance(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
+{
+    ep->tx.put_sn++;
+
+    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK)) {
+        /* Add UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK flag and increment iface
+         * outstanding operations counter in order to ensure returning
+         * UCS_INPROGRESS from flush functions and do progressing.
+         * UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK flag has to be removed upon PUT
+         * ACK message receiving if there are no other PUT operations in-flight */
+        ep->flags |= UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK;
+        uct_tcp_iface_outstanding_inc(iface);
+    }
+}
+
 ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
                                   size_t iovcnt, uint64_t remote_addr,
                                   uct_rkey_t rkey, uct_completion_t *comp)
@@ -2113,23 +2840,27 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     put_req.length    = ep->tx.length;
     put_req.sn        = ep->tx.put_sn + 1;
 
+    if ((iovcnt == 1) && (iov[0].memh != UCT_MEM_HANDLE_NULL) &&
+        (put_req.length != 0)) {
+        /* The payload is registered with a file, send it from the file, so
+         * the kernel doesn't copy it from the user space */
+        ctx->file_memh = iov[0].memh;
+        ep->flags     |= UCT_TCP_EP_FLAG_FILE_TX;
+    } else {
+        /* PUT is completed by the PUT ACK, which the peer sends after it has
+         * received all the data */
+        uct_tcp_ep_msg_zcopy_start(iface, ep, ctx, &put_req, sizeof(put_req),
+                                   put_req.length, NULL);
+    }
+
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_PUT_ZCOPY_MAX,
                                  &put_req, ctx->iov, ctx->iov_cnt);
     if (ucs_unlikely(status != UCS_OK)) {
+        ep->flags &= ~(UCT_TCP_EP_FLAG_MSG_ZCOPY_TX | UCT_TCP_EP_FLAG_FILE_TX);
         return status;
     }
 
-    ep->tx.put_sn++;
-
-    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK)) {
-        /* Add UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK flag and increment iface
-         * outstanding operations counter in order to ensure returning
-         * UCS_INPROGRESS from flush functions and do progressing.
-         * UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK flag has to be removed upon PUT
-         * ACK message receiving if there are no other PUT operations in-flight */
-        ep->flags |= UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK;
-        uct_tcp_iface_outstanding_inc(iface);
-    }
+    uct_tcp_ep_put_sn_advance(iface, ep);
 
     UCT_TL_EP_STAT_OP(&ep->super, PUT, ZCOPY, put_req.length);
 
@@ -2141,11 +2872,183 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
         uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, &put_req,
                                          sizeof(put_req), NULL);
+    } else {
+        ep->flags &= ~UCT_TCP_EP_FLAG_FILE_TX;
     }
 
     return UCS_INPROGRESS;
 }
 
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    size_t length          = uct_iov_total_length(iov, iovcnt);
+    uct_tcp_ep_get_req_hdr_t *get_req;
+    uct_tcp_ep_get_op_t *get_op;
+    ucs_status_t status;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, 1ul, "get_zcopy");
+    UCT_CHECK_LENGTH(length, 0, UCT_TCP_EP_GET_ZCOPY_MAX, "get_zcopy");
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_REQ_AM_ID, 0,
+                                   &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    get_op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(get_op == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate GET request from mpool", ep);
+        uct_tcp_ep_ctx_reset(&ep->tx);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+    hdr->length     = sizeof(*get_req);
+    get_req         = (uct_tcp_ep_get_req_hdr_t*)(hdr + 1);
+    get_req->addr   = remote_addr;
+    get_req->length = length;
+
+    status = uct_tcp_ep_am_send(ep, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucs_mpool_put_inline(get_op);
+        return status;
+    }
+
+    /* The peer responds to the requests in order, and the response is
+     * received directly to the user's buffer */
+    get_op->comp   = comp;
+    get_op->buffer = (iovcnt != 0) ? iov[0].buffer : NULL;
+    get_op->length = length;
+    ucs_queue_push(&ep->get_req_q, &get_op->elem);
+    uct_tcp_iface_outstanding_inc(iface);
+
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, length);
+    return UCS_INPROGRESS;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_tcp_ep_atomic(uct_ep_h tl_ep, uct_atomic_op_t opcode, size_t size,
+                  uint64_t value, uint64_t compare, uint64_t remote_addr,
+                  void *result, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep            = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface      = ucs_derived_of(tl_ep->iface,
+                                                 uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr       = NULL;
+    uct_tcp_ep_get_op_t *get_op = NULL;
+    uct_tcp_ep_atomic_req_hdr_t *atomic_req;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_ATOMIC_REQ_AM_ID, 0,
+                                   &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    if (result != NULL) {
+        get_op = ucs_mpool_get_inline(&iface->tx_mpool);
+        if (ucs_unlikely(get_op == NULL)) {
+            ucs_error("tcp_ep %p: unable to allocate atomic request from mpool",
+                      ep);
+            uct_tcp_ep_ctx_reset(&ep->tx);
+            return UCS_ERR_NO_MEMORY;
+        }
+    }
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+    hdr->length         = sizeof(*atomic_req);
+    atomic_req          = (uct_tcp_ep_atomic_req_hdr_t*)(hdr + 1);
+    atomic_req->addr    = remote_addr;
+    atomic_req->value   = value;
+    atomic_req->compare = compare;
+    atomic_req->opcode  = opcode;
+    atomic_req->size    = size;
+    atomic_req->fetch   = (result != NULL);
+    atomic_req->sn      = ep->tx.put_sn + 1;
+
+    status = uct_tcp_ep_am_send(ep, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        if (get_op != NULL) {
+            ucs_mpool_put_inline(get_op);
+        }
+        return status;
+    }
+
+    UCT_TL_EP_STAT_ATOMIC(&ep->super);
+
+    if (result == NULL) {
+        /* The peer acknowledges the operation like PUT, so flush completes
+         * after it was performed */
+        uct_tcp_ep_put_sn_advance(iface, ep);
+        return UCS_OK;
+    }
+
+    /* The previous value is received in GET RESP to the user's buffer */
+    get_op->comp   = comp;
+    get_op->buffer = result;
+    get_op->length = size;
+    ucs_queue_push(&ep->get_req_q, &get_op->elem);
+    uct_tcp_iface_outstanding_inc(iface);
+    return UCS_INPROGRESS;
+}
+
+ucs_status_t uct_tcp_ep_atomic32_post(uct_ep_h tl_ep, unsigned opcode,
+                                      uint32_t value, uint64_t remote_addr,
+                                      uct_rkey_t rkey)
+{
+    return uct_tcp_ep_atomic(tl_ep, (uct_atomic_op_t)opcode, sizeof(value),
+                             value, 0, remote_addr, NULL, NULL);
+}
+
+ucs_status_t uct_tcp_ep_atomic64_post(uct_ep_h tl_ep, unsigned opcode,
+                                      uint64_t value, uint64_t remote_addr,
+                                      uct_rkey_t rkey)
+{
+    return uct_tcp_ep_atomic(tl_ep, (uct_atomic_op_t)opcode, sizeof(value),
+                             value, 0, remote_addr, NULL, NULL);
+}
+
+ucs_status_t uct_tcp_ep_atomic32_fetch(uct_ep_h tl_ep, uct_atomic_op_t opcode,
+                                       uint32_t value, uint32_t *result,
+                                       uint64_t remote_addr, uct_rkey_t rkey,
+                                       uct_completion_t *comp)
+{
+    return uct_tcp_ep_atomic(tl_ep, opcode, sizeof(value), value, 0,
+                             remote_addr, result, comp);
+}
+
+ucs_status_t uct_tcp_ep_atomic64_fetch(uct_ep_h tl_ep, uct_atomic_op_t opcode,
+                                       uint64_t value, uint64_t *result,
+                                       uint64_t remote_addr, uct_rkey_t rkey,
+                                       uct_completion_t *comp)
+{
+    return uct_tcp_ep_atomic(tl_ep, opcode, sizeof(value), value, 0,
+                             remote_addr, result, comp);
+}
+
+ucs_status_t uct_tcp_ep_atomic_cswap32(uct_ep_h tl_ep, uint32_t compare,
+                                       uint32_t swap, uint64_t remote_addr,
+                                       uct_rkey_t rkey, uint32_t *result,
+                                       uct_completion_t *comp)
+{
+    return uct_tcp_ep_atomic(tl_ep, UCT_ATOMIC_OP_CSWAP, sizeof(swap), swap,
+                             compare, remote_addr, result, comp);
+}
+
+ucs_status_t uct_tcp_ep_atomic_cswap64(uct_ep_h tl_ep, uint64_t compare,
+                                       uint64_t swap, uint64_t remote_addr,
+                                       uct_rkey_t rkey, uint64_t *result,
+                                       uct_completion_t *comp)
+{
+    return uct_tcp_ep_atomic(tl_ep, UCT_ATOMIC_OP_CSWAP, sizeof(swap), swap,
+                             compare, remote_addr, result, comp);
+}
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags)
 {
@@ -2187,6 +3090,109 @@ void uct_tcp_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
                             uct_tcp_ep_pending_purge_cb, &purge_arg);
 }
 
+static ucs_status_t
+uct_tcp_ep_msg_zcopy_comp_add(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx;
+
+    if (comp == NULL) {
+        return UCS_OK;
+    }
+
+    ctx = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(ctx == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate MSG_ZEROCOPY completion from "
+                  "mpool", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    /* Complete together with the last outstanding operation */
+    ctx->comp         = comp;
+    ctx->msg_zcopy_sn = ep->msg_zcopy.sn - 1;
+    ucs_queue_push(&ep->msg_zcopy.comp_q, &ctx->msg_zcopy_elem);
+    uct_tcp_iface_outstanding_inc(iface);
+
+    return UCS_OK;
+}
+
+unsigned uct_tcp_ep_progress_msg_zcopy(uct_tcp_ep_t *ep)
+{
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    char cmsg_buf[CMSG_SPACE(sizeof(struct sock_extended_err))];
+    struct sock_extended_err *serr;
+    uct_tcp_ep_zcopy_tx_t *ctx;
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    unsigned count = 0;
+
+    while (!ucs_queue_is_empty(&ep->msg_zcopy.comp_q)) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = cmsg_buf;
+        msg.msg_controllen = sizeof(cmsg_buf);
+
+        if (recvmsg(ep->fd, &msg, MSG_ERRQUEUE) < 0) {
+            if (errno != EAGAIN) {
+                ucs_debug("tcp_ep %p: recvmsg(fd=%d, MSG_ERRQUEUE) failed: %m",
+                          ep, ep->fd);
+            }
+            break;
+        }
+
+        cmsg = CMSG_FIRSTHDR(&msg);
+        if ((cmsg == NULL) ||
+            !(((cmsg->cmsg_level == IPPROTO_IP) &&
+               (cmsg->cmsg_type == IP_RECVERR)) ||
+              ((cmsg->cmsg_level == IPPROTO_IPV6) &&
+               (cmsg->cmsg_type == IPV6_RECVERR)))) {
+            continue;
+        }
+
+        serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+        if ((serr->ee_errno != 0) ||
+            (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)) {
+            continue;
+        }
+
+        if ((serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) &&
+            !(ep->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_COPIED)) {
+            /* No gain from zero-copy send on this connection, e.g. loopback
+             * or a device without scatter-gather support */
+            ucs_debug("tcp_ep %p: kernel copied MSG_ZEROCOPY data, "
+                      "switching to regular send", ep);
+            ep->flags |= UCT_TCP_EP_FLAG_MSG_ZCOPY_COPIED;
+        }
+
+        /* Notification [ee_info, ee_data] covers the range of send calls,
+         * TCP reports the ranges in order */
+        ucs_queue_for_each_extract(ctx, &ep->msg_zcopy.comp_q, msg_zcopy_elem,
+                                   UCS_CIRCULAR_COMPARE32(ctx->msg_zcopy_sn,
+                                                          <=,
+                                                          serr->ee_data)) {
+            if (ctx->comp != NULL) {
+                uct_invoke_completion(ctx->comp, UCS_OK);
+            }
+
+            ucs_mpool_put_inline(ctx);
+            uct_tcp_iface_outstanding_dec(iface);
+            ++count;
+        }
+    }
+
+    if (ucs_queue_is_empty(&ep->msg_zcopy.comp_q) &&
+        (ep->events & UCS_EVENT_SET_EVERR)) {
+        uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVERR);
+    }
+
+    return count;
+#else
+    return 0;
+#endif
+}
+
 ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
                               uct_completion_t *comp)
 {
@@ -2215,18 +3221,32 @@ ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
         ucs_assert(ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK);
     }
 
+    if (!ucs_queue_is_empty(&ep->msg_zcopy.comp_q)) {
+        status = uct_tcp_ep_msg_zcopy_comp_add(ep, comp);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        if ((ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) &&
+            (comp != NULL)) {
+            /* The completion is invoked by both the MSG_ZEROCOPY
+             * notification and the PUT ACK */
+            ++comp->count;
+        }
+    } else if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK)) {
+        UCT_TL_EP_STAT_FLUSH(&ep->super);
+        return UCS_OK;
+    }
+
     if (ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) {
         status = uct_tcp_ep_put_comp_add(ep, comp, ep->tx.put_sn);
         if (status != UCS_OK) {
             return status;
         }
-
-        UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
-        return UCS_INPROGRESS;
     }
 
-    UCT_TL_EP_STAT_FLUSH(&ep->super);
-    return UCS_OK;
+    UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+    return UCS_INPROGRESS;
 }
 
 ucs_status_t
@@ -2240,7 +3260,7 @@ uct_tcp_ep_check(uct_ep_h tl_ep, unsigned flags, uct_completion_t *comp)
     UCT_EP_KEEPALIVE_CHECK_PARAM(flags, comp);
 
     status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_KEEPALIVE_AM_ID,
-                                   &hdr);
+                                   0, &hdr);
     if (status != UCS_OK) {
         return (status == UCS_ERR_NO_RESOURCE) ? UCS_OK : status;
     }
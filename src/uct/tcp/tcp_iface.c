@@ -13,6 +13,8 @@
 #include <ucs/async/async.h>
 #include <ucs/sys/string.h>
 #include <ucs/config/types.h>
+#include <ucs/vfs/base/vfs_obj.h>
+#include <ucs/vfs/base/vfs_cb.h>
 #include <sys/socket.h>
 #include <sys/poll.h>
 #include <netinet/tcp.h>
@@ -45,6 +47,23 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Threshold for switching from send() to sendmsg() for short active messages",
    ucs_offsetof(uct_tcp_iface_config_t, sendv_thresh), UCS_CONFIG_TYPE_MEMUNITS},
 
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+  {"MSG_ZCOPY_THRESH", "inf",
+   "Threshold for sending the payload of AM and PUT Zcopy operations with\n"
+   "MSG_ZEROCOPY, which lets the kernel transmit directly from user buffers.\n"
+   "Specifying \"inf\" disables zero-copy send.",
+   ucs_offsetof(uct_tcp_iface_config_t, msg_zcopy_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+#endif /* UCT_TCP_EP_MSG_ZCOPY */
+
+  {"TX_COALESCE_THRESH", "0",
+   "Maximal payload size of short and bcopy active messages which are kept in\n"
+   "the send buffer of an endpoint, so the messages posted until the end of the\n"
+   "progress call, the flush of the endpoint, or until the buffer is filled up\n"
+   "are sent by a single send() call. 0 disables coalescing.",
+   ucs_offsetof(uct_tcp_iface_config_t, tx_coalesce_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
   {"PREFER_DEFAULT", "y",
    "Give higher priority to the default network interface on the host",
    ucs_offsetof(uct_tcp_iface_config_t, prefer_default), UCS_CONFIG_TYPE_BOOL},
@@ -53,15 +72,65 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Enable PUT Zcopy support",
    ucs_offsetof(uct_tcp_iface_config_t, put_enable), UCS_CONFIG_TYPE_BOOL},
 
+  {"GET_ENABLE", "y",
+   "Enable GET Zcopy support. The peer sends the requested data directly\n"
+   "from its memory in response to a GET request.",
+   ucs_offsetof(uct_tcp_iface_config_t, get_enable), UCS_CONFIG_TYPE_BOOL},
+
+  {"ATOMIC_ENABLE", "y",
+   "Enable 32/64-bit atomic operations support. The peer performs the\n"
+   "operation by the CPU when it receives the request, and sends the previous\n"
+   "value back for the fetching operations.",
+   ucs_offsetof(uct_tcp_iface_config_t, atomic_enable), UCS_CONFIG_TYPE_BOOL},
+
+  {"NUM_PATHS", "1",
+   "Number of connections that should be created between a pair of\n"
+   "communicating endpoints. Each connection uses its own socket, so large\n"
+   "messages striped across them are not limited by a single TCP flow.",
+   ucs_offsetof(uct_tcp_iface_config_t, num_paths), UCS_CONFIG_TYPE_UINT},
+
   {"CONN_NB", "n",
    "Enable non-blocking connection establishment. It may improve startup "
    "time, but can lead to connection resets due to high load on TCP/IP stack",
    ucs_offsetof(uct_tcp_iface_config_t, conn_nb), UCS_CONFIG_TYPE_BOOL},
 
+  {"CONN_FAST_OPEN", "n",
+   "Use TCP Fast Open to send the connection request in the SYN packet, once\n"
+   "the peer's cookie is cached. It saves a round trip per connection and\n"
+   "requires net.ipv4.tcp_fastopen to enable both client and server sides. If\n"
+   "set to \"try\", regular connection establishment is used when TCP Fast\n"
+   "Open is not supported by the system.",
+   ucs_offsetof(uct_tcp_iface_config_t, conn_fast_open),
+                UCS_CONFIG_TYPE_TERNARY},
+
   {"MAX_POLL", UCS_PP_MAKE_STRING(UCT_TCP_MAX_EVENTS),
    "Number of times to poll on a ready socket. 0 - no polling, -1 - until drained",
    ucs_offsetof(uct_tcp_iface_config_t, max_poll), UCS_CONFIG_TYPE_UINT},
 
+  {"BUSY_POLL_IDLE", "0",
+   "How long an endpoint which received data keeps being polled by a non-blocking\n"
+   "receive on every progress call, without waiting for socket events. While\n"
+   "there are such endpoints, socket events are waited for only once in\n"
+   "BUSY_POLL_WAIT_INTERVAL progress calls. 0 disables busy-polling.",
+   ucs_offsetof(uct_tcp_iface_config_t, busy_poll.idle),
+   UCS_CONFIG_TYPE_TIME_UNITS},
+
+  {"BUSY_POLL_WAIT_INTERVAL", "16",
+   "Wait for socket events at least once in this number of progress calls\n"
+   "while endpoints are busy-polled, to detect new connections, send\n"
+   "completions and data on other endpoints.",
+   ucs_offsetof(uct_tcp_iface_config_t, busy_poll.wait_interval),
+   UCS_CONFIG_TYPE_UINT},
+
+#ifdef SO_BUSY_POLL
+  {"SO_BUSY_POLL", "0",
+   "Set SO_BUSY_POLL socket option to the given time, so a receive on a socket\n"
+   "without data polls the network device for it. Setting a value above\n"
+   "net.core.busy_read requires CAP_NET_ADMIN. 0 - the option is not set.",
+   ucs_offsetof(uct_tcp_iface_config_t, busy_poll.sockopt),
+   UCS_CONFIG_TYPE_TIME_UNITS},
+#endif
+
   {UCT_TCP_CONFIG_MAX_CONN_RETRIES, "25",
    "How many connection establishment attempts should be done if dropped "
    "connection was detected due to lack of system resources",
@@ -111,6 +180,12 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
                 UCS_CONFIG_TYPE_TIME_UNITS},
 #endif /* UCT_TCP_EP_KEEPALIVE */
 
+  {"IO_URING", "n",
+   "Wait for socket events using io_uring poll requests instead of epoll.\n"
+   "Progress does not make a system call when no socket has an event. If set\n"
+   "to \"try\", epoll is used when io_uring is not supported by the system.",
+   ucs_offsetof(uct_tcp_iface_config_t, io_uring), UCS_CONFIG_TYPE_TERNARY},
+
   {"EP_BIND_SRC_ADDR", "try",
    "Bind client socket to the local network interface before connecting to the "
    "remote peer",
@@ -302,6 +377,7 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
 
     /* Bandwidth is bounded by TCP stack computation time */
     attr->bandwidth.shared = ucs_min(calculated_bw, iface->config.max_bw);
+    attr->dev_num_paths    = iface->config.num_paths;
 
     attr->ep_addr_len      = sizeof(uct_tcp_ep_addr_t);
     attr->iface_addr_len   = sizeof(uct_tcp_iface_addr_t);
@@ -345,6 +421,32 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
             attr->cap.put.opt_zcopy_align  = 1;
             attr->cap.flags               |= UCT_IFACE_FLAG_PUT_ZCOPY;
         }
+
+        if (iface->config.get_enable) {
+            /* GET */
+            attr->cap.get.max_iov          = 1;
+            attr->cap.get.max_zcopy        = UCT_TCP_EP_GET_ZCOPY_MAX;
+            attr->cap.get.opt_zcopy_align  = 1;
+            attr->cap.flags               |= UCT_IFACE_FLAG_GET_ZCOPY;
+        }
+
+        if (iface->config.atomic_enable) {
+            /* Atomics, the result of a fetching operation is sent back in
+             * GET response */
+            attr->cap.flags              |= UCT_IFACE_FLAG_ATOMIC_CPU;
+            attr->cap.atomic32.op_flags   =
+            attr->cap.atomic64.op_flags   = UCS_BIT(UCT_ATOMIC_OP_ADD) |
+                                            UCS_BIT(UCT_ATOMIC_OP_AND) |
+                                            UCS_BIT(UCT_ATOMIC_OP_OR)  |
+                                            UCS_BIT(UCT_ATOMIC_OP_XOR);
+            attr->cap.atomic32.fop_flags  =
+            attr->cap.atomic64.fop_flags  = UCS_BIT(UCT_ATOMIC_OP_ADD)  |
+                                            UCS_BIT(UCT_ATOMIC_OP_AND)  |
+                                            UCS_BIT(UCT_ATOMIC_OP_OR)   |
+                                            UCS_BIT(UCT_ATOMIC_OP_XOR)  |
+                                            UCS_BIT(UCT_ATOMIC_OP_SWAP) |
+                                            UCS_BIT(UCT_ATOMIC_OP_CSWAP);
+        }
     }
 
     attr->bandwidth.dedicated = 0;
@@ -368,6 +470,30 @@ out:
     return status;
 }
 
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+static int uct_tcp_iface_msg_zcopy_is_supported()
+{
+    int optval = 1;
+    ucs_status_t status;
+    int ret, fd;
+
+    status = ucs_socket_create(AF_INET, SOCK_STREAM, 0, &fd);
+    if (status != UCS_OK) {
+        return 0;
+    }
+
+    /* Kernels older than 4.14 reject the option */
+    ret = setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval));
+    if (ret < 0) {
+        ucs_diag("setsockopt(SO_ZEROCOPY) failed: %m, MSG_ZEROCOPY send is "
+                 "disabled");
+    }
+
+    ucs_close_fd(&fd);
+    return ret == 0;
+}
+#endif /* UCT_TCP_EP_MSG_ZCOPY */
+
 static ucs_status_t uct_tcp_iface_event_fd_get(uct_iface_h tl_iface, int *fd_p)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
@@ -384,6 +510,9 @@ static void uct_tcp_iface_handle_events(void *callback_data,
 
     ucs_assertv(ep->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED, "ep=%p", ep);
 
+    if (events & UCS_EVENT_SET_EVERR) {
+        *count += uct_tcp_ep_progress_msg_zcopy(ep);
+    }
     if (events & UCS_EVENT_SET_EVREAD) {
         *count += uct_tcp_ep_cm_state[ep->conn_state].rx_progress(ep);
     }
@@ -392,6 +521,79 @@ static void uct_tcp_iface_handle_events(void *callback_data,
     }
 }
 
+void uct_tcp_iface_busy_poll_add_ep(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_BUSY_POLL));
+
+    if (ep->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED) {
+        return;
+    }
+
+    ucs_trace("tcp_ep %p: start busy-polling", ep);
+    ucs_list_add_tail(&iface->busy_poll.ep_list, &ep->busy_poll.list);
+    ep->flags |= UCT_TCP_EP_FLAG_BUSY_POLL;
+}
+
+void uct_tcp_iface_busy_poll_remove_ep(uct_tcp_ep_t *ep)
+{
+    ucs_assert(ep->flags & UCT_TCP_EP_FLAG_BUSY_POLL);
+
+    ucs_trace("tcp_ep %p: stop busy-polling", ep);
+    ucs_list_del(&ep->busy_poll.list);
+    ep->flags &= ~UCT_TCP_EP_FLAG_BUSY_POLL;
+}
+
+static unsigned uct_tcp_iface_tx_coalesce_progress(uct_tcp_iface_t *iface)
+{
+    unsigned count = 0;
+    uct_tcp_ep_t *ep, *tmp;
+
+    ucs_list_for_each_safe(ep, tmp, &iface->tx_coalesce_list,
+                           tx_coalesce_list) {
+        count += uct_tcp_ep_tx_coalesce_flush(ep);
+    }
+
+    return count;
+}
+
+static unsigned uct_tcp_iface_busy_poll_progress(uct_tcp_iface_t *iface)
+{
+    ucs_time_t now = ucs_get_time();
+    unsigned count = 0;
+    ucs_list_link_t ep_list;
+    uct_tcp_ep_t *ep;
+
+    /* RX progress may destroy any EP, which removes it from the list it is
+     * on. So move the EPs to a local list, and put every EP back on the iface
+     * list before progressing it, instead of keeping a pointer to the next
+     * EP across the callbacks */
+    ucs_list_head_init(&ep_list);
+    ucs_list_splice_tail(&ep_list, &iface->busy_poll.ep_list);
+    ucs_list_head_init(&iface->busy_poll.ep_list);
+
+    while (!ucs_list_is_empty(&ep_list)) {
+        ep = ucs_list_extract_head(&ep_list, uct_tcp_ep_t, busy_poll.list);
+        ucs_list_add_tail(&iface->busy_poll.ep_list, &ep->busy_poll.list);
+
+        if ((ep->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED) ||
+            !(ep->events & UCS_EVENT_SET_EVREAD) ||
+            ((now - ep->busy_poll.last_rx) > iface->config.busy_poll.idle)) {
+            uct_tcp_iface_busy_poll_remove_ep(ep);
+            continue;
+        }
+
+        /* The EP may be destroyed by RX progress, don't touch it after */
+        ++iface->counters.busy_poll_rx;
+        ++iface->counters.syscalls;
+        count += uct_tcp_ep_cm_state[ep->conn_state].rx_progress(ep);
+    }
+
+    return count;
+}
+
 unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
@@ -400,7 +602,21 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
     unsigned read_events;
     ucs_status_t status;
 
+    ++iface->counters.progress;
+
+    if (!ucs_list_is_empty(&iface->busy_poll.ep_list)) {
+        count = uct_tcp_iface_busy_poll_progress(iface);
+        if (++iface->busy_poll.wait_skips <
+            iface->config.busy_poll.wait_interval) {
+            ++iface->counters.busy_poll_skip;
+            goto out;
+        }
+    }
+
+    iface->busy_poll.wait_skips = 0;
+
     do {
+        ++iface->counters.syscalls;
         read_events = ucs_min(ucs_sys_event_set_max_wait_events, max_events);
         status = ucs_event_set_wait(iface->event_set, &read_events,
                                     0, uct_tcp_iface_handle_events,
@@ -413,6 +629,13 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
     } while ((max_events > 0) && (read_events == UCT_TCP_MAX_EVENTS) &&
              ((status == UCS_OK) || (status == UCS_INPROGRESS)));
 
+out:
+    /* Send AMs which were coalesced by the user or by the callbacks invoked
+     * during this progress call */
+    if (!ucs_list_is_empty(&iface->tx_coalesce_list)) {
+        count += uct_tcp_iface_tx_coalesce_progress(iface);
+    }
+
     return count;
 }
 
@@ -471,6 +694,9 @@ uct_tcp_iface_connect_handler(int listen_fd, ucs_event_set_types_t events,
 ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
                                        int set_nb)
 {
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+    const int optval_one = 1;
+#endif
     ucs_status_t status;
 
     if (set_nb) {
@@ -493,6 +719,27 @@ ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
         return status;
     }
 
+#ifdef SO_BUSY_POLL
+    if (iface->sockopt.busy_poll != 0) {
+        status = ucs_socket_setopt(fd, SOL_SOCKET, SO_BUSY_POLL,
+                                   (const void*)&iface->sockopt.busy_poll,
+                                   sizeof(int));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+#endif
+
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+    if (iface->config.msg_zcopy_thresh != UCS_MEMUNITS_INF) {
+        status = ucs_socket_setopt(fd, SOL_SOCKET, SO_ZEROCOPY,
+                                   (const void*)&optval_one, sizeof(int));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+#endif
+
     return ucs_tcp_base_set_syn_cnt(fd, iface->config.syn_cnt);
 }
 
@@ -502,6 +749,13 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .ep_am_bcopy              = uct_tcp_ep_am_bcopy,
     .ep_am_zcopy              = uct_tcp_ep_am_zcopy,
     .ep_put_zcopy             = uct_tcp_ep_put_zcopy,
+    .ep_get_zcopy             = uct_tcp_ep_get_zcopy,
+    .ep_atomic_cswap64        = uct_tcp_ep_atomic_cswap64,
+    .ep_atomic_cswap32        = uct_tcp_ep_atomic_cswap32,
+    .ep_atomic64_post         = uct_tcp_ep_atomic64_post,
+    .ep_atomic32_post         = uct_tcp_ep_atomic32_post,
+    .ep_atomic64_fetch        = uct_tcp_ep_atomic64_fetch,
+    .ep_atomic32_fetch        = uct_tcp_ep_atomic32_fetch,
     .ep_pending_add           = uct_tcp_ep_pending_add,
     .ep_pending_purge         = uct_tcp_ep_pending_purge,
     .ep_flush                 = uct_tcp_ep_flush,
@@ -566,6 +820,42 @@ static ucs_status_t uct_tcp_iface_server_init(uct_tcp_iface_t *iface)
     return status;
 }
 
+static ucs_status_t uct_tcp_iface_fast_open_init(uct_tcp_iface_t *iface)
+{
+    int suppress_error = (iface->config.conn_fast_open != UCS_YES);
+#ifdef TCP_FASTOPEN_CONNECT
+    int qlen           = ucs_socket_max_conn();
+    int ret;
+#endif
+
+    if (iface->config.conn_fast_open == UCS_NO) {
+        return UCS_OK;
+    }
+
+#ifdef TCP_FASTOPEN_CONNECT
+    /* Accept the data carried in SYN packets of the incoming connections */
+    ret = setsockopt(iface->listen_fd, IPPROTO_TCP, TCP_FASTOPEN, &qlen,
+                     sizeof(qlen));
+    if (ret == 0) {
+        return UCS_OK;
+    }
+
+    ucs_log(suppress_error ? UCS_LOG_LEVEL_DEBUG : UCS_LOG_LEVEL_ERROR,
+            "tcp_iface %p: failed to enable TCP Fast Open on fd %d: %m",
+            iface, iface->listen_fd);
+#else
+    ucs_log(suppress_error ? UCS_LOG_LEVEL_DEBUG : UCS_LOG_LEVEL_ERROR,
+            "tcp_iface %p: TCP Fast Open is not supported", iface);
+#endif
+
+    if (!suppress_error) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    iface->config.conn_fast_open = UCS_NO;
+    return UCS_OK;
+}
+
 static ucs_status_t uct_tcp_iface_listener_init(uct_tcp_iface_t *iface)
 {
     struct sockaddr_storage bind_addr = iface->config.ifaddr;
@@ -580,6 +870,11 @@ static ucs_status_t uct_tcp_iface_listener_init(uct_tcp_iface_t *iface)
         goto err;
     }
 
+    status = uct_tcp_iface_fast_open_init(iface);
+    if (status != UCS_OK) {
+        goto err_close_sock;
+    }
+
     /* Get the port which was selected for the socket */
     ret = getsockname(iface->listen_fd, (struct sockaddr*)&bind_addr, &socklen);
     if (ret < 0) {
@@ -631,9 +926,34 @@ static ucs_mpool_ops_t uct_tcp_mpool_ops = {
     .obj_str       = NULL
 };
 
+static void uct_tcp_iface_vfs_refresh(uct_iface_h tl_iface)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
+
+    ucs_vfs_obj_add_ro_file(iface, ucs_vfs_show_primitive,
+                            &iface->counters.progress, UCS_VFS_TYPE_ULONG,
+                            "progress_count");
+
+    ucs_vfs_obj_add_ro_file(iface, ucs_vfs_show_primitive,
+                            &iface->counters.syscalls, UCS_VFS_TYPE_ULONG,
+                            "syscall_count");
+
+    ucs_vfs_obj_add_ro_file(iface, ucs_vfs_show_primitive,
+                            &iface->counters.busy_poll_skip, UCS_VFS_TYPE_ULONG,
+                            "busy_poll_skip_count");
+
+    ucs_vfs_obj_add_ro_file(iface, ucs_vfs_show_primitive,
+                            &iface->counters.busy_poll_rx, UCS_VFS_TYPE_ULONG,
+                            "busy_poll_rx_count");
+
+    ucs_vfs_obj_add_ro_file(iface, ucs_vfs_show_primitive,
+                            &iface->counters.tx_coalesce, UCS_VFS_TYPE_ULONG,
+                            "tx_coalesce_count");
+}
+
 static uct_iface_internal_ops_t uct_tcp_iface_internal_ops = {
     .iface_estimate_perf   = uct_base_iface_estimate_perf,
-    .iface_vfs_refresh     = (uct_iface_vfs_refresh_func_t)ucs_empty_function,
+    .iface_vfs_refresh     = uct_tcp_iface_vfs_refresh,
     .ep_query              = (uct_ep_query_func_t)ucs_empty_function_return_unsupported,
     .ep_invalidate         = (uct_ep_invalidate_func_t)ucs_empty_function_return_unsupported,
     .ep_connect_to_ep_v2   = uct_tcp_ep_connect_to_ep_v2,
@@ -641,6 +961,35 @@ static uct_iface_internal_ops_t uct_tcp_iface_internal_ops = {
     .ep_is_connected       = uct_tcp_ep_is_connected
 };
 
+static ucs_status_t
+uct_tcp_iface_event_set_create(uct_tcp_iface_t *iface,
+                               const uct_tcp_iface_config_t *config)
+{
+    ucs_status_t status;
+
+    if (config->io_uring != UCS_NO) {
+        status = ucs_event_set_create_io_uring(&iface->event_set);
+        if (status == UCS_OK) {
+            return UCS_OK;
+        } else if ((status != UCS_ERR_UNSUPPORTED) ||
+                   (config->io_uring == UCS_YES)) {
+            ucs_error("tcp_iface %p: failed to create io_uring event set: %s",
+                      iface, ucs_status_string(status));
+            return status;
+        }
+
+        ucs_debug("tcp_iface %p: io_uring is not supported, using epoll",
+                  iface);
+    }
+
+    status = ucs_event_set_create(&iface->event_set);
+    if (status != UCS_OK) {
+        return UCS_ERR_IO_ERROR;
+    }
+
+    return UCS_OK;
+}
+
 static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                            const uct_iface_params_t *params,
                            const uct_iface_config_t *tl_config)
@@ -680,6 +1029,13 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     self->config.rx_seg_size = config->rx_seg_size +
                                sizeof(uct_tcp_am_hdr_t);
 
+    /* Coalescing needs room for one more AM of the maximal size after the
+     * coalesced ones, so the TX buffer is doubled */
+    self->config.tx_coalesce_thresh = config->tx_coalesce_thresh;
+    self->config.tx_buf_size        = (self->config.tx_coalesce_thresh != 0) ?
+                                      (2 * self->config.tx_seg_size) :
+                                      self->config.tx_seg_size;
+
     if (ucs_iov_get_max() >= UCT_TCP_EP_AM_SHORTV_IOV_COUNT) {
         self->config.sendv_thresh = config->sendv_thresh;
     } else {
@@ -687,6 +1043,16 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         self->config.sendv_thresh = UCS_MEMUNITS_INF;
     }
 
+#ifdef UCT_TCP_EP_MSG_ZCOPY
+    self->config.msg_zcopy_thresh = config->msg_zcopy_thresh;
+    if ((self->config.msg_zcopy_thresh != UCS_MEMUNITS_INF) &&
+        !uct_tcp_iface_msg_zcopy_is_supported()) {
+        self->config.msg_zcopy_thresh = UCS_MEMUNITS_INF;
+    }
+#else
+    self->config.msg_zcopy_thresh = UCS_MEMUNITS_INF;
+#endif
+
     /* Maximum IOV count allowed by user's configuration (considering TCP
      * protocol and user's AM headers that use 1st and 2nd IOVs
      * correspondingly) and system constraints */
@@ -705,6 +1071,13 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         return UCS_ERR_INVALID_PARAM;
     }
 
+    if ((config->num_paths == 0) || (config->num_paths > UINT8_MAX)) {
+        ucs_error("unsupported value was specified (%u) for the number of "
+                  "paths, expected between 1 and %u", config->num_paths,
+                  UINT8_MAX);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
     if (config->max_conn_retries > UINT8_MAX) {
         ucs_error("unsupported value was specified (%u) for the maximal "
                   "connection retries, expected lower than %u",
@@ -716,7 +1089,11 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                                      self->config.zcopy.hdr_offset;
     self->config.prefer_default    = config->prefer_default;
     self->config.put_enable        = config->put_enable;
+    self->config.get_enable        = config->get_enable;
+    self->config.atomic_enable     = config->atomic_enable;
+    self->config.num_paths         = config->num_paths;
     self->config.conn_nb           = config->conn_nb;
+    self->config.conn_fast_open    = config->conn_fast_open;
     self->config.max_poll          = config->max_poll;
     self->config.max_conn_retries  = config->max_conn_retries;
     self->config.syn_cnt           = config->syn_cnt;
@@ -741,6 +1118,14 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
             ucs_time_from_sec(UCT_TCP_EP_DEFAULT_KEEPALIVE_IDLE);
     }
 
+    self->config.busy_poll.idle          = config->busy_poll.idle;
+    self->config.busy_poll.wait_interval = config->busy_poll.wait_interval;
+#ifdef SO_BUSY_POLL
+    self->sockopt.busy_poll = ucs_time_to_usec(config->busy_poll.sockopt);
+#else
+    self->sockopt.busy_poll = 0;
+#endif
+
     self->config.max_bw = UCS_CONFIG_DBL_IS_AUTO(config->max_bw) ?
                                   DBL_MAX :
                                   config->max_bw;
@@ -756,7 +1141,7 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     uct_iface_mpool_config_copy(&mp_params, &config->tx_mpool);
     mp_params.elems_per_chunk = (config->tx_mpool.bufs_grow == 0) ?
                                 32 : config->tx_mpool.bufs_grow;
-    mp_params.elem_size       = self->config.tx_seg_size;
+    mp_params.elem_size       = self->config.tx_buf_size;
     mp_params.ops             = &uct_tcp_mpool_ops;
     mp_params.name            = "uct_tcp_iface_tx_buf_mp";
     status = ucs_mpool_init(&mp_params, &self->tx_mpool);
@@ -797,14 +1182,17 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     }
 
     ucs_list_head_init(&self->ep_list);
+    ucs_list_head_init(&self->busy_poll.ep_list);
+    self->busy_poll.wait_skips = 0;
+    ucs_list_head_init(&self->tx_coalesce_list);
+    memset(&self->counters, 0, sizeof(self->counters));
     ucs_conn_match_init(&self->conn_match_ctx, self->config.sockaddr_len,
                         UCT_TCP_CM_CONN_SN_MAX, &uct_tcp_cm_conn_match_ops);
     status = UCS_PTR_MAP_INIT(tcp_ep, &self->ep_ptr_map);
     ucs_assert_always(status == UCS_OK);
 
-    status = ucs_event_set_create(&self->event_set);
+    status = uct_tcp_iface_event_set_create(self, config);
     if (status != UCS_OK) {
-        status = UCS_ERR_IO_ERROR;
         goto err_cleanup_rx_mpool;
     }
 
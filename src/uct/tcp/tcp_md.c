@@ -30,10 +30,51 @@ static ucs_config_field_t uct_tcp_md_config_table[] = {
 static ucs_status_t uct_tcp_md_query(uct_md_h md, uct_md_attr_v2_t *attr)
 {
     uct_md_base_md_query(attr);
+    attr->flags            = UCT_MD_FLAG_REG_FILE;
     attr->access_mem_types = UCS_BIT(UCS_MEMORY_TYPE_HOST);
     return UCS_OK;
 }
 
+static ucs_status_t
+uct_tcp_md_mem_reg(uct_md_h md, void *address, size_t length,
+                   const uct_md_mem_reg_params_t *params, uct_mem_h *memh_p)
+{
+    uint64_t flags = UCT_MD_MEM_REG_FIELD_VALUE(params, flags, FIELD_FLAGS, 0);
+    int file_fd    = UCT_MD_MEM_REG_FIELD_VALUE(params, file_fd, FIELD_FILE_FD,
+                                                -1);
+    uct_tcp_mem_t *memh;
+
+    /* Only memory backed by a file is registered, to send it by sendfile() */
+    if (file_fd < 0) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    memh = ucs_malloc(sizeof(*memh), "uct_tcp_mem_t");
+    if (memh == NULL) {
+        uct_md_log_mem_reg_error(flags,
+                                 "tcp_md %p: failed to allocate memory handle",
+                                 md);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    memh->address = address;
+    memh->length  = length;
+    memh->fd      = file_fd;
+    memh->offset  = UCT_MD_MEM_REG_FIELD_VALUE(params, file_offset,
+                                               FIELD_FILE_OFFSET, 0);
+    *memh_p       = memh;
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_tcp_md_mem_dereg(uct_md_h md, const uct_md_mem_dereg_params_t *params)
+{
+    UCT_MD_MEM_DEREG_CHECK_PARAMS(params, 0);
+
+    ucs_free(params->memh);
+    return UCS_OK;
+}
+
 static void uct_tcp_md_close(uct_md_h md)
 {
     uct_tcp_md_t *tcp_md = ucs_derived_of(md, uct_tcp_md_t);
@@ -46,8 +87,8 @@ static uct_md_ops_t uct_tcp_md_ops = {
     .mem_alloc          = (uct_md_mem_alloc_func_t)ucs_empty_function_return_unsupported,
     .mem_free           = (uct_md_mem_free_func_t)ucs_empty_function_return_unsupported,
     .mem_advise         = (uct_md_mem_advise_func_t)ucs_empty_function_return_unsupported,
-    .mem_reg            = (uct_md_mem_reg_func_t)ucs_empty_function_return_unsupported,
-    .mem_dereg          = (uct_md_mem_dereg_func_t)ucs_empty_function_return_unsupported,
+    .mem_reg            = uct_tcp_md_mem_reg,
+    .mem_dereg          = uct_tcp_md_mem_dereg,
     .mem_query          = (uct_md_mem_query_func_t)ucs_empty_function_return_unsupported,
     .mkey_pack          = (uct_md_mkey_pack_func_t)ucs_empty_function_return_unsupported,
     .mem_attach         = (uct_md_mem_attach_func_t)ucs_empty_function_return_unsupported,
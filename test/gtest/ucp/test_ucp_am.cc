@@ -984,6 +984,29 @@ UCS_TEST_P(test_ucp_am_nbx, rx_am_mpools,
     ucp_am_data_release(receiver().worker(), rx_data);
 }
 
+UCS_TEST_P(test_ucp_am_nbx, zcopy_header_thp_pages, "ZCOPY_THRESH=1",
+           "RNDV_THRESH=inf", "REG_MPOOL_PAGES=thp")
+{
+    /* Zcopy with a user header packs the header to the registered pool */
+    test_am_send_recv(4 * UCS_KBYTE, 64);
+
+    ucs_mpool_t *mp = &sender().worker()->reg_mp;
+    void *desc      = ucs_mpool_get(mp);
+    ASSERT_TRUE(desc != NULL);
+
+    ucp_mem_desc_t *chunk_hdr = (ucp_mem_desc_t*)mp->data->chunks - 1;
+    ssize_t huge_page_size    = ucs_get_huge_page_size();
+    if (ucs_is_thp_enabled() && (huge_page_size > 0)) {
+        EXPECT_EQ(0ul, ucp_memh_length(chunk_hdr->memh) % huge_page_size);
+        if (chunk_hdr->memh->alloc_method == UCT_ALLOC_METHOD_THP) {
+            EXPECT_EQ(0ul, (uintptr_t)ucp_memh_address(chunk_hdr->memh) %
+                                   huge_page_size);
+        }
+    }
+
+    ucs_mpool_put(desc);
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx)
 
 
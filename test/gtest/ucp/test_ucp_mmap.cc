@@ -1245,3 +1245,131 @@ UCS_TEST_P(test_ucp_mmap_export, export_import) {
 }
 
 UCP_INSTANTIATE_TEST_CASE_GPU_AWARE(test_ucp_mmap_export)
+
+
+class test_ucp_mmap_file : public ucp_test {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant(variants, UCP_FEATURE_RMA);
+    }
+
+    test_ucp_mmap_file() : m_fd(-1), m_file_ptr(MAP_FAILED), m_length(0)
+    {
+    }
+
+    virtual void init()
+    {
+        ucp_test::init();
+
+        sender().connect(&receiver(), get_ep_params());
+        if (!is_loopback()) {
+            receiver().connect(&sender(), get_ep_params());
+        }
+    }
+
+    virtual void cleanup()
+    {
+        if (m_file_ptr != MAP_FAILED) {
+            munmap(m_file_ptr, m_length);
+        }
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+
+        ucp_test::cleanup();
+    }
+
+protected:
+    static const uint64_t SEED = 0x1234;
+
+    /* Create a file with a pattern, and map its part starting from 'offset' */
+    void create_file(size_t length, size_t offset)
+    {
+        char path[] = "/tmp/ucp_mmap_file_XXXXXX";
+        std::vector<char> buf(offset + length);
+
+        m_fd = mkstemp(path);
+        ASSERT_GE(m_fd, 0) << strerror(errno);
+        unlink(path);
+
+        mem_buffer::pattern_fill(&buf[offset], length, SEED);
+        ASSERT_EQ((ssize_t)buf.size(), write(m_fd, &buf[0], buf.size()));
+
+        m_length   = length;
+        m_file_ptr = mmap(NULL, m_length, PROT_READ, MAP_SHARED, m_fd, offset);
+        ASSERT_NE(MAP_FAILED, m_file_ptr) << strerror(errno);
+    }
+
+    ucs_status_t map_file(size_t offset, unsigned flags, ucp_mem_h *memh_p)
+    {
+        ucp_mem_map_params_t params;
+
+        params.field_mask  = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                             UCP_MEM_MAP_PARAM_FIELD_LENGTH |
+                             UCP_MEM_MAP_PARAM_FIELD_FLAGS |
+                             UCP_MEM_MAP_PARAM_FIELD_FILE_FD |
+                             UCP_MEM_MAP_PARAM_FIELD_FILE_OFFSET;
+        params.address     = m_file_ptr;
+        params.length      = m_length;
+        params.flags       = flags;
+        params.file_fd     = m_fd;
+        params.file_offset = offset;
+        return ucp_mem_map(sender().ucph(), &params, memh_p);
+    }
+
+    int    m_fd;
+    void   *m_file_ptr;
+    size_t m_length;
+};
+
+UCS_TEST_P(test_ucp_mmap_file, put_from_file)
+{
+    const size_t offset = ucs_get_page_size();
+    ucp_context_h context = sender().ucph();
+    void *rkey_buffer;
+    size_t rkey_size;
+    ucp_mem_h memh;
+
+    create_file(UCS_MBYTE, offset);
+    ASSERT_UCS_OK(map_file(offset, 0, &memh));
+
+    /* The memory is registered with the file on all MDs which support it */
+    ASSERT_NE(0, context->file_reg_md_map);
+    EXPECT_EQ(context->file_reg_md_map,
+              memh->md_map & context->file_reg_md_map);
+    EXPECT_EQ(memh, memh->parent);
+
+    /* Registration with the file does not add a remote key */
+    ASSERT_UCS_OK(ucp_rkey_pack(context, memh, &rkey_buffer, &rkey_size));
+    ucp_rkey_buffer_release(rkey_buffer);
+
+    mapped_buffer recvbuf(m_length, receiver());
+    recvbuf.memset(0);
+    ucs::handle<ucp_rkey_h> rkey = recvbuf.rkey(sender());
+
+    ucp_request_param_t param;
+    param.op_attr_mask = UCP_OP_ATTR_FIELD_MEMH;
+    param.memh         = memh;
+    auto sreq = ucp_put_nbx(sender().ep(), m_file_ptr, m_length,
+                            (uintptr_t)recvbuf.ptr(), rkey, &param);
+
+    param.op_attr_mask = 0;
+    auto freq          = ucp_ep_flush_nbx(sender().ep(), &param);
+    ASSERT_UCS_OK(requests_wait({sreq, freq}));
+
+    mem_buffer::pattern_check(recvbuf.ptr(), m_length, SEED);
+    ASSERT_UCS_OK(ucp_mem_unmap(context, memh));
+}
+
+UCS_TEST_P(test_ucp_mmap_file, allocate)
+{
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    ucp_mem_h memh;
+
+    create_file(UCS_MBYTE, 0);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              map_file(0, UCP_MEM_MAP_ALLOCATE, &memh));
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_mmap_file, tcp, "tcp")
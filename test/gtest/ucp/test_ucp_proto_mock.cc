@@ -392,7 +392,7 @@ protected:
         ucp_proto_select_key_t select_key;
 
         bool found = false;
-        kh_foreach(proto_select.hash, select_key.u64, select_elem, {
+        ucs_swiss_foreach(proto_select.hash, select_key.u64, select_elem, {
             if (key_match(key, select_key)) {
                 check_proto_select_elem(e, select_key.param, select_elem,
                                         data_vec);
@@ -782,13 +782,36 @@ UCS_TEST_P(test_ucp_proto_mock_tcp, am_send_1_lane)
     key.param.op_attr          = 0;
 
     check_ep_config(sender(), {
-        {0,      0,      "short",                                       "tcp/mock"},
-        {1,      65528,  "zero-copy",                                   "tcp/mock"},
-        {65529,  367108, "multi-frag zero-copy",                        "tcp/mock"},
-        {367109, INF,    "rendezvous zero-copy fenced write to remote", "tcp/mock"},
+        {0,      0,      "short",                                 "tcp/mock"},
+        {1,      65528,  "zero-copy",                             "tcp/mock"},
+        {65529,  222173, "multi-frag zero-copy",                  "tcp/mock"},
+        {222174, INF,    "rendezvous zero-copy read from remote", "tcp/mock"},
     }, key);
 }
 
+UCS_TEST_P(test_ucp_proto_mock_tcp, rndv_2_paths, "TCP_NUM_PATHS?=2",
+           "MAX_RNDV_LANES=2")
+{
+    ucp_proto_select_key_t key = any_key();
+    key.param.op_id_flags      = UCP_OP_ID_AM_SEND;
+    key.param.op_attr          = 0;
+
+    /* The RNDV payload is striped evenly over the connections */
+    check_ep_config(sender(), {
+        {0,      0,      "short",                "tcp/mock/path0"},
+        {1,      65528,  "zero-copy",            "tcp/mock/path0"},
+        {65529,  269511, "multi-frag zero-copy", "tcp/mock/path0"},
+        {269512, INF,    "rendezvous zero-copy read from remote",
+         "tcp/mock 50% on path0 and 50% on path1"},
+    }, key);
+}
+
+UCS_TEST_P(test_ucp_proto_mock_tcp, rndv_send_recv_2_paths, "TCP_NUM_PATHS?=2",
+           "MAX_RNDV_LANES=2", "RNDV_THRESH=0")
+{
+    send_recv_am_range(UCS_KBYTE, 256 * UCS_KBYTE, 16 * UCS_KBYTE);
+}
+
 UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_proto_mock_tcp, tcp, "tcp")
 
 class test_ucp_proto_mock_self : public test_ucp_proto_mock {
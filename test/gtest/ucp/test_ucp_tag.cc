@@ -517,7 +517,7 @@ protected:
             UCS_TEST_SKIP_R("Skip EP RNDV_THRESH check for HWTM");
         }
 
-        kh_foreach_value(cfg->proto_select.hash, value, {
+        ucs_swiss_foreach_value(cfg->proto_select.hash, value, {
             /* Find index of the corresponding ucp_proto_threshold_elem_t
              * to handle the given message size */
             unsigned idx = 0;
@@ -1053,6 +1053,113 @@ UCS_TEST_P(test_ucp_tag_xfer, iov_with_empty_buffers, "ZCOPY_THRESH=512") {
 UCP_INSTANTIATE_TEST_CASE(test_ucp_tag_xfer)
 
 
+class test_ucp_tag_shm_rkey_ptr : public test_ucp_tag {
+public:
+    void init()
+    {
+        modify_config("RNDV_SHM_RKEY_PTR", "y");
+        modify_config("RNDV_THRESH", "0");
+        /* Copy in several progress calls, so the receive is observed on the
+         * queue of rkey_ptr requests */
+        modify_config("RKEY_PTR_SEG_SIZE", "16k");
+        test_ucp_tag::init();
+    }
+
+    using test_ucp_tag::get_test_variants;
+
+protected:
+    void mem_alloc(size_t size, ucp_mem_h *memh_p, void **address_p)
+    {
+        ucp_mem_map_params_t params;
+        ucp_mem_attr_t attr;
+
+        params.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                            UCP_MEM_MAP_PARAM_FIELD_LENGTH |
+                            UCP_MEM_MAP_PARAM_FIELD_FLAGS;
+        params.address    = NULL;
+        params.length     = size;
+        params.flags      = UCP_MEM_MAP_ALLOCATE;
+        ASSERT_UCS_OK(ucp_mem_map(sender().ucph(), &params, memh_p));
+
+        attr.field_mask = UCP_MEM_ATTR_FIELD_ADDRESS;
+        ASSERT_UCS_OK(ucp_mem_query(*memh_p, &attr));
+        *address_p = attr.address;
+    }
+
+    /* Set rkey_ptr_used to whether the receiver copied the data directly from
+     * the sender's buffer by the rndv/rkey_ptr protocol */
+    void send_recv(const void *buffer, ucp_mem_h memh, size_t size,
+                   bool &rkey_ptr_used)
+    {
+        std::vector<uint8_t> recvbuf(size, 0);
+        ucp_request_param_t param;
+        request *rreq;
+        void *sreq;
+
+        param.op_attr_mask = UCP_OP_ATTR_FIELD_DATATYPE;
+        param.datatype     = ucp_dt_make_contig(1);
+        if (memh != NULL) {
+            param.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMH;
+            param.memh          = memh;
+        }
+
+        sreq = ucp_tag_send_nbx(sender().ep(), buffer, size, 0x111337, &param);
+        rreq = recv_nb(recvbuf.data(), size, DATATYPE, 0x111337,
+                       (ucp_tag_t)-1);
+
+        rkey_ptr_used = false;
+        while (!rreq->completed) {
+            progress();
+            rkey_ptr_used |= !ucs_queue_is_empty(
+                    &receiver().worker()->rkey_ptr_reqs);
+        }
+
+        ASSERT_UCS_OK(rreq->status);
+        EXPECT_EQ(size, rreq->info.length);
+        request_free(rreq);
+        ASSERT_UCS_OK(request_wait(sreq));
+
+        EXPECT_EQ(0, memcmp(buffer, recvbuf.data(), size));
+    }
+};
+
+UCS_TEST_P(test_ucp_tag_shm_rkey_ptr, send_mapped_buffer)
+{
+    const size_t size = UCS_MBYTE;
+    ucp_lane_index_t rkey_ptr_lane;
+    ucp_md_index_t md_index;
+    bool rkey_ptr_used;
+    ucp_mem_h memh;
+    void *buffer;
+
+    mem_alloc(size, &memh, &buffer);
+    ucs::fill_random(buffer, size);
+
+    /* Send twice, to cover also the completed wireup */
+    for (int i = 0; i < 2; ++i) {
+        send_recv(buffer, memh, size, rkey_ptr_used);
+    }
+    EXPECT_TRUE(rkey_ptr_used) << "rndv/rkey_ptr was not selected";
+
+    /* Memory allocated on the shared memory domain is mapped by the peer */
+    rkey_ptr_lane = ucp_ep_config(sender().ep())->key.rkey_ptr_lane;
+    ASSERT_NE(UCP_NULL_LANE, rkey_ptr_lane);
+    md_index = ucp_ep_md_index(sender().ep(), rkey_ptr_lane);
+    EXPECT_EQ(memh->alloc_md_index, md_index);
+
+    /* A buffer which is not allocated on that memory domain is sent by the
+     * regular rendezvous protocols */
+    std::vector<uint8_t> sendbuf(size);
+    ucs::fill_random(sendbuf);
+    send_recv(sendbuf.data(), NULL, size, rkey_ptr_used);
+    EXPECT_FALSE(rkey_ptr_used);
+
+    ucp_mem_unmap(sender().ucph(), memh);
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(test_ucp_tag_shm_rkey_ptr, posix, "posix")
+
+
 #ifdef ENABLE_STATS
 
 class test_ucp_tag_stats : public test_ucp_tag_xfer {
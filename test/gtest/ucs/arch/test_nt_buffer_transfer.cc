@@ -0,0 +1,159 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+* Copyright (C) Advanced Micro Devices, Inc. 2024. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#include <common/test.h>
+extern "C" {
+#include <ucs/arch/cpu.h>
+#include <ucs/config/global_opts.h>
+#include <ucs/sys/string.h>
+}
+
+#include <algorithm>
+#include <vector>
+
+class test_nt_buffer_transfer : public ucs::test {
+protected:
+    void nt_buffer_transfer_test(ucs_arch_memcpy_hint_t hint,
+                                 size_t nt_dest_thresh = UCS_MEMUNITS_INF)
+    {
+#ifndef UCS_ARCH_HAVE_NT_BUFFER_TRANSFER
+        UCS_TEST_SKIP_R("non-temporal buffer transfer is not supported");
+#else
+        int i, j;
+        char *src, *dst;
+        size_t len, total_size, test_window_size, hole_size, align;
+
+        align            = 64;
+        test_window_size = 8 * 1024;
+        hole_size        = 2 * align;
+
+        auto msg = [&]() {
+            std::stringstream ss;
+            ss << "using length=" << len << " src_align=" << i
+               << " dst_align=" << j;
+            return ss.str();
+        };
+
+        /*
+         * Allocate a hole above and below the test_window_size
+         * to check for writes beyond the designated area.
+         */
+        total_size = test_window_size + (2 * hole_size);
+
+        auto alloc_aligned = [&align, &total_size]() {
+            void *ptr;
+            return std::unique_ptr<char>(reinterpret_cast<char*>(
+                    !posix_memalign(&ptr, align, total_size) ? ptr : nullptr));
+        };
+
+        auto test_window_src = alloc_aligned();
+        auto test_window_dst = alloc_aligned();
+        auto dup             = alloc_aligned();
+
+        ASSERT_TRUE(test_window_src);
+        ASSERT_TRUE(test_window_dst);
+        ASSERT_TRUE(dup);
+
+        src = test_window_src.get() + hole_size;
+        dst = test_window_dst.get() + hole_size;
+
+        /* Initialize the regions with known patterns */
+        memset(dup.get(), 0x0, total_size);
+        memset(test_window_src.get(), 0xdeaddead, total_size);
+        memset(test_window_dst.get(), 0x0, total_size);
+
+        len = 0;
+
+        while (len < test_window_size) {
+            for (i = 0; i < align; i++) {
+                for (j = 0; j < align; j++) {
+                    /* Perform the transfer */
+                    ucs_arch_nt_buffer_transfer(dst + i, src + j, len, hint,
+                                                len, nt_dest_thresh);
+                    ASSERT_EQ(0, memcmp(src + j, dst + i, len)) << msg();
+
+                    /* reset the copied region back to zero */
+                    memset(dst + i, 0x0, len);
+
+                    /* check for any modifications in the holes */
+                    ASSERT_EQ(0, memcmp(test_window_dst.get(), dup.get(),
+                                        total_size));
+                }
+            }
+            /* Check for each len for less than 1k sizes
+             * Above 1k test steps of 53
+             */
+            if (len < 1024) {
+                len++;
+            } else {
+                len += 53;
+            }
+        }
+#endif
+    }
+};
+
+UCS_TEST_F(test_nt_buffer_transfer, nt_src) {
+    nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_SOURCE);
+}
+
+UCS_TEST_F(test_nt_buffer_transfer, nt_dst) {
+    nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_DEST);
+}
+
+UCS_TEST_F(test_nt_buffer_transfer, nt_src_dst) {
+    /* Zero destination threshold to test the combination of hints */
+    nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_SOURCE, 0);
+}
+
+UCS_TEST_F(test_nt_buffer_transfer, nt_dst_thresh) {
+    /* Non-temporal destination stores without a hint */
+    nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_NONE, 0);
+}
+
+UCS_TEST_SKIP_COND_F(test_nt_buffer_transfer, calibrate,
+                     RUNNING_ON_VALGRIND || !ucs::perf_retry_count) {
+#ifndef UCS_ARCH_HAVE_NT_BUFFER_TRANSFER
+    size_t nt_min, nt_dest;
+
+    EXPECT_EQ(UCS_ERR_UNSUPPORTED,
+              ucs_cpu_nt_calibrate(NULL, NULL, &nt_min, &nt_dest));
+#else
+    ucs_arch_global_opts_t saved_opts = ucs_global_opts.arch;
+    std::vector<size_t> sizes;
+    size_t nt_min, nt_dest;
+    ucs_status_t status;
+
+    status = ucs_cpu_nt_calibrate(
+            [](size_t size, const double *bw, void *arg) {
+                for (int i = 0; i < UCS_CPU_NT_COPY_LAST; ++i) {
+                    EXPECT_GT(bw[i], 0) << "size=" << size << " copy=" << i;
+                }
+                static_cast<std::vector<size_t>*>(arg)->push_back(size);
+            },
+            &sizes, &nt_min, &nt_dest);
+    ASSERT_UCS_OK(status);
+    ASSERT_FALSE(sizes.empty());
+    for (size_t i = 1; i < sizes.size(); ++i) {
+        EXPECT_GT(sizes[i], sizes[i - 1]);
+    }
+
+    /* Thresholds are either one of the measured sizes or infinite */
+    for (auto thresh : {nt_min, nt_dest}) {
+        if (thresh != UCS_MEMUNITS_INF) {
+            EXPECT_NE(sizes.end(), std::find(sizes.begin(), sizes.end(),
+                                             thresh)) << thresh;
+        }
+    }
+
+    /* Calibration must not change the thresholds in use */
+    EXPECT_EQ(saved_opts.nt_buffer_transfer_min,
+              ucs_global_opts.arch.nt_buffer_transfer_min);
+    EXPECT_EQ(saved_opts.nt_dest_threshold,
+              ucs_global_opts.arch.nt_dest_threshold);
+#endif
+}
@@ -63,84 +63,6 @@ protected:
     out:
         return result;
     }
-
-    void nt_buffer_transfer_test(ucs_arch_memcpy_hint_t hint)
-    {
-#ifndef __AVX__
-        UCS_TEST_SKIP_R("Built without AVX support");
-#else
-        int i, j;
-        char *src, *dst;
-        size_t len, total_size, test_window_size, hole_size, align;
-
-        align            = 64;
-        test_window_size = 8 * 1024;
-        hole_size        = 2 * align;
-
-        auto msg = [&]() {
-            std::stringstream ss;
-            ss << "using length=" << len << " src_align=" << i
-               << " dst_align=" << j;
-            return ss.str();
-        };
-
-        /*
-         * Allocate a hole above and below the test_window_size
-         * to check for writes beyond the designated area.
-         */
-        total_size = test_window_size + (2 * hole_size);
-
-        auto alloc_aligned = [&align, &total_size]() {
-            void *ptr;
-            return std::unique_ptr<char>(reinterpret_cast<char*>(
-                    !posix_memalign(&ptr, align, total_size) ? ptr : nullptr));
-        };
-
-        auto test_window_src = alloc_aligned();
-        auto test_window_dst = alloc_aligned();
-        auto dup             = alloc_aligned();
-
-        ASSERT_TRUE(test_window_src);
-        ASSERT_TRUE(test_window_dst);
-        ASSERT_TRUE(dup);
-
-        src = test_window_src.get() + hole_size;
-        dst = test_window_dst.get() + hole_size;
-
-        /* Initialize the regions with known patterns */
-        memset(dup.get(), 0x0, total_size);
-        memset(test_window_src.get(), 0xdeaddead, total_size);
-        memset(test_window_dst.get(), 0x0, total_size);
-
-        len = 0;
-
-        while (len < test_window_size) {
-            for (i = 0; i < align; i++) {
-                for (j = 0; j < align; j++) {
-                    /* Perform the transfer */
-                    ucs_x86_nt_buffer_transfer(dst + i, src + j, len, hint,
-                                               len);
-                    ASSERT_EQ(0, memcmp(src + j, dst + i, len)) << msg();
-
-                    /* reset the copied region back to zero */
-                    memset(dst + i, 0x0, len);
-
-                    /* check for any modifications in the holes */
-                    ASSERT_EQ(0, memcmp(test_window_dst.get(), dup.get(),
-                                        total_size));
-                }
-            }
-            /* Check for each len for less than 1k sizes
-             * Above 1k test steps of 53
-             */
-            if (len < 1024) {
-                len++;
-            } else {
-                len += 53;
-            }
-        }
-#endif
-    }
 };
 
 UCS_TEST_SKIP_COND_F(test_arch, memcpy, RUNNING_ON_VALGRIND || !ucs::perf_retry_count) {
@@ -181,17 +103,4 @@ UCS_TEST_SKIP_COND_F(test_arch, memcpy, RUNNING_ON_VALGRIND || !ucs::perf_retry_
     }
 }
 
-UCS_TEST_F(test_arch, nt_buffer_transfer_nt_src) {
-    nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_SOURCE);
-}
-
-UCS_TEST_F(test_arch, nt_buffer_transfer_nt_dst) {
-    nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_DEST);
-}
-
-UCS_TEST_F(test_arch, nt_buffer_transfer_nt_src_dst) {
-    /* Make nt_dest_threshold zero to test the combination of hints */
-    ucs_global_opts.arch.nt_dest_threshold = 0;
-    nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_SOURCE);
-}
 #endif
@@ -6,9 +6,10 @@
 
 #include <common/test.h>
 extern "C" {
-#include <ucs/algorithm/crc.h>
+#include <ucs/algorithm/crc_int.h>
 #include <ucs/algorithm/qsort_r.h>
 #include <ucs/algorithm/string_distance.h>
+#include <ucs/time/time.h>
 }
 #include <vector>
 
@@ -122,6 +123,74 @@ UCS_TEST_F(test_algorithm, crc32) {
     EXPECT_EQ(0xa684c7c6ul, ucs_crc32(0, test_str.c_str(), test_str.size()));
 }
 
+UCS_TEST_F(test_algorithm, crc_methods) {
+    std::vector<uint8_t> buffer(4096 + 64);
+
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = ucs::rand();
+    }
+
+    for (int i = 0; i < 1000 / ucs::test_time_multiplier(); ++i) {
+        size_t offset     = ucs::rand() % 64;
+        size_t size       = ucs::rand() % (buffer.size() - offset);
+        uint32_t prev_crc = ucs::rand();
+        const void *p     = &buffer[offset];
+
+        uint32_t crc32 = ucs_crc32_method(UCS_CRC_METHOD_BITWISE, prev_crc, p,
+                                          size);
+        for (int m = UCS_CRC_METHOD_TABLE; m < UCS_CRC_METHOD_LAST; ++m) {
+            ucs_crc_method_t method = static_cast<ucs_crc_method_t>(m);
+            if (!ucs_crc32_method_is_supported(method)) {
+                continue;
+            }
+
+            ASSERT_EQ(crc32, ucs_crc32_method(method, prev_crc, p, size))
+                    << ucs_crc_method_names[method] << " offset=" << offset
+                    << " size=" << size;
+        }
+        ASSERT_EQ(crc32, ucs_crc32(prev_crc, p, size));
+
+        ASSERT_EQ(ucs_crc16_method(UCS_CRC_METHOD_BITWISE, p, size),
+                  ucs_crc16(p, size)) << "offset=" << offset << " size=" << size;
+    }
+}
+
+UCS_TEST_SKIP_COND_F(test_algorithm, crc_perf, RUNNING_ON_VALGRIND) {
+    const std::vector<size_t> sizes = {16, 64, 1024, 65536};
+    const size_t total_size         = UCS_MBYTE * 64 /
+                                      ucs::test_time_multiplier();
+    std::vector<uint8_t> buffer(sizes.back());
+    uint32_t crc = 0;
+
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = ucs::rand();
+    }
+
+    for (size_t size : sizes) {
+        for (int m = UCS_CRC_METHOD_BITWISE; m < UCS_CRC_METHOD_LAST; ++m) {
+            ucs_crc_method_t method = static_cast<ucs_crc_method_t>(m);
+            if (!ucs_crc32_method_is_supported(method)) {
+                continue;
+            }
+
+            /* Bitwise method is much slower, so run less iterations */
+            size_t count = total_size / size /
+                           ((method == UCS_CRC_METHOD_BITWISE) ? 16 : 1);
+            ucs_time_t start_time = ucs_get_time();
+            for (size_t i = 0; i < count; ++i) {
+                crc = ucs_crc32_method(method, crc, &buffer[0], size);
+            }
+            double sec = ucs_time_to_sec(ucs_get_time() - start_time);
+
+            UCS_TEST_MESSAGE << "crc32 " << ucs_crc_method_names[method]
+                             << " size " << size << ": "
+                             << (count * size) / sec / UCS_GBYTE << " GB/s";
+        }
+    }
+
+    UCS_TEST_MESSAGE << "crc 0x" << std::hex << crc;
+}
+
 UCS_TEST_F(test_algorithm, string_distance) {
     // Empty strings
     EXPECT_EQ(0u, ucs_string_distance("", ""));
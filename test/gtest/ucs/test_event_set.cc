@@ -19,6 +19,7 @@ static const int   UCS_EVENT_SET_EXTRA_NUM    = 0xFF;
 
 enum {
     UCS_EVENT_SET_EXTERNAL_FD = UCS_BIT(0),
+    UCS_EVENT_SET_IO_URING    = UCS_BIT(1)
 };
 
 class test_event_set : public ucs::test_base,
@@ -77,6 +78,19 @@ protected:
         ucs_status_t status;
         int ret;
 
+        if (GetParam() & UCS_EVENT_SET_EXTERNAL_FD) {
+            status = ucs_event_set_create_from_fd(&m_event_set, m_ext_fd);
+        } else if (GetParam() & UCS_EVENT_SET_IO_URING) {
+            status = ucs_event_set_create_io_uring(&m_event_set);
+            if (status == UCS_ERR_UNSUPPORTED) {
+                UCS_TEST_SKIP_R("io_uring is not supported");
+            }
+        } else {
+            status = ucs_event_set_create(&m_event_set);
+        }
+        ASSERT_UCS_OK(status);
+        EXPECT_TRUE(m_event_set != NULL);
+
         if (pipe(m_pipefd) == -1) {
             UCS_TEST_ABORT("pipe() failed with error - " <<
                            strerror(errno));
@@ -93,14 +107,6 @@ protected:
             UCS_TEST_ABORT("pthread_create() failed with error - " <<
                            strerror(errno));
         }
-
-        if (GetParam() & UCS_EVENT_SET_EXTERNAL_FD) {
-            status = ucs_event_set_create_from_fd(&m_event_set, m_ext_fd);
-        } else {
-            status = ucs_event_set_create(&m_event_set);
-        }
-        ASSERT_UCS_OK(status);
-        EXPECT_TRUE(m_event_set != NULL);
     }
 
     void event_set_cleanup() {
@@ -283,3 +289,6 @@ INSTANTIATE_TEST_SUITE_P(ext_fd, test_event_set,
                         ::testing::Values(static_cast<int>(
                                               UCS_EVENT_SET_EXTERNAL_FD)));
 INSTANTIATE_TEST_SUITE_P(int_fd, test_event_set, ::testing::Values(0));
+INSTANTIATE_TEST_SUITE_P(io_uring, test_event_set,
+                        ::testing::Values(static_cast<int>(
+                                              UCS_EVENT_SET_IO_URING)));
@@ -8,8 +8,12 @@
 
 extern "C" {
 #include <ucs/datastruct/mpmc.h>
+#include <ucs/time/time.h>
 }
 #include <pthread.h>
+#include <functional>
+#include <thread>
+#include <vector>
 
 
 class test_mpmc : public ucs::test {
@@ -64,7 +68,7 @@ UCS_TEST_F(test_mpmc, basic) {
     ucs_mpmc_queue_t mpmc;
     ucs_status_t status;
 
-    status = ucs_mpmc_queue_init(&mpmc);
+    status = ucs_mpmc_queue_init(&mpmc, UCS_MPMC_QUEUE_DEFAULT_LENGTH);
     ASSERT_UCS_OK(status);
 
     EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
@@ -109,7 +113,7 @@ UCS_TEST_F(test_mpmc, multi_threaded) {
     size_t total;
     void *retval;
 
-    status = ucs_mpmc_queue_init(&mpmc);
+    status = ucs_mpmc_queue_init(&mpmc, UCS_MPMC_QUEUE_DEFAULT_LENGTH);
     ASSERT_UCS_OK(status);
 
     for (unsigned i = 0; i < NUM_THREADS; ++i) {
@@ -128,3 +132,231 @@ UCS_TEST_F(test_mpmc, multi_threaded) {
     EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
     ucs_mpmc_queue_cleanup(&mpmc);
 }
+
+UCS_TEST_F(test_mpmc, overflow) {
+    static const unsigned LENGTH = 8;
+    static const uint64_t COUNT  = LENGTH * 4;
+    ucs_mpmc_queue_t mpmc;
+    ucs_status_t status;
+    uint64_t value;
+
+    status = ucs_mpmc_queue_init(&mpmc, LENGTH - 1);
+    ASSERT_UCS_OK(status);
+
+    /* Values which do not fit the ring should be kept in FIFO order */
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        status = ucs_mpmc_queue_push(&mpmc, i);
+        ASSERT_UCS_OK(status);
+    }
+
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        status = ucs_mpmc_queue_pull(&mpmc, &value);
+        ASSERT_UCS_OK(status);
+        EXPECT_EQ(i, value);
+    }
+
+    status = ucs_mpmc_queue_pull(&mpmc, &value);
+    EXPECT_EQ(UCS_ERR_NO_PROGRESS, status);
+    EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
+
+    ucs_mpmc_queue_cleanup(&mpmc);
+}
+
+UCS_TEST_F(test_mpmc, batch) {
+    static const unsigned LENGTH = 16;
+    std::vector<uint64_t> values(LENGTH * 3), result(LENGTH * 3);
+    ucs_mpmc_queue_t mpmc;
+    ucs_status_t status;
+    unsigned count;
+
+    status = ucs_mpmc_queue_init(&mpmc, LENGTH);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < values.size(); ++i) {
+        values[i] = i * 3;
+    }
+
+    /* Wrap around the ring several times with odd-sized batches */
+    for (unsigned iter = 0; iter < 10; ++iter) {
+        status = ucs_mpmc_queue_push_batch(&mpmc, &values[0], 5);
+        ASSERT_UCS_OK(status);
+        status = ucs_mpmc_queue_push_batch(&mpmc, &values[5], 7);
+        ASSERT_UCS_OK(status);
+
+        count = ucs_mpmc_queue_pull_batch(&mpmc, &result[0], 3);
+        EXPECT_EQ(3u, count);
+        count = ucs_mpmc_queue_pull_batch(&mpmc, &result[3], LENGTH);
+        EXPECT_EQ(9u, count);
+        for (unsigned i = 0; i < 12; ++i) {
+            EXPECT_EQ(values[i], result[i]) << "iter=" << iter << " i=" << i;
+        }
+    }
+
+    /* Batch larger than the ring */
+    status = ucs_mpmc_queue_push_batch(&mpmc, &values[0], values.size());
+    ASSERT_UCS_OK(status);
+    count = ucs_mpmc_queue_pull_batch(&mpmc, &result[0], result.size());
+    EXPECT_EQ(values.size(), count);
+    EXPECT_EQ(values, result);
+
+    count = ucs_mpmc_queue_pull_batch(&mpmc, &result[0], result.size());
+    EXPECT_EQ(0u, count);
+    EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
+
+    ucs_mpmc_queue_cleanup(&mpmc);
+}
+
+static int test_mpmc_is_odd(uint64_t value, void *arg)
+{
+    return value & 1;
+}
+
+UCS_TEST_F(test_mpmc, remove_if) {
+    static const unsigned LENGTH = 8;
+    static const uint64_t COUNT  = LENGTH * 2;
+    ucs_mpmc_queue_t mpmc;
+    ucs_status_t status;
+    uint64_t value;
+
+    status = ucs_mpmc_queue_init(&mpmc, LENGTH);
+    ASSERT_UCS_OK(status);
+
+    /* Remove from both the ring and the overflow queue */
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        status = ucs_mpmc_queue_push(&mpmc, i);
+        ASSERT_UCS_OK(status);
+    }
+
+    ucs_mpmc_queue_remove_if(&mpmc, test_mpmc_is_odd, NULL);
+
+    for (uint64_t i = 0; i < COUNT; i += 2) {
+        status = ucs_mpmc_queue_pull(&mpmc, &value);
+        ASSERT_UCS_OK(status);
+        EXPECT_EQ(i, value);
+    }
+
+    status = ucs_mpmc_queue_pull(&mpmc, &value);
+    EXPECT_EQ(UCS_ERR_NO_PROGRESS, status);
+    EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
+
+    ucs_mpmc_queue_cleanup(&mpmc);
+}
+
+
+/* Spinlock-protected linked queue, which was used before the lock-free ring,
+ * to compare contended throughput */
+class test_mpmc_locked_queue {
+public:
+    test_mpmc_locked_queue() {
+        ucs_queue_head_init(&m_queue);
+        ucs_spinlock_init(&m_lock, 0);
+    }
+
+    ~test_mpmc_locked_queue() {
+        ucs_spinlock_destroy(&m_lock);
+    }
+
+    void push(uint64_t value) {
+        ucs_mpmc_elem_t *elem = new ucs_mpmc_elem_t;
+
+        elem->value = value;
+        ucs_spin_lock(&m_lock);
+        ucs_queue_push(&m_queue, &elem->super);
+        ucs_spin_unlock(&m_lock);
+    }
+
+    bool pull(uint64_t *value_p) {
+        ucs_mpmc_elem_t *elem = NULL;
+
+        if (ucs_queue_is_empty_no_deref(&m_queue)) {
+            return false;
+        }
+
+        ucs_spin_lock(&m_lock);
+        if (!ucs_queue_is_empty(&m_queue)) {
+            elem = ucs_queue_pull_elem_non_empty(&m_queue, ucs_mpmc_elem_t,
+                                                 super);
+        }
+        ucs_spin_unlock(&m_lock);
+
+        if (elem == NULL) {
+            return false;
+        }
+
+        *value_p = elem->value;
+        delete elem;
+        return true;
+    }
+
+private:
+    ucs_spinlock_t   m_lock;
+    ucs_queue_head_t m_queue;
+};
+
+
+class test_mpmc_perf : public ucs::test {
+protected:
+    typedef std::function<void(uint64_t)> push_func_t;
+    typedef std::function<bool(uint64_t*)> pull_func_t;
+
+    /* Every thread pushes and then pulls a value, so the queue stays short
+     * and all threads contend on the same positions */
+    double measure(unsigned num_threads, size_t count, push_func_t push,
+                   pull_func_t pull) {
+        std::vector<std::thread> threads;
+        ucs_time_t start_time;
+
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads.push_back(std::thread([&]() {
+                uint64_t value;
+                for (size_t j = 0; j < count; ++j) {
+                    push(j);
+                    while (!pull(&value));
+                }
+            }));
+        }
+
+        for (std::thread &t : threads) {
+            t.join();
+        }
+
+        return (count * num_threads) /
+               ucs_time_to_sec(ucs_get_time() - start_time);
+    }
+};
+
+UCS_TEST_SKIP_COND_F(test_mpmc_perf, contended, RUNNING_ON_VALGRIND) {
+    const size_t count = 200000 / ucs::test_time_multiplier();
+    const std::vector<unsigned> num_threads = {1, 2, 4, 8, 16, 32, 64};
+    test_mpmc_locked_queue locked;
+    ucs_mpmc_queue_t mpmc;
+    ucs_status_t status;
+
+    status = ucs_mpmc_queue_init(&mpmc, UCS_MPMC_QUEUE_DEFAULT_LENGTH);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned n : num_threads) {
+        double lockfree_rate = measure(n, count / n,
+                [&](uint64_t value) {
+                    ucs_mpmc_queue_push(&mpmc, value);
+                },
+                [&](uint64_t *value_p) {
+                    return ucs_mpmc_queue_pull(&mpmc, value_p) == UCS_OK;
+                });
+        double locked_rate = measure(n, count / n,
+                [&](uint64_t value) {
+                    locked.push(value);
+                },
+                [&](uint64_t *value_p) {
+                    return locked.pull(value_p);
+                });
+
+        UCS_TEST_MESSAGE << n << " threads: lock-free "
+                         << lockfree_rate / 1e6 << " Mops/s, spinlock "
+                         << locked_rate / 1e6 << " Mops/s";
+    }
+
+    EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
+    ucs_mpmc_queue_cleanup(&mpmc);
+}
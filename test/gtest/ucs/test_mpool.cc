@@ -7,11 +7,18 @@
 #include <common/test.h>
 extern "C" {
 #include <ucs/datastruct/mpool.h>
+#include <ucs/datastruct/mpool.inl>
+#include <ucs/type/spinlock.h>
+#include <ucs/time/time.h>
 }
 
 #include <limits.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <functional>
 #include <vector>
 #include <queue>
+#include <thread>
 
 class test_mpool : public ucs::test {
 protected:
@@ -79,7 +86,8 @@ protected:
     static size_t leak_count;
 
     ucs_status_t setup_mpool(ucs_mpool_t *mp, size_t elem_size,
-                             unsigned elems_per_chunk, unsigned max_elems = 0)
+                             unsigned elems_per_chunk, unsigned max_elems = 0,
+                             unsigned flags = 0)
     {
         static ucs_mpool_ops_t mpool_ops = {ucs_mpool_chunk_malloc,
                                             ucs_mpool_chunk_free, NULL, NULL,
@@ -99,6 +107,7 @@ protected:
         mp_params.max_elems       = max_elems;
         mp_params.ops             = &mpool_ops;
         mp_params.name            = "tests";
+        mp_params.flags           = flags;
         return ucs_mpool_init(&mp_params, mp);
     }
 };
@@ -367,6 +376,50 @@ UCS_TEST_F(test_mpool, leak_check) {
     EXPECT_EQ(5u, leak_count);
 }
 
+UCS_TEST_F(test_mpool, numa_node) {
+    ucs_mpool_ops_t ops = {
+       ucs_mpool_chunk_mmap,
+       ucs_mpool_chunk_munmap,
+       NULL,
+       NULL,
+       NULL
+    };
+    ucs_mpool_params_t mp_params;
+    int mode_before, mode_after, node;
+    ucs_status_t status;
+    ucs_mpool_t mp;
+
+    if (syscall(SYS_get_mempolicy, &mode_before, NULL, 0, NULL, 0) != 0) {
+        UCS_TEST_SKIP_R("get_mempolicy() is not supported");
+    }
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size       = header_size + data_size;
+    mp_params.align_offset    = header_size;
+    mp_params.alignment       = align;
+    mp_params.elems_per_chunk = 100;
+    mp_params.numa_node       = UCS_NUMA_NODE_CURRENT;
+    mp_params.ops             = &ops;
+    mp_params.name            = "tests";
+    status = ucs_mpool_init(&mp_params, &mp);
+    ASSERT_UCS_OK(status);
+    ASSERT_GE(mp.data->numa_node, 0);
+
+    void *obj = ucs_mpool_get(&mp);
+    ASSERT_TRUE(obj != NULL);
+
+    /* The chunk is placed on the requested node, and the memory policy of the
+     * thread is restored */
+    ASSERT_EQ(0, syscall(SYS_get_mempolicy, &node, NULL, 0, obj,
+                         3 /* MPOL_F_NODE | MPOL_F_ADDR */));
+    EXPECT_EQ(mp.data->numa_node, node);
+    ASSERT_EQ(0, syscall(SYS_get_mempolicy, &mode_after, NULL, 0, NULL, 0));
+    EXPECT_EQ(mode_before, mode_after);
+
+    ucs_mpool_put(obj);
+    ucs_mpool_cleanup(&mp, 1);
+}
+
 class test_mpool_grow : public test_mpool {
 public:
     void run_grow_test(double grow_factor,
@@ -495,3 +548,257 @@ UCS_TEST_SKIP_COND_F(test_mpool_fifo, alloc_release, !ENABLE_DEBUG_DATA)
 
     ucs_mpool_cleanup(&mp, 0); // skip individual put as obj could be corrupted
 }
+
+
+class test_mpool_tcache : public test_mpool {
+protected:
+    static const unsigned elem_size = 64;
+
+    /* Every thread allocates a batch of objects and releases them in a
+     * different order */
+    double measure(unsigned num_threads, size_t count, unsigned batch,
+                   std::function<void*()> get, std::function<void(void*)> put)
+    {
+        std::vector<std::thread> threads;
+        ucs_time_t start_time;
+
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads.push_back(std::thread([&]() {
+                std::vector<void*> objs(batch);
+                for (size_t j = 0; j < count; j += batch) {
+                    for (unsigned k = 0; k < batch; ++k) {
+                        objs[k] = get();
+                        ASSERT_TRUE(objs[k] != NULL);
+                    }
+                    for (unsigned k = 0; k < batch; ++k) {
+                        put(objs[(k * 7) % batch]);
+                    }
+                }
+            }));
+        }
+
+        for (std::thread &t : threads) {
+            t.join();
+        }
+
+        return (count * num_threads) /
+               ucs_time_to_sec(ucs_get_time() - start_time);
+    }
+};
+
+UCS_TEST_F(test_mpool_tcache, basic) {
+    const unsigned max_elems = 100;
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    ucs_status_t status = setup_mpool(&mp, elem_size, 16, max_elems,
+                                      UCS_MPOOL_FLAG_THREAD_CACHE);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned loop = 0; loop < 3; ++loop) {
+        for (unsigned i = 0; i < max_elems; ++i) {
+            void *obj = ucs_mpool_get(&mp);
+            ASSERT_TRUE(obj != NULL);
+            ASSERT_EQ(0ul, ((uintptr_t)obj + header_size) % align) << obj;
+            EXPECT_EQ(&mp, ucs_mpool_obj_owner(obj));
+            memset(obj, 0xBB, header_size + elem_size);
+            objs.push_back(obj);
+        }
+
+        EXPECT_TRUE(NULL == ucs_mpool_get(&mp));
+
+        for (void *obj : objs) {
+            ucs_mpool_put(obj);
+        }
+        objs.clear();
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_tcache, grow) {
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    ucs_status_t status = setup_mpool(&mp, elem_size, 16, UINT_MAX,
+                                      UCS_MPOOL_FLAG_THREAD_CACHE);
+    ASSERT_UCS_OK(status);
+
+    /* New elements must never be visible on the main freelist, which is
+     * accessed without a lock by ucs_mpool_get_inline() */
+    ucs_mpool_grow(&mp, 100);
+    EXPECT_TRUE(NULL == mp.freelist);
+
+    for (unsigned i = 0; i < 500; ++i) {
+        void *obj = ucs_mpool_get_inline(&mp);
+        ASSERT_TRUE(obj != NULL);
+        EXPECT_TRUE(NULL == mp.freelist);
+        EXPECT_NE(0ul, (uintptr_t)ucs_mpool_obj_to_elem(obj)->mpool &
+                       UCS_MPOOL_ELEM_FLAG_TCACHE) << i;
+        objs.push_back(obj);
+    }
+
+    for (void *obj : objs) {
+        ucs_mpool_put_inline(obj);
+    }
+    EXPECT_TRUE(NULL == mp.freelist);
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_tcache, malloc_safe) {
+    scoped_log_handler log_handler(mpool_log_handler);
+    ucs_mpool_ops_t ops = {ucs_mpool_chunk_malloc, ucs_mpool_chunk_free, NULL,
+                           NULL, NULL};
+    ucs_mpool_params_t mp_params;
+    ucs_mpool_t mp;
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size   = elem_size;
+    mp_params.malloc_safe = 1;
+    mp_params.flags       = UCS_MPOOL_FLAG_THREAD_CACHE;
+    mp_params.ops         = &ops;
+    mp_params.name        = "tests";
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, ucs_mpool_init(&mp_params, &mp));
+}
+
+UCS_TEST_F(test_mpool_tcache, leak_check) {
+    const unsigned num_leaks = 5;
+    ucs_mpool_ops_t ops = {ucs_mpool_chunk_malloc, ucs_mpool_chunk_free, NULL,
+                           NULL, obj_str};
+    ucs_mpool_params_t mp_params;
+    ucs_mpool_t mp;
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size       = elem_size;
+    mp_params.elems_per_chunk = 64;
+    mp_params.flags           = UCS_MPOOL_FLAG_THREAD_CACHE;
+    mp_params.ops             = &ops;
+    mp_params.name            = "tests";
+    ASSERT_UCS_OK(ucs_mpool_init(&mp_params, &mp));
+
+    /* Cache released objects in the magazines of a few threads */
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < 4; ++i) {
+        threads.push_back(std::thread([&]() {
+            std::vector<void*> objs;
+            for (unsigned j = 0; j < 100; ++j) {
+                objs.push_back(ucs_mpool_get(&mp));
+            }
+            for (void *obj : objs) {
+                ucs_mpool_put(obj);
+            }
+        }));
+    }
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    for (unsigned i = 0; i < num_leaks; ++i) {
+        EXPECT_TRUE(ucs_mpool_get(&mp) != NULL);
+    }
+
+    leak_count = 0;
+    scoped_log_handler log_handler(mpool_log_leak_handler);
+    ucs_mpool_cleanup(&mp, 1);
+
+    EXPECT_EQ(num_leaks, leak_count);
+}
+
+UCS_TEST_F(test_mpool_tcache, multi_threaded) {
+    const unsigned num_threads = 8;
+    const size_t count         = 100000 / ucs::test_time_multiplier();
+    const unsigned batch       = 50;
+    ucs_mpool_t mp;
+
+    ucs_status_t status = setup_mpool(&mp, elem_size, 64,
+                                      num_threads * batch,
+                                      UCS_MPOOL_FLAG_THREAD_CACHE);
+    ASSERT_UCS_OK(status);
+
+    /* Objects are allocated by one thread and released by another one */
+    ucs_spinlock_t lock;
+    std::queue<void*> released;
+    ASSERT_UCS_OK(ucs_spinlock_init(&lock, 0));
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < num_threads; ++i) {
+        threads.push_back(std::thread([&, i]() {
+            for (size_t j = 0; j < count; ++j) {
+                void *obj = ucs_mpool_get(&mp);
+                if (obj != NULL) {
+                    *(unsigned*)obj = i;
+                    ucs_spin_lock(&lock);
+                    released.push(obj);
+                    ucs_spin_unlock(&lock);
+                }
+
+                obj = NULL;
+                ucs_spin_lock(&lock);
+                if (released.size() > batch) {
+                    obj = released.front();
+                    released.pop();
+                }
+                ucs_spin_unlock(&lock);
+
+                if (obj != NULL) {
+                    EXPECT_LT(*(unsigned*)obj, num_threads);
+                    ucs_mpool_put(obj);
+                }
+            }
+        }));
+    }
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    while (!released.empty()) {
+        ucs_mpool_put(released.front());
+        released.pop();
+    }
+
+    ucs_spinlock_destroy(&lock);
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_SKIP_COND_F(test_mpool_tcache, scalability, RUNNING_ON_VALGRIND) {
+    const size_t count = 2000000 / ucs::test_time_multiplier();
+    const unsigned batch = 16;
+    const std::vector<unsigned> num_threads = {1, 2, 4, 8, 16, 32, 64};
+    ucs_mpool_t locked_mp, tcache_mp;
+    ucs_spinlock_t lock;
+
+    ASSERT_UCS_OK(setup_mpool(&locked_mp, elem_size, 1024, UINT_MAX));
+    ASSERT_UCS_OK(setup_mpool(&tcache_mp, elem_size, 1024, UINT_MAX,
+                              UCS_MPOOL_FLAG_THREAD_CACHE));
+    ASSERT_UCS_OK(ucs_spinlock_init(&lock, 0));
+
+    for (unsigned n : num_threads) {
+        double locked_rate = measure(n, count / n, batch,
+                [&]() {
+                    ucs_spin_lock(&lock);
+                    void *obj = ucs_mpool_get(&locked_mp);
+                    ucs_spin_unlock(&lock);
+                    return obj;
+                },
+                [&](void *obj) {
+                    ucs_spin_lock(&lock);
+                    ucs_mpool_put(obj);
+                    ucs_spin_unlock(&lock);
+                });
+        double tcache_rate = measure(n, count / n, batch,
+                [&]() { return ucs_mpool_get(&tcache_mp); },
+                [](void *obj) { ucs_mpool_put(obj); });
+
+        UCS_TEST_MESSAGE << n << " threads: locked " << locked_rate / 1e6
+                         << " Mops/s, thread cache " << tcache_rate / 1e6
+                         << " Mops/s";
+    }
+
+    ucs_spinlock_destroy(&lock);
+    ucs_mpool_cleanup(&tcache_mp, 1);
+    ucs_mpool_cleanup(&locked_mp, 1);
+}
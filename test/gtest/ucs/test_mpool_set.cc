@@ -27,8 +27,8 @@ protected:
 
         return ucs_mpool_set_init(mp_set, sizes, sizes_count, max_size,
                                   priv_size, priv_elem_size, 0,
-                                  UCS_SYS_CACHE_LINE_SIZE, 4, UINT_MAX, &ops,
-                                  name);
+                                  UCS_SYS_CACHE_LINE_SIZE, 4, UINT_MAX,
+                                  UCS_NUMA_NODE_UNDEFINED, &ops, name);
     }
 };
 
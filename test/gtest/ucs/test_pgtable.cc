@@ -15,20 +15,21 @@ extern "C" {
 #include <vector>
 #include <set>
 
-class test_pgtable : public ucs::test {
+class test_pgtable : public ucs::test_with_param<unsigned> {
 protected:
 
     typedef std::vector<ucs_pgt_region_t*> search_result_t;
 
     virtual void init() {
-        ucs::test::init();
-        ucs_status_t status = ucs_pgtable_init(&m_pgtable, pgd_alloc, pgd_free);
+        ucs::test_with_param<unsigned>::init();
+        ucs_status_t status = ucs_pgtable_init_fanout(&m_pgtable, GetParam(),
+                                                      pgd_alloc, pgd_free);
         ASSERT_UCS_OK(status);
     }
 
     virtual void cleanup() {
         ucs_pgtable_cleanup(&m_pgtable);
-        ucs::test::cleanup();
+        ucs::test_with_param<unsigned>::cleanup();
     }
 
     void insert(ucs_pgt_region_t *region, ucs_status_t exp_status = UCS_OK,
@@ -120,15 +121,15 @@ protected:
         EXPECT_EQ(&region, result.front());
     }
 
-private:
     static ucs_pgt_dir_t *pgd_alloc(const ucs_pgtable_t *pgtable) {
-        return new ucs_pgt_dir_t;
+        return (ucs_pgt_dir_t*)malloc(ucs_pgtable_dir_size(pgtable));
     }
 
     static void pgd_free(const ucs_pgtable_t *pgtable, ucs_pgt_dir_t *pgdir) {
-        delete pgdir;
+        free(pgdir);
     }
 
+private:
     static void pgd_purge_cb(const ucs_pgtable_t *pgtable,
                              ucs_pgt_region_t *region, void *arg) {
     }
@@ -145,7 +146,7 @@ protected:
 };
 
 
-UCS_TEST_F(test_pgtable, basic) {
+UCS_TEST_P(test_pgtable, basic) {
     ucs_pgt_region_t region;
 
     region.start = 0x400800;
@@ -171,7 +172,7 @@ UCS_TEST_F(test_pgtable, basic) {
     purge(); /* region goes out of scope so we must remove it */
 }
 
-UCS_TEST_F(test_pgtable, lookup_adjacent) {
+UCS_TEST_P(test_pgtable, lookup_adjacent) {
     ucs_pgt_region_t region1 = {0xc500000, 0xc500400};
     ucs_pgt_region_t region2 = {0xc500400, 0xc500800};
     insert(&region1);
@@ -182,7 +183,7 @@ UCS_TEST_F(test_pgtable, lookup_adjacent) {
     purge();
 }
 
-UCS_TEST_F(test_pgtable, multi_search) {
+UCS_TEST_P(test_pgtable, multi_search) {
     for (int count = 0; count < 10; ++count) {
         ucs::ptr_vector<ucs_pgt_region_t> regions;
         ucs_pgt_addr_t min = std::numeric_limits<ucs_pgt_addr_t>::max();
@@ -229,7 +230,7 @@ UCS_TEST_F(test_pgtable, multi_search) {
     }
 }
 
-UCS_TEST_SKIP_COND_F(test_pgtable, invalid_param,
+UCS_TEST_SKIP_COND_P(test_pgtable, invalid_param,
                      (UCS_PGT_ADDR_ALIGN == 1)) {
     ucs_pgt_region_t region1 = {0x4000, 0x4001};
     insert(&region1, UCS_ERR_INVALID_PARAM);
@@ -241,7 +242,18 @@ UCS_TEST_SKIP_COND_F(test_pgtable, invalid_param,
     insert(&region3, UCS_ERR_INVALID_PARAM);
 }
 
-UCS_TEST_F(test_pgtable, overlap_insert) {
+UCS_TEST_P(test_pgtable, invalid_fanout) {
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    ucs_pgtable_t pgtable;
+
+    /* The address bits above UCS_PGT_ADDR_SHIFT cannot be split evenly */
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucs_pgtable_init_fanout(&pgtable, 7, pgd_alloc, pgd_free));
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM,
+              ucs_pgtable_init_fanout(&pgtable, 0, pgd_alloc, pgd_free));
+}
+
+UCS_TEST_P(test_pgtable, overlap_insert) {
     ucs_pgt_region_t region1 = {0x4000, 0x6000};
     insert(&region1);
 
@@ -254,7 +266,7 @@ UCS_TEST_F(test_pgtable, overlap_insert) {
     remove(&region1);
 }
 
-UCS_TEST_F(test_pgtable, nonexist_remove) {
+UCS_TEST_P(test_pgtable, nonexist_remove) {
     ucs_pgt_region_t region1 = {0x4000, 0x6000};
     remove(&region1, UCS_ERR_NO_ELEM);
 
@@ -273,7 +285,7 @@ UCS_TEST_F(test_pgtable, nonexist_remove) {
     remove(&region2);
 }
 
-UCS_TEST_F(test_pgtable, search_large_region) {
+UCS_TEST_P(test_pgtable, search_large_region) {
     ucs_pgt_region_t region = {0x3c03cb00, 0x3c03f600};
     insert(&region, UCS_OK);
 
@@ -300,7 +312,7 @@ UCS_TEST_F(test_pgtable, search_large_region) {
     remove(&region);
 }
 
-UCS_TEST_F(test_pgtable, search_non_contig_regions) {
+UCS_TEST_P(test_pgtable, search_non_contig_regions) {
     const size_t region_size = UCS_BIT(28);
     size_t start, end;
 
@@ -338,7 +350,7 @@ UCS_TEST_F(test_pgtable, search_non_contig_regions) {
     remove(&region3);
 }
 
-UCS_TEST_F(test_pgtable, search_adjacent_regions) {
+UCS_TEST_P(test_pgtable, search_adjacent_regions) {
     const size_t region_size = UCS_BIT(28);
     size_t start, end;
 
@@ -445,7 +457,8 @@ protected:
                           unsigned num_superblocks, /* Number of big blocks */
                           unsigned num_lookups, /* How many lookups to generate */
                           bool random_access, /* Whether access pattern is random or ordered */
-                          double hit_ratio) /* Probability of lookup hit */
+                          double hit_ratio, /* Probability of lookup hit */
+                          size_t alignment = UCS_PGT_ADDR_ALIGN) /* Alignment of big blocks */
     {
         block_size = ucs_align_up_pow2(block_size, UCS_PGT_ADDR_ALIGN);
 
@@ -459,7 +472,9 @@ protected:
         ucs_pgt_addr_t start = 0;
         std::vector<ucs_pgt_addr_t> superblocks;
         for (unsigned i = 0; i < num_superblocks; ++i) {
-            ucs_pgt_addr_t addr = random_address(start, max_start);
+            ucs_pgt_addr_t addr = ucs_align_up_pow2(random_address(start,
+                                                                   max_start),
+                                                    alignment);
             superblocks.push_back(addr);
             start = addr + superblock_size * 2; /* minimal gap */
             if (start >= max_start) {
@@ -513,7 +528,8 @@ protected:
 
         EXPECT_EQ(result_stl.second, result_pgt.second);
 
-        UCS_TEST_MESSAGE << std::dec << num_superblocks << " areas of " <<
+        UCS_TEST_MESSAGE << std::dec << "dir " << UCS_BIT(GetParam()) << ": " <<
+                        num_superblocks << " areas of " <<
                         blocks_per_superblock << "x" << block_size << " bytes, " <<
                         (random_access ? "random" : "ordered") << ": " <<
                         "stl: " << (ucs_time_to_nsec(result_stl.first) / num_lookups) << " ns, "
@@ -573,7 +589,7 @@ private:
 /*
  * Compare out lookup performance to STL's
  */
-UCS_TEST_F(test_pgtable_perf, basic) {
+UCS_TEST_P(test_pgtable_perf, basic) {
     ucs_pgt_region_t region = {0x4000, 0x5000};
     insert(&region);
     EXPECT_EQ(&region, lookup_in_stl(0x4500));
@@ -583,7 +599,7 @@ UCS_TEST_F(test_pgtable_perf, basic) {
     purge();
 }
 
-UCS_TEST_SKIP_COND_F(test_pgtable_perf, workloads,
+UCS_TEST_SKIP_COND_P(test_pgtable_perf, workloads,
                      (ucs::test_time_multiplier() != 1)) {
 
     measure_workload(UCS_MASK(28),
@@ -614,4 +630,32 @@ UCS_TEST_SKIP_COND_F(test_pgtable_perf, workloads,
                      10000000,
                      false,
                      0.8);
+
+    /* Page-aligned buffers spread over a wide address range, like the regions
+     * of a registration cache */
+    measure_workload(UCS_MASK(40),
+                     4096,
+                     256,
+                     64,
+                     5000000,
+                     true,
+                     0.9,
+                     4096);
+    measure_workload(UCS_MASK(40),
+                     64 * 1024,
+                     16,
+                     256,
+                     5000000,
+                     true,
+                     0.9,
+                     64 * 1024);
 }
+
+INSTANTIATE_TEST_SUITE_P(dir16, test_pgtable,
+                         ::testing::Values(UCS_PGT_ENTRY_SHIFT));
+INSTANTIATE_TEST_SUITE_P(dir64, test_pgtable,
+                         ::testing::Values(UCS_PGT_ENTRY_SHIFT_WIDE));
+INSTANTIATE_TEST_SUITE_P(dir16, test_pgtable_perf,
+                         ::testing::Values(UCS_PGT_ENTRY_SHIFT));
+INSTANTIATE_TEST_SUITE_P(dir64, test_pgtable_perf,
+                         ::testing::Values(UCS_PGT_ENTRY_SHIFT_WIDE));
@@ -12,9 +12,13 @@ extern "C" {
 #include <ucs/memory/rcache.h>
 #include <ucs/memory/rcache_int.h>
 #include <ucs/sys/sys.h>
+#include <ucs/sys/string.h>
 #include <ucm/api/ucm.h>
 }
+#include <climits>
+#include <vector>
 #include <set>
+#include <thread>
 
 static ucs_rcache_params_t
 get_default_rcache_params(void *context, const ucs_rcache_ops_t *ops)
@@ -65,6 +69,26 @@ UCS_TEST_F(test_rcache_basic, create_destroy) {
 }
 
 
+UCS_TEST_SKIP_COND_F(test_rcache_basic, create_many, RUNNING_ON_VALGRIND) {
+    static const ucs_rcache_ops_t ops = {NULL, NULL, NULL};
+    ucs_rcache_params_t params        = get_default_rcache_params(this, &ops);
+    std::vector<ucs_rcache_t*> rcaches;
+
+    /* Without a thread cache, the number of rcaches is not limited by the
+     * number of thread-specific keys */
+    for (unsigned i = 0; i < (PTHREAD_KEYS_MAX + 16); ++i) {
+        ucs_rcache_t *rcache;
+        ucs_status_t status = ucs_rcache_create(&params, "test",
+                                                ucs_stats_get_root(), &rcache);
+        ASSERT_UCS_OK(status, << "rcache " << i);
+        rcaches.push_back(rcache);
+    }
+
+    for (ucs_rcache_t *rcache : rcaches) {
+        ucs_rcache_destroy(rcache);
+    }
+}
+
 class test_rcache : public ucs::test {
 protected:
 
@@ -872,6 +896,404 @@ UCS_TEST_F(test_rcache_with_limit, by_size_inuse) {
     free(ptr1);
 }
 
+class test_rcache_sharded : public test_rcache {
+protected:
+    static const unsigned NUM_SHARDS = 5;
+    static const size_t   BLOCK_SIZE = UCS_BIT(UCS_RCACHE_SHARD_SHIFT);
+    static const size_t   MAX_LENGTH = 4 * UCS_KBYTE;
+
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache::rcache_params();
+        params.num_shards          = NUM_SHARDS;
+        return params;
+    }
+
+    /* Map a range of address blocks, aligned to the shard block size */
+    static char *alloc_blocks(unsigned num_blocks)
+    {
+        size_t size = (num_blocks + 1) * BLOCK_SIZE;
+        char *ptr   = (char*)mmap(NULL, size, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                                  -1, 0);
+        EXPECT_NE(MAP_FAILED, ptr) << strerror(errno);
+
+        char *start = (char*)ucs_align_up_pow2((uintptr_t)ptr, BLOCK_SIZE);
+        char *end   = start + (num_blocks * BLOCK_SIZE);
+        if (start > ptr) {
+            munmap(ptr, start - ptr);
+        }
+        if (end < (ptr + size)) {
+            munmap(end, ptr + size - end);
+        }
+        return start;
+    }
+
+    /* Get and put random ranges of [base, base + size), some of them crossing
+     * the block boundary at 'base + boundary' */
+    void get_put_random(char *base, size_t size, size_t boundary,
+                        unsigned count)
+    {
+        for (unsigned i = 0; i < count; ++i) {
+            size_t length = 1 + ucs::rand() % MAX_LENGTH;
+            size_t offset = ((i % 8) == 0) ? (boundary - (length / 2)) :
+                            ucs::rand() % (size - length);
+            char *ptr     = base + offset;
+
+            region *r = get(ptr, length);
+            EXPECT_LE(r->super.super.start, (uintptr_t)ptr);
+            EXPECT_GE(r->super.super.end, (uintptr_t)ptr + length);
+            put(r);
+        }
+    }
+
+    uint32_t get_put(void *ptr, size_t size)
+    {
+        region *region = get(ptr, size);
+        uint32_t id    = region->id;
+        put(region);
+        return id;
+    }
+
+    /* Memory operations which do not register anything, to measure the
+     * overhead of the cache itself */
+    static ucs_status_t perf_mem_reg(void *context, ucs_rcache_t *rcache,
+                                     void *arg, ucs_rcache_region_t *r,
+                                     uint16_t rcache_mem_reg_flags)
+    {
+        return UCS_OK;
+    }
+
+    static void perf_mem_dereg(void *context, ucs_rcache_t *rcache,
+                               ucs_rcache_region_t *r)
+    {
+    }
+
+    static void perf_merge(void *context, ucs_rcache_t *rcache, void *arg,
+                           ucs_rcache_region_t *r)
+    {
+    }
+
+    static void perf_dump_region(void *context, ucs_rcache_t *rcache,
+                                 ucs_rcache_region_t *r, char *buf, size_t max)
+    {
+        ucs_strncpy_zero(buf, "", max);
+    }
+};
+
+UCS_MT_TEST_F(test_rcache_sharded, disjoint, 8) {
+    char *base = alloc_blocks(2);
+
+    get_put_random(base, 2 * BLOCK_SIZE, BLOCK_SIZE,
+                   200 / ucs::test_time_multiplier());
+    munmap(base, 2 * BLOCK_SIZE);
+}
+
+UCS_MT_TEST_F(test_rcache_sharded, overlapping, 8) {
+    static const size_t range = 64 * UCS_KBYTE;
+
+    if (barrier()) {
+        m_ptr = alloc_blocks(2);
+    }
+    barrier();
+
+    /* All threads use the same small range around the block boundary */
+    get_put_random((char*)m_ptr + BLOCK_SIZE - range, 2 * range, range,
+                   200 / ucs::test_time_multiplier());
+
+    if (barrier()) {
+        munmap(m_ptr, 2 * BLOCK_SIZE);
+    }
+}
+
+UCS_TEST_F(test_rcache_sharded, unmap_all_shards) {
+    static const unsigned num_blocks = NUM_SHARDS;
+    static const size_t size         = 4 * UCS_KBYTE;
+    char *base                       = alloc_blocks(num_blocks);
+    std::vector<char*> ptrs;
+    std::vector<uint32_t> ids;
+
+    /* One region in every block, and one crossing each block boundary */
+    for (unsigned i = 0; i < num_blocks; ++i) {
+        ptrs.push_back(base + (i * BLOCK_SIZE) + BLOCK_SIZE / 2);
+        if (i > 0) {
+            ptrs.push_back(base + (i * BLOCK_SIZE) - size / 2);
+        }
+    }
+
+    for (char *ptr : ptrs) {
+        ids.push_back(get_put(ptr, size));
+    }
+
+    for (size_t i = 0; i < ptrs.size(); ++i) {
+        EXPECT_EQ(ids[i], get_put(ptrs[i], size));
+    }
+
+    /* Unmapping the whole range must invalidate the regions in all shards */
+    munmap(base, num_blocks * BLOCK_SIZE);
+    void *ptr = mmap(base, num_blocks * BLOCK_SIZE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+                     -1, 0);
+    ASSERT_EQ((void*)base, ptr) << strerror(errno);
+
+    for (size_t i = 0; i < ptrs.size(); ++i) {
+        EXPECT_NE(ids[i], get_put(ptrs[i], size));
+    }
+
+    munmap(base, num_blocks * BLOCK_SIZE);
+}
+
+UCS_TEST_SKIP_COND_F(test_rcache_sharded, perf, RUNNING_ON_VALGRIND) {
+    static const ucs_rcache_ops_t ops  = {perf_mem_reg, perf_mem_dereg,
+                                          perf_merge, perf_dump_region};
+    const size_t count                 = 20000 / ucs::test_time_multiplier();
+    const size_t page_size             = ucs_get_page_size();
+    const std::vector<unsigned> shards = {1, NUM_SHARDS};
+    const unsigned num_threads         = 4;
+    char *base                         = alloc_blocks(num_threads);
+
+    for (unsigned num_shards : shards) {
+        ucs_rcache_params_t params = get_default_rcache_params(this, &ops);
+        std::vector<std::thread> threads;
+        ucs_time_t start_time;
+        ucs_rcache_t *rcache;
+
+        params.ucm_events = 0;
+        params.num_shards = num_shards;
+        ASSERT_UCS_OK(ucs_rcache_create(&params, "perf", ucs_stats_get_root(),
+                                        &rcache));
+
+        /* Every thread registers distinct pages in its own address block, and
+         * then looks them up again */
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads.push_back(std::thread([&, i]() {
+                char *block = base + (i * BLOCK_SIZE);
+                ucs_rcache_region_t *r;
+
+                for (unsigned pass = 0; pass < 2; ++pass) {
+                    for (size_t j = 0; j < count; ++j) {
+                        ASSERT_UCS_OK(ucs_rcache_get(rcache,
+                                                     block + (j * page_size),
+                                                     page_size, 1,
+                                                     PROT_READ | PROT_WRITE,
+                                                     NULL, &r));
+                        ucs_rcache_region_put(rcache, r);
+                    }
+                }
+            }));
+        }
+
+        for (std::thread &t : threads) {
+            t.join();
+        }
+
+        double rate = (2 * count * num_threads) /
+                      ucs_time_to_sec(ucs_get_time() - start_time);
+        UCS_TEST_MESSAGE << num_threads << " threads, " << num_shards
+                         << " shards: " << rate / 1e6 << " Mops/s";
+
+        ucs_rcache_destroy(rcache);
+    }
+
+    munmap(base, num_threads * BLOCK_SIZE);
+}
+
+class test_rcache_sharded_with_limit : public test_rcache_sharded {
+protected:
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache_sharded::rcache_params();
+        params.max_regions         = 2;
+        return params;
+    }
+};
+
+UCS_TEST_F(test_rcache_sharded_with_limit, evict_other_shard) {
+    static const size_t size = 32;
+    char *base               = alloc_blocks(3);
+
+    /* Every region is placed in a different shard, but the regions limit is
+     * global */
+    uint32_t region1_id = get_put(base, size);
+    get_put(base + BLOCK_SIZE, size);
+    EXPECT_EQ(2, m_rcache.get()->num_regions);
+
+    get_put(base + 2 * BLOCK_SIZE, size);
+    EXPECT_EQ(2, m_rcache.get()->num_regions);
+
+    /* First region was evicted by lru policy */
+    EXPECT_NE(region1_id, get_put(base, size));
+    EXPECT_EQ(2, m_rcache.get()->num_regions);
+
+    munmap(base, 3 * BLOCK_SIZE);
+}
+
+class test_rcache_tcache : public test_rcache_sharded {
+protected:
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache_sharded::rcache_params();
+        params.flags              |= UCS_RCACHE_FLAG_THREAD_CACHE;
+        return params;
+    }
+
+    uint64_t tcache_hits()
+    {
+        ucs_rcache_thread_cache_t *tc;
+        uint64_t hits;
+
+        ucs_spin_lock(&m_rcache->tcache.lock);
+        hits = m_rcache->tcache.hits;
+        ucs_list_for_each(tc, &m_rcache->tcache.threads, list) {
+            hits += tc->hits;
+        }
+        ucs_spin_unlock(&m_rcache->tcache.lock);
+
+        return hits;
+    }
+};
+
+UCS_TEST_F(test_rcache_tcache, hit) {
+    static const size_t size = 4 * UCS_KBYTE;
+    char *base               = alloc_blocks(1);
+
+    /* The first lookup registers the region, the second one finds it in the
+     * page table and remembers it */
+    uint32_t id = get_put(base, size);
+    EXPECT_EQ(id, get_put(base, size));
+    EXPECT_EQ(0, tcache_hits());
+
+    /* Repeated lookups, also of a sub-range, are served by the thread cache */
+    for (unsigned i = 0; i < 10; ++i) {
+        EXPECT_EQ(id, get_put(base, size));
+        EXPECT_EQ(id, get_put(base + 1, size / 2));
+    }
+    EXPECT_EQ(20, tcache_hits());
+
+    /* A larger range is not contained in the cached region */
+    region *r = get(base, 2 * size);
+    EXPECT_NE(id, r->id);
+    put(r);
+
+    munmap(base, BLOCK_SIZE);
+}
+
+UCS_TEST_F(test_rcache_tcache, unmap) {
+    static const size_t size = 4 * UCS_KBYTE;
+    char *base               = alloc_blocks(1);
+
+    uint32_t id = get_put(base, size);
+    EXPECT_EQ(id, get_put(base, size));
+
+    /* The region is cached by this thread, but it must not be returned after
+     * the memory was unmapped */
+    munmap(base, BLOCK_SIZE);
+    void *ptr = mmap(base, BLOCK_SIZE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+                     -1, 0);
+    ASSERT_EQ((void*)base, ptr) << strerror(errno);
+
+    uint64_t hits = tcache_hits();
+    uint32_t new_id = get_put(base, size);
+    EXPECT_NE(id, new_id);
+    EXPECT_EQ(hits, tcache_hits());
+    EXPECT_EQ(new_id, get_put(base, size));
+
+    munmap(base, BLOCK_SIZE);
+}
+
+UCS_TEST_F(test_rcache_tcache, inuse_unmap) {
+    static const size_t size = 4 * UCS_KBYTE;
+    char *base               = alloc_blocks(1);
+
+    get_put(base, size);
+    region *r = get(base, size);
+
+    /* An unmapped region stays valid until released, but new lookups must not
+     * find it */
+    munmap(base, BLOCK_SIZE);
+    void *ptr = mmap(base, BLOCK_SIZE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+                     -1, 0);
+    ASSERT_EQ((void*)base, ptr) << strerror(errno);
+
+    EXPECT_NE(r->id, get_put(base, size));
+    put(r);
+
+    munmap(base, BLOCK_SIZE);
+}
+
+UCS_MT_TEST_F(test_rcache_tcache, overlapping, 8) {
+    static const size_t range = 64 * UCS_KBYTE;
+
+    if (barrier()) {
+        m_ptr = alloc_blocks(2);
+    }
+    barrier();
+
+    get_put_random((char*)m_ptr + BLOCK_SIZE - range, 2 * range, range,
+                   200 / ucs::test_time_multiplier());
+
+    if (barrier()) {
+        munmap(m_ptr, 2 * BLOCK_SIZE);
+    }
+}
+
+UCS_TEST_SKIP_COND_F(test_rcache_tcache, perf, RUNNING_ON_VALGRIND) {
+    static const ucs_rcache_ops_t ops = {perf_mem_reg, perf_mem_dereg,
+                                         perf_merge, perf_dump_region};
+    const size_t count                = 100000 / ucs::test_time_multiplier();
+    const size_t page_size            = ucs_get_page_size();
+    const unsigned num_buffers        = 8;
+    const unsigned num_threads        = 4;
+    const std::vector<unsigned> flags = {0, UCS_RCACHE_FLAG_THREAD_CACHE};
+    char *base                        = alloc_blocks(num_threads);
+
+    for (unsigned flag : flags) {
+        ucs_rcache_params_t params = get_default_rcache_params(this, &ops);
+        std::vector<std::thread> threads;
+        ucs_time_t start_time;
+        ucs_rcache_t *rcache;
+
+        params.ucm_events = 0;
+        params.flags     |= flag;
+        ASSERT_UCS_OK(ucs_rcache_create(&params, "perf", ucs_stats_get_root(),
+                                        &rcache));
+
+        /* Every thread reuses a small set of buffers, like a communication
+         * library sending from the same buffers over and over */
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads.push_back(std::thread([&, i]() {
+                char *block = base + (i * BLOCK_SIZE);
+                ucs_rcache_region_t *r;
+
+                for (size_t j = 0; j < count; ++j) {
+                    ASSERT_UCS_OK(ucs_rcache_get(
+                            rcache, block + ((j % num_buffers) * page_size),
+                            page_size, 1, PROT_READ | PROT_WRITE, NULL, &r));
+                    ucs_rcache_region_put(rcache, r);
+                }
+            }));
+        }
+
+        for (std::thread &t : threads) {
+            t.join();
+        }
+
+        double rate = (count * num_threads) /
+                      ucs_time_to_sec(ucs_get_time() - start_time);
+        UCS_TEST_MESSAGE << num_threads << " threads, thread cache "
+                         << (flag ? "on" : "off") << ": " << rate / 1e6
+                         << " Mops/s";
+
+        ucs_rcache_destroy(rcache);
+    }
+
+    munmap(base, num_threads * BLOCK_SIZE);
+}
+
 #ifdef ENABLE_STATS
 class test_rcache_stats : public test_rcache {
 protected:
@@ -972,9 +1394,9 @@ UCS_TEST_F(test_rcache_stats, unmap_dereg_with_lock) {
      * We can have more unmap events if releasing the region structure triggers
      * releasing memory back to the OS.
      */
-    ucs_rw_spinlock_write_lock(&m_rcache->pgt_lock);
+    ucs_rw_spinlock_write_lock(&m_rcache->shards[0].pgt_lock);
     munmap(mem, size1);
-    ucs_rw_spinlock_write_unlock(&m_rcache->pgt_lock);
+    ucs_rw_spinlock_write_unlock(&m_rcache->shards[0].pgt_lock);
 
     EXPECT_GE(get_counter(UCS_RCACHE_UNMAPS), 1);
     EXPECT_EQ(0, get_counter(UCS_RCACHE_UNMAP_INVALIDATES));
@@ -1026,9 +1448,9 @@ UCS_TEST_F(test_rcache_stats, hits_slow) {
     r1 = get(mem2, size1);
 
     /* generate unmap event under lock, to roce using invalidation queue */
-    ucs_rw_spinlock_read_lock(&m_rcache->pgt_lock);
+    ucs_rw_spinlock_read_lock(&m_rcache->shards[0].pgt_lock);
     munmap(mem1, size1);
-    ucs_rw_spinlock_read_unlock(&m_rcache->pgt_lock);
+    ucs_rw_spinlock_read_unlock(&m_rcache->shards[0].pgt_lock);
 
     EXPECT_EQ(1, get_counter(UCS_RCACHE_UNMAPS));
 
@@ -0,0 +1,273 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2026. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#include <common/test.h>
+extern "C" {
+#include <ucs/datastruct/swiss_hash.h>
+#include <ucs/time/time.h>
+}
+
+#include <map>
+#include <vector>
+
+
+UCS_SWISS_HASH_TYPE(test_swiss, uint64_t, size_t)
+UCS_SWISS_HASH_IMPL(test_swiss, uint64_t, size_t, 1, kh_int64_hash_func,
+                    kh_int64_hash_equal)
+
+UCS_SWISS_HASH_TYPE(test_swiss_set, uint64_t, char)
+UCS_SWISS_HASH_IMPL(test_swiss_set, uint64_t, char, 0, kh_int64_hash_func,
+                    kh_int64_hash_equal)
+
+KHASH_MAP_INIT_INT64(test_swiss_khash, size_t)
+
+
+class test_swiss_hash : public ucs::test {
+protected:
+    typedef ucs_swiss_hash_t(test_swiss) hash_t;
+
+    void check(hash_t *h, const std::map<uint64_t, size_t> &expected)
+    {
+        std::map<uint64_t, size_t> found;
+        uint64_t key;
+        size_t value;
+
+        ASSERT_EQ(expected.size(), ucs_swiss_size(h));
+        for (auto it = expected.begin(); it != expected.end(); ++it) {
+            khint_t iter = ucs_swiss_get(test_swiss, h, it->first);
+            ASSERT_NE(ucs_swiss_end(h), iter) << "key " << it->first;
+            EXPECT_EQ(it->first, ucs_swiss_key(h, iter));
+            EXPECT_EQ(it->second, ucs_swiss_value(h, iter));
+        }
+
+        ucs_swiss_foreach(h, key, value, {
+            EXPECT_TRUE(found.insert(std::make_pair(key, value)).second);
+        })
+        EXPECT_EQ(expected, found);
+    }
+};
+
+UCS_TEST_F(test_swiss_hash, empty) {
+    hash_t *h = ucs_swiss_init(test_swiss);
+    ASSERT_TRUE(h != NULL);
+
+    EXPECT_EQ(0u, ucs_swiss_size(h));
+    EXPECT_EQ(ucs_swiss_end(h), ucs_swiss_get(test_swiss, h, 5));
+    ucs_swiss_del(test_swiss, h, ucs_swiss_end(h));
+    ucs_swiss_clear(test_swiss, h);
+    ucs_swiss_destroy(test_swiss, h);
+}
+
+UCS_TEST_F(test_swiss_hash, put_get_del) {
+    std::map<uint64_t, size_t> expected;
+    hash_t h;
+    khint_t iter;
+    int ret;
+
+    ucs_swiss_init_inplace(test_swiss, &h);
+
+    for (int i = 0; i < 20000; ++i) {
+        uint64_t key = ucs::rand() % 4096;
+        if (ucs::rand() % 3) {
+            iter = ucs_swiss_put(test_swiss, &h, key, &ret);
+            ASSERT_NE(UCS_KH_PUT_FAILED, ret);
+            if (expected.find(key) != expected.end()) {
+                EXPECT_EQ(UCS_KH_PUT_KEY_PRESENT, ret);
+            } else {
+                EXPECT_NE(UCS_KH_PUT_KEY_PRESENT, ret);
+            }
+
+            ucs_swiss_value(&h, iter) = i;
+            expected[key]             = i;
+        } else {
+            iter = ucs_swiss_get(test_swiss, &h, key);
+            if (expected.erase(key)) {
+                ASSERT_NE(ucs_swiss_end(&h), iter);
+                ucs_swiss_del(test_swiss, &h, iter);
+            } else {
+                EXPECT_EQ(ucs_swiss_end(&h), iter);
+            }
+        }
+    }
+
+    check(&h, expected);
+
+    /* Keys which collide in the low bits */
+    for (uint64_t key = 0; key < 1000; ++key) {
+        iter = ucs_swiss_put(test_swiss, &h, key << 40, &ret);
+        ASSERT_NE(UCS_KH_PUT_FAILED, ret);
+        ucs_swiss_value(&h, iter) = key;
+        expected[key << 40]       = key;
+    }
+
+    check(&h, expected);
+
+    ucs_swiss_clear(test_swiss, &h);
+    expected.clear();
+    check(&h, expected);
+
+    ucs_swiss_destroy_inplace(test_swiss, &h);
+}
+
+UCS_TEST_F(test_swiss_hash, deleted_reuse) {
+    std::map<uint64_t, size_t> expected;
+    hash_t h;
+    khint_t iter;
+    int ret;
+
+    ucs_swiss_init_inplace(test_swiss, &h);
+
+    /* Fill and empty the table many times, the deleted buckets must be
+     * reclaimed without growing the table */
+    for (int round = 0; round < 100; ++round) {
+        for (uint64_t key = 0; key < 100; ++key) {
+            iter = ucs_swiss_put(test_swiss, &h, (round * 100) + key, &ret);
+            ASSERT_NE(UCS_KH_PUT_FAILED, ret);
+            ucs_swiss_value(&h, iter) = key;
+        }
+
+        for (uint64_t key = 0; key < 100; ++key) {
+            iter = ucs_swiss_get(test_swiss, &h, (round * 100) + key);
+            ASSERT_NE(ucs_swiss_end(&h), iter);
+            ucs_swiss_del(test_swiss, &h, iter);
+        }
+    }
+
+    check(&h, expected);
+    EXPECT_LE(ucs_swiss_n_buckets(&h), 256u);
+
+    ucs_swiss_destroy_inplace(test_swiss, &h);
+}
+
+UCS_TEST_F(test_swiss_hash, resize) {
+    std::map<uint64_t, size_t> expected;
+    hash_t h;
+    khint_t iter;
+    int ret;
+
+    ucs_swiss_init_inplace(test_swiss, &h);
+    ASSERT_EQ(0, ucs_swiss_resize(test_swiss, &h, 1000));
+    EXPECT_EQ(1024u, ucs_swiss_n_buckets(&h));
+
+    for (uint64_t key = 0; key < 800; ++key) {
+        iter = ucs_swiss_put(test_swiss, &h, key * 3, &ret);
+        EXPECT_EQ(UCS_KH_PUT_BUCKET_EMPTY, ret);
+        ucs_swiss_value(&h, iter) = key;
+        expected[key * 3]         = key;
+    }
+
+    /* Does not shrink below the number of keys */
+    EXPECT_EQ(0, ucs_swiss_resize(test_swiss, &h, 16));
+    EXPECT_EQ(1024u, ucs_swiss_n_buckets(&h));
+    check(&h, expected);
+
+    ucs_swiss_destroy_inplace(test_swiss, &h);
+}
+
+UCS_TEST_F(test_swiss_hash, set) {
+    ucs_swiss_hash_t(test_swiss_set) h;
+    uint64_t key;
+    size_t count;
+    int ret;
+
+    ucs_swiss_init_inplace(test_swiss_set, &h);
+    for (key = 0; key < 100; ++key) {
+        ucs_swiss_put(test_swiss_set, &h, key, &ret);
+        EXPECT_EQ(UCS_KH_PUT_BUCKET_EMPTY, ret);
+    }
+
+    EXPECT_TRUE(h.vals == NULL);
+
+    count = 0;
+    ucs_swiss_foreach_key(&h, key, {
+        EXPECT_LT(key, 100u);
+        ++count;
+    })
+    EXPECT_EQ(100u, count);
+
+    ucs_swiss_destroy_inplace(test_swiss_set, &h);
+}
+
+class test_swiss_hash_perf : public ucs::test {
+protected:
+    static const size_t NUM_LOOKUPS = 4000000;
+
+    template<typename F> static double measure(F func)
+    {
+        ucs_time_t start_time = ucs_get_time();
+
+        func();
+        return ucs_time_to_nsec(ucs_get_time() - start_time);
+    }
+
+    void run(size_t num_keys)
+    {
+        std::vector<uint64_t> keys(num_keys);
+        khash_t(test_swiss_khash) kh;
+        ucs_swiss_hash_t(test_swiss) sh;
+        double kh_put, sh_put, kh_get, sh_get;
+        size_t sum_kh = 0, sum_sh = 0;
+        khint_t iter;
+        int ret;
+
+        for (size_t i = 0; i < num_keys; ++i) {
+            /* Protocol selection keys differ in a few bit fields */
+            keys[i] = (ucs::rand() & 0xff) | ((uint64_t)i << 8) |
+                      ((uint64_t)(ucs::rand() & 0x3) << 40);
+        }
+
+        kh_init_inplace(test_swiss_khash, &kh);
+        ucs_swiss_init_inplace(test_swiss, &sh);
+
+        /* Adding a key can move the values, so take the iterator first */
+        kh_put = measure([&]() {
+            for (size_t i = 0; i < num_keys; ++i) {
+                iter                = kh_put(test_swiss_khash, &kh, keys[i],
+                                             &ret);
+                kh_value(&kh, iter) = i;
+            }
+        });
+        sh_put = measure([&]() {
+            for (size_t i = 0; i < num_keys; ++i) {
+                iter                       = ucs_swiss_put(test_swiss, &sh,
+                                                           keys[i], &ret);
+                ucs_swiss_value(&sh, iter) = i;
+            }
+        });
+
+        kh_get = measure([&]() {
+            for (size_t i = 0; i < NUM_LOOKUPS; ++i) {
+                sum_kh += kh_value(&kh, kh_get(test_swiss_khash, &kh,
+                                               keys[i % num_keys]));
+            }
+        });
+        sh_get = measure([&]() {
+            for (size_t i = 0; i < NUM_LOOKUPS; ++i) {
+                sum_sh += ucs_swiss_value(&sh, ucs_swiss_get(test_swiss, &sh,
+                                                             keys[i % num_keys]));
+            }
+        });
+
+        EXPECT_EQ(sum_kh, sum_sh);
+
+        UCS_TEST_MESSAGE << num_keys << " keys: insert khash "
+                         << kh_put / num_keys << " ns, swiss "
+                         << sh_put / num_keys << " ns; lookup khash "
+                         << kh_get / NUM_LOOKUPS << " ns, swiss "
+                         << sh_get / NUM_LOOKUPS << " ns";
+
+        kh_destroy_inplace(test_swiss_khash, &kh);
+        ucs_swiss_destroy_inplace(test_swiss, &sh);
+    }
+};
+
+UCS_TEST_SKIP_COND_F(test_swiss_hash_perf, lookup_insert,
+                     RUNNING_ON_VALGRIND) {
+    run(16);
+    run(256);
+    run(4096);
+    run(262144);
+}
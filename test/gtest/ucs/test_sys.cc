@@ -126,6 +126,35 @@ UCS_TEST_F(test_sys, fcntl) {
     close(fd);
 }
 
+UCS_TEST_F(test_sys, pidfd_getfd) {
+    const char data = 'x';
+    char buffer     = 0;
+    ucs_status_t status;
+    int fds[2], fd;
+
+    ASSERT_EQ(0, pipe(fds));
+
+    /* may be unsupported by the kernel or blocked by a seccomp filter */
+    status = ucs_sys_pidfd_getfd(getpid(), fds[1], &fd);
+    if (status != UCS_OK) {
+        close(fds[0]);
+        close(fds[1]);
+        UCS_TEST_SKIP_R(std::string("pidfd_getfd failed: ") +
+                        ucs_status_string(status));
+    }
+    EXPECT_NE(fds[1], fd);
+
+    /* the new descriptor refers to the same pipe */
+    EXPECT_EQ(1, write(fd, &data, 1));
+    EXPECT_EQ(1, read(fds[0], &buffer, 1));
+    EXPECT_EQ(data, buffer);
+    EXPECT_TRUE(fcntl(fd, F_GETFD) & FD_CLOEXEC);
+
+    close(fd);
+    close(fds[0]);
+    close(fds[1]);
+}
+
 UCS_TEST_F(test_sys, memory) {
     size_t phys_size = ucs_get_phys_mem_size();
     UCS_TEST_MESSAGE << "Physical memory size: " << ucs::size_value(phys_size);
@@ -11,6 +11,8 @@ extern "C" {
 }
 
 #include <time.h>
+#include <map>
+#include <set>
 
 class test_time : public ucs::test {
 };
@@ -142,4 +144,119 @@ UCS_TEST_F(test_time, timerq) {
     }
 }
 
+UCS_TEST_F(test_time, timerq_random) {
+    const unsigned num_timers = 200;
+    const unsigned num_sweeps = 5000 / ucs::test_time_multiplier();
+    std::map<int, std::pair<ucs_time_t, ucs_time_t>> expected; /* id ->
+                                                     (expiration, interval) */
+    ucs_timer_queue_t timerq;
+    ucs_timer_t *timer;
+    ucs_status_t status;
+
+    status = ucs_timerq_init(&timerq);
+    ASSERT_UCS_OK(status);
+
+    ucs_time_t current_time = ucs::rand();
+    for (unsigned sweep = 0; sweep < num_sweeps; ++sweep) {
+        /* Add or remove a random timer */
+        int timer_id = ucs::rand() % num_timers;
+        if (expected.find(timer_id) == expected.end()) {
+            /* Intervals and time steps span several levels of the wheel */
+            ucs_time_t interval = 1 + (ucs::rand() % (1 << (ucs::rand() % 24)));
+            status              = ucs_timerq_add(&timerq, timer_id, interval);
+            ASSERT_UCS_OK(status);
+            expected[timer_id] = std::make_pair(0, interval);
+        } else if (ucs::rand() % 2) {
+            status = ucs_timerq_remove(&timerq, timer_id);
+            ASSERT_UCS_OK(status);
+            expected.erase(timer_id);
+        } else {
+            EXPECT_EQ(UCS_ERR_ALREADY_EXISTS,
+                      ucs_timerq_add(&timerq, timer_id, 1));
+        }
+
+        ASSERT_EQ(expected.size(), ucs_timerq_size(&timerq));
+
+        ucs_time_t min_interval = UCS_TIME_INFINITY;
+        for (auto &elem : expected) {
+            min_interval = std::min(min_interval, elem.second.second);
+        }
+        ASSERT_EQ(min_interval, ucs_timerq_min_interval(&timerq));
+
+        current_time += ucs::rand() % (1 << (ucs::rand() % 24));
+
+        std::set<int> expected_expired;
+        for (auto &elem : expected) {
+            if (current_time >= elem.second.first) {
+                expected_expired.insert(elem.first);
+                elem.second.first = current_time + elem.second.second;
+            }
+        }
+
+        std::set<int> expired;
+        ucs_timerq_for_each_expired(timer, &timerq, current_time, {
+            EXPECT_TRUE(expired.insert(timer->id).second) << timer->id;
+        })
+        ASSERT_EQ(expected_expired, expired) << "sweep " << sweep;
+    }
+
+    for (auto &elem : expected) {
+        status = ucs_timerq_remove(&timerq, elem.first);
+        ASSERT_UCS_OK(status);
+    }
+
+    EXPECT_TRUE(ucs_timerq_is_empty(&timerq));
+    ucs_timerq_cleanup(&timerq);
+}
 
+UCS_TEST_SKIP_COND_F(test_time, timerq_perf, RUNNING_ON_VALGRIND) {
+    const std::vector<unsigned> num_timers = {10000, 100000};
+    const unsigned num_sweeps              = 1000;
+    const ucs_time_t tick                  = ucs_time_from_msec(1);
+    ucs_timer_queue_t timerq;
+    ucs_time_t start_time;
+    ucs_timer_t *timer;
+    ucs_status_t status;
+
+    for (unsigned count : num_timers) {
+        status = ucs_timerq_init(&timerq);
+        ASSERT_UCS_OK(status);
+
+        /* Intervals between 1 millisecond and 1 second */
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < count; ++i) {
+            status = ucs_timerq_add(&timerq, i,
+                                    tick * (1 + (ucs::rand() % 1000)));
+            ASSERT_UCS_OK(status);
+        }
+        double add_time = ucs_time_to_nsec(ucs_get_time() - start_time) /
+                          count;
+
+        size_t num_expired      = 0;
+        ucs_time_t current_time = ucs_get_time();
+        start_time              = ucs_get_time();
+        for (unsigned sweep = 0; sweep < num_sweeps; ++sweep) {
+            current_time += tick;
+            ucs_timerq_for_each_expired(timer, &timerq, current_time, {
+                ++num_expired;
+            })
+        }
+        double sweep_time = ucs_time_to_usec(ucs_get_time() - start_time) /
+                            num_sweeps;
+
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < count; ++i) {
+            status = ucs_timerq_remove(&timerq, i);
+            ASSERT_UCS_OK(status);
+        }
+        double remove_time = ucs_time_to_nsec(ucs_get_time() - start_time) /
+                             count;
+
+        UCS_TEST_MESSAGE << count << " timers: add " << add_time
+                         << " ns, remove " << remove_time << " ns, sweep "
+                         << sweep_time << " us ("
+                         << (double)num_expired / num_sweeps
+                         << " expired timers per sweep)";
+        ucs_timerq_cleanup(&timerq);
+    }
+}
@@ -6,6 +6,10 @@
 #include <common/test.h>
 #include <uct/uct_test.h>
 
+#include <algorithm>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+
 extern "C" {
 #include <uct/api/uct.h>
 #include <uct/tcp/tcp.h>
@@ -288,3 +292,972 @@ UCS_TEST_P(test_uct_tcp, check_addr_len)
 
 
 _UCT_INSTANTIATE_TEST_CASE(test_uct_tcp, tcp)
+
+
+/* A pair of connected entities, for the tests of a data transfer between them */
+class test_uct_tcp_pair : public uct_test {
+public:
+    test_uct_tcp_pair() : m_am_count(0) {
+        m_comp.func   = (uct_completion_callback_t)ucs_empty_function;
+        m_comp.count  = 0;
+        m_comp.status = UCS_OK;
+    }
+
+    void init() {
+        uct_test::init();
+        create_connected_entities(0);
+    }
+
+    entity& sender() {
+        return m_entities.at(0);
+    }
+
+    entity& receiver() {
+        return m_entities.at(1);
+    }
+
+    uct_tcp_iface_t *sender_iface() {
+        return ucs_derived_of(sender().iface(), uct_tcp_iface_t);
+    }
+
+    uct_tcp_iface_t *receiver_iface() {
+        return ucs_derived_of(receiver().iface(), uct_tcp_iface_t);
+    }
+
+    uct_tcp_ep_t *sender_ep() {
+        return ucs_derived_of(sender().ep(0), uct_tcp_ep_t);
+    }
+
+    void set_am_handler(uint8_t am_id) {
+        ucs_status_t status = uct_iface_set_am_handler(receiver().iface(),
+                                                       am_id, am_handler,
+                                                       this, 0);
+        ASSERT_UCS_OK(status);
+    }
+
+    /* Retry the operation until it is accepted, and count it in m_comp if it
+     * is completed later */
+    template<typename Op>
+    void post(Op op) {
+        ucs_status_t status;
+
+        do {
+            status = op();
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        if (status == UCS_INPROGRESS) {
+            ++m_comp.count;
+        } else {
+            ASSERT_UCS_OK(status);
+        }
+    }
+
+    void wait_for_completions() {
+        wait_for_value(&m_comp.count, 0, true);
+        EXPECT_EQ(0, m_comp.count);
+        EXPECT_UCS_OK(m_comp.status);
+    }
+
+    void wait_for_am_count(size_t count) {
+        wait_for_value(&m_am_count, count, true);
+        EXPECT_EQ(count, m_am_count);
+    }
+
+protected:
+    /* Called for every received active message before it is counted */
+    virtual void check_am(const void *data, size_t length) {
+    }
+
+private:
+    static ucs_status_t
+    am_handler(void *arg, void *data, size_t length, unsigned flags) {
+        test_uct_tcp_pair *self = static_cast<test_uct_tcp_pair*>(arg);
+
+        self->check_am(data, length);
+        ++self->m_am_count;
+        return UCS_OK;
+    }
+
+protected:
+    uct_completion_t m_comp;
+    volatile size_t  m_am_count;
+};
+
+
+class test_uct_tcp_msg_zcopy : public test_uct_tcp_pair {
+public:
+    static const uint8_t  AM_ID = 5;
+    static const uint64_t SEED  = 0x1111111111111111lu;
+
+    void init() {
+        modify_config("TCP_MSG_ZCOPY_THRESH", "0", IGNORE_IF_NOT_EXIST);
+        test_uct_tcp_pair::init();
+
+        if (sender_iface()->config.msg_zcopy_thresh == UCS_MEMUNITS_INF) {
+            UCS_TEST_SKIP_R("MSG_ZEROCOPY send is not supported");
+        }
+
+        set_am_handler(AM_ID);
+    }
+
+    void wait_for_completions() {
+        test_uct_tcp_pair::wait_for_completions();
+
+        EXPECT_TRUE(ucs_queue_is_empty(&sender_ep()->msg_zcopy.comp_q));
+        /* The kernel copies the data sent over a loopback connection and
+         * reports it in the notifications */
+        EXPECT_TRUE(sender_ep()->flags & UCT_TCP_EP_FLAG_MSG_ZCOPY_COPIED);
+    }
+
+protected:
+    virtual void check_am(const void *data, size_t length) {
+        mem_buffer::pattern_check(data, length, SEED);
+    }
+};
+
+UCS_TEST_P(test_uct_tcp_msg_zcopy, am_zcopy) {
+    const size_t num_msgs = 64 / ucs::test_time_multiplier();
+    const size_t length   = sender().iface_attr().cap.am.max_zcopy;
+    mapped_buffer sendbuf(length, SEED, sender());
+
+    UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, sendbuf.ptr(), sendbuf.length(),
+                            sendbuf.memh(),
+                            sender().iface_attr().cap.am.max_iov);
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        post([&]() {
+            return uct_ep_am_zcopy(sender().ep(0), AM_ID, NULL, 0, iov, iovcnt,
+                                   0, &m_comp);
+        });
+    }
+
+    wait_for_am_count(num_msgs);
+    wait_for_completions();
+}
+
+UCS_TEST_P(test_uct_tcp_msg_zcopy, put_zcopy_flush) {
+    const size_t length = 256 * UCS_KBYTE;
+    mapped_buffer sendbuf(length, SEED, sender());
+    mapped_buffer recvbuf(length, 0, receiver());
+
+    UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, sendbuf.ptr(), sendbuf.length(),
+                            sendbuf.memh(),
+                            sender().iface_attr().cap.put.max_iov);
+
+    post([&]() {
+        return uct_ep_put_zcopy(sender().ep(0), iov, iovcnt, recvbuf.addr(),
+                                recvbuf.rkey(), &m_comp);
+    });
+    post([&]() {
+        return uct_ep_flush(sender().ep(0), 0, &m_comp);
+    });
+
+    wait_for_completions();
+    recvbuf.pattern_check(SEED);
+}
+
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_msg_zcopy, tcp)
+
+
+class test_uct_tcp_get : public test_uct_tcp_pair {
+public:
+    static const uint64_t SEED = 0x2222222222222222lu;
+
+    void init() {
+        test_uct_tcp_pair::init();
+        check_caps_skip(UCT_IFACE_FLAG_GET_ZCOPY);
+    }
+
+    ucs_status_t get(mapped_buffer &recvbuf, const mapped_buffer &sendbuf,
+                     uct_completion_t *comp) {
+        ucs_status_t status;
+
+        UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, recvbuf.ptr(), recvbuf.length(),
+                                recvbuf.memh(),
+                                sender().iface_attr().cap.get.max_iov);
+
+        do {
+            status = uct_ep_get_zcopy(sender().ep(0), iov, iovcnt,
+                                      sendbuf.addr(), sendbuf.rkey(), comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        return status;
+    }
+
+    void flush() {
+        ucs_status_t status;
+
+        do {
+            progress();
+            status = uct_ep_flush(sender().ep(0), 0, NULL);
+        } while ((status == UCS_ERR_NO_RESOURCE) || (status == UCS_INPROGRESS));
+        ASSERT_UCS_OK(status);
+    }
+};
+
+UCS_TEST_P(test_uct_tcp_get, get_zcopy) {
+    const size_t lengths[] = { 0, 1, 1000, 64 * UCS_KBYTE, 4 * UCS_MBYTE };
+    ucs::ptr_vector<mapped_buffer> sendbufs, recvbufs;
+
+    for (size_t i = 0; i < ucs_static_array_size(lengths); ++i) {
+        sendbufs.push_back(new mapped_buffer(lengths[i], SEED + i,
+                                             receiver()));
+        recvbufs.push_back(new mapped_buffer(lengths[i], 0, sender()));
+    }
+
+    /* Post all requests at once to check the responses are matched in order */
+    for (size_t i = 0; i < ucs_static_array_size(lengths); ++i) {
+        post([&]() {
+            return get(recvbufs.at(i), sendbufs.at(i), &m_comp);
+        });
+    }
+
+    wait_for_completions();
+
+    for (size_t i = 0; i < ucs_static_array_size(lengths); ++i) {
+        recvbufs.at(i).pattern_check(SEED + i);
+    }
+}
+
+UCS_TEST_P(test_uct_tcp_get, get_zcopy_flush) {
+    const size_t num_gets = 32 / ucs::test_time_multiplier();
+    const size_t length   = 256 * UCS_KBYTE;
+    mapped_buffer sendbuf(length, SEED, receiver());
+    ucs::ptr_vector<mapped_buffer> recvbufs;
+
+    for (size_t i = 0; i < num_gets; ++i) {
+        recvbufs.push_back(new mapped_buffer(length, 0, sender()));
+        ucs_status_t status = get(recvbufs.at(i), sendbuf, NULL);
+        ASSERT_UCS_OK_OR_INPROGRESS(status);
+    }
+
+    /* Flush is completed by PUT ACK which the peer sends after the
+     * responses to all GET requests */
+    flush();
+
+    for (size_t i = 0; i < num_gets; ++i) {
+        recvbufs.at(i).pattern_check(SEED);
+    }
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_get, tcp)
+
+
+class test_uct_tcp_busy_poll : public test_uct_tcp_pair {
+public:
+    static const uint8_t AM_ID = 7;
+
+    void init() {
+        modify_config("TCP_BUSY_POLL_IDLE", "10s");
+        modify_config("TCP_BUSY_POLL_WAIT_INTERVAL", "4");
+        test_uct_tcp_pair::init();
+        set_am_handler(AM_ID);
+    }
+};
+
+UCS_TEST_P(test_uct_tcp_busy_poll, am_short) {
+    const size_t num_msgs = 1000 / ucs::test_time_multiplier();
+    uct_tcp_iface_t *iface = receiver_iface();
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        post([&]() {
+            return uct_ep_am_short(sender().ep(0), AM_ID, i, NULL, 0);
+        });
+
+        wait_for_value(&m_am_count, i + 1, true);
+        ASSERT_EQ(i + 1, m_am_count);
+    }
+
+    /* The receiving EP is busy-polled after the first message, so most of
+     * the progress calls must not wait for socket events */
+    EXPECT_FALSE(ucs_list_is_empty(&iface->busy_poll.ep_list));
+    EXPECT_GT(iface->counters.busy_poll_rx, 0ul);
+    EXPECT_GT(iface->counters.busy_poll_skip, 0ul);
+
+    /* Every progress call which did not skip the wait waited for socket
+     * events at least once */
+    ASSERT_GE(iface->counters.syscalls, iface->counters.busy_poll_rx);
+    unsigned long event_set_waits = iface->counters.syscalls -
+                                    iface->counters.busy_poll_rx;
+    EXPECT_GE(event_set_waits,
+              iface->counters.progress - iface->counters.busy_poll_skip);
+    EXPECT_LT(event_set_waits, iface->counters.progress);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_busy_poll, tcp)
+
+
+class test_uct_tcp_tx_coalesce : public test_uct_tcp_pair {
+public:
+    static const uint8_t AM_ID = 7;
+
+    test_uct_tcp_tx_coalesce() : m_am_order_errors(0) {
+    }
+
+    void init() {
+        modify_config("TCP_TX_COALESCE_THRESH", "256");
+        test_uct_tcp_pair::init();
+        set_am_handler(AM_ID);
+    }
+
+    static size_t pack_cb(void *dest, void *arg) {
+        *(uint64_t*)dest = *(uint64_t*)arg;
+        return sizeof(uint64_t);
+    }
+
+    void am_send(uint64_t sn) {
+        post([&]() {
+            ssize_t packed_len;
+
+            if (sn % 2) {
+                return uct_ep_am_short(sender().ep(0), AM_ID, sn, NULL, 0);
+            }
+
+            packed_len = uct_ep_am_bcopy(sender().ep(0), AM_ID, pack_cb, &sn,
+                                         0);
+            return (packed_len >= 0) ? UCS_OK : (ucs_status_t)packed_len;
+        });
+    }
+
+protected:
+    virtual void check_am(const void *data, size_t length) {
+        if (*(const uint64_t*)data != m_am_count) {
+            ++m_am_order_errors;
+        }
+    }
+
+    size_t m_am_order_errors;
+};
+
+UCS_TEST_P(test_uct_tcp_tx_coalesce, am_short_bcopy) {
+    const size_t num_msgs = 10000 / ucs::test_time_multiplier();
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        am_send(i);
+    }
+
+    flush();
+    wait_for_am_count(num_msgs);
+    EXPECT_EQ(0ul, m_am_order_errors);
+
+    /* Messages posted without progress are appended to the TX buffer */
+    EXPECT_GT(sender_iface()->counters.tx_coalesce, 0ul);
+    EXPECT_TRUE(ucs_list_is_empty(&sender_iface()->tx_coalesce_list));
+}
+
+UCS_TEST_P(test_uct_tcp_tx_coalesce, progress) {
+    const size_t num_msgs = 100;
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        am_send(i);
+        /* The coalesced messages are sent by the progress call */
+        wait_for_value(&m_am_count, i + 1, true);
+        ASSERT_EQ(i + 1, m_am_count);
+    }
+
+    EXPECT_EQ(0ul, m_am_order_errors);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_tx_coalesce, tcp)
+
+
+class test_uct_tcp_am_rx : public test_uct_tcp_pair {
+public:
+    static const uint8_t  AM_ID       = 11;
+    static const uint64_t SEED        = 0x4444444444444444lu;
+    static const size_t   MAX_PAYLOAD = UCS_KBYTE;
+
+    void init() {
+        /* Small segments, so a few messages fill the RX buffer */
+        modify_config("TCP_TX_SEG_SIZE", "1kb");
+        modify_config("TCP_RX_SEG_SIZE", "1kb");
+        test_uct_tcp_pair::init();
+        set_am_handler(AM_ID);
+
+        /* Wait for the connection establishment, so the receiver gets the
+         * stream written by the test without the connection messages */
+        wait_for_cond([&]() { return is_connected(); }, [&]() { progress(); });
+        ASSERT_TRUE(is_connected());
+    }
+
+    bool is_connected() {
+        uct_tcp_iface_t *iface = receiver_iface();
+        bool connected         = false;
+        uct_tcp_ep_t *ep;
+
+        if (sender_ep()->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED) {
+            return false;
+        }
+
+        UCS_ASYNC_BLOCK(iface->super.worker->async);
+        ucs_list_for_each(ep, &iface->ep_list, list) {
+            connected |= (ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED);
+        }
+        UCS_ASYNC_UNBLOCK(iface->super.worker->async);
+
+        return connected;
+    }
+
+    /* Append a message with a payload of the given length to the stream. The
+     * payload is a pattern which starts with the message sequence number */
+    void add_msg(size_t length) {
+        size_t offset = m_stream.size();
+        uct_tcp_am_hdr_t hdr;
+
+        ASSERT_LE(length, MAX_PAYLOAD);
+        hdr.am_id  = AM_ID;
+        hdr.length = length;
+        m_stream.resize(offset + sizeof(hdr) + length);
+        memcpy(&m_stream[offset], &hdr, sizeof(hdr));
+        mem_buffer::pattern_fill(&m_stream[offset + sizeof(hdr)], length,
+                                 SEED + m_lengths.size());
+        m_lengths.push_back(length);
+        m_msg_ends.push_back(m_stream.size());
+    }
+
+    /* Write the next part of the stream directly to the sender socket, to
+     * control how the receiver gets the stream split */
+    void send_stream(size_t length) {
+        ASSERT_LE(m_sent + length, m_stream.size());
+        ASSERT_UCS_OK(ucs_socket_send(sender_ep()->fd, &m_stream[m_sent],
+                                      length));
+        m_sent += length;
+    }
+
+    /* Wait until the receiver handles the given number of messages and keeps
+     * the given number of bytes of a partial message in the RX buffer */
+    void wait_for_rx(size_t am_count, size_t rx_remaining) {
+        wait_for_cond([&]() {
+                          return (m_am_count == am_count) &&
+                                 (get_rx_remaining() == rx_remaining);
+                      },
+                      [&]() { progress(); });
+        ASSERT_EQ(am_count, m_am_count);
+        ASSERT_EQ(rx_remaining, get_rx_remaining());
+        EXPECT_EQ(0ul, m_am_errors);
+    }
+
+    /* The receiver EP which has a partial message in its RX buffer */
+    uct_tcp_ep_t *get_rx_ep() {
+        uct_tcp_iface_t *iface = receiver_iface();
+        uct_tcp_ep_t *ep, *rx_ep = NULL;
+
+        UCS_ASYNC_BLOCK(iface->super.worker->async);
+        ucs_list_for_each(ep, &iface->ep_list, list) {
+            if (ep->rx.length > ep->rx.offset) {
+                rx_ep = ep;
+            }
+        }
+        UCS_ASYNC_UNBLOCK(iface->super.worker->async);
+
+        return rx_ep;
+    }
+
+    size_t get_rx_remaining() {
+        uct_tcp_ep_t *ep = get_rx_ep();
+        return (ep == NULL) ? 0 : (ep->rx.length - ep->rx.offset);
+    }
+
+    size_t rx_buf_size() {
+        return receiver_iface()->config.rx_seg_size * 2;
+    }
+
+protected:
+    test_uct_tcp_am_rx() : m_sent(0), m_am_errors(0) {
+    }
+
+    virtual void check_am(const void *data, size_t length) {
+        size_t sn = m_am_count;
+
+        if ((sn >= m_lengths.size()) || (length != m_lengths[sn])) {
+            ++m_am_errors;
+            return;
+        }
+
+        /* The pattern starts with the sequence number, so the check fails if
+         * the messages are reordered */
+        mem_buffer::pattern_check(data, length, SEED + sn);
+    }
+
+    std::vector<char>   m_stream;
+    std::vector<size_t> m_lengths;
+    std::vector<size_t> m_msg_ends;
+    size_t              m_sent;
+    size_t              m_am_errors;
+};
+
+const size_t test_uct_tcp_am_rx::MAX_PAYLOAD;
+
+UCS_TEST_P(test_uct_tcp_am_rx, many_msgs_one_recv) {
+    const size_t num_msgs = 16;
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        add_msg(i * 7 + 1);
+    }
+    ASSERT_LE(m_stream.size(), rx_buf_size());
+
+    send_stream(m_stream.size());
+    wait_for_rx(num_msgs, 0);
+}
+
+UCS_TEST_P(test_uct_tcp_am_rx, partial_hdr) {
+    add_msg(100);
+    add_msg(200);
+    add_msg(0);
+
+    /* The first message and a part of the second message header */
+    send_stream(sizeof(uct_tcp_am_hdr_t) + 100 + 2);
+    wait_for_rx(1, 2);
+
+    /* The rest of the header only */
+    send_stream(sizeof(uct_tcp_am_hdr_t) - 2);
+    wait_for_rx(1, sizeof(uct_tcp_am_hdr_t));
+
+    send_stream(m_stream.size() - m_sent);
+    wait_for_rx(3, 0);
+}
+
+UCS_TEST_P(test_uct_tcp_am_rx, partial_payload) {
+    const size_t hdr_size = sizeof(uct_tcp_am_hdr_t);
+
+    add_msg(MAX_PAYLOAD);
+    add_msg(10);
+
+    /* The payload is received byte by byte for a part of it */
+    send_stream(hdr_size + 1);
+    wait_for_rx(0, hdr_size + 1);
+    for (size_t i = 2; i < 10; ++i) {
+        send_stream(1);
+        wait_for_rx(0, hdr_size + i);
+    }
+
+    /* The rest of the first message together with the second one */
+    send_stream(m_stream.size() - m_sent);
+    wait_for_rx(2, 0);
+}
+
+UCS_TEST_P(test_uct_tcp_am_rx, partial_wrap) {
+    const size_t hdr_size   = sizeof(uct_tcp_am_hdr_t);
+    const size_t small_size = 100;
+    size_t num_small_msgs, partial_offset;
+    uct_tcp_ep_t *ep;
+
+    /* Fill the RX buffer with small messages, so a message of the maximal
+     * size which follows them does not fit before the end of the buffer */
+    num_small_msgs = (rx_buf_size() - receiver_iface()->config.rx_seg_size) /
+                     (hdr_size + small_size) + 1;
+    for (size_t i = 0; i < num_small_msgs; ++i) {
+        add_msg(small_size);
+    }
+
+    partial_offset = m_stream.size();
+    add_msg(MAX_PAYLOAD);
+    add_msg(1);
+    ASSERT_LE(partial_offset + hdr_size + small_size, rx_buf_size());
+
+    send_stream(partial_offset + hdr_size + small_size);
+    wait_for_rx(num_small_msgs, hdr_size + small_size);
+    ep = get_rx_ep();
+    ASSERT_TRUE(ep != NULL);
+    EXPECT_EQ(partial_offset, ep->rx.offset);
+
+    /* The partial message is moved to the beginning of the buffer before the
+     * next receive */
+    send_stream(small_size);
+    wait_for_rx(num_small_msgs, hdr_size + (2 * small_size));
+    ep = get_rx_ep();
+    ASSERT_TRUE(ep != NULL);
+    EXPECT_EQ(0ul, ep->rx.offset);
+
+    send_stream(m_stream.size() - m_sent);
+    wait_for_rx(num_small_msgs + 2, 0);
+}
+
+UCS_TEST_P(test_uct_tcp_am_rx, random_split) {
+    const size_t num_msgs = 1000 / ucs::test_time_multiplier();
+    size_t length, am_count, msg_end;
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        add_msg(ucs::rand() % (MAX_PAYLOAD + 1));
+    }
+
+    /* Send the stream in parts of random length, and check the receiver
+     * handles the messages which are complete and keeps the rest */
+    while (m_sent < m_stream.size()) {
+        length = ucs_min(ucs::rand() % (2 * rx_buf_size()) + 1,
+                         m_stream.size() - m_sent);
+        send_stream(length);
+
+        am_count = std::upper_bound(m_msg_ends.begin(), m_msg_ends.end(),
+                                    m_sent) - m_msg_ends.begin();
+        msg_end  = (am_count == 0) ? 0 : m_msg_ends[am_count - 1];
+        wait_for_rx(am_count, m_sent - msg_end);
+    }
+
+    EXPECT_EQ(num_msgs, m_am_count);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_am_rx, tcp)
+
+
+class test_uct_tcp_io_uring : public test_uct_tcp_pair {
+public:
+    static const uint8_t  AM_ID = 13;
+    static const uint64_t SEED  = 0x5555555555555555lu;
+
+    test_uct_tcp_io_uring() : m_am_errors(0) {
+    }
+
+    void init() {
+        ucs_sys_event_set_t *event_set;
+        ucs_status_t status;
+
+        status = ucs_event_set_create_io_uring(&event_set);
+        if (status == UCS_ERR_UNSUPPORTED) {
+            UCS_TEST_SKIP_R("io_uring is not supported");
+        }
+
+        ASSERT_UCS_OK(status);
+        ucs_event_set_cleanup(event_set);
+
+        modify_config("TCP_IO_URING", "y");
+        test_uct_tcp_pair::init();
+        set_am_handler(AM_ID);
+    }
+
+    static size_t pack_cb(void *dest, void *arg) {
+        const std::vector<char> *buf = (const std::vector<char>*)arg;
+
+        memcpy(dest, &(*buf)[0], buf->size());
+        return buf->size();
+    }
+
+protected:
+    virtual void check_am(const void *data, size_t length) {
+        /* The pattern starts with the sequence number of the message */
+        if (length < sizeof(uint64_t)) {
+            ++m_am_errors;
+            return;
+        }
+
+        mem_buffer::pattern_check(data, length, SEED + m_am_count);
+    }
+
+    size_t m_am_errors;
+};
+
+UCS_TEST_P(test_uct_tcp_io_uring, am_bcopy) {
+    const size_t num_msgs   = 1000 / ucs::test_time_multiplier();
+    const size_t max_length = sender().iface_attr().cap.am.max_bcopy;
+    std::vector<char> buf;
+
+    for (size_t i = 0; i < num_msgs; ++i) {
+        buf.resize(sizeof(uint64_t) +
+                   (ucs::rand() % (max_length - sizeof(uint64_t) + 1)));
+        mem_buffer::pattern_fill(&buf[0], buf.size(), SEED + i);
+        post([&]() {
+            ssize_t packed_len = uct_ep_am_bcopy(sender().ep(0), AM_ID,
+                                                 pack_cb, &buf, 0);
+            return (packed_len >= 0) ? UCS_OK : (ucs_status_t)packed_len;
+        });
+    }
+
+    wait_for_am_count(num_msgs);
+    EXPECT_EQ(0ul, m_am_errors);
+}
+
+UCS_TEST_P(test_uct_tcp_io_uring, put_zcopy) {
+    const size_t length = UCS_MBYTE;
+
+    check_caps_skip(UCT_IFACE_FLAG_PUT_ZCOPY);
+
+    mapped_buffer sendbuf(length, SEED, sender());
+    mapped_buffer recvbuf(length, 0, receiver());
+
+    UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, sendbuf.ptr(), sendbuf.length(),
+                            sendbuf.memh(), 1);
+
+    post([&]() {
+        return uct_ep_put_zcopy(sender().ep(0), iov, iovcnt, recvbuf.addr(),
+                                recvbuf.rkey(), &m_comp);
+    });
+    post([&]() {
+        return uct_ep_flush(sender().ep(0), 0, &m_comp);
+    });
+
+    wait_for_completions();
+    recvbuf.pattern_check(SEED);
+}
+
+UCS_TEST_P(test_uct_tcp_io_uring, get_zcopy) {
+    const size_t length = UCS_MBYTE;
+
+    check_caps_skip(UCT_IFACE_FLAG_GET_ZCOPY);
+
+    mapped_buffer sendbuf(length, SEED, receiver());
+    mapped_buffer recvbuf(length, 0, sender());
+
+    UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, recvbuf.ptr(), recvbuf.length(),
+                            recvbuf.memh(), 1);
+
+    post([&]() {
+        return uct_ep_get_zcopy(sender().ep(0), iov, iovcnt, sendbuf.addr(),
+                                sendbuf.rkey(), &m_comp);
+    });
+
+    wait_for_completions();
+    recvbuf.pattern_check(SEED);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_io_uring, tcp)
+
+
+class test_uct_tcp_conn : public test_uct_tcp_pair {
+public:
+    static const uint8_t AM_ID = 9;
+
+    void init() {
+        uct_test::init();
+
+        /* The endpoints are connected by the test */
+        m_entities.push_back(uct_test::create_entity(0));
+        m_entities.push_back(uct_test::create_entity(0));
+        set_am_handler(AM_ID);
+    }
+
+    uct_tcp_ep_t *sender_ep(unsigned index) {
+        return ucs_derived_of(sender().ep(index), uct_tcp_ep_t);
+    }
+
+    bool is_connected(unsigned index) {
+        return sender_ep(index)->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED;
+    }
+
+    void check_fast_open(unsigned index, bool expected) {
+#ifdef TCP_FASTOPEN_CONNECT
+        int optval = 0;
+
+        ASSERT_UCS_OK(ucs_socket_getopt(sender_ep(index)->fd, IPPROTO_TCP,
+                                        TCP_FASTOPEN_CONNECT, &optval,
+                                        sizeof(optval)));
+        EXPECT_EQ(expected, optval != 0) << "ep " << index;
+#endif
+    }
+
+    /* Measure the time to fully connect many endpoints to the same peer, and
+     * check every endpoint delivers data */
+    void test_connect_many(bool fast_open) {
+        const unsigned num_eps = ucs_min(ucs_min(1000, max_connections()),
+                                         max_connect_batch()) /
+                                 ucs::test_time_multiplier();
+        ucs_time_t start_time, deadline;
+        double elapsed_ms;
+
+        /* With "try", fast open is disabled if the system does not support
+         * it */
+        fast_open = fast_open && (sender_iface()->config.conn_fast_open !=
+                                  UCS_NO);
+        m_recv_eps.assign(num_eps, false);
+
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < num_eps; ++i) {
+            sender().connect_to_iface(i, receiver());
+        }
+
+        deadline = ucs::get_deadline();
+        for (unsigned i = 0; i < num_eps;) {
+            if (is_connected(i)) {
+                ++i;
+            } else {
+                ASSERT_LT(ucs_get_time(), deadline)
+                        << "ep " << i << " is not connected";
+                progress();
+            }
+        }
+
+        elapsed_ms = ucs_time_to_msec(ucs_get_time() - start_time);
+        UCS_TEST_MESSAGE << num_eps << " endpoints connected in "
+                         << elapsed_ms << " ms";
+
+        for (unsigned i = 0; i < num_eps; ++i) {
+            check_fast_open(i, fast_open);
+            post([&]() {
+                return uct_ep_am_short(sender().ep(i), AM_ID, i, NULL, 0);
+            });
+        }
+
+        wait_for_am_count(num_eps);
+        EXPECT_EQ(num_eps, std::count(m_recv_eps.begin(), m_recv_eps.end(),
+                                      true));
+    }
+
+protected:
+    virtual void check_am(const void *data, size_t length) {
+        uint64_t index = *(const uint64_t*)data;
+
+        ASSERT_EQ(sizeof(index), length);
+        ASSERT_LT(index, m_recv_eps.size());
+        EXPECT_FALSE(m_recv_eps[index]) << "ep " << index;
+        m_recv_eps[index] = true;
+    }
+
+    std::vector<bool> m_recv_eps;
+};
+
+UCS_TEST_P(test_uct_tcp_conn, connect_many) {
+    test_connect_many(false);
+}
+
+UCS_TEST_P(test_uct_tcp_conn, connect_many_nb, "TCP_CONN_NB=y") {
+    test_connect_many(false);
+}
+
+UCS_TEST_P(test_uct_tcp_conn, connect_many_fast_open, "TCP_CONN_NB=y",
+           "TCP_CONN_FAST_OPEN=try") {
+    test_connect_many(true);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_conn, tcp)
+
+
+class test_uct_tcp_file_put : public test_uct_tcp_pair {
+public:
+    static const uint64_t SEED       = 0x3333333333333333lu;
+    static const size_t   CHUNK_SIZE = 256 * UCS_KBYTE;
+
+    test_uct_tcp_file_put() : m_fd(-1), m_file_ptr(MAP_FAILED), m_length(0),
+                              m_memh(UCT_MEM_HANDLE_NULL) {
+    }
+
+    void init() {
+        test_uct_tcp_pair::init();
+        check_caps_skip(UCT_IFACE_FLAG_PUT_ZCOPY);
+
+        uct_md_attr_v2_t md_attr;
+        md_attr.field_mask = UCT_MD_ATTR_FIELD_FLAGS;
+        ASSERT_UCS_OK(uct_md_query_v2(sender().md(), &md_attr));
+        if (!(md_attr.flags & UCT_MD_FLAG_REG_FILE)) {
+            UCS_TEST_SKIP_R("registration of files is not supported");
+        }
+
+        create_file(32 * UCS_MBYTE / ucs::test_time_multiplier());
+    }
+
+    void cleanup() {
+        if (m_memh != UCT_MEM_HANDLE_NULL) {
+            uct_md_mem_dereg(sender().md(), m_memh);
+        }
+        if (m_file_ptr != MAP_FAILED) {
+            munmap(m_file_ptr, m_length);
+        }
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+
+        test_uct_tcp_pair::cleanup();
+    }
+
+    void create_file(size_t length) {
+        char path[] = "/tmp/uct_tcp_file_put_XXXXXX";
+        std::vector<char> buf(CHUNK_SIZE);
+
+        m_fd = mkstemp(path);
+        ASSERT_GE(m_fd, 0) << strerror(errno);
+        unlink(path);
+
+        for (size_t offset = 0; offset < length; offset += buf.size()) {
+            mem_buffer::pattern_fill(&buf[0], buf.size(), SEED + offset);
+            ASSERT_EQ((ssize_t)buf.size(), write(m_fd, &buf[0], buf.size()));
+        }
+
+        m_length   = length;
+        m_file_ptr = mmap(NULL, m_length, PROT_READ, MAP_SHARED, m_fd, 0);
+        ASSERT_NE(MAP_FAILED, m_file_ptr) << strerror(errno);
+
+        uct_md_mem_reg_params_t params;
+        params.field_mask = UCT_MD_MEM_REG_FIELD_FILE_FD;
+        params.file_fd    = m_fd;
+        ASSERT_UCS_OK(uct_md_mem_reg_v2(sender().md(), m_file_ptr, m_length,
+                                        &params, &m_memh));
+    }
+
+    void put(void *buffer, uct_mem_h memh, size_t length,
+             uint64_t remote_addr, uct_rkey_t rkey) {
+        uct_iov_t iov;
+
+        iov.buffer = buffer;
+        iov.length = length;
+        iov.memh   = memh;
+        iov.stride = 0;
+        iov.count  = 1;
+
+        post([&]() {
+            return uct_ep_put_zcopy(sender().ep(0), &iov, 1, remote_addr, rkey,
+                                    &m_comp);
+        });
+    }
+
+    /* Send the whole file to the receiver buffer and return the time it took,
+     * either from the registered file, or by reading every chunk of the file
+     * to a buffer and sending the buffer */
+    double send_file(mapped_buffer &recvbuf, bool from_file) {
+        std::vector<char> read_buf(from_file ? 0 : m_length);
+        ucs_time_t start_time = ucs_get_time();
+        void *buffer;
+
+        for (size_t offset = 0; offset < m_length; offset += CHUNK_SIZE) {
+            if (from_file) {
+                buffer = UCS_PTR_BYTE_OFFSET(m_file_ptr, offset);
+            } else {
+                buffer = &read_buf[offset];
+                EXPECT_EQ((ssize_t)CHUNK_SIZE,
+                          pread(m_fd, buffer, CHUNK_SIZE, offset));
+            }
+
+            put(buffer, from_file ? m_memh : UCT_MEM_HANDLE_NULL, CHUNK_SIZE,
+                recvbuf.addr() + offset, recvbuf.rkey());
+        }
+
+        wait_for_completions();
+        return ucs_time_to_sec(ucs_get_time() - start_time);
+    }
+
+    void check_recv_data(const mapped_buffer &recvbuf) {
+        for (size_t offset = 0; offset < m_length; offset += CHUNK_SIZE) {
+            mem_buffer::pattern_check(UCS_PTR_BYTE_OFFSET(recvbuf.ptr(),
+                                                          offset),
+                                      CHUNK_SIZE, SEED + offset);
+        }
+    }
+
+protected:
+    int       m_fd;
+    void      *m_file_ptr;
+    size_t    m_length;
+    uct_mem_h m_memh;
+};
+
+UCS_TEST_P(test_uct_tcp_file_put, put_zcopy) {
+    mapped_buffer recvbuf(m_length, 0, receiver());
+    double file_time, read_time;
+
+    file_time = send_file(recvbuf, true);
+    check_recv_data(recvbuf);
+
+    recvbuf.memset(0);
+    read_time = send_file(recvbuf, false);
+    check_recv_data(recvbuf);
+
+    UCS_TEST_MESSAGE << "sent " << m_length / UCS_MBYTE << " MB: sendfile "
+                     << m_length / file_time / UCS_MBYTE << " MB/s, read+send "
+                     << m_length / read_time / UCS_MBYTE << " MB/s";
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_file_put, tcp)
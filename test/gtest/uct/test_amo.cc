@@ -116,9 +116,9 @@ void uct_amo_test::validate_replies(const std::vector<uint64_t>& exp_replies) {
 }
 
 void uct_amo_test::wait_for_remote() {
-    for (unsigned i = 0; i < num_senders(); ++i) {
-        sender(i).flush();
-    }
+    /* Progress the receiver as well, since it performs the operations in
+     * software on some transports */
+    flush();
 }
 
 void uct_amo_test::run_workers(send_func_t send, const mapped_buffer& recvbuf,
@@ -131,7 +131,12 @@ void uct_amo_test::run_workers(send_func_t send, const mapped_buffer& recvbuf,
                                        initial_values[i], advance));
     }
 
+    /* Progress the receiver while the workers are running, since it may have
+     * to perform the operations in software and send back the replies */
     for (unsigned i = 0; i < num_senders(); ++i) {
+        while (!m_workers.at(i).done) {
+            receiver().progress();
+        }
         m_workers.at(i).join();
     }
 }
@@ -139,7 +144,7 @@ void uct_amo_test::run_workers(send_func_t send, const mapped_buffer& recvbuf,
 uct_amo_test::worker::worker(uct_amo_test* test, send_func_t send,
                              const mapped_buffer& recvbuf, const entity& entity,
                              uint64_t initial_value, bool advance) :
-    test(test), value(initial_value), count(0), running(true),
+    test(test), value(initial_value), count(0), running(true), done(false),
     m_send(send), m_advance(advance), m_recvbuf(recvbuf), m_entity(entity)
 
 {
@@ -192,6 +197,8 @@ void uct_amo_test::worker::run() {
             value = hash64(value);
         }
     }
+
+    done = true;
 }
 
 void uct_amo_test::worker::join() {
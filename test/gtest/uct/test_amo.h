@@ -67,6 +67,7 @@ public:
         uint64_t            value;
         unsigned            count;
         bool                running;
+        volatile bool       done;
 
     private:
         void run();
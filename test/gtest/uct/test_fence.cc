@@ -60,8 +60,8 @@ public:
                const mapped_buffer& recvbuf,
                const entity& entity, uct_atomic_op_t op, uint32_t* error) :
             test(test), value(0), result32(0), result64(0),
-            error(error), running(true), op(op), m_send(send), m_recv(recv),
-            m_recvbuf(recvbuf), m_entity(entity) {
+            error(error), running(true), done(false), op(op), m_send(send),
+            m_recv(recv), m_recvbuf(recvbuf), m_entity(entity) {
             pthread_create(&m_thread, NULL, run, reinterpret_cast<void*>(this));
         }
 
@@ -103,6 +103,7 @@ public:
         uint64_t result64;
         uint32_t* error;
         bool running;
+        volatile bool done;
         uct_atomic_op_t op;
 
     private:
@@ -122,10 +123,16 @@ public:
                 }
                 value = local_val;
 
-                (test->*m_send)(m_entity.ep(0), *this, m_recvbuf);
+                /* Retry while the endpoint is not connected yet */
+                while ((test->*m_send)(m_entity.ep(0), *this, m_recvbuf) ==
+                       UCS_ERR_NO_RESOURCE) {
+                    m_entity.progress();
+                }
                 uct_ep_fence(m_entity.ep(0), 0);
-                (test->*m_recv)(m_entity.ep(0), *this,
-                                m_recvbuf, &uct_comp);
+                while ((test->*m_recv)(m_entity.ep(0), *this, m_recvbuf,
+                                       &uct_comp) == UCS_ERR_NO_RESOURCE) {
+                    m_entity.progress();
+                }
                 m_entity.flush();
 
                 uint64_t result = (m_recvbuf.length() == sizeof(uint32_t)) ?
@@ -138,6 +145,8 @@ public:
                 result32 = 0;
                 result64 = 0;
             }
+
+            done = true;
         }
 
         send_func_t m_send;
@@ -154,6 +163,12 @@ public:
         m_workers.clear();
         m_workers.push_back(new worker(this, send, recv, recvbuf,
                                        sender(), OP, error));
+        /* Progress the receiver while the worker is running, since it may
+         * have to perform the operations in software and send back the
+         * replies */
+        while (!m_workers.at(0).done) {
+            receiver().progress();
+        }
         m_workers.at(0).join();
         m_workers.clear();
     }
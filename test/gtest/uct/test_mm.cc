@@ -7,6 +7,7 @@
 extern "C" {
 #include <uct/api/uct.h>
 #include <uct/sm/mm/base/mm_md.h>
+#include <uct/sm/mm/base/mm_ep.h>
 #include <ucs/time/time.h>
 }
 #include "uct_p2p_test.h"
@@ -187,6 +188,45 @@ public:
         test_rkey(ptr, memh, size);
     }
 
+    uct_mm_ep_t *mm_ep(entity *e) {
+        return ucs_derived_of(e->ep(0), uct_mm_ep_t);
+    }
+
+    /* Send a message to the armed receiver and check it wakes up */
+    void test_wakeup() {
+        static const unsigned num_msgs = 10;
+        uint64_t send_data             = 0xdeadbeef;
+        uct_test::async_event_ctx event_ctx;
+        ucs_status_t status;
+        recv_desc_t *recv_buffer;
+
+        recv_buffer = (recv_desc_t*)malloc(sizeof(*recv_buffer) +
+                                           sizeof(uint64_t));
+        uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_handler, recv_buffer,
+                                 0);
+
+        for (unsigned i = 0; i < num_msgs; ++i) {
+            recv_buffer->length = 0;
+
+            do {
+                m_e2->progress();
+                status = uct_iface_event_arm(m_e2->iface(), UCT_EVENT_RECV);
+            } while (status == UCS_ERR_BUSY);
+            ASSERT_UCS_OK(status);
+            EXPECT_FALSE(event_ctx.wait_for_event(*m_e2, 0));
+
+            status = uct_ep_am_short(m_e1->ep(0), 0, 0xbeef, &send_data,
+                                     sizeof(send_data));
+            ASSERT_UCS_OK(status);
+
+            EXPECT_TRUE(event_ctx.wait_for_event(*m_e2, 10));
+            wait_for_flag(&recv_buffer->length);
+            EXPECT_EQ(sizeof(send_data), recv_buffer->length);
+        }
+
+        free(recv_buffer);
+    }
+
 protected:
     entity *m_e1, *m_e2;
 };
@@ -269,4 +309,229 @@ UCS_TEST_SKIP_COND_P(test_uct_mm, reg,
     ASSERT_UCS_OK(status);
 }
 
+UCS_TEST_SKIP_COND_P(test_uct_mm, wakeup_eventfd,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC) ||
+                     !check_event_caps(UCT_IFACE_FLAG_EVENT_RECV))
+{
+    /* the sender duplicates the receiver's eventfd, unless the system does not
+     * support it */
+    if (mm_ep(m_e1)->signal_eventfd == -1) {
+        UCS_TEST_MESSAGE << "eventfd is not available, using the socket";
+    }
+
+    test_wakeup();
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, wakeup_socket,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC) ||
+                     !check_event_caps(UCT_IFACE_FLAG_EVENT_RECV),
+                     "MM_EVENTFD_WAKEUP=n")
+{
+    EXPECT_EQ(-1, mm_ep(m_e1)->signal_eventfd);
+    test_wakeup();
+}
+
 UCT_INSTANTIATE_MM_TEST_CASE(test_uct_mm)
+
+
+class test_uct_mm_fifo_lanes : public uct_test {
+public:
+    static const uint8_t  AM_ID       = 1;
+    static const unsigned NUM_SENDERS = 8;
+    static const size_t   BCOPY_SIZE  = 256;
+
+    test_uct_mm_fifo_lanes() : m_receiver(NULL), m_am_count(0) {
+    }
+
+    virtual void init() {
+        uct_test::init();
+
+        m_receiver = uct_test::create_entity(0);
+        m_entities.push_back(m_receiver);
+
+        check_skip_test();
+
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            entity *sender = uct_test::create_entity(0);
+            m_entities.push_back(sender);
+            sender->connect_to_iface(0, *m_receiver);
+        }
+
+        m_send_sn.resize(NUM_SENDERS, 0);
+        m_recv_sn.resize(NUM_SENDERS, 0);
+
+        ucs_status_t status = uct_iface_set_am_handler(m_receiver->iface(),
+                                                       AM_ID, am_handler,
+                                                       this, 0);
+        ASSERT_UCS_OK(status);
+    }
+
+    entity& sender(unsigned index) {
+        return m_entities.at(1 + index);
+    }
+
+    uct_mm_ep_t *sender_ep(unsigned index) {
+        return ucs_derived_of(sender(index).ep(0), uct_mm_ep_t);
+    }
+
+    unsigned num_lanes() {
+        return ucs_derived_of(m_receiver->iface(),
+                              uct_mm_iface_t)->config.fifo_lanes;
+    }
+
+    unsigned num_lane_owners() {
+        unsigned count = 0;
+
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            count += (sender_ep(i)->lane_ctl != NULL);
+        }
+
+        return count;
+    }
+
+    /* Number of senders which already moved from the shared FIFO to a lane */
+    unsigned num_lane_senders() {
+        unsigned count = 0;
+
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            count += (sender_ep(i)->lane_ctl != NULL) &&
+                     (sender_ep(i)->fifo_ctl == sender_ep(i)->lane_ctl);
+        }
+
+        return count;
+    }
+
+    static size_t pack_cb(void *dest, void *arg) {
+        memset(dest, 0, BCOPY_SIZE);
+        *(uint64_t*)dest = *(uint64_t*)arg;
+        return BCOPY_SIZE;
+    }
+
+    ucs_status_t send(unsigned index, bool bcopy) {
+        uint64_t hdr = ((uint64_t)index << 32) | m_send_sn[index];
+        ssize_t packed_len;
+
+        if (!bcopy) {
+            return uct_ep_am_short(sender(index).ep(0), AM_ID, hdr, NULL, 0);
+        }
+
+        packed_len = uct_ep_am_bcopy(sender(index).ep(0), AM_ID, pack_cb, &hdr,
+                                     0);
+        return (packed_len >= 0) ? UCS_OK : (ucs_status_t)packed_len;
+    }
+
+    /* Send from all senders in turn, so their messages are interleaved in the
+     * shared FIFO, and check every sender's messages arrive in order */
+    void send_all(unsigned num_msgs) {
+        size_t expected_count = m_am_count + (num_msgs * NUM_SENDERS);
+        ucs_status_t status;
+
+        for (unsigned n = 0; n < num_msgs; ++n) {
+            for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+                while ((status = send(i, n % 2)) == UCS_ERR_NO_RESOURCE) {
+                    progress();
+                }
+                ASSERT_UCS_OK(status);
+                ++m_send_sn[i];
+            }
+        }
+
+        wait_for_value(&m_am_count, expected_count, true);
+        EXPECT_EQ(expected_count, m_am_count);
+    }
+
+private:
+    static ucs_status_t
+    am_handler(void *arg, void *data, size_t length, unsigned flags) {
+        test_uct_mm_fifo_lanes *self = static_cast<test_uct_mm_fifo_lanes*>(
+                arg);
+        uint64_t hdr                 = *(uint64_t*)data;
+        unsigned index               = hdr >> 32;
+
+        EXPECT_LT(index, (unsigned)NUM_SENDERS);
+        EXPECT_EQ(self->m_recv_sn.at(index), hdr & UCS_MASK(32))
+                << "sender " << index;
+        self->m_recv_sn.at(index) = (hdr & UCS_MASK(32)) + 1;
+        ++self->m_am_count;
+        return UCS_OK;
+    }
+
+protected:
+    entity                *m_receiver;
+    std::vector<uint32_t> m_send_sn;
+    std::vector<uint32_t> m_recv_sn;
+    volatile size_t       m_am_count;
+};
+
+UCS_TEST_P(test_uct_mm_fifo_lanes, many_to_one, "MM_FIFO_LANES=4",
+           "MM_FIFO_LANE_SIZE=8")
+{
+    /* Only some of the senders get a lane, the rest use the shared FIFO */
+    EXPECT_EQ(num_lanes(), num_lane_owners());
+    send_all(1000 / ucs::test_time_multiplier());
+}
+
+UCS_TEST_P(test_uct_mm_fifo_lanes, lane_per_sender, "MM_FIFO_LANES=8")
+{
+    EXPECT_EQ((unsigned)NUM_SENDERS, num_lane_owners());
+    send_all(1000 / ucs::test_time_multiplier());
+    EXPECT_EQ((unsigned)NUM_SENDERS, num_lane_senders());
+}
+
+UCS_TEST_P(test_uct_mm_fifo_lanes, reuse_lanes, "MM_FIFO_LANES=4",
+           "MM_FIFO_LANE_SIZE=8")
+{
+    send_all(100);
+
+    /* Reconnect the senders which own lanes, to check the lanes are released
+     * and claimed again, and all the messages still arrive in order */
+    for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+        if (sender_ep(i)->lane_ctl != NULL) {
+            sender(i).destroy_ep(0);
+            sender(i).connect_to_iface(0, *m_receiver);
+            EXPECT_TRUE(sender_ep(i)->lane_ctl != NULL);
+        }
+    }
+
+    EXPECT_EQ(num_lanes(), num_lane_owners());
+    send_all(100);
+}
+
+UCS_TEST_P(test_uct_mm_fifo_lanes, lane_size_mismatch, "MM_FIFO_LANES=8")
+{
+    /* Free a lane, and connect a sender whose lane size differs from the
+     * receiver's, so it would locate the lanes wrong */
+    sender(0).destroy_ep(0);
+    modify_config("MM_FIFO_LANE_SIZE", "64");
+    entity *other = uct_test::create_entity(0);
+    m_entities.push_back(other);
+    other->connect_to_iface(0, *m_receiver);
+
+    uct_mm_ep_t *other_ep = ucs_derived_of(other->ep(0), uct_mm_ep_t);
+    EXPECT_TRUE(other_ep->lane_ctl == NULL);
+
+    /* The sender uses the shared FIFO instead, send on behalf of sender 0 */
+    size_t expected_count = m_am_count + 100;
+    for (unsigned n = 0; n < 100; ++n) {
+        uint64_t hdr = m_send_sn[0];
+        ucs_status_t status;
+
+        while ((status = uct_ep_am_short(other->ep(0), AM_ID, hdr, NULL,
+                                         0)) == UCS_ERR_NO_RESOURCE) {
+            progress();
+        }
+        ASSERT_UCS_OK(status);
+        ++m_send_sn[0];
+    }
+
+    wait_for_value(&m_am_count, expected_count, true);
+    EXPECT_EQ(expected_count, m_am_count);
+
+    /* The lane is still free for a sender with a matching configuration */
+    sender(0).connect_to_iface(0, *m_receiver);
+    EXPECT_TRUE(sender_ep(0)->lane_ctl != NULL);
+}
+
+UCT_INSTANTIATE_MM_TEST_CASE(test_uct_mm_fifo_lanes)
@@ -7,9 +7,12 @@
 #include "test_p2p_rma.h"
 
 #include <functional>
+#include <ucs/sys/ptr_arith.h>
+#include <sys/mman.h>
 
 
-uct_p2p_rma_test::uct_p2p_rma_test() : uct_p2p_test(0) {
+uct_p2p_rma_test::uct_p2p_rma_test(uct_error_handler_t err_handler) :
+    uct_p2p_test(0, err_handler) {
 }
 
 ucs_status_t uct_p2p_rma_test::put_short(uct_ep_h ep, const mapped_buffer &sendbuf,
@@ -170,3 +173,152 @@ UCS_TEST_SKIP_COND_P(test_p2p_rma_madvise, madvise,
 }
 
 UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_madvise)
+
+class test_p2p_rma_scopy_mt : public uct_p2p_rma_test {
+public:
+    test_p2p_rma_scopy_mt() : uct_p2p_rma_test(error_handler) {
+    }
+
+    void init() {
+        /* Split operations of 64k or more to 16k segments */
+        modify_config("SCOPY_SEG_SIZE", "16k");
+        modify_config("SCOPY_TX_THREADS", "2");
+        modify_config("SCOPY_TX_THREADS_THRESH", "64k");
+        uct_p2p_rma_test::init();
+    }
+
+protected:
+    /* Fixed sizes, since test_xfer_multi() may trim the maximal size below
+     * the threshold of the helper threads */
+    void test_xfer_sizes(send_func_t send, unsigned flags) {
+        static const size_t lengths[] = {64 * UCS_KBYTE, 64 * UCS_KBYTE + 1,
+                                         UCS_MBYTE + 123, 4 * UCS_MBYTE};
+
+        for (size_t length : lengths) {
+            test_xfer(send, length, flags, UCS_MEMORY_TYPE_HOST);
+        }
+    }
+
+    static ucs_status_t
+    error_handler(void *arg, uct_ep_h ep, ucs_status_t status) {
+        return UCS_OK;
+    }
+
+    struct tx_comp {
+        uct_completion_t uct;
+        volatile bool    done;
+    };
+
+    static void tx_comp_cb(uct_completion_t *self) {
+        ucs_container_of(self, tx_comp, uct)->done = true;
+    }
+
+    ucs_status_t put_zcopy(const mapped_buffer &sendbuf, uintptr_t remote_addr,
+                           uct_rkey_t rkey, tx_comp *comp) {
+        UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, sendbuf.ptr(), sendbuf.length(),
+                                sendbuf.memh(),
+                                sender().iface_attr().cap.put.max_iov);
+
+        comp->uct.func   = tx_comp_cb;
+        comp->uct.count  = 1;
+        comp->uct.status = UCS_OK;
+        comp->done       = false;
+        return uct_ep_put_zcopy(sender_ep(), iov, iovcnt, remote_addr, rkey,
+                                &comp->uct);
+    }
+};
+
+UCS_TEST_P(test_p2p_rma_scopy_mt, put_zcopy) {
+    test_xfer_sizes(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+UCS_TEST_P(test_p2p_rma_scopy_mt, get_zcopy) {
+    test_xfer_sizes(static_cast<send_func_t>(&uct_p2p_rma_test::get_zcopy),
+                    TEST_UCT_FLAG_RECV_ZCOPY);
+}
+
+UCS_TEST_P(test_p2p_rma_scopy_mt, destroy_ep_inflight) {
+    static const size_t length = 16 * UCS_MBYTE;
+    mapped_buffer sendbuf(length, 1, sender());
+    mapped_buffer recvbuf(length, 2, receiver());
+    tx_comp comp;
+
+    ucs_status_t status = put_zcopy(sendbuf, recvbuf.addr(), recvbuf.rkey(),
+                                    &comp);
+    ASSERT_UCS_OK_OR_INPROGRESS(status);
+
+    /* Helper threads are still copying the segments of the operation */
+    sender().destroy_ep(0);
+
+    if (status == UCS_INPROGRESS) {
+        EXPECT_TRUE(comp.done);
+        EXPECT_EQ(UCS_ERR_CANCELED, comp.uct.status);
+    }
+}
+
+UCS_TEST_P(test_p2p_rma_scopy_mt, put_zcopy_fault) {
+    static const size_t length = 1 * UCS_MBYTE;
+    size_t page_size           = ucs_get_page_size();
+    mapped_buffer sendbuf(length, 1, sender());
+    mapped_buffer recvbuf(length + page_size, 0, receiver());
+    tx_comp comp;
+
+    /* Make the last segments of the remote buffer inaccessible, so a helper
+     * thread fails and the failed segment is repeated from progress */
+    uintptr_t remote_addr = ucs_align_up_pow2(recvbuf.addr(), page_size);
+    void *fault_addr      = (void*)(remote_addr + (length / 2));
+    ASSERT_EQ(0, mprotect(fault_addr, length / 2, PROT_NONE));
+
+    {
+        scoped_log_handler wrap_err(wrap_errors_logger);
+        ucs_status_t status = put_zcopy(sendbuf, remote_addr, recvbuf.rkey(),
+                                        &comp);
+        if (status == UCS_INPROGRESS) {
+            wait_for_flag(&comp.done);
+            status = comp.done ? comp.uct.status : UCS_ERR_TIMED_OUT;
+        }
+
+        EXPECT_TRUE(UCS_STATUS_IS_ERR(status)) << ucs_status_string(status);
+    }
+
+    ASSERT_EQ(0, mprotect(fault_addr, length / 2, PROT_READ | PROT_WRITE));
+}
+
+UCS_TEST_P(test_p2p_rma_scopy_mt, put_zcopy_fence_overlap) {
+    static const size_t length = 4 * UCS_MBYTE;
+    static const int num_iters = 10;
+    mapped_buffer recvbuf(length, 0, receiver());
+
+    for (int i = 0; i < num_iters; ++i) {
+        /* Both operations are split between helper threads and write the same
+         * remote range, so the second one must be copied after the first */
+        mapped_buffer sendbuf1(length, 2 * i + 1, sender());
+        mapped_buffer sendbuf2(length, 2 * i + 2, sender());
+        tx_comp comp1, comp2;
+
+        ucs_status_t status1 = put_zcopy(sendbuf1, recvbuf.addr(),
+                                         recvbuf.rkey(), &comp1);
+        ASSERT_UCS_OK_OR_INPROGRESS(status1);
+        ASSERT_UCS_OK(uct_ep_fence(sender_ep(), 0));
+        ucs_status_t status2 = put_zcopy(sendbuf2, recvbuf.addr(),
+                                         recvbuf.rkey(), &comp2);
+        ASSERT_UCS_OK_OR_INPROGRESS(status2);
+
+        if (status1 == UCS_INPROGRESS) {
+            wait_for_flag(&comp1.done);
+            ASSERT_TRUE(comp1.done);
+            ASSERT_UCS_OK(comp1.uct.status);
+        }
+
+        if (status2 == UCS_INPROGRESS) {
+            wait_for_flag(&comp2.done);
+            ASSERT_TRUE(comp2.done);
+            ASSERT_UCS_OK(comp2.uct.status);
+        }
+
+        recvbuf.pattern_check(2 * i + 2);
+    }
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_scopy_mt, cma)
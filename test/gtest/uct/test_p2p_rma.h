@@ -15,7 +15,7 @@ public:
     static const uint64_t SEED2 = 0x2222222222222222lu;
     static const uint64_t SEED3 = 0x3333333333333333lu;
 
-    uct_p2p_rma_test();
+    uct_p2p_rma_test(uct_error_handler_t err_handler = NULL);
 
     ucs_status_t put_short(uct_ep_h ep, const mapped_buffer &sendbuf,
                            const mapped_buffer &recvbuf);